@@ -50,6 +50,7 @@ CODEOWNERS = ["@sense360store"]
 # so nothing here can drift from the tested implementation.
 SHARED_HEADERS = (
     "sense360_runtime.h",
+    "hysteresis_ladder.h",
     "airiq_engine.h",
     "ventiq_engine.h",
     "roomiq_engine.h",
@@ -74,6 +74,9 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
+
+#include "hysteresis_ladder.h"
 
 namespace sense360 {
 namespace airiq {
@@ -223,109 +226,963 @@ inline const char *health_to_string(Health health) {
   return "Unavailable";
 }
 
-class AirIQEngine {
+// One multi-value sample from a single sensor measurement (an SPS30 frame
+// carries PM1/PM2.5/PM4/PM10, an SCD41 frame carries CO2). The first six
+// fields share the Pollutant order; `present` is a bit mask over FrameField
+// so an absent field is never confused with a zero reading.
+enum FrameField {
+  FRAME_CO2 = 0,
+  FRAME_VOC = 1,
+  FRAME_NOX = 2,
+  FRAME_PM2_5 = 3,
+  FRAME_HCHO = 4,
+  FRAME_O3 = 5,
+  FRAME_PM1 = 6,
+  FRAME_PM4 = 7,
+  FRAME_PM10 = 8,
+  FRAME_FIELD_COUNT = 9,
+};
+
+struct AirIQFrame {
+  uint16_t present = 0;
+  float value[FRAME_FIELD_COUNT] = {};
+
+  void set(FrameField field, float v) {
+    value[field] = v;
+    present |= static_cast<uint16_t>(1u << field);
+  }
+  bool has(FrameField field) const { return (present >> field) & 1u; }
+  // Present and usable (not NaN, not negative) — the engine's validity rule.
+  bool valid(FrameField field) const {
+    return has(field) && !std::isnan(value[field]) && value[field] >= 0.0f;
+  }
+  bool empty() const { return present == 0; }
+  void clear() { present = 0; }
+};
+
+// One pollutant channel's static configuration: composition membership,
+// freshness windows and the provisional severity bands. A literal type, so
+// the codegen can emit a complete configuration as a constexpr value.
+struct ChannelConfig {
+  bool expected;
+  uint32_t warmup_ms;
+  uint32_t stale_ms;
+  float fair;
+  float poor;
+  float very_poor;
+  float hysteresis;
+
+  constexpr ChannelConfig with_expected(bool value) const {
+    return ChannelConfig{value, warmup_ms, stale_ms, fair, poor, very_poor,
+                         hysteresis};
+  }
+  constexpr ChannelConfig with_stale_ms(uint32_t value) const {
+    return ChannelConfig{expected, warmup_ms, value, fair, poor, very_poor,
+                         hysteresis};
+  }
+};
+
+// The complete, immutable AirIQ engine configuration (every pollutant
+// channel, enum order). Applied once by AirIQEngine::apply_config(); the
+// version makes a change explicit — re-applying the same version is a
+// no-op, so a configuration can only move on a deliberate reconfigure.
+// Version 0 is reserved for the engine defaults below.
+//
+// early_ventilate_min enables the predictive "Ventilate soon": when > 0, a
+// fresh expected ventilation-responsive pollutant whose trend reaches Poor
+// within this many minutes recommends ventilation before the band is
+// crossed. 0 (the default) keeps the purely reactive recommendation.
+struct AirIQConfig {
+  uint32_t version;
+  ChannelConfig channels[POLLUTANT_COUNT];
+  float early_ventilate_min;
+};
+
+// The engine defaults, single-sourced here (the glue and VentIQ derive
+// their configurations from these; no downstream threshold duplicates).
+//
+// Expected-channel defaults are the generic engine baseline (CO2, VOC,
+// NOx); a composition drives the rest. In the S360-210 framework the SFA40
+// formaldehyde channel (U2) is set expected, while the EXTERNAL SPS30 PM
+// module (J2) is expected only via the opt-in overlay — an undeclared
+// absent module must never degrade health. The ozone slot has no driver
+// and stays unexpected everywhere.
+//
+// PROVISIONAL severity thresholds (fair / poor / very poor lower bounds)
+// and improvement hysteresis — indoor-air-quality heuristics pending bench
+// + customer validation, never medical or regulatory values. Sources are
+// documented in the architecture doc:
+//   CO2  : accepted owner comfort/ventilation bands (800/1000/1500).
+//   VOC  : relative-index heuristic informed by Sensirion's guidance
+//          that 100 is the conditioning average (150/250/400).
+//   NOx  : relative-index heuristic; the NOx index baseline is 1 and
+//          values above ~100 indicate elevated NOx (100/200/300).
+//   PM2.5: derived from published US EPA PM2.5 breakpoints, used as
+//          provisional indoor heuristics only (12/35.5/55.5).
+//   HCHO : provisional ppb bands referencing the WHO indoor guideline
+//          magnitude (~81 ppb) — contract slot only (80/120/250).
+//   O3   : provisional ppb bands — contract slot only (50/70/120).
+//
+// PROVISIONAL per-sensor freshness windows (ms). Warm-up = how long after
+// boot the first valid sample may honestly take (data availability only —
+// NEVER an accuracy claim; the SGP41 index keeps adapting its baseline for
+// much longer, which is documented, not hidden). Stale = three missed
+// update intervals of the compiled sensor configuration.
+constexpr ChannelConfig default_channel_config(Pollutant pollutant) {
+  return pollutant == POLLUTANT_CO2
+             ? ChannelConfig{true, 60000, 90000, 800.0f, 1000.0f, 1500.0f,
+                             50.0f}
+         : pollutant == POLLUTANT_VOC
+             ? ChannelConfig{true, 120000, 90000, 150.0f, 250.0f, 400.0f,
+                             10.0f}
+         : pollutant == POLLUTANT_NOX
+             ? ChannelConfig{true, 120000, 90000, 100.0f, 200.0f, 300.0f,
+                             10.0f}
+         : pollutant == POLLUTANT_PM25
+             ? ChannelConfig{false, 60000, 90000, 12.0f, 35.5f, 55.5f, 3.0f}
+         : pollutant == POLLUTANT_HCHO
+             ? ChannelConfig{false, 60000, 90000, 80.0f, 120.0f, 250.0f,
+                             10.0f}
+             : ChannelConfig{false, 120000, 90000, 50.0f, 70.0f, 120.0f,
+                             5.0f};
+}
+
+constexpr AirIQConfig default_config() {
+  return AirIQConfig{0,
+                     {default_channel_config(POLLUTANT_CO2),
+                      default_channel_config(POLLUTANT_VOC),
+                      default_channel_config(POLLUTANT_NOX),
+                      default_channel_config(POLLUTANT_PM25),
+                      default_channel_config(POLLUTANT_HCHO),
+                      default_channel_config(POLLUTANT_O3)},
+                     0.0f};
+}
+
+// --- compile-time composition ----------------------------------------------
+// A channel set is a bit mask: bit i (i < POLLUTANT_COUNT) is pollutant
+// channel i; the two top bits carry the non-pollutant contract channels.
+// The PM1/PM4/PM10 fractions ride the PM2.5 bit (same SPS30 measurement).
+// A channel outside the set has NO storage and no loop iteration in the
+// engine: its inputs are ignored, its values read NAN, its severity reads
+// Unavailable and it can never be expected.
+constexpr uint8_t channel_bit(Pollutant pollutant) {
+  return static_cast<uint8_t>(1u << pollutant);
+}
+constexpr uint8_t CHANNEL_PRESSURE = 1u << 6;
+constexpr uint8_t CHANNEL_MICS = 1u << 7;
+constexpr uint8_t POLLUTANT_CHANNELS = (1u << POLLUTANT_COUNT) - 1u;
+constexpr uint8_t ALL_CHANNELS = 0xFF;
+// The ventilation-responsive pollutants (ventilation demonstrably reduces
+// them): the recommendation drivers, each with a trend estimator.
+constexpr uint8_t VENTILATION_CHANNELS = (1u << POLLUTANT_CO2) |
+                                         (1u << POLLUTANT_VOC) |
+                                         (1u << POLLUTANT_NOX);
+
+// --- rolling statistics ------------------------------------------------------
+// Per-pollutant 1 h / 8 h / 24 h views built from fixed rings of bucket
+// aggregates (sum, min, max, count) — never raw samples. A sample costs one
+// bucket update per ring; a query folds at most 24 buckets. Only valid
+// inputs enter a bucket, so a stale gap contributes nothing: a window that
+// saw no valid sample reads NAN, and a gap is never averaged in as a held
+// value. Statistics are a compile-time opt-in per pollutant (a second
+// channel mask on the engine); a pollutant without them carries no storage.
+enum StatisticsWindow {
+  WINDOW_1H = 0,
+  WINDOW_8H = 1,
+  WINDOW_24H = 2,
+};
+
+enum Statistic {
+  STATISTIC_MEAN = 0,
+  STATISTIC_MIN = 1,
+  STATISTIC_MAX = 2,
+  STATISTIC_P95 = 3,
+};
+
+// One window's statistics. The mean is sample-weighted; min and max are
+// exact. The 95th percentile is taken over the window's bucket means
+// (weighted by bucket sample count), i.e. it describes sustained 5-minute
+// (1 h window) or hourly (8 h / 24 h) levels, not single-sample spikes.
+// Window edges move one bucket at a time: the 1 h window is the current
+// 5-minute bucket plus the previous eleven, the 8 h / 24 h windows the
+// current hour plus the previous 7 / 23.
+struct WindowStatistics {
+  float mean = NAN;
+  float min = NAN;
+  float max = NAN;
+  float p95 = NAN;
+  uint32_t samples = 0;
+
+  float get(Statistic statistic) const {
+    switch (statistic) {
+      case STATISTIC_MEAN:
+        return mean;
+      case STATISTIC_MIN:
+        return min;
+      case STATISTIC_MAX:
+        return max;
+      case STATISTIC_P95:
+        return p95;
+    }
+    return NAN;
+  }
+};
+
+// --- exposure dose -----------------------------------------------------------
+// Time-weighted exposure integrated on-device since the last daily reset
+// (the glue resets at local midnight from its clock), plus a rolling 8-hour
+// integral that no daily reset touches. Each valid sample
+// closes one linear segment back to the previous sample — a constant-time
+// trapezoidal update — but only while the previous sample is still FRESH
+// under the channel's stale window (the severity rule), so stale time
+// contributes nothing. Like statistics, exposure is a compile-time opt-in
+// per pollutant.
+enum ExposureMetric {
+  EXPOSURE_DOSE = 0,    // unit·h above the pollutant's Poor threshold
+  EXPOSURE_TWA = 1,     // time-weighted mean over the covered time
+  EXPOSURE_TWA_8H = 2,  // last 8 h's integral / 8 h (stale time as zero)
+  EXPOSURE_HOURS = 3,   // covered (fresh) hours
+};
+
+struct ExposureSummary {
+  float dose = NAN;
+  float integral = NAN;     // unit·h
+  float hours = NAN;
+  float integral_8h = NAN;  // unit·h over the last 8 hours
+
+  float get(ExposureMetric metric) const {
+    switch (metric) {
+      case EXPOSURE_DOSE:
+        return dose;
+      case EXPOSURE_TWA:
+        return hours > 0.0f ? integral / hours : NAN;
+      case EXPOSURE_TWA_8H:
+        return integral_8h / 8.0f;
+      case EXPOSURE_HOURS:
+        return hours;
+    }
+    return NAN;
+  }
+};
+
+// --- transition journal -------------------------------------------------------
+// Each severity, headline and recommendation change is recorded in a
+// fixed ring of 8-byte entries (opt-in, see BasicAirIQEngine's Journal):
+// the device-side evidence for a flapping headline. When the ring is full
+// the oldest entry is overwritten and counted as dropped.
+
+// Journal subjects: the pollutants (enum Pollutant), then the headline
+// outputs.
+constexpr uint8_t JOURNAL_AIR_QUALITY = POLLUTANT_COUNT;
+constexpr uint8_t JOURNAL_RECOMMENDATION = POLLUTANT_COUNT + 1;
+// Transition::value when the value was unknown.
+constexpr int16_t JOURNAL_NO_VALUE = INT16_MIN;
+
+struct Transition {
+  uint32_t at_ms;
+  // The subject's value rounded to an integer (headline subjects: the
+  // driving pollutant's value); JOURNAL_NO_VALUE when unknown.
+  int16_t value;
+  uint8_t subject;
+  uint8_t states;  // from << 4 | to (Severity / AirQuality / Recommendation)
+
+  int from() const { return states >> 4; }
+  int to() const { return states & 0x0F; }
+};
+static_assert(sizeof(Transition) == 8, "journal entries stay 8 bytes");
+
+namespace detail {
+
+// Returned by next_deadline_ms() when no output can change on its own.
+constexpr uint32_t NO_DEADLINE = 0xFFFFFFFFu;
+
+enum ChannelState {
+  CHANNEL_INIT = 0,
+  CHANNEL_FRESH = 1,
+  CHANNEL_MISSING = 2,
+};
+
+inline uint32_t elapsed(uint32_t since_ms, uint32_t now_ms) {
+  return now_ms - since_ms;  // unsigned arithmetic handles wrap-around
+}
+
+inline uint32_t earliest(uint32_t a, uint32_t b) { return a < b ? a : b; }
+
+inline ChannelState channel_state(uint32_t start_ms, uint32_t now_ms,
+                                  bool seen, uint32_t last_ms,
+                                  uint32_t warmup_ms, uint32_t stale_ms) {
+  if (!seen) {
+    return elapsed(start_ms, now_ms) < warmup_ms ? CHANNEL_INIT
+                                                 : CHANNEL_MISSING;
+  }
+  return elapsed(last_ms, now_ms) <= stale_ms ? CHANNEL_FRESH
+                                              : CHANNEL_MISSING;
+}
+
+// Delay until a FRESH channel turns MISSING (fresh while elapsed <= stale).
+inline uint32_t stale_deadline(uint32_t now_ms, uint32_t last_ms,
+                               uint32_t stale_ms) {
+  const uint32_t age = elapsed(last_ms, now_ms);
+  if (age > stale_ms) return NO_DEADLINE;
+  const uint32_t left = stale_ms - age;
+  return left < NO_DEADLINE ? left + 1 : NO_DEADLINE;
+}
+
+// Delay until channel_state() would return something different for the
+// same inputs (mirrors its INIT / FRESH / MISSING boundaries exactly).
+inline uint32_t channel_deadline(uint32_t start_ms, uint32_t now_ms,
+                                 bool seen, uint32_t last_ms,
+                                 uint32_t warmup_ms, uint32_t stale_ms) {
+  if (seen) return stale_deadline(now_ms, last_ms, stale_ms);
+  const uint32_t age = elapsed(start_ms, now_ms);
+  return age < warmup_ms ? warmup_ms - age : NO_DEADLINE;
+}
+
+inline bool invalid(float value) { return std::isnan(value) || value < 0.0f; }
+
+constexpr int count_channels(unsigned mask) {
+  return mask == 0 ? 0 : static_cast<int>(mask & 1u) + count_channels(mask >> 1);
+}
+
+// Storage slot of pollutant p in a channel set (-1 when absent).
+constexpr int slot_of(uint8_t channels, int p) {
+  return ((channels >> p) & 1u) ? count_channels(channels & ((1u << p) - 1u))
+                                : -1;
+}
+
+// The pollutant held in storage slot n (POLLUTANT_COUNT past the end).
+constexpr int pollutant_at(uint8_t channels, int n, int p = 0) {
+  return p >= POLLUTANT_COUNT ? POLLUTANT_COUNT
+         : !((channels >> p) & 1u) ? pollutant_at(channels, n, p + 1)
+         : n == 0                  ? p
+                                   : pollutant_at(channels, n - 1, p + 1);
+}
+
+// Optional channel groups. The engine inherits one of each; the absent
+// specialisation is an empty base (zero bytes) whose members are no-ops.
+template <bool Fitted> struct PmFractions {
+  void input(int fraction, float ugm3) {
+    if (invalid(ugm3)) return;
+    value_[fraction] = ugm3;
+    seen_[fraction] = true;
+  }
+  float value(int fraction, bool pm_fresh) const {
+    return (seen_[fraction] && pm_fresh) ? value_[fraction] : NAN;
+  }
+
+ private:
+  float value_[3] = {NAN, NAN, NAN};  // PM1, PM4, PM10
+  bool seen_[3] = {};
+};
+template <> struct PmFractions<false> {
+  void input(int, float) {}
+  float value(int, bool) const { return NAN; }
+};
+
+template <bool Fitted> struct PressureChannel {
+  void input(uint32_t now_ms, float hpa) {
+    if (std::isnan(hpa) || hpa <= 0.0f) return;
+    value_ = hpa;
+    seen_ = true;
+    last_ms_ = now_ms;
+  }
+  void set_warmup_ms(uint32_t ms) { warmup_ms_ = ms; }
+  void set_stale_ms(uint32_t ms) { stale_ms_ = ms; }
+  void update(uint32_t start_ms, uint32_t now_ms) {
+    state_ = channel_state(start_ms, now_ms, seen_, last_ms_, warmup_ms_,
+                           stale_ms_);
+  }
+  uint32_t deadline(uint32_t start_ms, uint32_t now_ms) const {
+    return channel_deadline(start_ms, now_ms, seen_, last_ms_, warmup_ms_,
+                            stale_ms_);
+  }
+  bool fresh() const { return state_ == CHANNEL_FRESH; }
+  float value() const { return fresh() ? value_ : NAN; }
+  float data_age_s(uint32_t now_ms) const {
+    if (!seen_) return NAN;
+    return elapsed(last_ms_, now_ms) / 1000.0f;
+  }
+
+ private:
+  uint32_t warmup_ms_ = 90000;
+  uint32_t stale_ms_ = 180000;
+  float value_ = NAN;
+  bool seen_ = false;
+  uint32_t last_ms_ = 0;
+  int state_ = CHANNEL_INIT;
+};
+template <> struct PressureChannel<false> {
+  void input(uint32_t, float) {}
+  void set_warmup_ms(uint32_t) {}
+  void set_stale_ms(uint32_t) {}
+  void update(uint32_t, uint32_t) {}
+  uint32_t deadline(uint32_t, uint32_t) const { return NO_DEADLINE; }
+  bool fresh() const { return false; }
+  float value() const { return NAN; }
+  float data_age_s(uint32_t) const { return NAN; }
+};
+
+// MiCS freshness has no warm-up phase: only a seen channel can lapse.
+template <bool Fitted> struct MicsChannels {
+  void input(int channel, uint32_t now_ms, float value) {
+    if (std::isnan(value)) return;
+    value_[channel] = value;
+    seen_[channel] = true;
+    last_ms_[channel] = now_ms;
+  }
+  void set_stale_ms(uint32_t ms) { stale_ms_ = ms; }
+  void update(uint32_t now_ms) {
+    for (int i = 0; i < 2; i++)
+      fresh_[i] = seen_[i] && elapsed(last_ms_[i], now_ms) <= stale_ms_;
+  }
+  uint32_t deadline(uint32_t now_ms) const {
+    uint32_t next = NO_DEADLINE;
+    for (int i = 0; i < 2; i++) {
+      if (seen_[i])
+        next = earliest(next, stale_deadline(now_ms, last_ms_[i], stale_ms_));
+    }
+    return next;
+  }
+  float value(int channel) const {
+    return fresh_[channel] ? value_[channel] : NAN;
+  }
+
+ private:
+  uint32_t stale_ms_ = 90000;
+  float value_[2] = {NAN, NAN};  // reducing, oxidising
+  bool seen_[2] = {};
+  uint32_t last_ms_[2] = {};
+  bool fresh_[2] = {};
+};
+template <> struct MicsChannels<false> {
+  void input(int, uint32_t, float) {}
+  void set_stale_ms(uint32_t) {}
+  void update(uint32_t) {}
+  uint32_t deadline(uint32_t) const { return NO_DEADLINE; }
+  float value(int) const { return NAN; }
+};
+
+// Online trend of one pollutant: exponentially weighted least squares
+// over a bounded window (time constant TAU_MIN) held in five running sums
+// — no sample storage. The sums are re-centred on the newest sample (t = 0,
+// in minutes) at every update, so they stay well-conditioned in float.
+class TrendEstimator {
+ public:
+  static constexpr float TAU_MIN = 5.0f;
+
+  void reset() { *this = TrendEstimator(); }
+
+  void add(float dt_min, float value) {
+    if (w_ > 0.0f) {
+      const float decay = std::exp(-dt_min / TAU_MIN);
+      tt_ = decay * (tt_ - 2.0f * dt_min * t_ + dt_min * dt_min * w_);
+      tv_ = decay * (tv_ - dt_min * v_);
+      t_ = decay * (t_ - dt_min * w_);
+      v_ = decay * v_;
+      w_ = decay * w_;
+    }
+    w_ += 1.0f;
+    v_ += value;
+  }
+
+  // Units per minute. NAN until the weighted sample times spread over at
+  // least a minute (standard deviation), so a burst of near-simultaneous
+  // samples never extrapolates sensor noise.
+  float slope() const {
+    const float spread = w_ * tt_ - t_ * t_;
+    if (!(spread >= w_ * w_)) return NAN;
+    return (w_ * tv_ - t_ * v_) / spread;
+  }
+  // The fitted level at the newest sample.
+  float level() const { return (v_ - slope() * t_) / w_; }
+
+ private:
+  float w_ = 0.0f;
+  float t_ = 0.0f;
+  float v_ = 0.0f;
+  float tt_ = 0.0f;
+  float tv_ = 0.0f;
+};
+
+// One statistics bucket: aggregates only. A full bucket drops further
+// samples rather than biasing the mean.
+struct StatisticsBucket {
+  float sum = 0.0f;
+  float min = 0.0f;
+  float max = 0.0f;
+  uint16_t count = 0;
+
+  void add(float value) {
+    if (count == 0xFFFF) return;
+    if (count == 0 || value < min) min = value;
+    if (count == 0 || value > max) max = value;
+    sum += value;
+    count++;
+  }
+};
+
+// Query-side fold of up to 24 buckets into one WindowStatistics.
+class StatisticsFold {
+ public:
+  void add(const StatisticsBucket &bucket) {
+    if (buckets_ == 0 || bucket.min < min_) min_ = bucket.min;
+    if (buckets_ == 0 || bucket.max > max_) max_ = bucket.max;
+    sum_ += bucket.sum;
+    samples_ += bucket.count;
+    // Insertion keeps the bucket means sorted for the percentile.
+    const float mean = bucket.sum / bucket.count;
+    int i = buckets_++;
+    for (; i > 0 && mean_[i - 1] > mean; i--) {
+      mean_[i] = mean_[i - 1];
+      count_[i] = count_[i - 1];
+    }
+    mean_[i] = mean;
+    count_[i] = bucket.count;
+  }
+
+  WindowStatistics result() const {
+    WindowStatistics out;
+    if (samples_ == 0) return out;
+    out.samples = samples_;
+    out.mean = sum_ / samples_;
+    out.min = min_;
+    out.max = max_;
+    // Nearest rank over the sample-weighted bucket means.
+    const uint32_t rank = (samples_ * 95 + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < buckets_; i++) {
+      seen += count_[i];
+      if (seen >= rank) {
+        out.p95 = mean_[i];
+        break;
+      }
+    }
+    return out;
+  }
+
+ private:
+  float sum_ = 0.0f;
+  float min_ = 0.0f;
+  float max_ = 0.0f;
+  uint32_t samples_ = 0;
+  int buckets_ = 0;
+  float mean_[24];
+  uint16_t count_[24];
+};
+
+// N buckets of WidthMs each; the head bucket starts at head_ms_. Advancing
+// uses unsigned elapsed time, so the ring is indifferent to millis()
+// wrapping (like every freshness window in this engine).
+template <int N, uint32_t WidthMs> class BucketRing {
  public:
-  AirIQEngine() {
-    // Expected-channel defaults are the generic engine baseline (CO2, VOC,
-    // NOx); a composition drives the rest via set_expected(). In the
-    // S360-210 framework the SFA40 formaldehyde channel (U2) is set expected,
-    // while the EXTERNAL SPS30 PM module (J2) is expected only via the
-    // opt-in overlay — an undeclared absent module must never degrade
-    // health. The ozone slot has no driver and stays unexpected everywhere.
-    expected_[POLLUTANT_CO2] = true;
-    expected_[POLLUTANT_VOC] = true;
-    expected_[POLLUTANT_NOX] = true;
-    expected_[POLLUTANT_PM25] = false;
-    expected_[POLLUTANT_HCHO] = false;
-    expected_[POLLUTANT_O3] = false;
-
-    // PROVISIONAL severity thresholds (fair / poor / very poor lower
-    // bounds) and improvement hysteresis — indoor-air-quality heuristics
-    // pending bench + customer validation, never medical or regulatory
-    // values. Sources are documented in the architecture doc:
-    //   CO2  : accepted owner comfort/ventilation bands (800/1000/1500).
-    //   VOC  : relative-index heuristic informed by Sensirion's guidance
-    //          that 100 is the conditioning average (150/250/400).
-    //   NOx  : relative-index heuristic; the NOx index baseline is 1 and
-    //          values above ~100 indicate elevated NOx (100/200/300).
-    //   PM2.5: derived from published US EPA PM2.5 breakpoints, used as
-    //          provisional indoor heuristics only (12/35.5/55.5).
-    //   HCHO : provisional ppb bands referencing the WHO indoor guideline
-    //          magnitude (~81 ppb) — contract slot only (80/120/250).
-    //   O3   : provisional ppb bands — contract slot only (50/70/120).
-    set_thresholds(POLLUTANT_CO2, 800.0f, 1000.0f, 1500.0f);
-    set_hysteresis(POLLUTANT_CO2, 50.0f);
-    set_thresholds(POLLUTANT_VOC, 150.0f, 250.0f, 400.0f);
-    set_hysteresis(POLLUTANT_VOC, 10.0f);
-    set_thresholds(POLLUTANT_NOX, 100.0f, 200.0f, 300.0f);
-    set_hysteresis(POLLUTANT_NOX, 10.0f);
-    set_thresholds(POLLUTANT_PM25, 12.0f, 35.5f, 55.5f);
-    set_hysteresis(POLLUTANT_PM25, 3.0f);
-    set_thresholds(POLLUTANT_HCHO, 80.0f, 120.0f, 250.0f);
-    set_hysteresis(POLLUTANT_HCHO, 10.0f);
-    set_thresholds(POLLUTANT_O3, 50.0f, 70.0f, 120.0f);
-    set_hysteresis(POLLUTANT_O3, 5.0f);
-
-    // PROVISIONAL per-sensor freshness windows (ms). Warm-up = how long
-    // after boot the first valid sample may honestly take (data
-    // availability only — NEVER an accuracy claim; the SGP41 index keeps
-    // adapting its baseline for much longer, which is documented, not
-    // hidden). Stale = three missed update intervals of the compiled
-    // sensor configuration.
-    set_warmup_ms(POLLUTANT_CO2, 60000);
-    set_stale_ms(POLLUTANT_CO2, 90000);
-    set_warmup_ms(POLLUTANT_VOC, 120000);
-    set_stale_ms(POLLUTANT_VOC, 90000);
-    set_warmup_ms(POLLUTANT_NOX, 120000);
-    set_stale_ms(POLLUTANT_NOX, 90000);
-    set_warmup_ms(POLLUTANT_PM25, 60000);
-    set_stale_ms(POLLUTANT_PM25, 90000);
-    set_warmup_ms(POLLUTANT_HCHO, 60000);
-    set_stale_ms(POLLUTANT_HCHO, 90000);
-    set_warmup_ms(POLLUTANT_O3, 120000);
-    set_stale_ms(POLLUTANT_O3, 90000);
+  void add(uint32_t now_ms, float value) {
+    advance(now_ms);
+    bucket_[head_].add(value);
   }
 
+  // Folds the buckets inside the newest `span` bucket periods as of now_ms.
+  void fold(uint32_t now_ms, int span, StatisticsFold &out) const {
+    if (!started_) return;
+    const uint32_t lag = elapsed(head_ms_, now_ms) / WidthMs;
+    for (int i = 0; i < span && lag + i < static_cast<uint32_t>(span); i++) {
+      const StatisticsBucket &bucket = bucket_[(head_ + N - i) % N];
+      if (bucket.count > 0) out.add(bucket);
+    }
+  }
+
+ private:
+  void advance(uint32_t now_ms) {
+    if (!started_) {
+      started_ = true;
+      head_ms_ = now_ms;
+      return;
+    }
+    const uint32_t steps = elapsed(head_ms_, now_ms) / WidthMs;
+    if (steps == 0) return;
+    const uint32_t cleared = steps < N ? steps : N;
+    for (uint32_t i = 0; i < cleared; i++) {
+      head_ = (head_ + 1) % N;
+      bucket_[head_] = StatisticsBucket();
+    }
+    head_ms_ += steps * WidthMs;
+  }
+
+  StatisticsBucket bucket_[N];
+  uint32_t head_ms_ = 0;
+  uint8_t head_ = 0;
+  bool started_ = false;
+};
+
+// One pollutant's statistics: 12 x 5 min for the 1 h window, 24 x 1 h for
+// the 8 h and 24 h windows.
+struct RollingStatistics {
+  void add(uint32_t now_ms, float value) {
+    fine_.add(now_ms, value);
+    coarse_.add(now_ms, value);
+  }
+  WindowStatistics window(StatisticsWindow window, uint32_t now_ms) const {
+    StatisticsFold fold;
+    switch (window) {
+      case WINDOW_1H:
+        fine_.fold(now_ms, 12, fold);
+        break;
+      case WINDOW_8H:
+        coarse_.fold(now_ms, 8, fold);
+        break;
+      case WINDOW_24H:
+        coarse_.fold(now_ms, 24, fold);
+        break;
+    }
+    return fold.result();
+  }
+
+ private:
+  BucketRing<12, 300000> fine_;
+  BucketRing<24, 3600000> coarse_;
+};
+
+// Statistics storage for N pollutants (empty base when none are compiled).
+template <int N> struct StatisticsStore {
+  void add(int slot, uint32_t now_ms, float value) {
+    if (slot >= 0) statistics_[slot].add(now_ms, value);
+  }
+  WindowStatistics window(int slot, StatisticsWindow window,
+                          uint32_t now_ms) const {
+    return slot >= 0 ? statistics_[slot].window(window, now_ms)
+                     : WindowStatistics();
+  }
+
+ private:
+  RollingStatistics statistics_[N];
+};
+template <> struct StatisticsStore<0> {
+  void add(int, uint32_t, float) {}
+  WindowStatistics window(int, StatisticsWindow, uint32_t) const {
+    return WindowStatistics();
+  }
+};
+
+// Mean excess over `limit` of the linear segment a -> b (exact, including
+// a segment that crosses the limit).
+inline float segment_excess(float a, float b, float limit) {
+  const float ea = a - limit;
+  const float eb = b - limit;
+  if (ea <= 0.0f && eb <= 0.0f) return 0.0f;
+  if (ea >= 0.0f && eb >= 0.0f) return 0.5f * (ea + eb);
+  const float peak = ea > 0.0f ? ea : eb;
+  return 0.5f * peak * peak / (ea > eb ? ea - eb : eb - ea);
+}
+
+// The last eight hours' exposure integral from nine hourly buckets. The
+// oldest bucket counts for the part of its hour still inside the window
+// (its exposure taken as evenly spread), so a constant level reads back
+// exactly; a segment across an hour boundary is split by time. Like
+// BucketRing, indifferent to millis() wrapping.
+class ExposureHours {
+ public:
+  // The segment's integral over the dt_ms up to now_ms.
+  void add(uint32_t now_ms, uint32_t dt_ms, float integral) {
+    if (!started_) {
+      started_ = true;
+      head_ms_ = now_ms - dt_ms;  // the first hour starts with the segment
+    }
+    advance(now_ms);
+    const uint32_t inside = elapsed(head_ms_, now_ms);
+    if (dt_ms > inside) {
+      const float before = integral * (dt_ms - inside) / dt_ms;
+      hour_[(head_ + SLOTS - 1) % SLOTS] += before;
+      integral -= before;
+    }
+    hour_[head_] += integral;
+  }
+
+  float window_integral(uint32_t now_ms) const {
+    if (!started_) return 0.0f;
+    const uint32_t age = elapsed(head_ms_, now_ms);
+    const uint32_t lag = age / HOUR_MS;
+    const float into = static_cast<float>(age % HOUR_MS) / HOUR_MS;
+    float sum = 0.0f;
+    // i counts whole hours back from the hour now_ms is in.
+    for (uint32_t i = lag; i < SLOTS; i++) {
+      const float bucket = hour_[(head_ + SLOTS - (i - lag)) % SLOTS];
+      sum += i + 1 < SLOTS ? bucket : bucket * (1.0f - into);
+    }
+    return sum;
+  }
+
+ private:
+  static const uint32_t HOUR_MS = 3600000;
+  static const uint32_t SLOTS = 9;
+
+  void advance(uint32_t now_ms) {
+    const uint32_t steps = elapsed(head_ms_, now_ms) / HOUR_MS;
+    if (steps == 0) return;
+    const uint32_t cleared = steps < SLOTS ? steps : SLOTS;
+    for (uint32_t i = 0; i < cleared; i++) {
+      head_ = (head_ + 1) % SLOTS;
+      hour_[head_] = 0.0f;
+    }
+    head_ms_ += steps * HOUR_MS;
+  }
+
+  float hour_[SLOTS] = {};
+  uint32_t head_ms_ = 0;
+  uint8_t head_ = 0;
+  bool started_ = false;
+};
+
+// One pollutant's exposure since the last reset and over the last eight
+// hours (56 bytes).
+struct ExposureAccumulator {
+  void add(uint32_t now_ms, float a, float b, uint32_t dt_ms, float limit) {
+    const float hours = dt_ms / 3600000.0f;
+    const float segment = 0.5f * (a + b) * hours;
+    integral_ += segment;
+    last_8h_.add(now_ms, dt_ms, segment);
+    dose_ += segment_excess(a, b, limit) * hours;
+    // Saturates rather than wraps when no clock ever resets it.
+    covered_ms_ = dt_ms > 0xFFFFFFFFu - covered_ms_ ? 0xFFFFFFFFu
+                                                    : covered_ms_ + dt_ms;
+  }
+  ExposureSummary summary(uint32_t now_ms) const {
+    ExposureSummary out;
+    out.dose = dose_;
+    out.integral = integral_;
+    out.hours = covered_ms_ / 3600000.0f;
+    out.integral_8h = last_8h_.window_integral(now_ms);
+    return out;
+  }
+  // A new day: the rolling 8 hours run on across it.
+  void reset_day() {
+    integral_ = 0.0f;
+    dose_ = 0.0f;
+    covered_ms_ = 0;
+  }
+
+ private:
+  float integral_ = 0.0f;
+  float dose_ = 0.0f;
+  uint32_t covered_ms_ = 0;
+  ExposureHours last_8h_;
+};
+
+// Exposure storage for N pollutants (empty base when none are compiled).
+template <int N> struct ExposureStore {
+  void add(int slot, uint32_t now_ms, float a, float b, uint32_t dt_ms,
+           float limit) {
+    if (slot >= 0) exposure_[slot].add(now_ms, a, b, dt_ms, limit);
+  }
+  ExposureSummary summary(int slot, uint32_t now_ms) const {
+    return slot >= 0 ? exposure_[slot].summary(now_ms) : ExposureSummary();
+  }
+  void reset() {
+    for (int i = 0; i < N; i++) exposure_[i].reset_day();
+  }
+
+ private:
+  ExposureAccumulator exposure_[N];
+};
+template <> struct ExposureStore<0> {
+  void add(int, uint32_t, float, float, uint32_t, float) {}
+  ExposureSummary summary(int, uint32_t) const { return ExposureSummary(); }
+  void reset() {}
+};
+
+inline int16_t journal_value(float value) {
+  if (std::isnan(value)) return JOURNAL_NO_VALUE;
+  if (value >= 32767.0f) return 32767;
+  if (value <= -32767.0f) return -32767;
+  return static_cast<int16_t>(std::lround(value));
+}
+
+// The transition ring (N a power of two; empty base when N is 0).
+// Recording is O(1) and never allocates.
+template <int N> class TransitionJournal {
+  static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0,
+                "the journal size must be a power of two up to 128");
+
+ public:
+  void record(uint32_t now_ms, uint8_t subject, int from, int to,
+              float value) {
+    Transition &entry = entries_[(head_ + count_) & (N - 1)];
+    entry.at_ms = now_ms;
+    entry.value = journal_value(value);
+    entry.subject = subject;
+    entry.states = static_cast<uint8_t>((from << 4) | (to & 0x0F));
+    if (count_ < N) {
+      count_++;
+    } else {
+      head_ = (head_ + 1) & (N - 1);
+      if (dropped_ < UINT16_MAX) dropped_++;
+    }
+  }
+  int drain(Transition *out, int max) {
+    int n = 0;
+    while (n < max && count_ > 0) {
+      out[n++] = entries_[head_];
+      head_ = (head_ + 1) & (N - 1);
+      count_--;
+    }
+    if (count_ == 0) dropped_ = 0;
+    return n;
+  }
+  int pending() const { return count_; }
+  uint16_t dropped() const { return dropped_; }
+
+ private:
+  Transition entries_[N];
+  uint8_t head_ = 0;
+  uint8_t count_ = 0;
+  uint16_t dropped_ = 0;
+};
+template <> class TransitionJournal<0> {
+ public:
+  void record(uint32_t, uint8_t, int, int, float) {}
+  int drain(Transition *, int) { return 0; }
+  int pending() const { return 0; }
+  uint16_t dropped() const { return 0; }
+};
+
+}  // namespace detail
+
+// The engine over a compile-time channel set. Production compositions
+// instantiate the set their YAML can actually feed (see
+// SENSE360_AIRIQ_CHANNELS below); AirIQEngine is the all-channels engine.
+// Statistics and Exposure are the pollutant masks that keep rolling
+// statistics / exposure dose (none by default; only their overlap with
+// Channels is stored). Journal is the transition journal's entry count
+// (0 = none).
+template <uint8_t Channels, uint8_t Statistics = 0, uint8_t Exposure = 0,
+          uint8_t Journal = 0>
+class BasicAirIQEngine
+    : private detail::PmFractions<(Channels & (1u << POLLUTANT_PM25)) != 0>,
+      private detail::PressureChannel<(Channels & CHANNEL_PRESSURE) != 0>,
+      private detail::MicsChannels<(Channels & CHANNEL_MICS) != 0>,
+      private detail::StatisticsStore<detail::count_channels(
+          Channels & Statistics & POLLUTANT_CHANNELS)>,
+      private detail::ExposureStore<detail::count_channels(
+          Channels & Exposure & POLLUTANT_CHANNELS)>,
+      private detail::TransitionJournal<Journal> {
+  typedef detail::PmFractions<(Channels & (1u << POLLUTANT_PM25)) != 0>
+      PmStore;
+  typedef detail::PressureChannel<(Channels & CHANNEL_PRESSURE) != 0>
+      PressureStore;
+  typedef detail::MicsChannels<(Channels & CHANNEL_MICS) != 0> MicsStore;
+  typedef detail::StatisticsStore<detail::count_channels(
+      Channels & Statistics & POLLUTANT_CHANNELS)>
+      StatisticsStore;
+  typedef detail::ExposureStore<detail::count_channels(
+      Channels & Exposure & POLLUTANT_CHANNELS)>
+      ExposureStore;
+  typedef detail::TransitionJournal<Journal> JournalStore;
+
+ public:
+  // Pollutant channels held by this engine (storage slots, enum order).
+  static constexpr int CHANNELS =
+      detail::count_channels(Channels & POLLUTANT_CHANNELS);
+  static_assert(CHANNELS > 0, "an AirIQ engine needs a pollutant channel");
+
+  BasicAirIQEngine() {
+    for (HysteresisLadder<3> &ladder : ladder_) ladder.set_immediate_rise(0.0f);
+    write_config(default_config());
+  }
+
+  static constexpr bool has_channel(Pollutant pollutant) {
+    return pollutant < POLLUTANT_COUNT && ((Channels >> pollutant) & 1u);
+  }
+  static constexpr bool has_statistics(Pollutant pollutant) {
+    return has_channel(pollutant) && ((Statistics >> pollutant) & 1u);
+  }
+  static constexpr bool has_exposure(Pollutant pollutant) {
+    return has_channel(pollutant) && ((Exposure >> pollutant) & 1u);
+  }
+  // Pollutant channels with a trend estimator.
+  static constexpr int TRENDS =
+      detail::count_channels(Channels & VENTILATION_CHANNELS);
+
+  // --- configuration (one immutable value, applied once) --------------------
+  // Applies a complete configuration and forces a full reclassification on
+  // the next evaluate(). Returns false (and changes nothing) when this
+  // version is already applied — the per-channel setters below remain for
+  // tests and embedded consumers, but production glue configures through
+  // this single entry point at setup() and on an explicit reconfigure.
+  // Entries for channels outside the set are ignored.
+  bool apply_config(const AirIQConfig &config) {
+    if (config.version == config_version_) return false;
+    write_config(config);
+    invalidate();
+    return true;
+  }
+  uint32_t config_version() const { return config_version_; }
+
   // --- composition configuration (substitution-driven; no Base/Pro axis) ----
   void set_expected(Pollutant pollutant, bool expected) {
-    if (pollutant < POLLUTANT_COUNT) expected_[pollutant] = expected;
+    const int s = slot(pollutant);
+    if (s < 0 || expected_[s] == expected) return;
+    expected_[s] = expected;
+    headline_dirty_ = true;
   }
   bool expected(Pollutant pollutant) const {
-    return pollutant < POLLUTANT_COUNT && expected_[pollutant];
+    const int s = slot(pollutant);
+    return s >= 0 && expected_[s];
   }
 
   // --- provisional thresholds (centralised here; no downstream duplicates) --
   void set_thresholds(Pollutant pollutant, float fair, float poor,
                       float very_poor) {
-    if (pollutant >= POLLUTANT_COUNT) return;
-    fair_[pollutant] = fair;
-    poor_[pollutant] = poor;
-    very_poor_[pollutant] = very_poor;
+    const int s = slot(pollutant);
+    if (s < 0) return;
+    HysteresisLadder<3> &ladder = ladder_[s];
+    if (ladder.boundary(0) == fair && ladder.boundary(1) == poor &&
+        ladder.boundary(2) == very_poor)
+      return;
+    ladder.set_boundaries({fair, poor, very_poor});
+    dirty_ |= 1u << s;
   }
   // Improvement hysteresis: worsening classifies immediately; improving
   // requires clearing the band boundary by this margin (no flapping).
   void set_hysteresis(Pollutant pollutant, float margin) {
-    if (pollutant >= POLLUTANT_COUNT) return;
-    hysteresis_[pollutant] =
+    const int s = slot(pollutant);
+    if (s < 0) return;
+    const float sanitised =
         (std::isnan(margin) || margin < 0.0f) ? 0.0f : margin;
+    if (ladder_[s].fall_margin() == sanitised) return;
+    ladder_[s].set_immediate_rise(sanitised);
+    dirty_ |= 1u << s;
   }
 
   // --- per-sensor freshness windows (independent; provisional) --------------
   void set_warmup_ms(Pollutant pollutant, uint32_t ms) {
-    if (pollutant < POLLUTANT_COUNT) warmup_ms_[pollutant] = ms;
+    const int s = slot(pollutant);
+    if (s >= 0) warmup_ms_[s] = ms;
   }
   void set_stale_ms(Pollutant pollutant, uint32_t ms) {
-    if (pollutant < POLLUTANT_COUNT) stale_ms_[pollutant] = ms;
+    const int s = slot(pollutant);
+    if (s >= 0) stale_ms_[s] = ms;
+  }
+  void set_pressure_warmup_ms(uint32_t ms) { PressureStore::set_warmup_ms(ms); }
+  void set_pressure_stale_ms(uint32_t ms) { PressureStore::set_stale_ms(ms); }
+  void set_mics_stale_ms(uint32_t ms) { MicsStore::set_stale_ms(ms); }
+
+  // Predictive "Ventilate soon" horizon in minutes (0 = off; see
+  // AirIQConfig::early_ventilate_min).
+  void set_early_ventilate_min(float minutes) {
+    const float sanitised =
+        (std::isnan(minutes) || minutes < 0.0f) ? 0.0f : minutes;
+    if (early_ventilate_min_ == sanitised) return;
+    early_ventilate_min_ = sanitised;
+    headline_dirty_ = true;
   }
-  void set_pressure_warmup_ms(uint32_t ms) { pressure_warmup_ms_ = ms; }
-  void set_pressure_stale_ms(uint32_t ms) { pressure_stale_ms_ = ms; }
-  void set_mics_stale_ms(uint32_t ms) { mics_stale_ms_ = ms; }
 
   // Explicit persistent fault input. RESERVED: no composed component
   // exposes a supported AirIQ fault signal today, so production YAML
   // never sets this; the engine contract exists (and is tested) for a
   // future real signal. Ordinary staleness NEVER produces Fault.
-  void set_fault(bool fault) { fault_ = fault; }
+  void set_fault(bool fault) {
+    if (fault_ == fault) return;
+    fault_ = fault;
+    headline_dirty_ = true;
+  }
 
   // --- lifecycle -------------------------------------------------------------
   void begin(uint32_t now_ms) {
@@ -361,21 +1218,34 @@ class AirIQEngine {
   // channel (same physical measurement as PM2.5).
   void input_pm1(uint32_t now_ms, float ugm3) {
     ensure_started(now_ms);
-    if (invalid(ugm3)) return;
-    pm1_ = ugm3;
-    pm1_seen_ = true;
+    PmStore::input(0, ugm3);
   }
   void input_pm4(uint32_t now_ms, float ugm3) {
     ensure_started(now_ms);
-    if (invalid(ugm3)) return;
-    pm4_ = ugm3;
-    pm4_seen_ = true;
+    PmStore::input(1, ugm3);
   }
   void input_pm10(uint32_t now_ms, float ugm3) {
     ensure_started(now_ms);
-    if (invalid(ugm3)) return;
-    pm10_ = ugm3;
-    pm10_seen_ = true;
+    PmStore::input(2, ugm3);
+  }
+
+  // Commit one coherent frame at a single timestamp, then run ONE
+  // evaluation. The PM1/PM4/PM10 fractions are only accepted alongside a
+  // valid PM2.5 from the same frame, so the diagnostic fractions can never
+  // describe a different measurement from the classified one.
+  void input_frame(uint32_t now_ms, const AirIQFrame &frame) {
+    ensure_started(now_ms);
+    for (int s = 0; s < CHANNELS; s++) {
+      const FrameField field = static_cast<FrameField>(POLLUTANT_AT[s]);
+      if (frame.has(field))
+        input_slot(s, now_ms, frame.value[field]);
+    }
+    if (frame.valid(FRAME_PM2_5)) {
+      if (frame.has(FRAME_PM1)) input_pm1(now_ms, frame.value[FRAME_PM1]);
+      if (frame.has(FRAME_PM4)) input_pm4(now_ms, frame.value[FRAME_PM4]);
+      if (frame.has(FRAME_PM10)) input_pm10(now_ms, frame.value[FRAME_PM10]);
+    }
+    evaluate(now_ms);
   }
 
   // Pressure: an UNWIRED contract channel — NEVER a pollutant, never in
@@ -383,10 +1253,7 @@ class AirIQEngine {
   // S360-210-R4; the drifted BMP390 was removed — see the header notes).
   void input_pressure(uint32_t now_ms, float hpa) {
     ensure_started(now_ms);
-    if (std::isnan(hpa) || hpa <= 0.0f) return;
-    pressure_ = hpa;
-    pressure_seen_ = true;
-    pressure_last_ms_ = now_ms;
+    PressureStore::input(now_ms, hpa);
   }
 
   // MiCS-4514 diagnostic-only channels (units unverified — raw/derived
@@ -395,39 +1262,100 @@ class AirIQEngine {
   // evidence (see the architecture doc).
   void input_mics_reducing(uint32_t now_ms, float value) {
     ensure_started(now_ms);
-    if (std::isnan(value)) return;
-    mics_red_ = value;
-    mics_red_seen_ = true;
-    mics_red_last_ms_ = now_ms;
+    MicsStore::input(0, now_ms, value);
   }
   void input_mics_oxidising(uint32_t now_ms, float value) {
     ensure_started(now_ms);
-    if (std::isnan(value)) return;
-    mics_ox_ = value;
-    mics_ox_seen_ = true;
-    mics_ox_last_ms_ = now_ms;
+    MicsStore::input(1, now_ms, value);
   }
 
   // --- evaluation
   // -------------------------------------------------------------
+  // Incremental: a channel is reclassified only when it is dirty (a valid
+  // input or a threshold / hysteresis change since the last evaluation) or
+  // its freshness state moved with time; the headline, recommendation and
+  // health are rebuilt only when a channel state, a severity or the
+  // composition / fault inputs changed. Reclassifying a clean channel is
+  // idempotent, so the outputs are identical to a full recompute
+  // (pinned by tests/unit/test_airiq_engine.cpp).
   void evaluate(uint32_t now_ms) {
     ensure_started(now_ms);
 
-    for (int i = 0; i < POLLUTANT_COUNT; i++) {
-      channel_state_[i] = channel_state(now_ms, seen_[i], last_ms_[i],
-                                        warmup_ms_[i], stale_ms_[i]);
-      update_severity(static_cast<Pollutant>(i));
+    for (int s = 0; s < CHANNELS; s++) {
+      const int state =
+          detail::channel_state(start_ms_, now_ms, seen_[s], last_ms_[s],
+                                warmup_ms_[s], stale_ms_[s]);
+      const DirtyMask bit = static_cast<DirtyMask>(1u << s);
+      if (state != channel_state_[s]) {
+        channel_state_[s] = state;
+        dirty_ |= bit;
+        headline_dirty_ = true;
+      }
+      if (!(dirty_ & bit)) continue;
+      const Severity before = severity_[s];
+      update_severity(s);
+      if (severity_[s] != before) {
+        headline_dirty_ = true;
+        JournalStore::record(now_ms, POLLUTANT_AT[s], before, severity_[s],
+                             value_[s]);
+      }
+      // A new sample moves the trend the early recommendation reads.
+      if (early_ventilate_min_ > 0.0f && TREND_SLOT[POLLUTANT_AT[s]] >= 0)
+        headline_dirty_ = true;
     }
-    pressure_state_ = channel_state(now_ms, pressure_seen_, pressure_last_ms_,
-                                    pressure_warmup_ms_, pressure_stale_ms_);
-    mics_red_fresh_ =
-        mics_red_seen_ && elapsed(mics_red_last_ms_, now_ms) <= mics_stale_ms_;
-    mics_ox_fresh_ =
-        mics_ox_seen_ && elapsed(mics_ox_last_ms_, now_ms) <= mics_stale_ms_;
+    dirty_ = 0;
+    PressureStore::update(start_ms_, now_ms);
+    MicsStore::update(now_ms);
 
+    if (!headline_dirty_) return;
+    headline_dirty_ = false;
+    const AirQuality air_quality_before = air_quality_;
+    const Recommendation recommendation_before = recommendation_;
     update_air_quality();
     update_recommendation();
     update_health();
+    if (air_quality_ != air_quality_before)
+      JournalStore::record(now_ms, JOURNAL_AIR_QUALITY, air_quality_before,
+                           air_quality_, driver_value(worst_pollutant_));
+    if (recommendation_ != recommendation_before)
+      JournalStore::record(
+          now_ms, JOURNAL_RECOMMENDATION, recommendation_before,
+          recommendation_,
+          driver_value(rising_pollutant_ < POLLUTANT_COUNT ? rising_pollutant_
+                                                          : worst_pollutant_));
+  }
+
+  // Forces the next evaluate() to reclassify every channel and rebuild the
+  // headline — the full-recompute reference the incremental path is tested
+  // against, and the hook for an explicit reconfiguration.
+  void invalidate() {
+    dirty_ = ALL_DIRTY;
+    headline_dirty_ = true;
+  }
+
+  // --- scheduling -------------------------------------------------------------
+  // Returned by next_deadline_ms() when no output can change on its own.
+  static const uint32_t NO_DEADLINE = detail::NO_DEADLINE;
+
+  // Milliseconds from now_ms until the next instant an output can change
+  // WITHOUT a new input: a warm-up window expiring on a never-seen channel,
+  // a fresh pollutant going stale, or the pressure / MiCS windows lapsing.
+  // Every channel in the set is considered, expected or not (unexpected
+  // channels still report severity for diagnostics). Never 0: evaluating at
+  // now_ms + the returned delay is the first evaluation that observes the
+  // transition. NO_DEADLINE when nothing is pending (everything already
+  // missing) — the glue then sleeps until the next real input.
+  uint32_t next_deadline_ms(uint32_t now_ms) const {
+    if (!started_) return NO_DEADLINE;
+    uint32_t next = NO_DEADLINE;
+    for (int s = 0; s < CHANNELS; s++) {
+      next = detail::earliest(
+          next, detail::channel_deadline(start_ms_, now_ms, seen_[s],
+                                         last_ms_[s], warmup_ms_[s],
+                                         stale_ms_[s]));
+    }
+    next = detail::earliest(next, PressureStore::deadline(start_ms_, now_ms));
+    return detail::earliest(next, MicsStore::deadline(now_ms));
   }
 
   // --- value outputs (NAN unless the channel is fresh)
@@ -439,50 +1367,129 @@ class AirIQEngine {
   float hcho() const { return pollutant_value(POLLUTANT_HCHO); }
   float o3() const { return pollutant_value(POLLUTANT_O3); }
 
-  float pm1() const {
-    return (pm1_seen_ && channel_state_[POLLUTANT_PM25] == CHANNEL_FRESH) ? pm1_
-                                                                          : NAN;
-  }
-  float pm4() const {
-    return (pm4_seen_ && channel_state_[POLLUTANT_PM25] == CHANNEL_FRESH) ? pm4_
-                                                                          : NAN;
-  }
+  float pm1() const { return PmStore::value(0, pollutant_fresh(POLLUTANT_PM25)); }
+  float pm4() const { return PmStore::value(1, pollutant_fresh(POLLUTANT_PM25)); }
   float pm10() const {
-    return (pm10_seen_ && channel_state_[POLLUTANT_PM25] == CHANNEL_FRESH)
-               ? pm10_
-               : NAN;
+    return PmStore::value(2, pollutant_fresh(POLLUTANT_PM25));
   }
-
-  float pressure() const {
-    return pressure_state_ == CHANNEL_FRESH ? pressure_ : NAN;
+  // The fresh engine value behind one frame field (same rules as above).
+  float frame_value(FrameField field) const {
+    switch (field) {
+      case FRAME_PM1:
+        return pm1();
+      case FRAME_PM4:
+        return pm4();
+      case FRAME_PM10:
+        return pm10();
+      case FRAME_FIELD_COUNT:
+        return NAN;
+      default:
+        return pollutant_value(static_cast<Pollutant>(field));
+    }
   }
 
+  float pressure() const { return PressureStore::value(); }
+
   // MiCS diagnostics (freshness-gated on their own stale window, computed
   // by evaluate(); a stale raw channel is never left standing either).
-  float mics_reducing() const { return mics_red_fresh_ ? mics_red_ : NAN; }
-  float mics_oxidising() const { return mics_ox_fresh_ ? mics_ox_ : NAN; }
+  float mics_reducing() const { return MicsStore::value(0); }
+  float mics_oxidising() const { return MicsStore::value(1); }
 
   bool pollutant_fresh(Pollutant pollutant) const {
-    return pollutant < POLLUTANT_COUNT &&
-           channel_state_[pollutant] == CHANNEL_FRESH;
+    const int s = slot(pollutant);
+    return s >= 0 && channel_state_[s] == detail::CHANNEL_FRESH;
+  }
+  bool pressure_fresh() const { return PressureStore::fresh(); }
+
+  // Rolling statistics for one pollutant window as of now_ms (see
+  // WindowStatistics). Unlike the value outputs they are NOT gated on
+  // freshness — a window summarises the valid samples it holds, and reads
+  // NAN (0 samples) once it holds none or when the pollutant has no
+  // compiled statistics.
+  WindowStatistics statistics(Pollutant pollutant, StatisticsWindow window,
+                              uint32_t now_ms) const {
+    const int s = pollutant < POLLUTANT_COUNT ? STATISTICS_SLOT[pollutant] : -1;
+    return StatisticsStore::window(s, window, now_ms);
+  }
+
+  // Trend of a ventilation-responsive pollutant in units per minute (NAN
+  // for other pollutants, when stale, or until the window holds enough
+  // spread). A stale gap restarts the estimator.
+  float trend_per_min(Pollutant pollutant) const {
+    const int t = trend_slot(pollutant);
+    if (t < 0 || !pollutant_fresh(pollutant)) return NAN;
+    return trends_[t].slope();
+  }
+  // Minutes until the trend reaches the pollutant's Poor threshold: 0 when
+  // already there, NAN when no crossing is predicted (flat or falling
+  // trend, stale channel, or not a ventilation-responsive pollutant).
+  float minutes_until_poor(Pollutant pollutant) const {
+    const int s = slot(pollutant);
+    const float slope = trend_per_min(pollutant);
+    if (std::isnan(slope)) return NAN;
+    const float level = trends_[trend_slot(pollutant)].level();
+    const float poor = ladder_[s].boundary(1);
+    if (level >= poor || value_[s] >= poor) return 0.0f;
+    if (!(slope > 0.0f)) return NAN;
+    return (poor - level) / slope;
+  }
+  // How far the fresh value has progressed from the pollutant's Fair
+  // boundary to its Very-poor boundary: 0 at or below Fair, 1 at or above
+  // Very poor, linear between (NAN when not fresh). A continuous reading
+  // of the same bands the severity classifies — consumers that scale an
+  // effort with pollution use it instead of re-declaring thresholds.
+  float severity_progress(Pollutant pollutant) const {
+    const float value = pollutant_value(pollutant);
+    if (std::isnan(value)) return NAN;
+    const HysteresisLadder<3> &ladder = ladder_[slot(pollutant)];
+    const float span = ladder.boundary(2) - ladder.boundary(0);
+    if (!(span > 0.0f)) return value >= ladder.boundary(2) ? 1.0f : 0.0f;
+    const float progress = (value - ladder.boundary(0)) / span;
+    return progress < 0.0f ? 0.0f : (progress > 1.0f ? 1.0f : progress);
+  }
+  // The pollutant whose predicted crossing drives an early "Ventilate
+  // soon" (POLLUTANT_COUNT when the recommendation is not predictive).
+  Pollutant rising_pollutant() const { return rising_pollutant_; }
+
+  // Exposure since the last reset_exposure(), and over the 8 hours up to
+  // now_ms (see ExposureSummary). NAN
+  // when the pollutant has no compiled exposure.
+  ExposureSummary exposure(Pollutant pollutant, uint32_t now_ms) const {
+    const int s = pollutant < POLLUTANT_COUNT ? EXPOSURE_SLOT[pollutant] : -1;
+    return ExposureStore::summary(s, now_ms);
   }
-  bool pressure_fresh() const { return pressure_state_ == CHANNEL_FRESH; }
+  // Starts a new exposure day (the rolling 8 hours are kept). The last
+  // sample is kept, so the segment from it to the next sample counts
+  // towards the new day.
+  void reset_exposure() { ExposureStore::reset(); }
+
+  // --- transition journal -------------------------------------------------------
+  static constexpr bool has_journal() { return Journal > 0; }
+  // Moves up to `max` journal entries, oldest first, into `out`; returns
+  // how many were moved.
+  int drain_journal(Transition *out, int max) {
+    return JournalStore::drain(out, max);
+  }
+  int journal_pending() const { return JournalStore::pending(); }
+  // Entries overwritten before they were drained (reset once the journal
+  // is drained empty).
+  uint16_t journal_dropped() const { return JournalStore::dropped(); }
 
   // Seconds since the last valid update (diagnostics; NAN if never seen).
   float pollutant_data_age_s(Pollutant pollutant, uint32_t now_ms) const {
-    if (pollutant >= POLLUTANT_COUNT || !seen_[pollutant]) return NAN;
-    return elapsed(last_ms_[pollutant], now_ms) / 1000.0f;
+    const int s = slot(pollutant);
+    if (s < 0 || !seen_[s]) return NAN;
+    return detail::elapsed(last_ms_[s], now_ms) / 1000.0f;
   }
   float pressure_data_age_s(uint32_t now_ms) const {
-    if (!pressure_seen_) return NAN;
-    return elapsed(pressure_last_ms_, now_ms) / 1000.0f;
+    return PressureStore::data_age_s(now_ms);
   }
 
   // --- state outputs
   // --------------------------------------------------------------
   Severity severity(Pollutant pollutant) const {
-    return pollutant < POLLUTANT_COUNT ? severity_[pollutant]
-                                       : SEVERITY_UNAVAILABLE;
+    const int s = slot(pollutant);
+    return s >= 0 ? severity_[s] : SEVERITY_UNAVAILABLE;
   }
   AirQuality air_quality() const { return air_quality_; }
   Recommendation recommendation() const { return recommendation_; }
@@ -495,17 +1502,53 @@ class AirIQEngine {
   Pollutant worst_pollutant() const { return worst_pollutant_; }
 
  private:
-  enum ChannelState {
-    CHANNEL_INIT = 0,
-    CHANNEL_FRESH = 1,
-    CHANNEL_MISSING = 2,
-  };
+  // One dirty bit per storage slot (everything starts dirty so the first
+  // evaluation is a full pass).
+  typedef uint8_t DirtyMask;
+  static const DirtyMask ALL_DIRTY =
+      static_cast<DirtyMask>((1u << CHANNELS) - 1u);
 
-  static uint32_t elapsed(uint32_t since_ms, uint32_t now_ms) {
-    return now_ms - since_ms;  // unsigned arithmetic handles wrap-around
+  // Pollutant -> storage slot (-1 when absent) and slot -> pollutant.
+  static constexpr int8_t SLOT[POLLUTANT_COUNT] = {
+      detail::slot_of(Channels, 0), detail::slot_of(Channels, 1),
+      detail::slot_of(Channels, 2), detail::slot_of(Channels, 3),
+      detail::slot_of(Channels, 4), detail::slot_of(Channels, 5)};
+  static constexpr int8_t POLLUTANT_AT[POLLUTANT_COUNT] = {
+      detail::pollutant_at(Channels, 0), detail::pollutant_at(Channels, 1),
+      detail::pollutant_at(Channels, 2), detail::pollutant_at(Channels, 3),
+      detail::pollutant_at(Channels, 4), detail::pollutant_at(Channels, 5)};
+  // Pollutant -> statistics slot (-1 when not kept).
+  static constexpr int8_t STATISTICS_SLOT[POLLUTANT_COUNT] = {
+      detail::slot_of(Channels & Statistics, 0),
+      detail::slot_of(Channels & Statistics, 1),
+      detail::slot_of(Channels & Statistics, 2),
+      detail::slot_of(Channels & Statistics, 3),
+      detail::slot_of(Channels & Statistics, 4),
+      detail::slot_of(Channels & Statistics, 5)};
+  // Pollutant -> trend slot (-1 when not ventilation-responsive).
+  static constexpr int8_t TREND_SLOT[POLLUTANT_COUNT] = {
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 0),
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 1),
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 2),
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 3),
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 4),
+      detail::slot_of(Channels & VENTILATION_CHANNELS, 5)};
+  static int trend_slot(Pollutant pollutant) {
+    return pollutant < POLLUTANT_COUNT ? TREND_SLOT[pollutant] : -1;
   }
 
-  static bool invalid(float value) { return std::isnan(value) || value < 0.0f; }
+  // Pollutant -> exposure slot (-1 when not kept).
+  static constexpr int8_t EXPOSURE_SLOT[POLLUTANT_COUNT] = {
+      detail::slot_of(Channels & Exposure, 0),
+      detail::slot_of(Channels & Exposure, 1),
+      detail::slot_of(Channels & Exposure, 2),
+      detail::slot_of(Channels & Exposure, 3),
+      detail::slot_of(Channels & Exposure, 4),
+      detail::slot_of(Channels & Exposure, 5)};
+
+  static int slot(Pollutant pollutant) {
+    return pollutant < POLLUTANT_COUNT ? SLOT[pollutant] : -1;
+  }
 
   void ensure_started(uint32_t now_ms) {
     if (!started_) begin(now_ms);
@@ -513,85 +1556,77 @@ class AirIQEngine {
 
   void input_pollutant(Pollutant pollutant, uint32_t now_ms, float value) {
     ensure_started(now_ms);
-    if (pollutant >= POLLUTANT_COUNT || invalid(value)) return;
-    value_[pollutant] = value;
-    seen_[pollutant] = true;
-    last_ms_[pollutant] = now_ms;
+    const int s = slot(pollutant);
+    if (s >= 0) input_slot(s, now_ms, value);
   }
 
-  float pollutant_value(Pollutant pollutant) const {
-    if (pollutant >= POLLUTANT_COUNT) return NAN;
-    if (channel_state_[pollutant] != CHANNEL_FRESH) return NAN;
-    return value_[pollutant];
-  }
-
-  ChannelState channel_state(uint32_t now_ms, bool seen, uint32_t last_ms,
-                             uint32_t warmup_ms, uint32_t stale_ms) const {
-    if (!seen) {
-      return elapsed(start_ms_, now_ms) < warmup_ms ? CHANNEL_INIT
-                                                    : CHANNEL_MISSING;
+  void input_slot(int s, uint32_t now_ms, float value) {
+    if (detail::invalid(value)) return;
+    // Exposure and trend only span a gap whose start is still fresh.
+    const uint32_t gap = detail::elapsed(last_ms_[s], now_ms);
+    const bool continuous = seen_[s] && gap <= stale_ms_[s];
+    if (continuous)
+      ExposureStore::add(EXPOSURE_SLOT[POLLUTANT_AT[s]], now_ms, value_[s], value,
+                         gap, ladder_[s].boundary(1));
+    const int t = TREND_SLOT[POLLUTANT_AT[s]];
+    if (t >= 0) {
+      if (!continuous) trends_[t].reset();
+      trends_[t].add(gap / 60000.0f, value);
     }
-    return elapsed(last_ms, now_ms) <= stale_ms ? CHANNEL_FRESH
-                                                : CHANNEL_MISSING;
+    value_[s] = value;
+    seen_[s] = true;
+    last_ms_[s] = now_ms;
+    dirty_ |= 1u << s;
+    StatisticsStore::add(STATISTICS_SLOT[POLLUTANT_AT[s]], now_ms, value);
   }
 
-  // Band 0=Good, 1=Fair, 2=Poor, 3=Very poor. Worsening is immediate (a
-  // severe pollutant must show at once); improving requires clearing the
-  // band's lower boundary by the hysteresis margin.
-  int raw_band(Pollutant p, float v) const {
-    if (v < fair_[p]) return 0;
-    if (v < poor_[p]) return 1;
-    if (v < very_poor_[p]) return 2;
-    return 3;
+  float pollutant_value(Pollutant pollutant) const {
+    const int s = slot(pollutant);
+    if (s < 0 || channel_state_[s] != detail::CHANNEL_FRESH) return NAN;
+    return value_[s];
   }
 
-  float band_lower(Pollutant p, int band) const {
-    switch (band) {
-      case 1:
-        return fair_[p];
-      case 2:
-        return poor_[p];
-      case 3:
-        return very_poor_[p];
+  void write_config(const AirIQConfig &config) {
+    // The setters ignore channels outside the set.
+    for (int i = 0; i < POLLUTANT_COUNT; i++) {
+      const Pollutant p = static_cast<Pollutant>(i);
+      const ChannelConfig &c = config.channels[i];
+      set_expected(p, c.expected);
+      set_warmup_ms(p, c.warmup_ms);
+      set_stale_ms(p, c.stale_ms);
+      set_thresholds(p, c.fair, c.poor, c.very_poor);
+      set_hysteresis(p, c.hysteresis);
     }
-    return fair_[p];
+    set_early_ventilate_min(config.early_ventilate_min);
+    config_version_ = config.version;
   }
 
-  void update_severity(Pollutant p) {
-    if (channel_state_[p] == CHANNEL_INIT) {
-      severity_[p] = SEVERITY_INITIALISING;
-      band_valid_[p] = false;
+  void update_severity(int s) {
+    if (channel_state_[s] == detail::CHANNEL_INIT) {
+      severity_[s] = SEVERITY_INITIALISING;
+      ladder_[s].reset();
       return;
     }
-    if (channel_state_[p] == CHANNEL_MISSING) {
-      severity_[p] = SEVERITY_UNAVAILABLE;
-      band_valid_[p] = false;
+    if (channel_state_[s] == detail::CHANNEL_MISSING) {
+      severity_[s] = SEVERITY_UNAVAILABLE;
+      ladder_[s].reset();
       return;
     }
-    const float v = value_[p];
-    const int raw = raw_band(p, v);
-    if (!band_valid_[p]) {
-      band_[p] = raw;
-      band_valid_[p] = true;
-    } else if (raw > band_[p]) {
-      band_[p] = raw;  // worsening classifies immediately
-    } else {
-      while (raw < band_[p] && v < band_lower(p, band_[p]) - hysteresis_[p]) {
-        band_[p]--;
-      }
-    }
-    switch (band_[p]) {
+    // Band 0=Good, 1=Fair, 2=Poor, 3=Very poor. Worsening is immediate (a
+    // severe pollutant must show at once); improving requires clearing the
+    // band's lower boundary by the hysteresis margin.
+    switch (ladder_[s].update(value_[s])) {
       case 0:
-        severity_[p] = SEVERITY_GOOD;
+        severity_[s] = SEVERITY_GOOD;
         return;
       case 1:
-        severity_[p] = SEVERITY_FAIR;
+        severity_[s] = SEVERITY_FAIR;
         return;
       case 2:
-        severity_[p] = SEVERITY_POOR;
+        severity_[s] = SEVERITY_POOR;
         return;
     }
-    severity_[p] = SEVERITY_VERY_POOR;
+    severity_[s] = SEVERITY_VERY_POOR;
   }
 
   void update_air_quality() {
@@ -600,17 +1635,17 @@ class AirIQEngine {
     int fresh = 0, init = 0, expected_count = 0;
     Severity worst = SEVERITY_GOOD;
     Pollutant worst_p = POLLUTANT_COUNT;
-    for (int i = 0; i < POLLUTANT_COUNT; i++) {
-      if (!expected_[i]) continue;
+    for (int s = 0; s < CHANNELS; s++) {
+      if (!expected_[s]) continue;
       expected_count++;
-      if (channel_state_[i] == CHANNEL_INIT) init++;
-      if (channel_state_[i] != CHANNEL_FRESH) continue;
+      if (channel_state_[s] == detail::CHANNEL_INIT) init++;
+      if (channel_state_[s] != detail::CHANNEL_FRESH) continue;
       fresh++;
-      // Fixed priority order = enum order: the FIRST pollutant at the
-      // worst severity is the deterministic driver.
-      if (severity_[i] > worst) {
-        worst = severity_[i];
-        worst_p = static_cast<Pollutant>(i);
+      // Fixed priority order = enum order (slots keep it): the FIRST
+      // pollutant at the worst severity is the deterministic driver.
+      if (severity_[s] > worst) {
+        worst = severity_[s];
+        worst_p = static_cast<Pollutant>(POLLUTANT_AT[s]);
       }
     }
     if (expected_count == 0) {
@@ -649,6 +1684,7 @@ class AirIQEngine {
   }
 
   void update_recommendation() {
+    rising_pollutant_ = POLLUTANT_COUNT;
     switch (air_quality_) {
       case AIR_QUALITY_INITIALISING:
         recommendation_ = RECOMMENDATION_INITIALISING;
@@ -658,7 +1694,13 @@ class AirIQEngine {
         return;
       case AIR_QUALITY_GOOD:
       case AIR_QUALITY_FAIR:
-        recommendation_ = RECOMMENDATION_NO_ACTION;
+        // Predictive mode (opt-in): a ventilation-responsive pollutant
+        // trending into Poor within the horizon recommends ventilating
+        // now, while it is still cheap to stay ahead of the rise.
+        rising_pollutant_ = predicted_poor();
+        recommendation_ = rising_pollutant_ < POLLUTANT_COUNT
+                              ? RECOMMENDATION_VENTILATE_SOON
+                              : RECOMMENDATION_NO_ACTION;
         return;
       default:
         break;
@@ -672,10 +1714,12 @@ class AirIQEngine {
     const Severity worst =
         air_quality_ == AIR_QUALITY_POOR ? SEVERITY_POOR : SEVERITY_VERY_POOR;
     bool ventilation_driver = false;
-    for (int i = 0; i < POLLUTANT_COUNT; i++) {
-      if (!expected_[i] || channel_state_[i] != CHANNEL_FRESH) continue;
-      if (severity_[i] != worst) continue;
-      if (i == POLLUTANT_CO2 || i == POLLUTANT_VOC || i == POLLUTANT_NOX) {
+    for (int s = 0; s < CHANNELS; s++) {
+      if (!expected_[s] || channel_state_[s] != detail::CHANNEL_FRESH)
+        continue;
+      if (severity_[s] != worst) continue;
+      const int p = POLLUTANT_AT[s];
+      if (p == POLLUTANT_CO2 || p == POLLUTANT_VOC || p == POLLUTANT_NOX) {
         ventilation_driver = true;
         break;
       }
@@ -689,6 +1733,23 @@ class AirIQEngine {
     }
   }
 
+  float driver_value(Pollutant pollutant) const {
+    const int s = slot(pollutant);
+    return s >= 0 ? value_[s] : NAN;
+  }
+
+  // The first expected, fresh ventilation-responsive pollutant predicted to
+  // reach Poor within the early-ventilate horizon (POLLUTANT_COUNT if none).
+  Pollutant predicted_poor() const {
+    if (!(early_ventilate_min_ > 0.0f)) return POLLUTANT_COUNT;
+    for (int s = 0; s < CHANNELS; s++) {
+      const Pollutant p = static_cast<Pollutant>(POLLUTANT_AT[s]);
+      if (TREND_SLOT[p] < 0 || !expected_[s]) continue;
+      if (minutes_until_poor(p) <= early_ventilate_min_) return p;
+    }
+    return POLLUTANT_COUNT;
+  }
+
   void update_health() {
     if (fault_) {
       health_ = HEALTH_FAULT;
@@ -699,13 +1760,13 @@ class AirIQEngine {
     // never-fitted part must not degrade every device); the MiCS
     // diagnostic channels are excluded until promotion.
     int fresh = 0, init = 0, missing = 0;
-    for (int i = 0; i < POLLUTANT_COUNT; i++) {
-      if (!expected_[i]) continue;
-      switch (channel_state_[i]) {
-        case CHANNEL_FRESH:
+    for (int s = 0; s < CHANNELS; s++) {
+      if (!expected_[s]) continue;
+      switch (channel_state_[s]) {
+        case detail::CHANNEL_FRESH:
           fresh++;
           break;
-        case CHANNEL_INIT:
+        case detail::CHANNEL_INIT:
           init++;
           break;
         default:
@@ -730,81 +1791,231 @@ class AirIQEngine {
   }
 
   // composition
-  bool expected_[POLLUTANT_COUNT] = {};
+  uint32_t config_version_ = 0;
+  bool expected_[CHANNELS] = {};
 
-  // provisional thresholds + hysteresis
-  float fair_[POLLUTANT_COUNT] = {};
-  float poor_[POLLUTANT_COUNT] = {};
-  float very_poor_[POLLUTANT_COUNT] = {};
-  float hysteresis_[POLLUTANT_COUNT] = {};
+  // provisional thresholds (Fair / Poor / Very poor boundaries) with their
+  // improvement hysteresis and band memory
+  HysteresisLadder<3> ladder_[CHANNELS];
 
   // per-sensor freshness windows (independent, provisional)
-  uint32_t warmup_ms_[POLLUTANT_COUNT] = {};
-  uint32_t stale_ms_[POLLUTANT_COUNT] = {};
-  uint32_t pressure_warmup_ms_ = 90000;
-  uint32_t pressure_stale_ms_ = 180000;
-  uint32_t mics_stale_ms_ = 90000;
+  uint32_t warmup_ms_[CHANNELS] = {};
+  uint32_t stale_ms_[CHANNELS] = {};
 
   // lifecycle
   bool started_ = false;
   uint32_t start_ms_ = 0;
 
+  // predictive recommendation (0 = off)
+  float early_ventilate_min_ = 0.0f;
+
   // pollutant channel data
-  float value_[POLLUTANT_COUNT] = {};
-  bool seen_[POLLUTANT_COUNT] = {};
-  uint32_t last_ms_[POLLUTANT_COUNT] = {};
-  int channel_state_[POLLUTANT_COUNT] = {};
-
-  // hysteresis band memory
-  int band_[POLLUTANT_COUNT] = {};
-  bool band_valid_[POLLUTANT_COUNT] = {};
-
-  // extra PM fractions (shared SPS30 freshness)
-  float pm1_ = NAN;
-  bool pm1_seen_ = false;
-  float pm4_ = NAN;
-  bool pm4_seen_ = false;
-  float pm10_ = NAN;
-  bool pm10_seen_ = false;
-
-  // pressure (never a pollutant)
-  float pressure_ = NAN;
-  bool pressure_seen_ = false;
-  uint32_t pressure_last_ms_ = 0;
-  int pressure_state_ = CHANNEL_INIT;
-
-  // MiCS diagnostic channels (never a pollutant; promotion gated on
-  // calibration evidence)
-  float mics_red_ = NAN;
-  bool mics_red_seen_ = false;
-  uint32_t mics_red_last_ms_ = 0;
-  float mics_ox_ = NAN;
-  bool mics_ox_seen_ = false;
-  uint32_t mics_ox_last_ms_ = 0;
-  bool mics_red_fresh_ = false;
-  bool mics_ox_fresh_ = false;
+  float value_[CHANNELS] = {};
+  bool seen_[CHANNELS] = {};
+  uint32_t last_ms_[CHANNELS] = {};
+  int channel_state_[CHANNELS] = {};
+
+  // trend estimators (ventilation-responsive channels only)
+  detail::TrendEstimator trends_[TRENDS > 0 ? TRENDS : 1];
+
+  // incremental evaluation: slots awaiting reclassification
+  DirtyMask dirty_ = ALL_DIRTY;
+  bool headline_dirty_ = true;
 
   // fault (reserved — no production producer)
   bool fault_ = false;
 
   // outputs
-  Severity severity_[POLLUTANT_COUNT] = {};
+  Severity severity_[CHANNELS] = {};
   AirQuality air_quality_ = AIR_QUALITY_INITIALISING;
   Recommendation recommendation_ = RECOMMENDATION_INITIALISING;
   Health health_ = HEALTH_INITIALISING;
   Pollutant worst_pollutant_ = POLLUTANT_COUNT;
+  Pollutant rising_pollutant_ = POLLUTANT_COUNT;
 };
 
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::CHANNELS;
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+const uint32_t BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::NO_DEADLINE;
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int8_t
+    BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::SLOT[POLLUTANT_COUNT];
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int8_t
+    BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::POLLUTANT_AT[POLLUTANT_COUNT];
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int8_t
+    BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::STATISTICS_SLOT[POLLUTANT_COUNT];
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int8_t
+    BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::EXPOSURE_SLOT[POLLUTANT_COUNT];
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int8_t
+    BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::TREND_SLOT[POLLUTANT_COUNT];
+template <uint8_t Channels, uint8_t Statistics, uint8_t Exposure,
+          uint8_t Journal>
+constexpr int BasicAirIQEngine<Channels, Statistics, Exposure, Journal>::TRENDS;
+
+// Every channel — the reference engine the simulation tests exercise.
+typedef BasicAirIQEngine<ALL_CHANNELS> AirIQEngine;
+
+// The firmware composition's channel set. The sense360_airiq codegen
+// passes it as a build flag (every translation unit sees the same value,
+// so global_engine() has one type per firmware); without it the firmware
+// engine is the all-channels engine.
+// SENSE360_AIRIQ_STATISTICS / SENSE360_AIRIQ_EXPOSURE are the pollutant
+// masks with a configured statistic / exposure output (none by default),
+// passed the same way; SENSE360_AIRIQ_JOURNAL is the transition journal
+// size (none unless configured or exported to a text sensor).
+#ifndef SENSE360_AIRIQ_CHANNELS
+#define SENSE360_AIRIQ_CHANNELS 0xFF
+#endif
+#ifndef SENSE360_AIRIQ_STATISTICS
+#define SENSE360_AIRIQ_STATISTICS 0x00
+#endif
+#ifndef SENSE360_AIRIQ_EXPOSURE
+#define SENSE360_AIRIQ_EXPOSURE 0x00
+#endif
+#ifndef SENSE360_AIRIQ_JOURNAL
+#define SENSE360_AIRIQ_JOURNAL 0
+#endif
+typedef BasicAirIQEngine<SENSE360_AIRIQ_CHANNELS, SENSE360_AIRIQ_STATISTICS,
+                         SENSE360_AIRIQ_EXPOSURE, SENSE360_AIRIQ_JOURNAL>
+    FirmwareAirIQEngine;
+
 // Accessor for the firmware's single engine instance. ESPHome emits
 // `esphome: includes:` headers AFTER the globals storage declarations in
 // the generated main.cpp, so a custom-class `globals:` entry cannot name
 // this type; production lambdas share this function-local static instead
 // (constructed on first use). Tests instantiate their own AirIQEngine
 // objects directly.
-inline AirIQEngine &global_engine() {
-  static AirIQEngine engine;
+inline FirmwareAirIQEngine &global_engine() {
+  static FirmwareAirIQEngine engine;
   return engine;
 }
 
+// --- text outputs ---------------------------------------------------------------
+// The enum tuple behind every AirIQ text entity. The glue remembers the
+// tuple it last published and formats / publishes only the parts that
+// changed, so an unchanged evaluation costs no formatting and no heap
+// traffic (the state strings above are static).
+enum TextPart {
+  TEXT_AIR_QUALITY = 1 << 0,
+  TEXT_RECOMMENDATION = 1 << 1,
+  TEXT_HEALTH = 1 << 2,
+  TEXT_STATE_DETAIL = 1 << 3,
+  TEXT_RECOMMENDATION_REASON = 1 << 4,
+  TEXT_ALL = (1 << 5) - 1,
+};
+
+struct TextSnapshot {
+  AirQuality air_quality;
+  Recommendation recommendation;
+  Health health;
+  Severity detail[5];  // CO2, VOC, NOx, formaldehyde, PM2.5 (detail order)
+  Pollutant worst;
+  Severity worst_severity;
+  Pollutant rising;
+
+  // Bit mask of TextPart values that render differently from `previous`.
+  int changes_from(const TextSnapshot &previous) const {
+    int changed = 0;
+    if (air_quality != previous.air_quality) changed |= TEXT_AIR_QUALITY;
+    if (recommendation != previous.recommendation)
+      changed |= TEXT_RECOMMENDATION | TEXT_RECOMMENDATION_REASON;
+    if (health != previous.health) changed |= TEXT_HEALTH;
+    for (int i = 0; i < 5; i++) {
+      if (detail[i] != previous.detail[i]) changed |= TEXT_STATE_DETAIL;
+    }
+    if (worst != previous.worst || worst_severity != previous.worst_severity ||
+        rising != previous.rising)
+      changed |= TEXT_RECOMMENDATION_REASON;
+    return changed;
+  }
+};
+
+template <class Engine>
+TextSnapshot capture_text(const Engine &engine) {
+  TextSnapshot snapshot;
+  snapshot.air_quality = engine.air_quality();
+  snapshot.recommendation = engine.recommendation();
+  snapshot.health = engine.health();
+  snapshot.detail[0] = engine.severity(POLLUTANT_CO2);
+  snapshot.detail[1] = engine.severity(POLLUTANT_VOC);
+  snapshot.detail[2] = engine.severity(POLLUTANT_NOX);
+  snapshot.detail[3] = engine.severity(POLLUTANT_HCHO);
+  snapshot.detail[4] = engine.severity(POLLUTANT_PM25);
+  snapshot.worst = engine.worst_pollutant();
+  snapshot.worst_severity = engine.severity(snapshot.worst);
+  snapshot.rising = engine.rising_pollutant();
+  return snapshot;
+}
+
+// Diagnostic text, formatted into a caller buffer (no allocation).
+inline void format_state_detail(char *buffer, size_t size,
+                                const TextSnapshot &snapshot) {
+  snprintf(buffer, size, "co2=%s voc=%s nox=%s hcho=%s pm2.5=%s",
+           severity_to_string(snapshot.detail[0]),
+           severity_to_string(snapshot.detail[1]),
+           severity_to_string(snapshot.detail[2]),
+           severity_to_string(snapshot.detail[3]),
+           severity_to_string(snapshot.detail[4]));
+}
+
+inline void format_recommendation_reason(char *buffer, size_t size,
+                                         const TextSnapshot &snapshot) {
+  if (snapshot.rising < POLLUTANT_COUNT) {
+    snprintf(buffer, size, "%s rising towards Poor -> %s",
+             pollutant_to_string(snapshot.rising),
+             recommendation_to_string(snapshot.recommendation));
+  } else if (snapshot.worst < POLLUTANT_COUNT) {
+    snprintf(buffer, size, "worst pollutant: %s (%s) -> %s",
+             pollutant_to_string(snapshot.worst),
+             severity_to_string(snapshot.worst_severity),
+             recommendation_to_string(snapshot.recommendation));
+  } else {
+    snprintf(buffer, size, "no pollutant above Good -> %s",
+             recommendation_to_string(snapshot.recommendation));
+  }
+}
+
+// One journal entry as "<uptime s> <subject>: <from> -> <to> (<value>)".
+inline void format_transition(char *buffer, size_t size,
+                              const Transition &entry) {
+  const char *subject;
+  const char *from;
+  const char *to;
+  if (entry.subject == JOURNAL_AIR_QUALITY) {
+    subject = "Air quality";
+    from = air_quality_to_string(static_cast<AirQuality>(entry.from()));
+    to = air_quality_to_string(static_cast<AirQuality>(entry.to()));
+  } else if (entry.subject == JOURNAL_RECOMMENDATION) {
+    subject = "Recommendation";
+    from = recommendation_to_string(static_cast<Recommendation>(entry.from()));
+    to = recommendation_to_string(static_cast<Recommendation>(entry.to()));
+  } else {
+    subject = pollutant_to_string(static_cast<Pollutant>(entry.subject));
+    from = severity_to_string(static_cast<Severity>(entry.from()));
+    to = severity_to_string(static_cast<Severity>(entry.to()));
+  }
+  const unsigned long seconds = entry.at_ms / 1000u;
+  const unsigned fraction = static_cast<unsigned>(entry.at_ms % 1000u);
+  if (entry.value == JOURNAL_NO_VALUE) {
+    snprintf(buffer, size, "%lu.%03us %s: %s -> %s", seconds, fraction,
+             subject, from, to);
+  } else {
+    snprintf(buffer, size, "%lu.%03us %s: %s -> %s (%d)", seconds,
+             fraction, subject, from, to, static_cast<int>(entry.value));
+  }
+}
+
 }  // namespace airiq
 }  // namespace sense360
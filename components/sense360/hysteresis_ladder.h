@@ -0,0 +1,157 @@
+#pragma once
+
+// ============================================================================
+// Shared band classifier with hysteresis (RoomIQ comfort / brightness bands,
+// AirIQ pollutant severity bands)
+// ============================================================================
+// One threshold ladder implementation for every engine that turns a reading
+// into an ordered band and must not flap at a boundary. It is compiled BOTH
+// into production firmware (through roomiq_engine.h and airiq_engine.h) and
+// into the deterministic native tests (tests/unit/test_hysteresis_ladder.cpp
+// proves it equal to the hand-written ladders it replaced), so every engine
+// classifies with the same code.
+//
+// HysteresisLadder<N> holds N boundaries and so N + 1 bands (0 .. N). The
+// raw band is the index of the first boundary the value is below, N if none
+// — for sorted boundaries, the count of boundaries at or below the value.
+// Leaving the band the ladder holds is governed by one policy per ladder:
+//
+//   rising  : to band b + 1 once value >= boundary[b] + rise_margin, one
+//             band per boundary cleared — or straight to the raw band when
+//             rises are immediate (a worsening severity must show at once)
+//   falling : to band b - 1 once value <  boundary[b - 1] * fall_scale
+//                                          - fall_margin
+//
+// (fall_scale 1 and fall_margin h is the symmetric additive hysteresis;
+// fall_scale 1 - pct/100 and fall_margin 0 the proportional one). A band is
+// only ever left towards the raw band. Classification is comparisons only:
+// the percentage is turned into a scale when it is configured, never per
+// reading.
+//
+// The engines' default ladders are constant-initialised (the constexpr named
+// constructors below); their runtime setters still move the boundaries.
+// ============================================================================
+
+namespace sense360 {
+
+template <int N> class HysteresisLadder {
+  static_assert(N >= 1, "a ladder needs at least one boundary");
+
+ public:
+  // All boundaries 0, symmetric hysteresis 0 — configured at runtime.
+  constexpr HysteresisLadder() : boundaries_{} {}
+
+  // Constant-initialised ladders, one per policy (see above).
+  template <typename... Boundaries>
+  static constexpr HysteresisLadder symmetric(float margin, Boundaries... boundaries) {
+    return HysteresisLadder(false, margin, 1.0f, margin, boundaries...);
+  }
+  template <typename... Boundaries>
+  static constexpr HysteresisLadder immediate_rise(float fall_margin,
+                                                   Boundaries... boundaries) {
+    return HysteresisLadder(true, 0.0f, 1.0f, fall_margin, boundaries...);
+  }
+  template <typename... Boundaries>
+  static constexpr HysteresisLadder immediate_rise_scaled(float fall_scale,
+                                                          Boundaries... boundaries) {
+    return HysteresisLadder(true, 0.0f, fall_scale, 0.0f, boundaries...);
+  }
+
+  // --- configuration ----------------------------------------------------------
+  void set_boundaries(const float (&boundaries)[N]) {
+    for (int i = 0; i < N; i++) boundaries_[i] = boundaries[i];
+  }
+  void set_boundary(int index, float value) { boundaries_[index] = value; }
+  constexpr float boundary(int index) const { return boundaries_[index]; }
+  // Lower boundary of `band` (band 0 reports boundary 0, as the ladders this
+  // replaced did).
+  float band_lower(int band) const { return boundaries_[band > 0 ? band - 1 : 0]; }
+
+  void set_symmetric(float margin) {
+    rise_immediate_ = false;
+    rise_margin_ = margin;
+    fall_scale_ = 1.0f;
+    fall_margin_ = margin;
+  }
+  void set_immediate_rise(float fall_margin) {
+    rise_immediate_ = true;
+    rise_margin_ = 0.0f;
+    fall_scale_ = 1.0f;
+    fall_margin_ = fall_margin;
+  }
+  void set_immediate_rise_scaled(float fall_scale) {
+    rise_immediate_ = true;
+    rise_margin_ = 0.0f;
+    fall_scale_ = fall_scale;
+    fall_margin_ = 0.0f;
+  }
+
+  float fall_margin() const { return fall_margin_; }
+
+  // --- classification -----------------------------------------------------------
+  // First boundary the value is below, N if none (NaN: N). Scanned top
+  // down with a select rather than an early exit, so a value wandering
+  // across boundaries costs no mispredicted branch.
+  int raw_band(float value) const {
+    int band = N;
+    for (int i = N - 1; i >= 0; i--) band = value < boundaries_[i] ? i : band;
+    return band;
+  }
+
+  // Advances the held band for one reading and returns it. The first reading
+  // after reset() takes its raw band.
+  int update(float value) {
+    const int raw = raw_band(value);
+    if (!valid_) {
+      band_ = raw;
+      valid_ = true;
+    } else if (raw > band_) {
+      if (rise_immediate_) {
+        band_ = raw;
+      } else {
+        while (raw > band_ && value >= boundaries_[band_] + rise_margin_) band_++;
+      }
+    } else {
+      while (raw < band_ &&
+             value < boundaries_[band_ - 1] * fall_scale_ - fall_margin_) {
+        band_--;
+      }
+    }
+    return band_;
+  }
+
+  // --- held state -----------------------------------------------------------------
+  int band() const { return band_; }
+  bool valid() const { return valid_; }
+  void reset() { valid_ = false; }
+  // Resumes a held band (warm-boot carry-over); out-of-range bands are
+  // refused.
+  bool restore(int band) {
+    if (band < 0 || band > N) return false;
+    band_ = band;
+    valid_ = true;
+    return true;
+  }
+
+ private:
+  float boundaries_[N];
+  float rise_margin_ = 0.0f;
+  float fall_scale_ = 1.0f;
+  float fall_margin_ = 0.0f;
+  bool rise_immediate_ = false;
+  int band_ = 0;
+  bool valid_ = false;
+
+  template <typename... Boundaries>
+  constexpr HysteresisLadder(bool rise_immediate, float rise_margin, float fall_scale,
+                             float fall_margin, Boundaries... boundaries)
+      : boundaries_{static_cast<float>(boundaries)...},
+        rise_margin_(rise_margin),
+        fall_scale_(fall_scale),
+        fall_margin_(fall_margin),
+        rise_immediate_(rise_immediate) {
+    static_assert(sizeof...(Boundaries) == N, "one value per boundary");
+  }
+};
+
+}  // namespace sense360
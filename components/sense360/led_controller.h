@@ -392,6 +392,13 @@ class LedController {
   // --- outputs
   // -------------------------------------------------------------------
   const LightState &output() const { return output_; }
+  // Normalised electrical load of the arbitrated output (0 = off, 1 = full
+  // white at full brightness) — the board heat input of the RoomIQ
+  // self-heating model.
+  float heat_load() const {
+    if (!output_.on) return 0.0f;
+    return output_.brightness * (output_.red + output_.green + output_.blue) / 3.0f;
+  }
   Layer active_layer() const { return layer_; }
   bool night_mode() const { return night_on_; }
   bool night_automation_owned() const { return night_auto_; }
@@ -63,6 +63,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 
 namespace sense360 {
 namespace roomiq {
@@ -104,31 +105,131 @@ struct ClimateProfile {
   ClimateEvidence evidence;
 };
 
-// The S360-200 (Sense360 RoomIQ) revision R4 profile, version 1.
-//
-//   factory temperature correction : -5.80 °C
-//   factory humidity residual      : +4.52 percentage points RH
-//   evidence                       : validated-provisional (one board)
-//
-// Observed on the tested board over the ~42 h comparison run: temperature mean
-// error ~ +0.025 °C, MAE ~ 0.112 °C, 95th-percentile absolute error ~ 0.294 °C;
-// humidity mean error ~ -0.014 %RH, MAE ~ 0.237 %RH, 95th-percentile absolute
-// error ~ 0.670 %RH. Those are the tested board's numbers, not a production
-// specification.
-//
-// Exposed as a function (not a variable) so the header stays header-only and
-// C++11-clean while keeping the requested identifier verbatim.
-inline const ClimateProfile &S360_200_R4_CLIMATE_PROFILE_V1() {
-  static const ClimateProfile profile = {
-      "S360_200_R4_CLIMATE_PROFILE_V1",
-      "S360-200",
-      "R4",
-      -5.80f,
-      4.52f,
-      CLIMATE_EVIDENCE_VALIDATED_PROVISIONAL,
+// ---------------------------------------------------------------------------
+// The board climate profile registry: a constexpr table, one entry per
+// profile, indexed by ClimateProfileId. Constant initialised (no function
+// static, no guard variable) and, being a static member of a class template,
+// defined once across every translation unit while staying header-only in
+// C++11. A new board revision or variant adds an id and an entry — with the
+// evidence that earned its constants.
+// ---------------------------------------------------------------------------
+enum ClimateProfileId {
+  // No correction at all (evidence none). For collecting the raw side of a
+  // comparison log on a board that has no profile yet
+  // (tests/tools/fit_climate_profile.cpp).
+  CLIMATE_PROFILE_NEUTRAL = 0,
+  // The S360-200 (Sense360 RoomIQ) revision R4 profile, version 1.
+  //
+  //   factory temperature correction : -5.80 °C
+  //   factory humidity residual      : +4.52 percentage points RH
+  //   evidence                       : validated-provisional (one board)
+  //
+  // Observed on the tested board over the ~42 h comparison run: temperature
+  // mean error ~ +0.025 °C, MAE ~ 0.112 °C, 95th-percentile absolute error
+  // ~ 0.294 °C; humidity mean error ~ -0.014 %RH, MAE ~ 0.237 %RH,
+  // 95th-percentile absolute error ~ 0.670 %RH. Those are the tested board's
+  // numbers, not a production specification.
+  CLIMATE_PROFILE_S360_200_R4_V1 = 1,
+  CLIMATE_PROFILE_COUNT = 2,
+};
+
+template <typename Unused = void> struct ClimateProfileTable {
+  static constexpr ClimateProfile ENTRIES[CLIMATE_PROFILE_COUNT] = {
+      {"NEUTRAL_CLIMATE_PROFILE", "any", "any", 0.0f, 0.0f,
+       CLIMATE_EVIDENCE_NONE},
+      {"S360_200_R4_CLIMATE_PROFILE_V1", "S360-200", "R4", -5.80f, 4.52f,
+       CLIMATE_EVIDENCE_VALIDATED_PROVISIONAL},
   };
-  return profile;
+};
+template <typename Unused>
+constexpr ClimateProfile ClimateProfileTable<Unused>::ENTRIES[CLIMATE_PROFILE_COUNT];
+
+constexpr const ClimateProfile &climate_profile_entry(ClimateProfileId id) {
+  return ClimateProfileTable<>::ENTRIES[id];
+}
+
+// Kept under its historical identifier: the same table entry.
+constexpr const ClimateProfile &S360_200_R4_CLIMATE_PROFILE_V1() {
+  return climate_profile_entry(CLIMATE_PROFILE_S360_200_R4_V1);
+}
+
+// The profile compiled into this build, chosen by the sense360_roomiq
+// codegen (`climate_profile`, emitted as -DSENSE360_CLIMATE_PROFILE=<id>) —
+// the board package names its board's profile. RoomIQ IS the S360-200
+// board, so the default is the S360-200 R4 profile.
+#ifndef SENSE360_CLIMATE_PROFILE
+#define SENSE360_CLIMATE_PROFILE CLIMATE_PROFILE_S360_200_R4_V1
+#endif
+static_assert(SENSE360_CLIMATE_PROFILE >= 0 &&
+                  SENSE360_CLIMATE_PROFILE < CLIMATE_PROFILE_COUNT,
+              "SENSE360_CLIMATE_PROFILE is not a registry entry");
+
+constexpr const ClimateProfile &compiled_climate_profile() {
+  return climate_profile_entry(SENSE360_CLIMATE_PROFILE);
+}
+
+// Runtime selection by profile id string — bench builds only
+// (-DSENSE360_CLIMATE_PROFILE_RUNTIME=1, the sense360_roomiq
+// `climate_profile_runtime` option). Production firmware carries no lookup.
+#ifndef SENSE360_CLIMATE_PROFILE_RUNTIME
+#define SENSE360_CLIMATE_PROFILE_RUNTIME 0
+#endif
+#if SENSE360_CLIMATE_PROFILE_RUNTIME
+// nullptr when `id` names no registry entry.
+inline const ClimateProfile *find_climate_profile(const char *id) {
+  if (id == nullptr) return nullptr;
+  for (int i = 0; i < CLIMATE_PROFILE_COUNT; i++) {
+    if (std::strcmp(ClimateProfileTable<>::ENTRIES[i].id, id) == 0)
+      return &ClimateProfileTable<>::ENTRIES[i];
+  }
+  return nullptr;
 }
+#endif
+
+// ---------------------------------------------------------------------------
+// Fast exponential for the Magnus formula (opt-in, see below). Range
+// reduction x = k ln2 + r with |r| <= ln2/2 (Cody-Waite split of ln2), a
+// degree-5 minimax polynomial for exp(r) (relative error 7.5e-8) and k added
+// straight into the float exponent: no libm call. Valid for |x| < 80, which
+// covers every physical Magnus argument.
+//
+// Worst case over -40...85 °C (tests/unit/test_roomiq_svp_kernel.cpp sweeps
+// it in 0.001 °C steps): saturation vapour pressure within 5e-7 relative of
+// the std::exp kernel, i.e. below 1e-4 %RH on a compensated humidity — two
+// orders of magnitude under the SHT45's 0.01 %RH resolution.
+// ---------------------------------------------------------------------------
+inline float fast_exp(float x) {
+  const int k = static_cast<int>(x * 1.44269504f + std::copysign(0.5f, x));
+  const float kf = static_cast<float>(k);
+  const float r = (x - kf * 0.693359375f) + kf * 2.12194440e-4f;
+  const float p =
+      1.00000007f +
+      r * (0.999999692f +
+           r * (0.499988949f +
+                r * (0.166675747f + r * (0.0419153820f + r * 0.00829765508f))));
+  uint32_t bits;
+  std::memcpy(&bits, &p, sizeof(bits));
+  bits += static_cast<uint32_t>(k) << 23;  // scale by 2^k
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+// The exponential behind the Magnus formula, selected at compile time:
+// std::exp by default, fast_exp() with -DSENSE360_CLIMATE_FAST_SVP=1 (the
+// sense360_roomiq `fast_vapour_pressure` option). SENSE360_CLIMATE_EXP may
+// also be overridden directly so a host benchmark can count evaluations
+// (tests/unit/test_roomiq_climate_memo.cpp).
+#ifndef SENSE360_CLIMATE_FAST_SVP
+#define SENSE360_CLIMATE_FAST_SVP 0
+#endif
+#ifndef SENSE360_CLIMATE_EXP
+#if SENSE360_CLIMATE_FAST_SVP
+#define SENSE360_CLIMATE_EXP ::sense360::roomiq::fast_exp
+#else
+#define SENSE360_CLIMATE_EXP std::exp
+#endif
+#endif
 
 // ---------------------------------------------------------------------------
 // Magnus saturation vapour pressure, hPa. NAN for physically impossible
@@ -139,7 +240,7 @@ inline float saturation_vapour_pressure_hpa(float temperature_c) {
   if (!std::isfinite(temperature_c)) return NAN;
   const float denominator = 243.12f + temperature_c;
   if (denominator <= 0.0f) return NAN;
-  return 6.112f * std::exp((17.62f * temperature_c) / denominator);
+  return 6.112f * SENSE360_CLIMATE_EXP((17.62f * temperature_c) / denominator);
 }
 
 // A non-finite customer calibration value (an invalid persisted state) is
@@ -241,6 +342,161 @@ inline ClimateResult compensate_climate(const ClimateProfile &profile,
   return result;
 }
 
+// ---------------------------------------------------------------------------
+// Batch compensation for host-side profile fitting (tests/tools/
+// fit_climate_profile.cpp): `count` logged raw pairs in structure-of-arrays
+// form in, the customer temperature / humidity out. The output spans may not
+// alias the inputs.
+//
+// The loop body is select-only so GCC auto-vectorises it (-O3, or -O2
+// -ftree-vectorize, plus -fno-trapping-math: that flag changes no result, it
+// only lets GCC evaluate both arms of a select). Two departures from
+// compensate_climate() follow, both inside the fast kernel's bound:
+//   * the two vapour pressures collapse into ONE exponential,
+//     svp(raw) / svp(final) = exp(m(raw) - m(final)), evaluated with
+//     fast_exp() whatever SENSE360_CLIMATE_EXP selects (std::exp is an
+//     opaque libm call and blocks vectorisation);
+//   * an invalid pair yields NAN in BOTH outputs via a select, as
+//     invalid_climate_result() does, instead of an early return. Invalid
+//     means a non-finite sample or a raw / final temperature at or below
+//     BATCH_MIN_TEMPERATURE_C — a domain bound (the scalar model stays valid
+//     down to its -243.12 °C pole) that keeps every fast_exp() argument in
+//     range; no sensor or reference log comes within 100 K of it.
+// Temperature is bit-identical to compensate_climate(); humidity agrees
+// within 1e-4 %RH (tests/unit/test_roomiq_climate_batch.cpp).
+// ---------------------------------------------------------------------------
+static const float BATCH_MIN_TEMPERATURE_C = -100.0f;
+
+inline void compensate_climate_batch(const ClimateProfile &profile,
+                                     const float *__restrict__ raw_temperature_c,
+                                     const float *__restrict__ raw_humidity_pct,
+                                     uint32_t count,
+                                     float customer_temperature_offset_c,
+                                     float customer_humidity_offset_pct,
+                                     float *__restrict__ temperature_c,
+                                     float *__restrict__ humidity_pct) {
+  const float temperature_offset =
+      sanitise_customer_offset(customer_temperature_offset_c);
+  const float residual = profile.humidity_residual_pct +
+                         sanitise_customer_offset(customer_humidity_offset_pct);
+  for (uint32_t i = 0; i < count; i++) {
+    const float raw_t = raw_temperature_c[i];
+    const float raw_rh = raw_humidity_pct[i];
+    const float final_t =
+        (raw_t + profile.temperature_correction_c) + temperature_offset;
+    // x - x is 0 for a finite sample and NAN for NaN / +/-inf.
+    const bool valid = (raw_t - raw_t) + (raw_rh - raw_rh) == 0.0f &&
+                       raw_t > BATCH_MIN_TEMPERATURE_C &&
+                       final_t > BATCH_MIN_TEMPERATURE_C;
+    // An invalid lane computes on 0 °C so fast_exp never sees an out-of-range
+    // argument, and is masked at the store.
+    const float t_raw = valid ? raw_t : 0.0f;
+    const float t_final = valid ? final_t : 0.0f;
+    const float humidity =
+        raw_rh * fast_exp((17.62f * t_raw) / (243.12f + t_raw) -
+                          (17.62f * t_final) / (243.12f + t_final)) +
+        residual;
+    const float clamped =
+        humidity < 0.0f ? 0.0f : (humidity > 100.0f ? 100.0f : humidity);
+    temperature_c[i] = valid ? final_t : NAN;
+    humidity_pct[i] = valid ? clamped : NAN;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Self-heating dynamics (optional)
+// ---------------------------------------------------------------------------
+// A profile's temperature correction is a STEADY-STATE number, measured with
+// the board at one typical load. The SHT45 really sits in the board's own
+// heat, which follows what the board is doing (the LED ring above all) with
+// a thermal lag of tens of minutes, so a load change leaves the compensated
+// temperature drifting while the board settles.
+//
+// SelfHeatingModel describes that as a first-order system: the sensor's
+// excess heating follows the normalised board heat input h (0 = idle,
+// 1 = the largest load the glue reports) through one time constant, and
+// each unit of settled heat above the profile's reference load needs
+// `correction_per_load_c` more correction. SelfHeatingFilter tracks it
+// incrementally — one exp() per update, exact for a load that is constant
+// between inputs:
+//
+//   h_eff += (h - h_eff) * (1 - exp(-dt / tau))
+//   correction = profile.temperature_correction_c +
+//                correction_per_load_c * (h_eff - reference_load)
+//
+// At h_eff == reference_load the static profile correction is returned
+// unchanged; with no model (time constant 0, the default) or no load input
+// yet, the filter contributes nothing — the static offset is the fallback.
+// The filter starts settled at the first load it sees (the same assumption
+// the static profile makes). The coefficients are per-board
+// characterisation values; none ship with a profile today.
+// ---------------------------------------------------------------------------
+struct SelfHeatingModel {
+  float reference_load;         // load at which the static correction was measured
+  float correction_per_load_c;  // extra correction per unit of settled load (°C)
+  float time_constant_s;        // first-order thermal time constant; 0 = off
+};
+
+class SelfHeatingFilter {
+ public:
+  void set_model(const SelfHeatingModel &model) {
+    model_ = model;
+    if (!std::isfinite(model_.reference_load)) model_.reference_load = 0.0f;
+    if (!std::isfinite(model_.correction_per_load_c)) model_.correction_per_load_c = 0.0f;
+    if (!std::isfinite(model_.time_constant_s) || model_.time_constant_s < 0.0f)
+      model_.time_constant_s = 0.0f;
+  }
+  const SelfHeatingModel &model() const { return model_; }
+  bool enabled() const { return model_.time_constant_s > 0.0f; }
+
+  // Normalised board heat, clamped to [0, 1]; NaN is ignored (the previous
+  // load holds). Only a CHANGE advances the filter: a fast caller repeating
+  // the same load would otherwise take steps too small for a float to
+  // resolve near the settled value.
+  void input_load(uint32_t now_ms, float load) {
+    if (std::isnan(load)) return;
+    load = load < 0.0f ? 0.0f : (load > 1.0f ? 1.0f : load);
+    if (seen_ && load == load_) return;
+    if (!seen_) {
+      seen_ = true;
+      settled_ = load;
+      last_ms_ = now_ms;
+    } else {
+      advance(now_ms);
+    }
+    load_ = load;
+  }
+
+  // Correction to add ON TOP of the profile's static correction at now_ms
+  // (0 with no model or no load yet).
+  float excess_correction_c(uint32_t now_ms) {
+    if (!enabled() || !seen_) return 0.0f;
+    advance(now_ms);
+    return model_.correction_per_load_c * (settled_ - model_.reference_load);
+  }
+
+  float settled_load() const { return seen_ ? settled_ : NAN; }
+
+ private:
+  void advance(uint32_t now_ms) {
+    const uint32_t dt_ms = now_ms - last_ms_;
+    last_ms_ = now_ms;
+    if (dt_ms == 0 || !enabled()) {
+      if (!enabled()) settled_ = load_;
+      return;
+    }
+    const float decay = std::exp(-static_cast<float>(dt_ms) /
+                                 (1000.0f * model_.time_constant_s));
+    settled_ = load_ + (settled_ - load_) * decay;
+  }
+
+  SelfHeatingModel model_ = {0.0f, 0.0f, 0.0f};
+  bool seen_ = false;
+  float load_ = 0.0f;
+  float settled_ = 0.0f;
+  uint32_t last_ms_ = 0;
+};
+
 // ---------------------------------------------------------------------------
 // Sample coherence
 // ---------------------------------------------------------------------------
@@ -286,6 +542,7 @@ class ClimateSamplePairer {
     temperature_raw_ = celsius;
     temperature_ms_ = now_ms;
     temperature_valid_ = true;
+    temperature_restored_ = false;
     return try_pair_();
   }
 
@@ -317,6 +574,28 @@ class ClimateSamplePairer {
   // Timestamp of the later half of the pair.
   uint32_t pair_ms() const { return pair_ms_; }
 
+  // Warm-boot carry-over (RoomIQSnapshot): re-establish the last raw
+  // temperature and the latest coherent pair captured before a reset. The
+  // restored temperature is a value only — it never pairs — so a new sample
+  // can never pair with one from before the reset.
+  void restore_temperature(uint32_t now_ms, float celsius) {
+    if (!std::isfinite(celsius)) return;
+    temperature_raw_ = celsius;
+    temperature_ms_ = now_ms;
+    temperature_valid_ = true;
+    temperature_restored_ = true;
+  }
+
+  void restore_pair(uint32_t pair_ms, float celsius, float percent) {
+    if (!std::isfinite(celsius) || !std::isfinite(percent)) return;
+    pair_temperature_ = celsius;
+    pair_humidity_ = percent;
+    pair_temperature_ms_ = pair_ms;
+    pair_humidity_ms_ = pair_ms;
+    pair_ms_ = pair_ms;
+    pair_valid_ = true;
+  }
+
   // Rollover-safe circular distance between two millisecond timestamps.
   static uint32_t skew_ms(uint32_t a_ms, uint32_t b_ms) {
     const uint32_t forward = a_ms - b_ms;
@@ -332,7 +611,7 @@ class ClimateSamplePairer {
 
  private:
   bool try_pair_() {
-    if (!temperature_valid_ || !humidity_valid_) return false;
+    if (!temperature_valid_ || !humidity_valid_ || temperature_restored_) return false;
     if (skew_ms(temperature_ms_, humidity_ms_) > max_pair_skew_ms_) return false;
     // Each (temperature, humidity) sample combination pairs at most once.
     if (pair_valid_ && pair_temperature_ms_ == temperature_ms_ &&
@@ -353,6 +632,7 @@ class ClimateSamplePairer {
   float temperature_raw_ = NAN;
   uint32_t temperature_ms_ = 0;
   bool temperature_valid_ = false;
+  bool temperature_restored_ = false;
 
   float humidity_raw_ = NAN;
   uint32_t humidity_ms_ = 0;
@@ -36,6 +36,14 @@
 //     decision consumed by the LED framework (which passes its customer
 //     Darkness Threshold in at runtime). One implementation; the LED
 //     controller consumes the decision and never re-implements it.
+//   * Adaptive illuminance sampling — the light-sensor update interval the
+//     darkness decision warrants (fast near the threshold or while a night
+//     automation is armed, slow far from it); the glue applies it.
+//   * Warm-boot carry-over (RoomIQSnapshot) — the last coherent pair, lux
+//     and hysteresis memory, restored after OTA / watchdog resets while
+//     still inside the stale windows.
+//   * Publish gate (PublishDeadband) — per-entity change bands plus a
+//     heartbeat, so only genuine changes reach the API connection.
 //   * Module health — Initialising / Available / Degraded / Unavailable
 //     from real freshness evidence only; Fault is an engine contract with
 //     NO production producer (no composed component exposes a supported
@@ -70,9 +78,11 @@
 // ============================================================================
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
+#include "hysteresis_ladder.h"
 #include "roomiq_climate_compensation.h"
 
 namespace sense360 {
@@ -248,20 +258,104 @@ inline const char *darkness_to_string(Darkness darkness) {
   return "Unknown";
 }
 
+// Warm-boot carry-over: the engine state that otherwise takes a full sensor
+// cycle to rebuild after OTA or a watchdog reset — the last coherent SHT45
+// pair, the last lux sample, their data ages, and the comfort / brightness /
+// darkness hysteresis memory. Plain 32-bit fields (no padding) so the glue
+// can keep it in RTC memory that survives a warm reset; `magic`, `version`
+// and `checksum` reject power-on garbage and layout changes. Ages are
+// relative to capture (millis() restarts at boot); ROOMIQ_SNAPSHOT_NEVER
+// marks a channel with no data.
+static const uint32_t ROOMIQ_SNAPSHOT_MAGIC = 0x52495131u;  // "RIQ1"
+static const uint32_t ROOMIQ_SNAPSHOT_VERSION = 1;
+static const uint32_t ROOMIQ_SNAPSHOT_NEVER = 0xFFFFFFFFu;
+
+struct RoomIQSnapshot {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t temperature_age_ms;
+  uint32_t pair_age_ms;
+  uint32_t lux_age_ms;
+  float raw_temperature_c;   // raw: the profile is re-applied on restore
+  float pair_temperature_c;
+  float pair_humidity_pct;
+  float lux_raw;
+  int32_t temperature_band;
+  int32_t humidity_band;
+  int32_t brightness_band;
+  int32_t darkness;
+  uint32_t band_valid;  // bit 0 temperature, 1 humidity, 2 brightness
+  uint32_t checksum;    // FNV-1a over every preceding byte
+};
+static_assert(sizeof(RoomIQSnapshot) == 15 * sizeof(uint32_t),
+              "RoomIQSnapshot must stay padding-free");
+
+inline uint32_t roomiq_snapshot_checksum(const RoomIQSnapshot &snapshot) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&snapshot);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < offsetof(RoomIQSnapshot, checksum); i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+inline bool roomiq_snapshot_valid(const RoomIQSnapshot &snapshot) {
+  return snapshot.magic == ROOMIQ_SNAPSHOT_MAGIC &&
+         snapshot.version == ROOMIQ_SNAPSHOT_VERSION &&
+         snapshot.checksum == roomiq_snapshot_checksum(snapshot);
+}
+
 class RoomIQEngine {
  public:
   // --- built-in board climate profile ---------------------------------------
-  // S360-200-R4-CLIMATE-COMPENSATION-001. RoomIQ IS the S360-200 board, so the
-  // S360-200 R4 profile is the engine default and EVERY composition that
-  // carries this engine gets the same compensation with no product-level
-  // configuration. The setter exists so the native tests can prove that the
-  // profile constants — not hidden literals in this file — drive the result,
-  // and so a future revision can carry its own profile.
+  // S360-200-R4-CLIMATE-COMPENSATION-001. The engine default is the profile
+  // the codegen compiled in (compiled_climate_profile(); the S360-200 R4
+  // profile unless the board package names another registry entry), so EVERY
+  // composition that carries this engine gets the same compensation with no
+  // product-level configuration and no runtime lookup.
+  //
+  // By registry id: a constant table index.
+  void set_climate_profile(ClimateProfileId id) {
+    set_climate_profile(climate_profile_entry(id));
+  }
+  // Any profile object — the native tests prove with it that the profile
+  // constants, not hidden literals in this file, drive the result.
   void set_climate_profile(const ClimateProfile &profile) {
     climate_profile_ = &profile;
+    rebuild_compensation_profile_();
+  }
+#if SENSE360_CLIMATE_PROFILE_RUNTIME
+  // Bench builds only: switch by profile id string ("NEUTRAL_CLIMATE_PROFILE",
+  // "S360_200_R4_CLIMATE_PROFILE_V1", ...). False, and no change, for an
+  // unknown id.
+  bool set_climate_profile(const char *id) {
+    const ClimateProfile *profile = find_climate_profile(id);
+    if (profile == nullptr) return false;
+    set_climate_profile(*profile);
+    return true;
   }
+#endif
   const ClimateProfile &climate_profile() const { return *climate_profile_; }
 
+  // --- self-heating dynamics (optional) ---------------------------------------
+  // The profile's correction is the steady state at one board load. With a
+  // SelfHeatingModel set, the board heat the glue reports (normalised 0..1,
+  // LED ring output today) moves the correction through the model's
+  // first-order lag; evaluate() advances it. No model (the default) or no
+  // heat input yet leaves the static profile correction in force.
+  void set_self_heating_model(const SelfHeatingModel &model) {
+    self_heating_.set_model(model);
+    self_heating_c_ = 0.0f;
+    rebuild_compensation_profile_();
+  }
+  const SelfHeatingModel &self_heating_model() const { return self_heating_.model(); }
+  void input_board_heat(uint32_t now_ms, float load) {
+    self_heating_.input_load(now_ms, load);
+  }
+  // The correction currently added on top of the profile's static value.
+  float self_heating_correction() const { return self_heating_c_; }
+
   // Maximum accepted skew between the two halves of one SHT45 conversion.
   void set_climate_pair_skew_ms(uint32_t ms) {
     climate_pair_.set_max_pair_skew_ms(ms);
@@ -282,7 +376,10 @@ class RoomIQEngine {
   // degree). A large value now means either an unusual installation or a
   // hardware question — never a routine setting.
   void set_temperature_offset(float offset_c) {
-    temperature_offset_ = sanitise_offset(offset_c, 15.0f);
+    const float offset = sanitise_offset(offset_c, 15.0f);
+    if (offset == temperature_offset_) return;  // re-applied every evaluation
+    temperature_offset_ = offset;
+    refresh_climate_();
   }
 
   // Customer humidity offset in %RH — ADDITIONAL fine calibration applied
@@ -291,7 +388,10 @@ class RoomIQEngine {
   // (+/-30 %RH) matches the Humidity Offset UI control and is likewise a
   // retained compatibility range, not an expected magnitude.
   void set_humidity_offset(float offset_pct) {
-    humidity_offset_ = sanitise_offset(offset_pct, 30.0f);
+    const float offset = sanitise_offset(offset_pct, 30.0f);
+    if (offset == humidity_offset_) return;
+    humidity_offset_ = offset;
+    refresh_climate_();
   }
 
   // Customer illuminance multiplier. Ambient-light error is dominated by
@@ -321,36 +421,29 @@ class RoomIQEngine {
   // --- comfort thresholds (provisional comfort heuristics — never medical,
   // health or regulatory thresholds) -----------------------------------------
   void set_temperature_bands(float cold, float cool, float warm, float hot) {
-    temp_cold_ = cold;
-    temp_cool_ = cool;
-    temp_warm_ = warm;
-    temp_hot_ = hot;
+    temp_ladder_.set_boundaries({cold, cool, warm, hot});
   }
   void set_temperature_hysteresis(float c) {
-    temp_hysteresis_ = std::isnan(c) || c < 0.0f ? 0.0f : c;
+    temp_ladder_.set_symmetric(std::isnan(c) || c < 0.0f ? 0.0f : c);
   }
   void set_humidity_bands(float dry, float humid) {
-    humidity_dry_ = dry;
-    humidity_humid_ = humid;
+    humidity_ladder_.set_boundaries({dry, humid});
   }
   void set_humidity_hysteresis(float pct) {
-    humidity_hysteresis_ = std::isnan(pct) || pct < 0.0f ? 0.0f : pct;
+    humidity_ladder_.set_symmetric(std::isnan(pct) || pct < 0.0f ? 0.0f : pct);
   }
 
   // --- brightness bands (provisional room-ambience categories) --------------
   void set_brightness_bands(float dim, float normal, float bright,
                             float very_bright) {
-    lux_dim_ = dim;
-    lux_normal_ = normal;
-    lux_bright_ = bright;
-    lux_very_bright_ = very_bright;
+    brightness_ladder_.set_boundaries({dim, normal, bright, very_bright});
   }
   // Falling margin in percent: a category only drops once lux falls below
   // boundary * (1 - pct/100); rising crosses the plain boundary.
   void set_brightness_hysteresis_pct(float pct) {
     if (std::isnan(pct) || pct < 0.0f) pct = 0.0f;
     if (pct > 90.0f) pct = 90.0f;
-    brightness_hysteresis_pct_ = pct;
+    brightness_ladder_.set_immediate_rise_scaled(1.0f - pct / 100.0f);
   }
 
   // --- darkness service (consumed by the LED framework) ---------------------
@@ -364,6 +457,26 @@ class RoomIQEngine {
     darkness_hysteresis_ = factor < 1.0f ? 1.0f : factor;
   }
 
+  // --- adaptive illuminance sampling (lux_sample_interval_ms) ---------------
+  // Fast / normal / slow light-sensor update intervals and the near band
+  // around the darkness decision, in percent: lux within
+  // [threshold * (1 - pct/100), threshold * hysteresis * (1 + pct/100)] is
+  // "near". Zero intervals are ignored; the band is clamped to [0, 90].
+  void set_lux_sample_intervals(uint32_t fast_ms, uint32_t normal_ms,
+                                uint32_t slow_ms) {
+    if (fast_ms > 0) lux_fast_ms_ = fast_ms;
+    if (normal_ms > 0) lux_normal_ms_ = normal_ms;
+    if (slow_ms > 0) lux_slow_ms_ = slow_ms;
+  }
+  void set_lux_near_band_pct(float pct) {
+    if (std::isnan(pct) || pct < 0.0f) pct = 0.0f;
+    if (pct > 90.0f) pct = 90.0f;
+    lux_near_band_pct_ = pct;
+  }
+  // The LED framework reports whether a night automation that reads the
+  // darkness decision is in force (When dark / When dark and occupied).
+  void set_darkness_armed(bool armed) { darkness_armed_ = armed; }
+
   // Explicit persistent fault input. RESERVED: no composed component
   // exposes a supported RoomIQ fault signal today, so production YAML
   // never sets this; the engine contract exists (and is tested) for a
@@ -397,6 +510,7 @@ class RoomIQEngine {
     if (paired) {
       humidity_seen_ = true;
       humidity_last_ms_ = climate_pair_.pair_ms();
+      refresh_climate_();
     }
   }
 
@@ -405,6 +519,7 @@ class RoomIQEngine {
     if (!climate_pair_.input_humidity(now_ms, percent)) return;
     humidity_seen_ = true;
     humidity_last_ms_ = climate_pair_.pair_ms();
+    refresh_climate_();
   }
 
   void input_lux(uint32_t now_ms, float lux) {
@@ -425,21 +540,144 @@ class RoomIQEngine {
                                     climate_warmup_ms_, climate_stale_ms_);
     lux_state_ = channel_state(now_ms, lux_seen_, lux_last_ms_,
                                lux_warmup_ms_, lux_stale_ms_);
+    advance_self_heating_(now_ms);
 
     update_comfort();
     update_brightness();
-    update_darkness();
+    update_darkness(lux_state_);
     update_environment();
     update_health();
   }
 
+  // Darkness-only refresh for the LED framework's 250 ms loop: the lux
+  // channel's freshness is computed for this call alone and the darkness
+  // hysteresis advanced — nothing else. Comfort, brightness, environment,
+  // health and the channel states read by the value getters keep what the
+  // last evaluate() produced (the RoomIQ component's own tick and input
+  // callbacks drive that). The decision is the one evaluate() would reach at
+  // the same instant.
+  Darkness evaluate_darkness(uint32_t now_ms) {
+    ensure_started(now_ms);
+    update_darkness(channel_state(now_ms, lux_seen_, lux_last_ms_,
+                                  lux_warmup_ms_, lux_stale_ms_));
+    return darkness_;
+  }
+
+  // Light-sensor update interval the darkness decision currently warrants:
+  //   * fast   — lux is near the darkness decision, or a night automation
+  //              is armed and lux is not far from it (a lights-off event
+  //              reaches the LED loop within a fast interval);
+  //   * slow   — lux is far from the decision (more than 4x outside the
+  //              near band) and nothing is armed;
+  //   * normal — otherwise, and whenever lux is not fresh (warm-up, missing
+  //              or stale data is never the moment to back off).
+  // Slow is capped at a third of the stale window so relaxed sampling can
+  // never age a healthy channel into MISSING. Pure: no engine state
+  // changes.
+  uint32_t lux_sample_interval_ms(uint32_t now_ms) const {
+    const uint32_t fast = lux_fast_ms_ < lux_normal_ms_ ? lux_fast_ms_ : lux_normal_ms_;
+    uint32_t slow = lux_slow_ms_ > lux_normal_ms_ ? lux_slow_ms_ : lux_normal_ms_;
+    if (slow > lux_stale_ms_ / 3) slow = lux_stale_ms_ / 3;
+    if (slow < lux_normal_ms_) slow = lux_normal_ms_;
+    if (channel_state(now_ms, lux_seen_, lux_last_ms_, lux_warmup_ms_,
+                      lux_stale_ms_) != CHANNEL_FRESH)
+      return lux_normal_ms_;
+    const float lux = calibrated_lux();
+    const float band = lux_near_band_pct_ / 100.0f;
+    const float near_low = darkness_threshold_ * (1.0f - band);
+    const float near_high = darkness_threshold_ * darkness_hysteresis_ * (1.0f + band);
+    const bool is_near = lux >= near_low && lux <= near_high;
+    const bool is_far = lux < near_low / 4.0f || lux > near_high * 4.0f;
+    if (is_near || (darkness_armed_ && !is_far)) return fast;
+    if (is_far && !darkness_armed_) return slow;
+    return lux_normal_ms_;
+  }
+
+  // --- warm-boot carry-over ----------------------------------------------------
+  // The state a warm reset would otherwise lose, with data ages taken at
+  // now_ms. Cheap enough to capture after every evaluation.
+  RoomIQSnapshot capture_snapshot(uint32_t now_ms) const {
+    RoomIQSnapshot snapshot;
+    std::memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.magic = ROOMIQ_SNAPSHOT_MAGIC;
+    snapshot.version = ROOMIQ_SNAPSHOT_VERSION;
+    snapshot.temperature_age_ms =
+        temp_seen_ ? elapsed(temp_last_ms_, now_ms) : ROOMIQ_SNAPSHOT_NEVER;
+    snapshot.pair_age_ms = humidity_seen_ && climate_pair_.pair_valid()
+                               ? elapsed(humidity_last_ms_, now_ms)
+                               : ROOMIQ_SNAPSHOT_NEVER;
+    snapshot.lux_age_ms = lux_seen_ ? elapsed(lux_last_ms_, now_ms) : ROOMIQ_SNAPSHOT_NEVER;
+    snapshot.raw_temperature_c = climate_pair_.raw_temperature();
+    snapshot.pair_temperature_c = climate_pair_.pair_temperature();
+    snapshot.pair_humidity_pct = climate_pair_.pair_humidity();
+    snapshot.lux_raw = lux_raw_;
+    snapshot.temperature_band = temp_ladder_.band();
+    snapshot.humidity_band = humidity_ladder_.band();
+    snapshot.brightness_band = brightness_ladder_.band();
+    snapshot.darkness = darkness_;
+    snapshot.band_valid = (temp_ladder_.valid() ? 1u : 0u) |
+                          (humidity_ladder_.valid() ? 2u : 0u) |
+                          (brightness_ladder_.valid() ? 4u : 0u);
+    snapshot.checksum = roomiq_snapshot_checksum(snapshot);
+    return snapshot;
+  }
+
+  // Restore a snapshot on a warm boot, after begin(). Each channel is
+  // restored only if its data — aged by the snapshot age plus
+  // `reboot_allowance_ms` for the reset itself, which millis() cannot see —
+  // is still inside that channel's stale window; it then ages on from
+  // there and expires exactly as live data would. Hysteresis memory follows
+  // its channel. An invalid snapshot, or one from before any sample,
+  // restores nothing. Returns the number of channels restored (0-3); call
+  // evaluate() afterwards.
+  int restore_snapshot(uint32_t now_ms, const RoomIQSnapshot &snapshot,
+                       uint32_t reboot_allowance_ms) {
+    ensure_started(now_ms);
+    if (!roomiq_snapshot_valid(snapshot)) return 0;
+    int restored = 0;
+    uint32_t age = 0;
+    if (restorable_age(snapshot.temperature_age_ms, reboot_allowance_ms,
+                       climate_stale_ms_, &age) &&
+        std::isfinite(snapshot.raw_temperature_c)) {
+      climate_pair_.restore_temperature(now_ms - age, snapshot.raw_temperature_c);
+      temp_seen_ = true;
+      temp_last_ms_ = now_ms - age;
+      restored++;
+      if (snapshot.band_valid & 1u) temp_ladder_.restore(snapshot.temperature_band);
+    }
+    if (restorable_age(snapshot.pair_age_ms, reboot_allowance_ms,
+                       climate_stale_ms_, &age) &&
+        std::isfinite(snapshot.pair_temperature_c) &&
+        std::isfinite(snapshot.pair_humidity_pct)) {
+      climate_pair_.restore_pair(now_ms - age, snapshot.pair_temperature_c,
+                                 snapshot.pair_humidity_pct);
+      humidity_seen_ = true;
+      humidity_last_ms_ = now_ms - age;
+      refresh_climate_();
+      restored++;
+      if (snapshot.band_valid & 2u) humidity_ladder_.restore(snapshot.humidity_band);
+    }
+    if (restorable_age(snapshot.lux_age_ms, reboot_allowance_ms, lux_stale_ms_,
+                       &age) &&
+        std::isfinite(snapshot.lux_raw) && snapshot.lux_raw >= 0.0f) {
+      lux_raw_ = snapshot.lux_raw;
+      lux_seen_ = true;
+      lux_last_ms_ = now_ms - age;
+      restored++;
+      if (snapshot.band_valid & 4u) brightness_ladder_.restore(snapshot.brightness_band);
+      if (snapshot.darkness == DARKNESS_DARK || snapshot.darkness == DARKNESS_NOT_DARK)
+        darkness_ = static_cast<Darkness>(snapshot.darkness);
+    }
+    return restored;
+  }
+
   // --- compensated value outputs ------------------------------------------------
   // NAN unless the channel is fresh: a stale value is never reported as a
   // real value. The board profile and the customer calibration are applied
   // here, exactly once, by the shared compensation helper.
   float temperature() const {
     if (temp_state_ != CHANNEL_FRESH) return NAN;
-    return compensate_temperature_c(*climate_profile_,
+    return compensate_temperature_c(compensation_profile_,
                                     climate_pair_.raw_temperature(),
                                     temperature_offset_);
   }
@@ -451,8 +689,7 @@ class RoomIQEngine {
 
   float illuminance() const {
     if (lux_state_ != CHANNEL_FRESH) return NAN;
-    float value = lux_raw_ * illuminance_scale_;
-    return value < 0.0f ? 0.0f : value;
+    return calibrated_lux();
   }
 
   // --- factory-only values (support diagnostics) ---------------------------
@@ -461,7 +698,7 @@ class RoomIQEngine {
   // the customer added". Never a customer-facing default entity.
   float factory_temperature() const {
     if (temp_state_ != CHANNEL_FRESH) return NAN;
-    return compensate_temperature_c(*climate_profile_,
+    return compensate_temperature_c(compensation_profile_,
                                     climate_pair_.raw_temperature(), 0.0f);
   }
 
@@ -614,12 +851,42 @@ class RoomIQEngine {
     return now_ms - since_ms;  // unsigned arithmetic handles wrap-around
   }
 
-  // The shared compensation model, evaluated on the latest COHERENT raw pair.
-  // Callers must already have checked humidity freshness.
-  ClimateResult climate_result_() const {
-    return compensate_climate(*climate_profile_, climate_pair_.pair_temperature(),
-                              climate_pair_.pair_humidity(), temperature_offset_,
-                              humidity_offset_);
+  // The shared compensation model on the latest COHERENT raw pair, memoised:
+  // recomputed only when a new pair forms or the profile / an offset
+  // changes, so every getter in an evaluate + publish cycle reads the same
+  // result for no further exp() calls. Callers must already have checked
+  // humidity freshness.
+  const ClimateResult &climate_result_() const { return climate_; }
+
+  static bool restorable_age(uint32_t age_ms, uint32_t allowance_ms,
+                             uint32_t stale_ms, uint32_t *age_out) {
+    if (age_ms == ROOMIQ_SNAPSHOT_NEVER || age_ms > stale_ms) return false;
+    if (allowance_ms > stale_ms - age_ms) return false;
+    *age_out = age_ms + allowance_ms;
+    return true;
+  }
+
+  // The profile the compensation actually runs with: the selected profile,
+  // its temperature correction moved by the self-heating model (if any).
+  void rebuild_compensation_profile_() {
+    compensation_profile_ = *climate_profile_;
+    compensation_profile_.temperature_correction_c += self_heating_c_;
+    refresh_climate_();
+  }
+
+  // Re-runs the humidity model only when the dynamic correction moved.
+  void advance_self_heating_(uint32_t now_ms) {
+    if (!self_heating_.enabled()) return;
+    const float correction = self_heating_.excess_correction_c(now_ms);
+    if (correction == self_heating_c_) return;
+    self_heating_c_ = correction;
+    rebuild_compensation_profile_();
+  }
+
+  void refresh_climate_() {
+    climate_ = compensate_climate(compensation_profile_, climate_pair_.pair_temperature(),
+                                  climate_pair_.pair_humidity(), temperature_offset_,
+                                  humidity_offset_);
   }
 
   static float sanitise_offset(float offset, float bound) {
@@ -643,41 +910,6 @@ class RoomIQEngine {
                                                 : CHANNEL_MISSING;
   }
 
-  // Temperature band indices (0 = cold .. 4 = hot) with symmetric
-  // hysteresis: leaving the current band requires crossing the boundary by
-  // the hysteresis margin, so noise at a boundary never flaps the state.
-  int raw_temp_band(float t) const {
-    if (t < temp_cold_) return 0;
-    if (t < temp_cool_) return 1;
-    if (t < temp_warm_) return 2;
-    if (t < temp_hot_) return 3;
-    return 4;
-  }
-
-  float temp_band_lower(int band) const {
-    switch (band) {
-      case 1:
-        return temp_cold_;
-      case 2:
-        return temp_cool_;
-      case 3:
-        return temp_warm_;
-      case 4:
-        return temp_hot_;
-    }
-    return temp_cold_;
-  }
-
-  int raw_humidity_band(float h) const {
-    if (h < humidity_dry_) return 0;
-    if (h < humidity_humid_) return 1;
-    return 2;
-  }
-
-  float humidity_band_lower(int band) const {
-    return band == 2 ? humidity_humid_ : humidity_dry_;
-  }
-
   void update_comfort() {
     const bool climate_fresh =
         temp_state_ == CHANNEL_FRESH && humidity_state_ == CHANNEL_FRESH;
@@ -687,53 +919,23 @@ class RoomIQEngine {
           temp_state_ != CHANNEL_MISSING && humidity_state_ != CHANNEL_MISSING;
       comfort_ = climate_initialising ? COMFORT_INITIALISING
                                       : COMFORT_UNAVAILABLE;
-      temp_band_valid_ = false;
-      humidity_band_valid_ = false;
+      temp_ladder_.reset();
+      humidity_ladder_.reset();
       return;
     }
 
-    const float t = temperature();
-    const float h = humidity();
-
-    // Band classification with hysteresis (state-holding at boundaries).
-    const int raw_t = raw_temp_band(t);
-    if (!temp_band_valid_) {
-      temp_band_ = raw_t;
-      temp_band_valid_ = true;
-    } else {
-      while (raw_t > temp_band_ &&
-             t >= temp_band_lower(temp_band_ + 1) + temp_hysteresis_) {
-        temp_band_++;
-      }
-      while (raw_t < temp_band_ &&
-             t < temp_band_lower(temp_band_) - temp_hysteresis_) {
-        temp_band_--;
-      }
-    }
-
-    const int raw_h = raw_humidity_band(h);
-    if (!humidity_band_valid_) {
-      humidity_band_ = raw_h;
-      humidity_band_valid_ = true;
-    } else {
-      while (raw_h > humidity_band_ &&
-             h >= humidity_band_lower(humidity_band_ + 1) +
-                      humidity_hysteresis_) {
-        humidity_band_++;
-      }
-      while (raw_h < humidity_band_ &&
-             h < humidity_band_lower(humidity_band_) - humidity_hysteresis_) {
-        humidity_band_--;
-      }
-    }
+    // Band classification with hysteresis (state-holding at boundaries):
+    // temperature 0 = cold .. 4 = hot, humidity 0 = dry .. 2 = humid.
+    const int temp_band = temp_ladder_.update(temperature());
+    const int humidity_band = humidity_ladder_.update(humidity());
 
     // Documented precedence: combined severe (warm/hot AND humid) >
     // temperature discomfort > humidity discomfort > comfortable.
-    if (temp_band_ >= 3 && humidity_band_ == 2) {
+    if (temp_band >= 3 && humidity_band == 2) {
       comfort_ = COMFORT_WARM_HUMID;
       return;
     }
-    switch (temp_band_) {
+    switch (temp_band) {
       case 0:
         comfort_ = COMFORT_COLD;
         return;
@@ -747,70 +949,33 @@ class RoomIQEngine {
         comfort_ = COMFORT_HOT;
         return;
     }
-    if (humidity_band_ == 0) {
+    if (humidity_band == 0) {
       comfort_ = COMFORT_DRY;
       return;
     }
-    if (humidity_band_ == 2) {
+    if (humidity_band == 2) {
       comfort_ = COMFORT_HUMID;
       return;
     }
     comfort_ = COMFORT_COMFORTABLE;
   }
 
-  int raw_brightness_band(float lux) const {
-    if (lux < lux_dim_) return 0;         // Dark
-    if (lux < lux_normal_) return 1;      // Dim
-    if (lux < lux_bright_) return 2;      // Normal
-    if (lux < lux_very_bright_) return 3; // Bright
-    return 4;                             // Very bright
-  }
-
-  float brightness_band_lower(int band) const {
-    switch (band) {
-      case 1:
-        return lux_dim_;
-      case 2:
-        return lux_normal_;
-      case 3:
-        return lux_bright_;
-      case 4:
-        return lux_very_bright_;
-    }
-    return lux_dim_;
-  }
-
   void update_brightness() {
     if (lux_state_ == CHANNEL_INIT) {
       brightness_ = BRIGHTNESS_INITIALISING;
-      brightness_band_valid_ = false;
+      brightness_ladder_.reset();
       return;
     }
     if (lux_state_ == CHANNEL_MISSING) {
       brightness_ = BRIGHTNESS_UNAVAILABLE;
-      brightness_band_valid_ = false;
+      brightness_ladder_.reset();
       return;
     }
 
-    const float lux = illuminance();
-    const int raw = raw_brightness_band(lux);
-    if (!brightness_band_valid_) {
-      brightness_band_ = raw;
-      brightness_band_valid_ = true;
-    } else if (raw > brightness_band_) {
-      // Rising crosses the plain boundary immediately.
-      brightness_band_ = raw;
-    } else {
-      // Falling drops only below boundary * (1 - margin) — hysteresis
-      // prevents category flapping near a boundary.
-      const float margin = 1.0f - brightness_hysteresis_pct_ / 100.0f;
-      while (raw < brightness_band_ &&
-             lux < brightness_band_lower(brightness_band_) * margin) {
-        brightness_band_--;
-      }
-    }
-
-    switch (brightness_band_) {
+    // Rising crosses the plain boundary immediately; falling drops only
+    // below boundary * (1 - margin) — hysteresis prevents category flapping
+    // near a boundary.
+    switch (brightness_ladder_.update(illuminance())) {
       case 0:
         brightness_ = BRIGHTNESS_DARK;
         return;
@@ -827,12 +992,17 @@ class RoomIQEngine {
     brightness_ = BRIGHTNESS_VERY_BRIGHT;
   }
 
-  void update_darkness() {
-    if (lux_state_ != CHANNEL_FRESH) {
+  float calibrated_lux() const {
+    const float value = lux_raw_ * illuminance_scale_;
+    return value < 0.0f ? 0.0f : value;
+  }
+
+  void update_darkness(int lux_state) {
+    if (lux_state != CHANNEL_FRESH) {
       darkness_ = DARKNESS_UNKNOWN;
       return;
     }
-    const float lux = illuminance();
+    const float lux = calibrated_lux();
     const float dark_below = darkness_threshold_;
     const float clear_above = darkness_threshold_ * darkness_hysteresis_;
     switch (darkness_) {
@@ -942,8 +1112,12 @@ class RoomIQEngine {
   // built-in board climate profile (default = the S360-200 R4 profile,
   // because RoomIQ IS the S360-200 board) and the SHT45 sample pairer that
   // guarantees the humidity model only ever sees one physical conversion.
-  const ClimateProfile *climate_profile_ = &S360_200_R4_CLIMATE_PROFILE_V1();
+  const ClimateProfile *climate_profile_ = &compiled_climate_profile();
+  ClimateProfile compensation_profile_ = compiled_climate_profile();
+  SelfHeatingFilter self_heating_;
+  float self_heating_c_ = 0.0f;  // dynamic correction in compensation_profile_
   ClimateSamplePairer climate_pair_;
+  ClimateResult climate_ = invalid_climate_result();  // see climate_result_()
 
   // calibration (customer-adjustable at runtime; persisted by the YAML
   // number entities, re-applied on every evaluation)
@@ -957,27 +1131,28 @@ class RoomIQEngine {
   uint32_t lux_warmup_ms_ = 30000;
   uint32_t lux_stale_ms_ = 60000;
 
-  // comfort thresholds (provisional comfort heuristics)
-  float temp_cold_ = 16.0f;
-  float temp_cool_ = 18.0f;
-  float temp_warm_ = 24.0f;
-  float temp_hot_ = 27.0f;
-  float temp_hysteresis_ = 0.3f;
-  float humidity_dry_ = 30.0f;
-  float humidity_humid_ = 60.0f;
-  float humidity_hysteresis_ = 2.0f;
-
-  // brightness bands (provisional room-ambience categories)
-  float lux_dim_ = 10.0f;
-  float lux_normal_ = 50.0f;
-  float lux_bright_ = 300.0f;
-  float lux_very_bright_ = 1000.0f;
-  float brightness_hysteresis_pct_ = 20.0f;
+  // comfort and brightness bands with their hysteresis memory (provisional
+  // comfort heuristics / room-ambience categories): Cold < 16 <= Cool < 18
+  // <= Comfortable < 24 <= Warm < 27 <= Hot, symmetric 0.3 °C; Dry < 30 <=
+  // Normal < 60 <= Humid, symmetric 2 %RH; Dark < 10 <= Dim < 50 <= Normal
+  // < 300 <= Bright < 1000 <= Very bright, falling 20 % below a boundary.
+  HysteresisLadder<4> temp_ladder_ =
+      HysteresisLadder<4>::symmetric(0.3f, 16.0f, 18.0f, 24.0f, 27.0f);
+  HysteresisLadder<2> humidity_ladder_ = HysteresisLadder<2>::symmetric(2.0f, 30.0f, 60.0f);
+  HysteresisLadder<4> brightness_ladder_ = HysteresisLadder<4>::immediate_rise_scaled(
+      1.0f - 20.0f / 100.0f, 10.0f, 50.0f, 300.0f, 1000.0f);
 
   // darkness service (LED semantics preserved)
   float darkness_threshold_ = 20.0f;
   float darkness_hysteresis_ = 1.5f;
 
+  // adaptive illuminance sampling (the 10 s board cadence is "normal")
+  uint32_t lux_fast_ms_ = 2000;
+  uint32_t lux_normal_ms_ = 10000;
+  uint32_t lux_slow_ms_ = 20000;
+  float lux_near_band_pct_ = 50.0f;
+  bool darkness_armed_ = false;
+
   // lifecycle
   bool started_ = false;
   uint32_t start_ms_ = 0;
@@ -997,14 +1172,6 @@ class RoomIQEngine {
   int humidity_state_ = CHANNEL_INIT;
   int lux_state_ = CHANNEL_INIT;
 
-  // hysteresis band memory
-  int temp_band_ = 2;
-  bool temp_band_valid_ = false;
-  int humidity_band_ = 1;
-  bool humidity_band_valid_ = false;
-  int brightness_band_ = 2;
-  bool brightness_band_valid_ = false;
-
   // fault (reserved — no production producer)
   bool fault_ = false;
 
@@ -1016,6 +1183,64 @@ class RoomIQEngine {
   Darkness darkness_ = DARKNESS_UNKNOWN;
 };
 
+// Publish gate for one numeric output entity: suppresses republishing a
+// value that has not genuinely moved. A value is published when
+//   * nothing has been published yet, or force() was called;
+//   * it crosses between a real value and NAN (a channel going stale or
+//     recovering is never held back);
+//   * it differs from the LAST PUBLISHED value by at least
+//     max(absolute, relative * |last published|) — measured against what
+//     the consumer actually holds, so slow drift still gets through once it
+//     adds up;
+//   * a real value has not been published for heartbeat_ms (0 = never), so
+//     a consumer can tell a steady reading from a silent device.
+// A NAN held unchanged is never republished.
+class PublishDeadband {
+ public:
+  PublishDeadband(float absolute, float relative)
+      : absolute_(absolute), relative_(relative) {}
+
+  void set_band(float absolute, float relative) {
+    absolute_ = std::isnan(absolute) || absolute < 0.0f ? 0.0f : absolute;
+    relative_ = std::isnan(relative) || relative < 0.0f ? 0.0f : relative;
+  }
+  void set_heartbeat_ms(uint32_t ms) { heartbeat_ms_ = ms; }
+  // The next offered value publishes regardless of the band (a
+  // calibration change the customer just made must show).
+  void force() { published_ = false; }
+
+  // True when `value` must be published now; records it as published.
+  bool offer(uint32_t now_ms, float value) {
+    if (!should_publish(now_ms, value)) return false;
+    published_ = true;
+    last_ = value;
+    last_ms_ = now_ms;
+    return true;
+  }
+
+  bool should_publish(uint32_t now_ms, float value) const {
+    if (!published_) return true;
+    const bool was_nan = std::isnan(last_);
+    if (std::isnan(value) || was_nan) return std::isnan(value) != was_nan;
+    const float magnitude = last_ < 0.0f ? -last_ : last_;
+    const float band = absolute_ > relative_ * magnitude ? absolute_
+                                                         : relative_ * magnitude;
+    const float delta = value - last_;
+    if ((delta < 0.0f ? -delta : delta) >= band && value != last_) return true;
+    return heartbeat_ms_ > 0 && now_ms - last_ms_ >= heartbeat_ms_;
+  }
+
+  float last_published() const { return published_ ? last_ : NAN; }
+
+ private:
+  float absolute_;
+  float relative_;
+  uint32_t heartbeat_ms_ = 0;
+  bool published_ = false;
+  float last_ = NAN;
+  uint32_t last_ms_ = 0;
+};
+
 // Accessor for the firmware's single engine instance. ESPHome emits
 // `esphome: includes:` headers AFTER the globals storage declarations in
 // the generated main.cpp, so a custom-class `globals:` entry cannot name
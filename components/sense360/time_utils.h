@@ -105,6 +105,21 @@ inline int minutes_until(const Time& current_time, const Time& target_time) {
   }
 }
 
+/**
+ * Check whether a daily reset point was passed between two clock readings
+ * (handles the midnight wrap). The readings must be less than 24 h apart;
+ * a reset exactly at the previous reading has already been taken.
+ *
+ * @param previous_time Previous clock reading
+ * @param current_time Current clock reading
+ * @param reset_time Daily reset point
+ * @return true if reset_time lies in (previous_time, current_time]
+ */
+inline bool passed_daily_reset(const Time& previous_time, const Time& current_time, const Time& reset_time) {
+  const int to_reset = minutes_until(previous_time, reset_time);
+  return to_reset > 0 && to_reset <= minutes_until(previous_time, current_time);
+}
+
 /**
  * Validate time is in valid range
  */
@@ -14,21 +14,35 @@
 //     falling-humidity end; a maximum-duration timeout so a stuck-humid
 //     bathroom is never claimed to be "showering" forever).
 //   * The post-shower moisture-clearing window.
+//   * Shower-onset burst sampling — the humidity sample interval the
+//     shower state warrants (fast from a pre-trigger through the end of
+//     clearing, the board cadence otherwise); the glue applies it.
 //   * The sustained-damp (mould-risk) accumulator with honest no-data
-//     freezing (no data means no accumulation AND no reset).
+//     freezing (no data means no accumulation AND no reset), and its
+//     flash-persistence policy (MouldSnapshot: when a commit is due, what
+//     a restore may believe); the glue owns the preference itself.
 //   * The high-humidity advice state with release hysteresis.
 //   * ONE deterministic customer ventilation Recommendation and ONE
 //     plain-language Ventilation Reason, from a fixed priority ladder:
 //     manual request > shower > clearing > very poor air > damp (high) >
 //     damp (medium) > poor air > odour > high humidity > nothing.
-//   * The legacy fan-percent mapping (compatibility surface only).
+//   * A continuous ventilation effort (0-100 %) for variable-speed fan
+//     outputs, scaled from the drivers behind the demand — humidity
+//     excess, clearing remaining, damp time, the AirIQ severity
+//     progress — with slew limiting, a minimum running effort and a
+//     minimum on-time.
+//   * The legacy fan-percent mapping (compatibility surface only: the
+//     stepped view of the demand ladder).
 //   * VentIQ module health over the board's own verifiable channels.
 //
 // What it deliberately does NOT own (consumed, never duplicated):
-//   * Pollutant severity. VOC/NOx classification comes from an EMBEDDED
-//     canonical AirIQ engine (components/sense360/airiq_engine.h — the
-//     platform's single source of pollutant truth). No VOC/NOx band
-//     value is re-declared here; the AirIQ defaults are the values.
+//   * Pollutant severity. VOC/NOx classification comes from a canonical
+//     AirIQ engine (components/sense360/airiq_engine.h — the platform's
+//     single source of pollutant truth): an EMBEDDED instance, or — on a
+//     composition that also carries the AirIQ board — that composition's
+//     own engine, bound read-only (SharedPollutants), so VOC/NOx are
+//     classified, stored and evaluated once. No VOC/NOx band value is
+//     re-declared here; the AirIQ defaults are the values.
 //     The odour signal is defined as "VOC or NOx at Fair or worse" —
 //     the canonical Fair boundary (VOC index 150) is exactly the legacy
 //     VentIQ odour threshold, so no second threshold exists.
@@ -68,7 +82,9 @@
 // ============================================================================
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 #include "airiq_engine.h"
 
@@ -142,27 +158,136 @@ inline const char *reason_to_string(Reason reason) {
   return "Unavailable";
 }
 
-class VentIQEngine {
+// The embedded pollutant engine's configuration: the canonical AirIQ
+// defaults with the S360-211 composition applied, as one immutable value.
+// (Entries outside the embedded engine's channel set are ignored; they are
+// kept so the value stays a complete AirIQConfig.)
+//   * Expected: ONLY the board's schematic-proven SGP41 channels (VOC +
+//     NOx). CO2 / PM / formaldehyde / ozone have no producer on this board
+//     and must never degrade anything. (The AirIQ defaults expect CO2 —
+//     correct for the S360-210 board, overridden here for S360-211.)
+//   * The compiled VentIQ SGP41 updates every 10 s (vs AirIQ's 30 s), so
+//     the stale window tightens to six missed updates. PROVISIONAL.
+//   * VOC/NOx severity thresholds are deliberately NOT set here: the
+//     canonical AirIQ engine defaults are the platform's single source of
+//     pollutant truth.
+constexpr airiq::AirIQConfig default_pollutant_config() {
+  return airiq::AirIQConfig{
+      1,
+      {airiq::default_channel_config(airiq::POLLUTANT_CO2).with_expected(false),
+       airiq::default_channel_config(airiq::POLLUTANT_VOC).with_stale_ms(60000),
+       airiq::default_channel_config(airiq::POLLUTANT_NOX).with_stale_ms(60000),
+       airiq::default_channel_config(airiq::POLLUTANT_PM25)
+           .with_expected(false),
+       airiq::default_channel_config(airiq::POLLUTANT_HCHO)
+           .with_expected(false),
+       airiq::default_channel_config(airiq::POLLUTANT_O3)
+           .with_expected(false)},
+      0.0f};
+}
+
+// --- persistent damp accumulation -----------------------------------------------
+// The mould-risk accumulator as the glue keeps it in a flash preference, so
+// a reboot or an OTA does not hide a damp spell hours in. `magic`, `version`
+// and `checksum` reject a blank or foreign record and layout changes; the
+// risk level is not stored (it follows from wet_ms and the configured
+// duration). saved_epoch_s is the wall clock at capture, 0 when unknown.
+static const uint32_t MOULD_SNAPSHOT_MAGIC = 0x4D4F4C31u;  // "MOL1"
+static const uint32_t MOULD_SNAPSHOT_VERSION = 1;
+
+struct MouldSnapshot {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t wet_ms;
+  uint32_t saved_epoch_s;
+  uint32_t checksum;  // FNV-1a over every preceding byte
+};
+static_assert(sizeof(MouldSnapshot) == 5 * sizeof(uint32_t),
+              "MouldSnapshot must stay padding-free");
+
+inline uint32_t mould_snapshot_checksum(const MouldSnapshot &snapshot) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&snapshot);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < offsetof(MouldSnapshot, checksum); i++) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+inline bool mould_snapshot_valid(const MouldSnapshot &snapshot) {
+  return snapshot.magic == MOULD_SNAPSHOT_MAGIC &&
+         snapshot.version == MOULD_SNAPSHOT_VERSION &&
+         snapshot.checksum == mould_snapshot_checksum(snapshot);
+}
+
+// --- pollutant sources -------------------------------------------------------
+// Where VentIQ's pollutant truth lives. Both expose the engine read-only
+// (engine()) and the engine this VentIQ owns — configures, feeds and
+// evaluates — through owned(), nullptr when it owns none.
+
+// An engine of VentIQ's own, specialised to the board's SGP41 channels: the
+// other pollutant, pressure and MiCS channels have no producer here and
+// carry no storage.
+class EmbeddedPollutants {
+ public:
+  static constexpr bool SHARED = false;
+  typedef airiq::BasicAirIQEngine<airiq::channel_bit(airiq::POLLUTANT_VOC) |
+                                  airiq::channel_bit(airiq::POLLUTANT_NOX)>
+      Engine;
+
+  EmbeddedPollutants() { engine_.apply_config(default_pollutant_config()); }
+
+  const Engine &engine() const { return engine_; }
+  Engine *owned() { return &engine_; }
+
+ private:
+  Engine engine_;
+};
+
+// The composition's AirIQ engine (e.g. airiq::global_engine() on a build
+// that carries the AirIQ board), bound by reference. Its owner configures,
+// feeds and evaluates it; VentIQ's pollutant setters and inputs are then
+// no-ops, and its air quality and health are that engine's headline over
+// every channel the composition expects — the platform's one air-quality
+// answer rather than a VOC/NOx-only second one.
+template <class AirIQ>
+class SharedPollutants {
  public:
-  VentIQEngine() {
-    // The embedded canonical pollutant engine expects ONLY the S360-211's
-    // schematic-proven sensor channels: SGP41 VOC + NOx. CO2 / PM /
-    // formaldehyde / ozone have no producer on this board and must never
-    // degrade anything. (The AirIQ engine's own defaults expect CO2 —
-    // correct for the S360-210 board, overridden here for S360-211.)
-    pollutants_.set_expected(airiq::POLLUTANT_CO2, false);
-    pollutants_.set_expected(airiq::POLLUTANT_VOC, true);
-    pollutants_.set_expected(airiq::POLLUTANT_NOX, true);
-    pollutants_.set_expected(airiq::POLLUTANT_PM25, false);
-    pollutants_.set_expected(airiq::POLLUTANT_HCHO, false);
-    pollutants_.set_expected(airiq::POLLUTANT_O3, false);
-    // The compiled VentIQ SGP41 updates every 10 s (vs AirIQ's 30 s), so
-    // the stale window tightens to six missed updates. PROVISIONAL.
-    pollutants_.set_stale_ms(airiq::POLLUTANT_VOC, 60000);
-    pollutants_.set_stale_ms(airiq::POLLUTANT_NOX, 60000);
-    // VOC/NOx severity thresholds are deliberately NOT set here: the
-    // canonical AirIQ engine defaults are the platform's single source
-    // of pollutant truth.
+  static constexpr bool SHARED = true;
+  typedef AirIQ Engine;
+
+  explicit SharedPollutants(const Engine &engine) : engine_(&engine) {}
+
+  const Engine &engine() const { return *engine_; }
+  Engine *owned() { return nullptr; }
+
+ private:
+  const Engine *engine_;
+};
+
+// The ventilation engine over a pollutant source: EmbeddedPollutants (the
+// VentIQEngine every composition uses today) or SharedPollutants bound to
+// the composition's AirIQ engine.
+template <class Pollutants>
+class BasicVentIQEngine {
+ public:
+  BasicVentIQEngine() {}
+  // Binds a shared pollutant engine (SharedPollutants only).
+  template <class Engine>
+  explicit BasicVentIQEngine(const Engine &shared) : source_(shared) {}
+
+  // True when pollutant truth is read from a bound engine this one neither
+  // configures, feeds nor evaluates.
+  static constexpr bool shares_pollutant_engine() { return Pollutants::SHARED; }
+
+  // Whole-configuration passthrough for the embedded pollutant engine (the
+  // same AirIQConfig value type the AirIQ glue applies; versioned, so
+  // re-applying an already applied version is a no-op). A shared engine is
+  // its owner's to configure: refused.
+  bool apply_pollutant_config(const airiq::AirIQConfig &config) {
+    typename Pollutants::Engine *owned = source_.owned();
+    return owned != nullptr && owned->apply_config(config);
   }
 
   // --- composition configuration (substitution-driven) -----------------------
@@ -199,28 +324,66 @@ class VentIQEngine {
     if (!std::isnan(pct) && pct >= 0.0f) humidity_hysteresis_pct_ = pct;
   }
 
+  // --- shower-onset burst sampling (humidity_sample_interval_ms) -------------
+  // Burst / normal humidity sample intervals; the pre-trigger that starts a
+  // burst — rate of rise >= pre_rate (%/min) or humidity within margin %RH
+  // of the shower threshold; and the longest a burst may run without the
+  // shower being claimed. Zero / invalid values are ignored; a burst
+  // interval below the 5 s the rate window is sized for is raised to it
+  // (faster samples would leave only part of the window in the fit).
+  void set_humidity_sample_intervals(uint32_t burst_ms, uint32_t normal_ms) {
+    if (burst_ms > 0)
+      humidity_burst_ms_ = burst_ms < RATE_MIN_INTERVAL_MS ? RATE_MIN_INTERVAL_MS : burst_ms;
+    if (normal_ms > 0) humidity_normal_ms_ = normal_ms;
+  }
+  void set_burst_pre_rate(float pct_per_min) {
+    if (!std::isnan(pct_per_min) && pct_per_min > 0.0f) burst_pre_rate_ = pct_per_min;
+  }
+  void set_burst_pre_margin_pct(float pct) {
+    if (!std::isnan(pct) && pct >= 0.0f) burst_pre_margin_pct_ = pct;
+  }
+  void set_burst_max_minutes(float minutes) {
+    if (!std::isnan(minutes) && minutes > 0.0f) burst_max_minutes_ = minutes;
+  }
+
+  // Continuous ventilation effort shaping: the rise and fall slew limits
+  // (%/min), the minimum on-time once started and the minimum running
+  // effort (a variable-speed fan's stall floor; below it the effort is 0).
+  void set_effort_slew(float up_pct_per_min, float down_pct_per_min) {
+    if (!std::isnan(up_pct_per_min) && up_pct_per_min > 0.0f)
+      effort_up_pct_per_min_ = up_pct_per_min;
+    if (!std::isnan(down_pct_per_min) && down_pct_per_min > 0.0f)
+      effort_down_pct_per_min_ = down_pct_per_min;
+  }
+  void set_effort_min_on_minutes(float minutes) {
+    if (!std::isnan(minutes) && minutes >= 0.0f) effort_min_on_minutes_ = minutes;
+  }
+  void set_effort_floor_pct(float pct) {
+    if (valid_pct(pct)) effort_floor_pct_ = pct;
+  }
+
   // Freshness windows (per input channel, independent; provisional).
   void set_humidity_warmup_ms(uint32_t ms) { humidity_warmup_ms_ = ms; }
   void set_humidity_stale_ms(uint32_t ms) { humidity_stale_ms_ = ms; }
   void set_temperature_warmup_ms(uint32_t ms) { temperature_warmup_ms_ = ms; }
   void set_temperature_stale_ms(uint32_t ms) { temperature_stale_ms_ = ms; }
   void set_voc_warmup_ms(uint32_t ms) {
-    pollutants_.set_warmup_ms(airiq::POLLUTANT_VOC, ms);
+    if (auto *owned = source_.owned()) owned->set_warmup_ms(airiq::POLLUTANT_VOC, ms);
   }
   void set_voc_stale_ms(uint32_t ms) {
-    pollutants_.set_stale_ms(airiq::POLLUTANT_VOC, ms);
+    if (auto *owned = source_.owned()) owned->set_stale_ms(airiq::POLLUTANT_VOC, ms);
   }
   void set_nox_warmup_ms(uint32_t ms) {
-    pollutants_.set_warmup_ms(airiq::POLLUTANT_NOX, ms);
+    if (auto *owned = source_.owned()) owned->set_warmup_ms(airiq::POLLUTANT_NOX, ms);
   }
   void set_nox_stale_ms(uint32_t ms) {
-    pollutants_.set_stale_ms(airiq::POLLUTANT_NOX, ms);
+    if (auto *owned = source_.owned()) owned->set_stale_ms(airiq::POLLUTANT_NOX, ms);
   }
 
   // Expected-channel passthrough for a future composition that declares
   // a real external attachment (configuration-driven; no Base/Pro axis).
   void set_pollutant_expected(airiq::Pollutant pollutant, bool expected) {
-    pollutants_.set_expected(pollutant, expected);
+    if (auto *owned = source_.owned()) owned->set_expected(pollutant, expected);
   }
 
   // Customer control: pause shower detection (preserved legacy switch).
@@ -232,7 +395,9 @@ class VentIQEngine {
   // Explicit persistent fault input. RESERVED: no composed component
   // exposes a supported VentIQ fault signal today, so production YAML
   // never sets this. Ordinary staleness NEVER produces Fault.
-  void set_fault(bool fault) { pollutants_.set_fault(fault); }
+  void set_fault(bool fault) {
+    if (auto *owned = source_.owned()) owned->set_fault(fault);
+  }
 
   // --- lifecycle
   // ---------------------------------------------------------------
@@ -240,7 +405,10 @@ class VentIQEngine {
     started_ = true;
     start_ms_ = now_ms;
     last_accum_ms_ = now_ms;
-    pollutants_.begin(now_ms);
+    last_commit_ms_ = now_ms;
+    burst_accounted_ms_ = now_ms;
+    effort_ms_ = now_ms;
+    if (auto *owned = source_.owned()) owned->begin(now_ms);
   }
 
   // --- inputs (real update callbacks — the freshness signal)
@@ -266,11 +434,11 @@ class VentIQEngine {
   // evidence behind VentIQ module health).
   void input_voc(uint32_t now_ms, float index) {
     ensure_started(now_ms);
-    pollutants_.input_voc(now_ms, index);
+    if (auto *owned = source_.owned()) owned->input_voc(now_ms, index);
   }
   void input_nox(uint32_t now_ms, float index) {
     ensure_started(now_ms);
-    pollutants_.input_nox(now_ms, index);
+    if (auto *owned = source_.owned()) owned->input_nox(now_ms, index);
   }
 
   // --- manual customer actions
@@ -285,18 +453,84 @@ class VentIQEngine {
   }
   void reset_shower(uint32_t now_ms) {
     ensure_started(now_ms);
+    // The rise that claimed the shower is acknowledged: the rate restarts
+    // from the samples that follow, so it cannot re-claim at once.
+    clear_rate_window();
     shower_active_ = false;
     clearing_until_ms_ = 0;
     clearing_active_ = false;
     forced_active_ = false;
+    end_burst(true);
   }
   void reset_mould() { wet_ms_ = 0; }
 
+  // --- mould-accumulator persistence -----------------------------------------
+  // Write policy, so flash wear stays bounded whatever the tick rate: a
+  // commit is due when the accumulator differs from the last committed
+  // value AND either its risk level has changed or, at risk 1 or above,
+  // the commit interval has passed since the last commit — never per
+  // evaluation. A dry, idle room never writes, nor does damp that dries
+  // before the first risk level; a clean shutdown commits whatever is
+  // outstanding (mould_dirty()). A reset that is not clean loses at most
+  // one interval of damp time (under-claimed, never invented).
+  void set_mould_commit_interval_ms(uint32_t ms) {
+    if (ms > 0) mould_commit_interval_ms_ = ms;
+  }
+  bool mould_dirty() const { return wet_ms_ != committed_wet_ms_; }
+  bool mould_commit_due(uint32_t now_ms) const {
+    if (!mould_dirty()) return false;
+    if (mould_risk_ != committed_risk_) return true;
+    return mould_risk_ > 0 &&
+           elapsed(last_commit_ms_, now_ms) >= mould_commit_interval_ms_;
+  }
+  // The record to write now; marks it committed.
+  MouldSnapshot commit_mould(uint32_t now_ms, uint32_t epoch_s) {
+    MouldSnapshot snapshot;
+    std::memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.magic = MOULD_SNAPSHOT_MAGIC;
+    snapshot.version = MOULD_SNAPSHOT_VERSION;
+    snapshot.wet_ms = wet_ms_;
+    snapshot.saved_epoch_s = epoch_s;
+    snapshot.checksum = mould_snapshot_checksum(snapshot);
+    committed_wet_ms_ = wet_ms_;
+    committed_risk_ = mould_risk_;
+    last_commit_ms_ = now_ms;
+    return snapshot;
+  }
+
+  // Restores a committed accumulator after a reboot, before the first fresh
+  // humidity sample is evaluated (afterwards the live accumulator stands:
+  // refused). Elapsed-time honesty: the time the device was down is never
+  // counted as damp time — the restored value is frozen, like any data
+  // gap, until fresh humidity continues it or (below the threshold) resets
+  // it. When both the record and epoch_s carry the wall clock, a gap longer
+  // than max_gap_s, or a clock that went backwards, discards the record:
+  // the spell it belonged to cannot be assumed unbroken. With either clock
+  // unknown the gap is unknown and the record is kept. Returns whether the
+  // accumulator was restored; call evaluate() afterwards.
+  bool restore_mould(uint32_t now_ms, const MouldSnapshot &snapshot, uint32_t epoch_s,
+                     uint32_t max_gap_s) {
+    ensure_started(now_ms);
+    if (mould_observed_ || !mould_snapshot_valid(snapshot)) return false;
+    if (snapshot.saved_epoch_s != 0 && epoch_s != 0 &&
+        (epoch_s < snapshot.saved_epoch_s ||
+         epoch_s - snapshot.saved_epoch_s > max_gap_s))
+      return false;
+    wet_ms_ = snapshot.wet_ms;
+    committed_wet_ms_ = wet_ms_;
+    update_mould_risk();
+    committed_risk_ = mould_risk_;
+    last_commit_ms_ = now_ms;
+    return true;
+  }
+
   // --- evaluation
   // ------------------------------------------------------------------
   void evaluate(uint32_t now_ms) {
     ensure_started(now_ms);
-    pollutants_.evaluate(now_ms);
+    // A shared engine is evaluated by its owner; this reads its last
+    // evaluation.
+    if (auto *owned = source_.owned()) owned->evaluate(now_ms);
 
     humidity_state_ = channel_state(now_ms, humidity_seen_, humidity_last_ms_,
                                     humidity_warmup_ms_, humidity_stale_ms_);
@@ -307,10 +541,12 @@ class VentIQEngine {
     update_rate();
     update_shower(now_ms);
     update_clearing(now_ms);
+    update_burst(now_ms);
     update_mould(now_ms);
     update_humidity_high();
     update_forced(now_ms);
     update_demand();
+    update_effort(now_ms);
   }
 
   // --- value outputs (NAN unless the channel is fresh)
@@ -321,8 +557,8 @@ class VentIQEngine {
   float temperature() const {
     return temperature_state_ == CHANNEL_FRESH ? temperature_ : NAN;
   }
-  float voc() const { return pollutants_.voc(); }
-  float nox() const { return pollutants_.nox(); }
+  float voc() const { return pollutants().voc(); }
+  float nox() const { return pollutants().nox(); }
 
   // Dew point (Magnus formula) from the canonical calibrated inputs;
   // unknown (never frozen) when either input is not fresh.
@@ -336,9 +572,10 @@ class VentIQEngine {
     return (b * alpha) / (a - alpha);
   }
 
-  // Humidity rate of rise (%/min) over the recent sample window; NAN
-  // until two sufficiently spaced samples exist or when humidity is not
-  // fresh.
+  // Humidity rate of rise (%/min): the least-squares slope of the samples
+  // in the recent window (2 min back from the newest sample — all of them
+  // at cadences down to 5 s); NAN until they span at least 20 s or when
+  // humidity is not fresh.
   float humidity_rate() const {
     return humidity_state_ == CHANNEL_FRESH ? rate_pct_per_min_ : NAN;
   }
@@ -346,10 +583,10 @@ class VentIQEngine {
   bool humidity_fresh() const { return humidity_state_ == CHANNEL_FRESH; }
   bool temperature_fresh() const { return temperature_state_ == CHANNEL_FRESH; }
   bool voc_fresh() const {
-    return pollutants_.pollutant_fresh(airiq::POLLUTANT_VOC);
+    return pollutants().pollutant_fresh(airiq::POLLUTANT_VOC);
   }
   bool nox_fresh() const {
-    return pollutants_.pollutant_fresh(airiq::POLLUTANT_NOX);
+    return pollutants().pollutant_fresh(airiq::POLLUTANT_NOX);
   }
 
   float humidity_data_age_s(uint32_t now_ms) const {
@@ -357,40 +594,84 @@ class VentIQEngine {
     return elapsed(humidity_last_ms_, now_ms) / 1000.0f;
   }
   float voc_data_age_s(uint32_t now_ms) const {
-    return pollutants_.pollutant_data_age_s(airiq::POLLUTANT_VOC, now_ms);
+    return pollutants().pollutant_data_age_s(airiq::POLLUTANT_VOC, now_ms);
   }
 
   // --- state outputs
   // -------------------------------------------------------------------
   bool shower_active() const { return shower_active_; }
   float clearing_minutes_remaining() const { return clearing_remaining_min_; }
+
+  // Humidity sample interval the shower state currently warrants: burst
+  // from a pre-trigger (rate or absolute humidity approaching the shower
+  // start) until the shower is claimed — bounded by the burst maximum —
+  // and on through the shower and its clearing window; normal otherwise,
+  // and whenever humidity is not fresh or shower detection is paused. A
+  // burst that ends without a claim (or by a manual shower reset) re-arms
+  // only once the pre-trigger has cleared, so a bathroom that stays humid
+  // never polls fast indefinitely.
+  uint32_t humidity_sample_interval_ms() const {
+    return burst_active_ ? humidity_burst_ms_ : humidity_normal_ms_;
+  }
+  bool humidity_burst_active() const { return burst_active_; }
+  // Share of time spent in burst (%), averaged with a one-day exponential
+  // memory — since start-up for the first day. With the two intervals it
+  // gives the extra I2C reads the burst costs.
+  float humidity_burst_duty_pct() const {
+    return burst_weight_ms_ > 0.0f ? 100.0f * burst_time_ms_ / burst_weight_ms_ : 0.0f;
+  }
   int mould_risk() const { return mould_risk_; }
+  // Damp time accumulated in the current spell (ms) — what is persisted.
+  uint32_t mould_wet_ms() const { return wet_ms_; }
   bool mould_warning() const { return mould_risk_ >= 2; }
   bool odour() const {
     return (voc_fresh() &&
-            pollutants_.severity(airiq::POLLUTANT_VOC) >=
+            pollutants().severity(airiq::POLLUTANT_VOC) >=
                 airiq::SEVERITY_FAIR &&
-            pollutants_.severity(airiq::POLLUTANT_VOC) <=
+            pollutants().severity(airiq::POLLUTANT_VOC) <=
                 airiq::SEVERITY_VERY_POOR) ||
            (nox_fresh() &&
-            pollutants_.severity(airiq::POLLUTANT_NOX) >=
+            pollutants().severity(airiq::POLLUTANT_NOX) >=
                 airiq::SEVERITY_FAIR &&
-            pollutants_.severity(airiq::POLLUTANT_NOX) <=
+            pollutants().severity(airiq::POLLUTANT_NOX) <=
                 airiq::SEVERITY_VERY_POOR);
   }
-  airiq::AirQuality air_quality() const { return pollutants_.air_quality(); }
+  airiq::AirQuality air_quality() const { return pollutants().air_quality(); }
   Demand demand() const { return demand_; }
   Reason reason() const { return reason_; }
   bool ventilation_needed() const {
     return demand_ == DEMAND_SOON || demand_ == DEMAND_NOW;
   }
+  // Legacy stepped fan percent (0/30/50/70/100 by demand step) — kept as
+  // the compatibility view; variable-speed outputs use the effort below.
   int fan_percent() const { return fan_percent_; }
 
+  // Continuous ventilation effort (%): 0, or from the running floor to 100.
+  // It follows the driver-scaled target within the slew limits, holds the
+  // floor until the minimum on-time has run, and jumps to 100 for a
+  // manual request. The target is the strongest driver:
+  //   * manual request, shower (the humidity rate acts through the shower
+  //     claim — extracting ahead of it would flatten the very rise the
+  //     detector keys on): 100;
+  //   * clearing: from 100 down to 30 as the window runs out — or as high
+  //     as the humidity excess still warrants;
+  //   * damp (risk medium/high): 50 rising to 100 with the damp time;
+  //   * high humidity: 20 rising to 80 with the excess over the
+  //     high-humidity threshold towards the shower threshold;
+  //   * VOC/NOx at Fair or worse: 30 rising to 100 with the AirIQ
+  //     severity progress (Fair -> Very poor); a Poor / Very poor headline
+  //     at least 50 / 100.
+  // PROVISIONAL engineering shaping pending bench validation.
+  float ventilation_effort_pct() const { return effort_pct_; }
+  float ventilation_effort_target_pct() const { return effort_target_pct_; }
+
   // VentIQ module health: the embedded canonical engine over the
-  // board's own verifiable channels (SGP41 VOC/NOx) ONLY. The
-  // RoomIQ-owned humidity/temperature inputs NEVER participate — their
-  // loss degrades the ventilation service, not this module.
-  airiq::Health health() const { return pollutants_.health(); }
+  // board's own verifiable channels (SGP41 VOC/NOx) ONLY — or, bound to a
+  // shared engine, that engine's health over the channels its owner
+  // expects. The RoomIQ-owned humidity/temperature inputs NEVER
+  // participate — their loss degrades the ventilation service, not this
+  // module.
+  airiq::Health health() const { return pollutants().health(); }
 
   // --- legacy compatibility strings (semantic upgrade — documented)
   // --------------------- Drive the preserved pre-framework text entities from
@@ -431,17 +712,17 @@ class VentIQEngine {
     airiq::Severity worst = airiq::SEVERITY_INITIALISING;
     bool any_fresh = false;
     if (voc_fresh()) {
-      worst = pollutants_.severity(airiq::POLLUTANT_VOC);
+      worst = pollutants().severity(airiq::POLLUTANT_VOC);
       any_fresh = true;
     }
     if (nox_fresh()) {
       const airiq::Severity nox_severity =
-          pollutants_.severity(airiq::POLLUTANT_NOX);
+          pollutants().severity(airiq::POLLUTANT_NOX);
       if (!any_fresh || nox_severity > worst) worst = nox_severity;
       any_fresh = true;
     }
     if (!any_fresh) {
-      return pollutants_.air_quality() == airiq::AIR_QUALITY_INITIALISING
+      return pollutants().air_quality() == airiq::AIR_QUALITY_INITIALISING
                  ? "Waiting for sensor..."
                  : "Unavailable";
     }
@@ -486,44 +767,78 @@ class VentIQEngine {
                                                 : CHANNEL_MISSING;
   }
 
-  // Recent humidity samples for the rate-of-rise calculation.
+  // Recent humidity samples for the rate-of-rise calculation. The samples
+  // within RATE_WINDOW_MS of the newest one are held as running
+  // least-squares sums: a push adds the sample and removes whatever it
+  // pushed out of the window (by age, or by overwriting its ring slot).
+  // Times are ms from the oldest windowed sample and values are
+  // milli-%RH, both integers, so adding and removing are exact — the sums
+  // never drift however long the engine runs.
   void push_humidity_sample(uint32_t now_ms, float pct) {
+    if (window_count_ == SAMPLE_SLOTS)
+      drop_oldest_windowed();  // its ring slot is about to be reused
+    const int32_t milli = static_cast<int32_t>(std::lround(pct * 1000.0f));
     sample_t_[sample_head_] = now_ms;
-    sample_v_[sample_head_] = pct;
+    sample_v_[sample_head_] = milli;
     sample_head_ = (sample_head_ + 1) % SAMPLE_SLOTS;
-    if (sample_count_ < SAMPLE_SLOTS) sample_count_++;
+    if (window_count_ == 0) origin_ms_ = now_ms;
+    add_windowed(elapsed(origin_ms_, now_ms), milli, 1);
+    window_count_++;
+    while (window_count_ > 1 &&
+           elapsed(sample_t_[oldest_windowed()], now_ms) > RATE_WINDOW_MS) {
+      drop_oldest_windowed();
+    }
+  }
+
+  void clear_rate_window() {
+    window_count_ = 0;
+    sum_n_ = sum_t_ = sum_v_ = sum_tt_ = sum_tv_ = 0;
   }
 
+  int oldest_windowed() const {
+    return (sample_head_ + SAMPLE_SLOTS - window_count_) % SAMPLE_SLOTS;
+  }
+
+  void add_windowed(int64_t t, int64_t v, int sign) {
+    sum_n_ += sign;
+    sum_t_ += sign * t;
+    sum_v_ += sign * v;
+    sum_tt_ += sign * t * t;
+    sum_tv_ += sign * t * v;
+  }
+
+  // Removes the oldest windowed sample, then re-bases the time origin on
+  // the new oldest one (exact: t' = t - d).
+  void drop_oldest_windowed() {
+    const int idx = oldest_windowed();
+    add_windowed(elapsed(origin_ms_, sample_t_[idx]), sample_v_[idx], -1);
+    window_count_--;
+    if (window_count_ == 0) return;
+    const uint32_t next = sample_t_[oldest_windowed()];
+    const int64_t d = elapsed(origin_ms_, next);
+    sum_tt_ += -2 * d * sum_t_ + d * d * sum_n_;
+    sum_tv_ -= d * sum_v_;
+    sum_t_ -= d * sum_n_;
+    origin_ms_ = next;
+  }
+
+  // Least-squares slope over the windowed samples — every sample counts,
+  // so one quantisation step at either end no longer swings the rate.
+  // O(1): the sums are already current.
   void update_rate() {
-    if (humidity_state_ != CHANNEL_FRESH || sample_count_ < 2) {
+    if (humidity_state_ != CHANNEL_FRESH || window_count_ < 2) {
       rate_pct_per_min_ = NAN;
       return;
     }
-    // Compare the newest sample against the OLDEST retained sample that
-    // is still inside the rate window and at least MIN_SPAN old —
-    // deterministic and robust against sample-cadence jitter.
     const int newest = (sample_head_ + SAMPLE_SLOTS - 1) % SAMPLE_SLOTS;
-    const uint32_t t_new = sample_t_[newest];
-    const float v_new = sample_v_[newest];
-    bool found = false;
-    uint32_t t_ref = 0;
-    float v_ref = 0.0f;
-    for (int i = 1; i < sample_count_; i++) {
-      const int idx = (newest + SAMPLE_SLOTS - i) % SAMPLE_SLOTS;
-      const uint32_t age = elapsed(sample_t_[idx], t_new);
-      if (age > RATE_WINDOW_MS) break;
-      if (age >= RATE_MIN_SPAN_MS) {
-        t_ref = sample_t_[idx];
-        v_ref = sample_v_[idx];
-        found = true;  // keep going: the oldest in-window sample wins
-      }
-    }
-    if (!found) {
+    if (elapsed(origin_ms_, sample_t_[newest]) < RATE_MIN_SPAN_MS) {
       rate_pct_per_min_ = NAN;
       return;
     }
-    const float span_min = elapsed(t_ref, t_new) / 60000.0f;
-    rate_pct_per_min_ = (v_new - v_ref) / span_min;
+    const int64_t num = sum_n_ * sum_tv_ - sum_t_ * sum_v_;
+    const int64_t den = sum_n_ * sum_tt_ - sum_t_ * sum_t_;
+    // milli-%RH per ms -> %RH per minute.
+    rate_pct_per_min_ = 60.0f * static_cast<float>(num) / static_cast<float>(den);
   }
 
   void update_shower(uint32_t now_ms) {
@@ -579,18 +894,72 @@ class VentIQEngine {
     }
   }
 
+  void update_burst(uint32_t now_ms) {
+    // Duty: the interval since the previous evaluate ran in the mode that
+    // was in force during it.
+    const uint32_t dt = elapsed(burst_accounted_ms_, now_ms);
+    burst_accounted_ms_ = now_ms;
+    if (dt > 0) {
+      const float keep = std::exp(-static_cast<float>(dt) / BURST_DUTY_MEMORY_MS);
+      burst_time_ms_ = burst_time_ms_ * keep + (burst_active_ ? dt : 0.0f);
+      burst_weight_ms_ = burst_weight_ms_ * keep + dt;
+    }
+
+    if (!shower_detection_enabled_ || humidity_state_ != CHANNEL_FRESH) {
+      burst_active_ = false;
+      return;
+    }
+    if (!burst_pre_trigger()) burst_armed_ = true;
+    if (shower_active_ || clearing_active_) {
+      if (!burst_active_) burst_start_ms_ = now_ms;
+      burst_active_ = true;
+      burst_claimed_ = true;
+      return;
+    }
+    if (burst_active_) {
+      // A claimed burst ends with the clearing window; an unclaimed one at
+      // its bound.
+      if (burst_claimed_ ||
+          elapsed(burst_start_ms_, now_ms) >=
+              (uint32_t)(burst_max_minutes_ * 60000.0f))
+        end_burst(burst_pre_trigger());
+      return;
+    }
+    if (burst_armed_ && burst_pre_trigger()) {
+      burst_active_ = true;
+      burst_claimed_ = false;
+      burst_start_ms_ = now_ms;
+    }
+  }
+
+  bool burst_pre_trigger() const {
+    return (!std::isnan(rate_pct_per_min_) && rate_pct_per_min_ >= burst_pre_rate_) ||
+           humidity_ >= shower_threshold_pct_ - burst_pre_margin_pct_;
+  }
+
+  void end_burst(bool disarm) {
+    burst_active_ = false;
+    burst_claimed_ = false;
+    if (disarm) burst_armed_ = false;
+  }
+
   void update_mould(uint32_t now_ms) {
     // Honest accumulation: only fresh humidity evidence moves the
     // accumulator (in either direction). No data = frozen, no claim.
     const uint32_t dt = elapsed(last_accum_ms_, now_ms);
     last_accum_ms_ = now_ms;
     if (humidity_state_ == CHANNEL_FRESH) {
+      mould_observed_ = true;
       if (humidity_ >= mould_threshold_pct_) {
         wet_ms_ += dt;
       } else {
         wet_ms_ = 0;
       }
     }
+    update_mould_risk();
+  }
+
+  void update_mould_risk() {
     const float dur_ms = mould_duration_minutes_ * 60000.0f;
     if (wet_ms_ >= (uint32_t)(2.0f * dur_ms)) {
       mould_risk_ = 3;
@@ -629,7 +998,7 @@ class VentIQEngine {
       fan_percent_ = 100;
       return;
     }
-    const airiq::AirQuality aq = pollutants_.air_quality();
+    const airiq::AirQuality aq = pollutants().air_quality();
     const bool aq_usable =
         aq == airiq::AIR_QUALITY_GOOD || aq == airiq::AIR_QUALITY_FAIR ||
         aq == airiq::AIR_QUALITY_POOR || aq == airiq::AIR_QUALITY_VERY_POOR;
@@ -700,9 +1069,77 @@ class VentIQEngine {
     reason_ = reason;
   }
 
-  // The embedded canonical pollutant engine (single source of VOC/NOx
-  // severity truth — see the header notes above).
-  airiq::AirIQEngine pollutants_;
+  static float clamp01(float value) {
+    return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+  }
+
+  // Humidity excess over the high-humidity threshold as a fraction of the
+  // way to the shower threshold (0 when humidity is not fresh).
+  float humidity_excess() const {
+    if (humidity_state_ != CHANNEL_FRESH) return 0.0f;
+    const float span = shower_threshold_pct_ - humidity_high_pct_;
+    if (!(span > 0.0f)) return humidity_ >= humidity_high_pct_ ? 1.0f : 0.0f;
+    return clamp01((humidity_ - humidity_high_pct_) / span);
+  }
+
+  float effort_target() const {
+    if (forced_active_ || shower_active_) return 100.0f;
+    float target = 0.0f;
+    if (clearing_active_) {
+      const float left =
+          clearing_minutes_ > 0.0f ? clearing_remaining_min_ / clearing_minutes_ : 0.0f;
+      target = std::fmax(target, 30.0f + 70.0f * std::fmax(clamp01(left), humidity_excess()));
+    }
+    if (mould_risk_ >= 2) {
+      const float dur_ms = mould_duration_minutes_ * 60000.0f;
+      target = std::fmax(target, 50.0f + 50.0f * clamp01((wet_ms_ - dur_ms) / dur_ms));
+    }
+    if (humidity_high_) target = std::fmax(target, 20.0f + 60.0f * humidity_excess());
+    const airiq::Pollutant odour_channels[2] = {airiq::POLLUTANT_VOC, airiq::POLLUTANT_NOX};
+    for (airiq::Pollutant pollutant : odour_channels) {
+      const airiq::Severity severity = pollutants().severity(pollutant);
+      if (!pollutants().pollutant_fresh(pollutant) || severity < airiq::SEVERITY_FAIR ||
+          severity > airiq::SEVERITY_VERY_POOR)
+        continue;
+      target = std::fmax(target, 30.0f + 70.0f * pollutants().severity_progress(pollutant));
+    }
+    const airiq::AirQuality aq = pollutants().air_quality();
+    if (aq == airiq::AIR_QUALITY_VERY_POOR) target = 100.0f;
+    if (aq == airiq::AIR_QUALITY_POOR) target = std::fmax(target, 50.0f);
+    return target;
+  }
+
+  void update_effort(uint32_t now_ms) {
+    const float dt_min = elapsed(effort_ms_, now_ms) / 60000.0f;
+    effort_ms_ = now_ms;
+    effort_target_pct_ = effort_target();
+    float next;
+    if (forced_active_) {
+      next = 100.0f;  // the customer asked: at once
+    } else if (effort_target_pct_ > effort_pct_) {
+      next = std::fmin(effort_target_pct_, effort_pct_ + effort_up_pct_per_min_ * dt_min);
+    } else {
+      next = std::fmax(effort_target_pct_, effort_pct_ - effort_down_pct_per_min_ * dt_min);
+    }
+    if (next < effort_floor_pct_) {
+      // Never between 0 and the floor: run at the floor while wanted or
+      // until the minimum on-time has run, then stop.
+      const bool hold = effort_pct_ > 0.0f &&
+                        elapsed(effort_on_ms_, now_ms) <
+                            (uint32_t)(effort_min_on_minutes_ * 60000.0f);
+      next = effort_target_pct_ > 0.0f || hold ? effort_floor_pct_ : 0.0f;
+    }
+    if (effort_pct_ == 0.0f && next > 0.0f) effort_on_ms_ = now_ms;
+    effort_pct_ = next;
+  }
+
+  const typename Pollutants::Engine &pollutants() const {
+    return source_.engine();
+  }
+
+  // The canonical pollutant engine (single source of VOC/NOx severity
+  // truth — see the header notes above): embedded, or the bound shared one.
+  Pollutants source_;
 
   // ventilation heuristics (PROVISIONAL defaults; substitution/number-driven)
   float shower_threshold_pct_ = 75.0f;
@@ -735,14 +1172,20 @@ class VentIQEngine {
   uint32_t temperature_last_ms_ = 0;
   int temperature_state_ = CHANNEL_INIT;
 
-  // humidity rate-of-rise window
-  static const int SAMPLE_SLOTS = 12;
-  static const uint32_t RATE_WINDOW_MS = 180000;   // consider samples <= 3 min
+  // humidity rate-of-rise window: the ring holds every sample of the
+  // window at the fastest cadence it is sized for (5 s, the burst
+  // interval); samples arriving faster leave only the newest SAMPLE_SLOTS
+  // in the fit.
+  static const uint32_t RATE_WINDOW_MS = 120000;   // consider samples <= 2 min
   static const uint32_t RATE_MIN_SPAN_MS = 20000;  // need >= 20 s of span
+  static const uint32_t RATE_MIN_INTERVAL_MS = 5000;
+  static const int SAMPLE_SLOTS = RATE_WINDOW_MS / RATE_MIN_INTERVAL_MS + 1;  // 25
   uint32_t sample_t_[SAMPLE_SLOTS] = {};
-  float sample_v_[SAMPLE_SLOTS] = {};
+  int32_t sample_v_[SAMPLE_SLOTS] = {};  // milli-%RH
   int sample_head_ = 0;
-  int sample_count_ = 0;
+  int window_count_ = 0;  // newest samples inside the window (in the sums)
+  uint32_t origin_ms_ = 0;
+  int64_t sum_n_ = 0, sum_t_ = 0, sum_v_ = 0, sum_tt_ = 0, sum_tv_ = 0;
   float rate_pct_per_min_ = NAN;
 
   // shower / clearing state
@@ -754,10 +1197,33 @@ class VentIQEngine {
   bool clearing_active_ = false;
   float clearing_remaining_min_ = 0.0f;
 
+  // shower-onset burst sampling (the 30 s RoomIQ climate cadence is
+  // "normal"; provisional)
+  static constexpr float BURST_DUTY_MEMORY_MS = 86400000.0f;  // one day
+  uint32_t humidity_burst_ms_ = 5000;
+  uint32_t humidity_normal_ms_ = 30000;
+  float burst_pre_rate_ = 2.5f;        // %/min, half the shower rate
+  float burst_pre_margin_pct_ = 10.0f;  // below the shower threshold
+  float burst_max_minutes_ = 5.0f;
+  bool burst_active_ = false;
+  bool burst_armed_ = true;
+  bool burst_claimed_ = false;  // the shower (or its clearing) took it over
+  uint32_t burst_start_ms_ = 0;
+  uint32_t burst_accounted_ms_ = 0;
+  float burst_time_ms_ = 0.0f;    // decayed time in burst
+  float burst_weight_ms_ = 0.0f;  // decayed time observed
+
   // damp / mould accumulation
   uint32_t wet_ms_ = 0;
   uint32_t last_accum_ms_ = 0;
   int mould_risk_ = 0;
+  bool mould_observed_ = false;  // fresh humidity has moved the accumulator
+
+  // damp accumulator persistence (write policy; the glue owns the flash)
+  uint32_t mould_commit_interval_ms_ = 3600000;  // one hour
+  uint32_t committed_wet_ms_ = 0;
+  int committed_risk_ = 0;
+  uint32_t last_commit_ms_ = 0;
 
   // humidity-high advice state (with release hysteresis)
   bool humidity_high_ = false;
@@ -770,16 +1236,55 @@ class VentIQEngine {
   Demand demand_ = DEMAND_INITIALISING;
   Reason reason_ = REASON_INITIALISING;
   int fan_percent_ = 0;
+
+  // continuous ventilation effort (PROVISIONAL shaping)
+  float effort_up_pct_per_min_ = 120.0f;   // 0 -> 100 in 50 s
+  float effort_down_pct_per_min_ = 20.0f;  // 100 -> 0 over 5 min
+  float effort_min_on_minutes_ = 3.0f;
+  float effort_floor_pct_ = 20.0f;
+  float effort_pct_ = 0.0f;
+  float effort_target_pct_ = 0.0f;
+  uint32_t effort_ms_ = 0;
+  uint32_t effort_on_ms_ = 0;
 };
 
+template <class Pollutants>
+const int BasicVentIQEngine<Pollutants>::SAMPLE_SLOTS;
+template <class Pollutants>
+const uint32_t BasicVentIQEngine<Pollutants>::RATE_WINDOW_MS;
+template <class Pollutants>
+const uint32_t BasicVentIQEngine<Pollutants>::RATE_MIN_SPAN_MS;
+template <class Pollutants>
+const uint32_t BasicVentIQEngine<Pollutants>::RATE_MIN_INTERVAL_MS;
+template <class Pollutants>
+constexpr float BasicVentIQEngine<Pollutants>::BURST_DUTY_MEMORY_MS;
+
+// The engine every composition instantiates unless it shares AirIQ's.
+typedef BasicVentIQEngine<EmbeddedPollutants> VentIQEngine;
+
+// The firmware composition's engine. The sense360_ventiq codegen passes
+// SENSE360_VENTIQ_SHARED_AIRIQ as a build flag when the composition binds
+// VentIQ to the AirIQ engine (every translation unit sees the same value,
+// so global_engine() has one type per firmware).
+#ifdef SENSE360_VENTIQ_SHARED_AIRIQ
+typedef BasicVentIQEngine<SharedPollutants<airiq::FirmwareAirIQEngine> >
+    FirmwareVentIQEngine;
+#else
+typedef VentIQEngine FirmwareVentIQEngine;
+#endif
+
 // Accessor for the firmware's single engine instance. ESPHome emits
 // `esphome: includes:` headers AFTER the globals storage declarations in
 // the generated main.cpp, so a custom-class `globals:` entry cannot name
 // this type; production lambdas share this function-local static instead
 // (constructed on first use). Tests instantiate their own VentIQEngine
 // objects directly.
-inline VentIQEngine &global_engine() {
-  static VentIQEngine engine;
+inline FirmwareVentIQEngine &global_engine() {
+#ifdef SENSE360_VENTIQ_SHARED_AIRIQ
+  static FirmwareVentIQEngine engine(airiq::global_engine());
+#else
+  static FirmwareVentIQEngine engine;
+#endif
   return engine;
 }
 
@@ -8,14 +8,43 @@ pollutant truth) as a real ESPHome component, per
 ``docs/architecture/sense360-airiq-ventiq-component-plan.md``. It owns what
 used to be YAML glue in ``packages/features/airiq_framework.yaml``: input
 feeding from the fitted base sensors (CO2 / VOC / NOx / HCHO), the
-expected-sensor and freshness/threshold configuration, the 10 s tick and
-the publish switchboard (fresh engine values on input, NAN on stale —
-a stale reading is never left standing as if it were live).
+expected-sensor and freshness/threshold configuration, the deadline-driven
+evaluation timer (one-shot, armed for the engine's next warm-up / stale
+expiry instead of a fixed 10 s tick) and the publish switchboard (fresh
+engine values on input, NAN on stale — a stale reading is never left
+standing as if it were live).
 
-The PM path stays externally fed: the opt-in SPS30 overlay
-(``packages/boards/s360-210-airiq-sps30.yaml``) feeds the engine's PM
-channels directly and re-evaluates through the framework's same-id bridge
-script; this component owns the PM entities' NAN-on-stale half only.
+Source callbacks are staged into one ``AirIQFrame`` and committed by a
+single deferred flush (``input_frame``): the values one sensor read
+publishes in the same loop pass — the four PM fractions of an SPS30
+measurement — commit atomically and cost one evaluation. The PM sources
+are optional and bound only by the opt-in SPS30 overlay
+(``packages/boards/s360-210-airiq-sps30.yaml``).
+
+Optional ``statistic`` sensors publish rolling 1 h / 8 h / 24 h mean, min,
+max or 95th-percentile views of one pollutant once a minute. The engine
+keeps fixed bucket aggregates only for the pollutants a statistic names, so
+a composition without one pays nothing. Every statistic, exposure and
+time_to_poor sensor must name a channel the composition sources or expects.
+
+Optional ``exposure`` sensors publish the on-device time-weighted exposure
+of one pollutant since local midnight (``time_id``; since boot without
+one): the dose above the pollutant's Poor threshold, the time-weighted
+average or the covered hours — or the rolling 8-hour TWA, which the daily
+reset leaves alone. Stale time contributes nothing, under the same
+freshness rule as severity.
+
+``early_ventilate`` (off by default) makes the recommendation predictive:
+a fresh CO2 / VOC / NOx reading whose online trend reaches Poor within
+``early_ventilate_horizon`` recommends "Ventilate soon" while the headline
+is still Good or Fair. Optional ``time_to_poor`` sensors expose the
+prediction.
+
+Every severity, headline and recommendation change is recorded in the
+engine's fixed transition journal (``journal_size`` entries of 8 bytes)
+and exported line by line to the optional ``transition_journal`` text
+sensor and the log. Without an explicit ``journal_size`` the journal holds
+32 entries when that text sensor is composed and is left out otherwise.
 
 The pollutant model (severity, hysteresis, headline, recommendation,
 module health) stays in the natively tested engine header — glue only, no
@@ -26,8 +55,9 @@ values.
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor, text_sensor
-from esphome.const import CONF_ID
+from esphome.components import sensor, text_sensor, time
+from esphome.const import CONF_ID, CONF_PLATFORM, CONF_TIME_ID, CONF_TYPE
+from esphome.core import CORE
 
 CODEOWNERS = ["@sense360store"]
 AUTO_LOAD = ["sense360", "sensor", "text_sensor"]
@@ -39,6 +69,10 @@ CONF_CO2_SOURCE = "co2_source"
 CONF_VOC_SOURCE = "voc_source"
 CONF_NOX_SOURCE = "nox_source"
 CONF_HCHO_SOURCE = "hcho_source"
+CONF_PM2_5_SOURCE = "pm2_5_source"
+CONF_PM1_SOURCE = "pm1_source"
+CONF_PM4_SOURCE = "pm4_source"
+CONF_PM10_SOURCE = "pm10_source"
 CONF_MODULE_STATUS_ID = "module_status_id"
 CONF_LEGACY_AIR_QUALITY_ID = "legacy_air_quality_id"
 
@@ -50,6 +84,12 @@ CONF_EXPECTED_NOX = "expected_nox"
 CONF_EXPECTED_PM = "expected_pm"
 CONF_EXPECTED_HCHO = "expected_hcho"
 CONF_EXPECTED_O3 = "expected_o3"
+CONF_EARLY_VENTILATE = "early_ventilate"
+CONF_EARLY_VENTILATE_HORIZON = "early_ventilate_horizon"
+CONF_JOURNAL_SIZE = "journal_size"
+# The journal size when a transition_journal text sensor is composed and
+# journal_size is not set; without either the engine has no journal.
+DEFAULT_JOURNAL_SIZE = 32
 
 _WINDOW_KEYS = []
 for _p in ("co2", "voc", "nox", "pm"):
@@ -65,14 +105,26 @@ _schema = {
     cv.Optional(CONF_VOC_SOURCE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_NOX_SOURCE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_HCHO_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_PM2_5_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_PM1_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_PM4_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_PM10_SOURCE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_MODULE_STATUS_ID): cv.use_id(text_sensor.TextSensor),
     cv.Optional(CONF_LEGACY_AIR_QUALITY_ID): cv.use_id(text_sensor.TextSensor),
+    cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
     cv.Optional(CONF_EXPECTED_CO2, default=True): cv.boolean,
     cv.Optional(CONF_EXPECTED_VOC, default=True): cv.boolean,
     cv.Optional(CONF_EXPECTED_NOX, default=True): cv.boolean,
     cv.Optional(CONF_EXPECTED_PM, default=False): cv.boolean,
     cv.Optional(CONF_EXPECTED_HCHO, default=True): cv.boolean,
     cv.Optional(CONF_EXPECTED_O3, default=False): cv.boolean,
+    cv.Optional(CONF_EARLY_VENTILATE, default=False): cv.boolean,
+    cv.Optional(
+        CONF_EARLY_VENTILATE_HORIZON, default="10min"
+    ): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_JOURNAL_SIZE): cv.one_of(
+        0, 8, 16, 32, 64, 128, int=True
+    ),
 }
 for _warmup, _stale in _WINDOW_KEYS:
     _schema[cv.Required(_warmup)] = cv.positive_time_period_milliseconds
@@ -85,6 +137,187 @@ for _fair, _poor, _very_poor, _hyst in _THRESHOLD_KEYS.values():
 
 CONFIG_SCHEMA = cv.Schema(_schema).extend(cv.COMPONENT_SCHEMA)
 
+# Engine channel bits (enum Pollutant order in airiq_engine.h). The
+# firmware engine is specialised at compile time to the channels this
+# composition can feed or expects: a channel with no bound source that is
+# not expected carries no storage and no evaluation work.
+_CHANNEL_BITS = {
+    "co2": 1 << 0,
+    "voc": 1 << 1,
+    "nox": 1 << 2,
+    "pm": 1 << 3,
+    "hcho": 1 << 4,
+    "o3": 1 << 5,
+}
+_SOURCE_CHANNELS = (
+    (CONF_CO2_SOURCE, "co2"),
+    (CONF_VOC_SOURCE, "voc"),
+    (CONF_NOX_SOURCE, "nox"),
+    (CONF_HCHO_SOURCE, "hcho"),
+    (CONF_PM2_5_SOURCE, "pm"),
+    (CONF_PM1_SOURCE, "pm"),
+    (CONF_PM4_SOURCE, "pm"),
+    (CONF_PM10_SOURCE, "pm"),
+)
+
+
+def _airiq_channel_mask(config):
+    mask = 0
+    for key, channel in _SOURCE_CHANNELS:
+        if key in config:
+            mask |= _CHANNEL_BITS[channel]
+    for channel, bit in _CHANNEL_BITS.items():
+        if config[f"expected_{channel}"]:
+            mask |= bit
+    # An engine needs at least one pollutant channel; an empty composition
+    # keeps CO2 (it reports Unavailable, exactly as before).
+    return mask or _CHANNEL_BITS["co2"]
+
+
+# Rolling-statistics outputs (sensor platform type ``statistic``). Only the
+# pollutants a configured statistic names keep statistics storage in the
+# engine (see SENSE360_AIRIQ_STATISTICS in airiq_engine.h).
+STATISTIC_POLLUTANTS = {
+    "co2": ("POLLUTANT_CO2", "co2"),
+    "voc": ("POLLUTANT_VOC", "voc"),
+    "nox": ("POLLUTANT_NOX", "nox"),
+    "hcho": ("POLLUTANT_HCHO", "hcho"),
+    "pm2_5": ("POLLUTANT_PM25", "pm"),
+}
+STATISTIC_WINDOWS = {"1h": "WINDOW_1H", "8h": "WINDOW_8H", "24h": "WINDOW_24H"}
+STATISTICS = {
+    "mean": "STATISTIC_MEAN",
+    "min": "STATISTIC_MIN",
+    "max": "STATISTIC_MAX",
+    "p95": "STATISTIC_P95",
+}
+# Exposure outputs (sensor platform type ``exposure``) name the same
+# pollutants.
+EXPOSURE_METRICS = {
+    "dose": "EXPOSURE_DOSE",
+    "twa": "EXPOSURE_TWA",
+    "twa_8h": "EXPOSURE_TWA_8H",
+    "hours": "EXPOSURE_HOURS",
+}
+CONF_POLLUTANT = "pollutant"
+CONF_WINDOW = "window"
+CONF_STATISTIC = "statistic"
+CONF_EXPOSURE = "exposure"
+# Trend outputs (sensor platform type ``time_to_poor``): the
+# ventilation-responsive pollutants only.
+TREND_POLLUTANTS = {
+    "co2": "POLLUTANT_CO2",
+    "voc": "POLLUTANT_VOC",
+    "nox": "POLLUTANT_NOX",
+}
+CONF_TIME_TO_POOR = "time_to_poor"
+
+
+def _airiq_summary_mask(full_config, summary_type):
+    """The pollutants named by this component's sensors of one type."""
+    mask = 0
+    for conf in full_config.get("sensor", []):
+        if conf.get(CONF_PLATFORM) != "sense360_airiq":
+            continue
+        if conf.get(CONF_TYPE) == summary_type:
+            mask |= _CHANNEL_BITS[STATISTIC_POLLUTANTS[conf[CONF_POLLUTANT]][1]]
+    return mask
+
+
+def _final_validate(config):
+    # A summary sensor on a channel the composition neither feeds from a
+    # bound source nor expects would read a channel with no storage.
+    channels = _airiq_channel_mask(config)
+    for conf in CORE.config.get("sensor", []):
+        if conf.get(CONF_PLATFORM) != "sense360_airiq":
+            continue
+        if conf.get(CONF_TYPE) not in (CONF_STATISTIC, CONF_EXPOSURE, CONF_TIME_TO_POOR):
+            continue
+        channel = STATISTIC_POLLUTANTS[conf[CONF_POLLUTANT]][1]
+        if not channels & _CHANNEL_BITS[channel]:
+            raise cv.Invalid(
+                f"{conf[CONF_TYPE]} sensor for {conf[CONF_POLLUTANT]} needs a "
+                f"{channel} source or expected_{channel}: true (an externally "
+                f"fed channel must set expected_{channel} to be stored)"
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+def _airiq_journal_size(config, full_config):
+    """The configured journal size, else the default if it is exported."""
+    if CONF_JOURNAL_SIZE in config:
+        return config[CONF_JOURNAL_SIZE]
+    for conf in full_config.get("text_sensor", []):
+        if (
+            conf.get(CONF_PLATFORM) == "sense360_airiq"
+            and conf.get(CONF_TYPE) == "transition_journal"
+        ):
+            return DEFAULT_JOURNAL_SIZE
+    return 0
+
+
+# Version of the generated configuration. The engine defaults are version
+# 0; a runtime reconfigure must carry a different version to take effect.
+AIRIQ_CONFIG_VERSION = 1
+
+
+def _cpp_bool(value):
+    return "true" if value else "false"
+
+
+def _channel_config(expected, warmup, stale, thresholds):
+    fair, poor, very_poor, hysteresis = (float(v) for v in thresholds)
+    return (
+        f"sense360::airiq::ChannelConfig{{{_cpp_bool(expected)}, "
+        f"{warmup.total_milliseconds}u, {stale.total_milliseconds}u, "
+        f"{fair!r}f, {poor!r}f, {very_poor!r}f, {hysteresis!r}f}}"
+    )
+
+
+def _airiq_config_expression(config):
+    """The complete engine configuration as one constexpr aggregate.
+
+    CO2 / VOC / NOx / PM2.5 carry the substitution-driven windows and
+    thresholds; formaldehyde and ozone carry expectation flags only and keep
+    the engine's own defaults (``default_channel_config``), so no threshold
+    is duplicated here.
+    """
+    channels = []
+    for key, window, threshold in (
+        (CONF_EXPECTED_CO2, "co2", "co2"),
+        (CONF_EXPECTED_VOC, "voc", "voc"),
+        (CONF_EXPECTED_NOX, "nox", "nox"),
+        (CONF_EXPECTED_PM, "pm", "pm25"),
+    ):
+        channels.append(
+            _channel_config(
+                config[key],
+                config[f"{window}_warmup"],
+                config[f"{window}_stale"],
+                [config[k] for k in _THRESHOLD_KEYS[threshold]],
+            )
+        )
+    for key, pollutant in (
+        (CONF_EXPECTED_HCHO, "POLLUTANT_HCHO"),
+        (CONF_EXPECTED_O3, "POLLUTANT_O3"),
+    ):
+        channels.append(
+            f"sense360::airiq::default_channel_config("
+            f"sense360::airiq::{pollutant}).with_expected({_cpp_bool(config[key])})"
+        )
+    early_ventilate_min = 0.0
+    if config[CONF_EARLY_VENTILATE]:
+        early_ventilate_min = (
+            config[CONF_EARLY_VENTILATE_HORIZON].total_milliseconds / 60000.0
+        )
+    return (
+        f"sense360::airiq::AirIQConfig{{{AIRIQ_CONFIG_VERSION}u, "
+        f"{{{', '.join(channels)}}}, {early_ventilate_min!r}f}}"
+    )
+
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -95,52 +328,37 @@ async def to_code(config):
         (CONF_VOC_SOURCE, var.set_voc_source),
         (CONF_NOX_SOURCE, var.set_nox_source),
         (CONF_HCHO_SOURCE, var.set_hcho_source),
+        (CONF_PM2_5_SOURCE, var.set_pm2_5_source),
+        (CONF_PM1_SOURCE, var.set_pm1_source),
+        (CONF_PM4_SOURCE, var.set_pm4_source),
+        (CONF_PM10_SOURCE, var.set_pm10_source),
         (CONF_MODULE_STATUS_ID, var.set_module_status_text_sensor),
         (CONF_LEGACY_AIR_QUALITY_ID, var.set_legacy_air_quality_text_sensor),
+        (CONF_TIME_ID, var.set_time),
     ):
         if key in config:
             bound = await cg.get_variable(config[key])
             cg.add(setter(bound))
 
-    cg.add(
-        var.set_expected(
-            config[CONF_EXPECTED_CO2],
-            config[CONF_EXPECTED_VOC],
-            config[CONF_EXPECTED_NOX],
-            config[CONF_EXPECTED_PM],
-            config[CONF_EXPECTED_HCHO],
-            config[CONF_EXPECTED_O3],
-        )
-    )
-    cg.add(
-        var.set_windows(
-            config["co2_warmup"], config["co2_stale"],
-            config["voc_warmup"], config["voc_stale"],
-            config["nox_warmup"], config["nox_stale"],
-            config["pm_warmup"], config["pm_stale"],
-        )
-    )
-    cg.add(
-        var.set_co2_thresholds(
-            config["co2_fair"], config["co2_poor"],
-            config["co2_very_poor"], config["co2_hysteresis"],
-        )
-    )
-    cg.add(
-        var.set_voc_thresholds(
-            config["voc_fair"], config["voc_poor"],
-            config["voc_very_poor"], config["voc_hysteresis"],
-        )
-    )
-    cg.add(
-        var.set_nox_thresholds(
-            config["nox_fair"], config["nox_poor"],
-            config["nox_very_poor"], config["nox_hysteresis"],
-        )
-    )
-    cg.add(
-        var.set_pm25_thresholds(
-            config["pm25_fair"], config["pm25_poor"],
-            config["pm25_very_poor"], config["pm25_hysteresis"],
+    # A build flag rather than a define: every translation unit that
+    # includes the engine header must agree on global_engine()'s type.
+    channels = _airiq_channel_mask(config)
+    cg.add_build_flag(f"-DSENSE360_AIRIQ_CHANNELS={channels:#04x}")
+    for summary_type, flag in (
+        (CONF_STATISTIC, "SENSE360_AIRIQ_STATISTICS"),
+        (CONF_EXPOSURE, "SENSE360_AIRIQ_EXPOSURE"),
+    ):
+        summaries = _airiq_summary_mask(CORE.config, summary_type)
+        if summaries:
+            cg.add_build_flag(f"-D{flag}={summaries:#04x}")
+    journal = _airiq_journal_size(config, CORE.config)
+    if journal:
+        cg.add_build_flag(f"-DSENSE360_AIRIQ_JOURNAL={journal}")
+
+    cg.add_global(
+        cg.RawStatement(
+            f"static constexpr sense360::airiq::AirIQConfig "
+            f"{config[CONF_ID].id}_config = {_airiq_config_expression(config)};"
         )
     )
+    cg.add(var.set_config(cg.RawExpression(f"&{config[CONF_ID].id}_config")))
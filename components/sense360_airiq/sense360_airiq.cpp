@@ -10,60 +10,102 @@ namespace sense360_airiq {
 
 static const char *const TAG = "sense360_airiq";
 
-// One evaluation clock, one publish owner — the cadence the YAML interval
-// carried.
-static constexpr uint32_t EVALUATE_INTERVAL_MS = 10000;
+// One evaluation owner, one publish owner. Between inputs the only thing
+// that can move an output is time (a warm-up or stale window lapsing), so
+// instead of the former fixed 10 s poll a one-shot timer is armed for
+// exactly the engine's next deadline and re-armed after every evaluation.
+static const char *const EVALUATE_TIMEOUT = "s360_airiq_evaluate";
+// Coalesces the source callbacks of one loop pass into one input frame.
+static const char *const FRAME_DEFER = "s360_airiq_frame";
+// Statistics and exposure publish on a fixed cadence, independent of
+// inputs.
+static const char *const SUMMARY_INTERVAL = "s360_airiq_summaries";
+static const uint32_t SUMMARY_INTERVAL_MS = 60000;
 
 float Sense360AirIQ::get_setup_priority() const { return setup_priority::DATA; }
 
 void Sense360AirIQ::setup() {
   using namespace sense360::airiq;
   auto &engine = global_engine();
+  // Static configuration is applied exactly once; without a generated
+  // configuration the engine keeps its own defaults.
+  if (this->config_ != nullptr)
+    engine.apply_config(*this->config_);
   engine.begin(millis());
 
   // The freshness signal is the real update callback: each fitted base
-  // sensor feeds the engine, re-evaluates, and publishes the engine's
-  // (calibrated) value to the canonical entity while the sample is valid.
-  if (this->co2_source_ != nullptr) {
-    this->co2_source_->add_on_state_callback([this](float x) {
-      auto &e = sense360::airiq::global_engine();
-      e.input_co2(millis(), x);
-      this->evaluate();
-      if (!std::isnan(x) && this->co2_sensor_ != nullptr)
-        this->co2_sensor_->publish_state(e.co2());
-    });
-  }
-  if (this->voc_source_ != nullptr) {
-    this->voc_source_->add_on_state_callback([this](float x) {
-      auto &e = sense360::airiq::global_engine();
-      e.input_voc(millis(), x);
-      this->evaluate();
-      if (!std::isnan(x) && this->voc_sensor_ != nullptr)
-        this->voc_sensor_->publish_state(e.voc());
-    });
-  }
-  if (this->nox_source_ != nullptr) {
-    this->nox_source_->add_on_state_callback([this](float x) {
-      auto &e = sense360::airiq::global_engine();
-      e.input_nox(millis(), x);
-      this->evaluate();
-      if (!std::isnan(x) && this->nox_sensor_ != nullptr)
-        this->nox_sensor_->publish_state(e.nox());
-    });
-  }
-  if (this->hcho_source_ != nullptr) {
-    this->hcho_source_->add_on_state_callback([this](float x) {
-      auto &e = sense360::airiq::global_engine();
-      e.input_hcho(millis(), x);
-      this->evaluate();
-      if (!std::isnan(x) && this->hcho_sensor_ != nullptr)
-        this->hcho_sensor_->publish_state(e.hcho());
-    });
-  }
+  // sensor stages its sample into the pending frame; the deferred flush
+  // commits the frame, re-evaluates once and publishes the engine's
+  // (calibrated) values to the canonical entities.
+  this->bind_source_(this->co2_source_, FRAME_CO2);
+  this->bind_source_(this->voc_source_, FRAME_VOC);
+  this->bind_source_(this->nox_source_, FRAME_NOX);
+  this->bind_source_(this->hcho_source_, FRAME_HCHO);
+  this->bind_source_(this->pm2_5_source_, FRAME_PM2_5);
+  this->bind_source_(this->pm1_source_, FRAME_PM1);
+  this->bind_source_(this->pm4_source_, FRAME_PM4);
+  this->bind_source_(this->pm10_source_, FRAME_PM10);
 
-  this->set_interval("s360_airiq_evaluate", EVALUATE_INTERVAL_MS,
-                     [this]() { this->evaluate(); });
   this->evaluate();
+
+  if (!this->statistic_sensors_.empty() || !this->exposure_sensors_.empty() ||
+      !this->time_to_poor_sensors_.empty())
+    this->set_interval(SUMMARY_INTERVAL, SUMMARY_INTERVAL_MS,
+                       [this]() { this->publish_summaries_(); });
+}
+
+void Sense360AirIQ::bind_source_(sensor::Sensor *source,
+                                 sense360::airiq::FrameField field) {
+  if (source == nullptr)
+    return;
+  source->add_on_state_callback([this, field](float x) {
+    this->pending_frame_.set(field, x);
+    // Re-deferring under the same name replaces the pending flush, so every
+    // callback of one loop pass (e.g. the four values of one SPS30 read)
+    // lands in a single frame.
+    this->defer(FRAME_DEFER, [this]() { this->flush_frame_(); });
+  });
+}
+
+void Sense360AirIQ::flush_frame_() {
+  using namespace sense360::airiq;
+  if (this->pending_frame_.empty())
+    return;
+  auto &engine = global_engine();
+  const uint32_t now = millis();
+  const AirIQFrame frame = this->pending_frame_;
+  this->pending_frame_.clear();
+
+  engine.input_frame(now, frame);
+
+  // Fresh values publish only for the fields this frame actually carried
+  // with a valid sample; the fractions only alongside a valid PM2.5.
+  sensor::Sensor *const targets[FRAME_FIELD_COUNT] = {
+      this->co2_sensor_,   this->voc_sensor_, this->nox_sensor_,
+      this->pm2_5_sensor_, this->hcho_sensor_, nullptr,
+      this->pm1_sensor_,   this->pm4_sensor_, this->pm10_sensor_,
+  };
+  for (int i = 0; i < FRAME_FIELD_COUNT; i++) {
+    const FrameField field = static_cast<FrameField>(i);
+    if (targets[i] == nullptr || !frame.valid(field))
+      continue;
+    const float value = engine.frame_value(field);
+    if (!std::isnan(value))
+      targets[i]->publish_state(value);
+  }
+
+  this->publish_(now);
+}
+
+void Sense360AirIQ::schedule_next_evaluate_(uint32_t now) {
+  const uint32_t delay = sense360::airiq::global_engine().next_deadline_ms(now);
+  if (delay == sense360::airiq::FirmwareAirIQEngine::NO_DEADLINE) {
+    // Nothing can change until a real input arrives (its callback
+    // evaluates and re-arms).
+    this->cancel_timeout(EVALUATE_TIMEOUT);
+    return;
+  }
+  this->set_timeout(EVALUATE_TIMEOUT, delay, [this]() { this->evaluate(); });
 }
 
 void Sense360AirIQ::publish_nan_if_stale_(sense360::airiq::Pollutant pollutant,
@@ -76,52 +118,70 @@ void Sense360AirIQ::publish_nan_if_stale_(sense360::airiq::Pollutant pollutant,
   }
 }
 
-void Sense360AirIQ::publish_changed_(text_sensor::TextSensor *target,
-                                     const std::string &value) {
-  if (target == nullptr)
-    return;
-  if (target->state != value)
+void Sense360AirIQ::publish_text_(text_sensor::TextSensor *target, const char *value) {
+  if (target != nullptr)
     target->publish_state(value);
 }
 
+void Sense360AirIQ::publish_summary_(sensor::Sensor *target, float value) {
+  // An empty window reads NAN (unknown), never a held or zero value.
+  const float current = target->state;
+  if (value == current || (std::isnan(value) && std::isnan(current)))
+    return;
+  target->publish_state(value);
+}
+
+void Sense360AirIQ::check_exposure_reset_() {
+#ifdef USE_TIME
+  if (this->time_ == nullptr)
+    return;
+  const ESPTime clock = this->time_->now();
+  if (!clock.is_valid())
+    return;
+  const sense360::time_utils::Time current(clock.hour, clock.minute);
+  // Called every minute, so consecutive readings are always < 24 h apart.
+  if (this->clock_seen_ &&
+      sense360::time_utils::passed_daily_reset(this->last_clock_, current,
+                                               sense360::time_utils::Time(0, 0))) {
+    sense360::airiq::global_engine().reset_exposure();
+    ESP_LOGD(TAG, "Daily exposure reset");
+  }
+  this->last_clock_ = current;
+  this->clock_seen_ = true;
+#endif
+}
+
+void Sense360AirIQ::publish_summaries_() {
+  auto &engine = sense360::airiq::global_engine();
+  const uint32_t now = millis();
+  for (const auto &output : this->statistic_sensors_) {
+    this->publish_summary_(
+        output.sensor,
+        engine.statistics(output.pollutant, output.window, now).get(output.statistic));
+  }
+  for (const auto &output : this->time_to_poor_sensors_)
+    this->publish_summary_(output.sensor, engine.minutes_until_poor(output.pollutant));
+  if (this->exposure_sensors_.empty())
+    return;
+  this->check_exposure_reset_();
+  for (const auto &output : this->exposure_sensors_) {
+    this->publish_summary_(output.sensor,
+                           engine.exposure(output.pollutant, now).get(output.metric));
+  }
+}
+
 void Sense360AirIQ::evaluate() {
   using namespace sense360::airiq;
   auto &engine = global_engine();
   const uint32_t now = millis();
 
-  // Composition (expected-sensor membership; NO Base/Pro axis).
-  engine.set_expected(POLLUTANT_CO2, this->expected_co2_);
-  engine.set_expected(POLLUTANT_VOC, this->expected_voc_);
-  engine.set_expected(POLLUTANT_NOX, this->expected_nox_);
-  engine.set_expected(POLLUTANT_PM25, this->expected_pm_);
-  engine.set_expected(POLLUTANT_HCHO, this->expected_hcho_);
-  engine.set_expected(POLLUTANT_O3, this->expected_o3_);
-
-  // Per-sensor freshness windows (provisional engineering values).
-  engine.set_warmup_ms(POLLUTANT_CO2, this->co2_warmup_ms_);
-  engine.set_stale_ms(POLLUTANT_CO2, this->co2_stale_ms_);
-  engine.set_warmup_ms(POLLUTANT_VOC, this->voc_warmup_ms_);
-  engine.set_stale_ms(POLLUTANT_VOC, this->voc_stale_ms_);
-  engine.set_warmup_ms(POLLUTANT_NOX, this->nox_warmup_ms_);
-  engine.set_stale_ms(POLLUTANT_NOX, this->nox_stale_ms_);
-  engine.set_warmup_ms(POLLUTANT_PM25, this->pm_warmup_ms_);
-  engine.set_stale_ms(POLLUTANT_PM25, this->pm_stale_ms_);
-
-  // Provisional severity thresholds (centralised contract).
-  engine.set_thresholds(POLLUTANT_CO2, this->co2_thresholds_.fair,
-                        this->co2_thresholds_.poor, this->co2_thresholds_.very_poor);
-  engine.set_hysteresis(POLLUTANT_CO2, this->co2_thresholds_.hysteresis);
-  engine.set_thresholds(POLLUTANT_VOC, this->voc_thresholds_.fair,
-                        this->voc_thresholds_.poor, this->voc_thresholds_.very_poor);
-  engine.set_hysteresis(POLLUTANT_VOC, this->voc_thresholds_.hysteresis);
-  engine.set_thresholds(POLLUTANT_NOX, this->nox_thresholds_.fair,
-                        this->nox_thresholds_.poor, this->nox_thresholds_.very_poor);
-  engine.set_hysteresis(POLLUTANT_NOX, this->nox_thresholds_.hysteresis);
-  engine.set_thresholds(POLLUTANT_PM25, this->pm25_thresholds_.fair,
-                        this->pm25_thresholds_.poor, this->pm25_thresholds_.very_poor);
-  engine.set_hysteresis(POLLUTANT_PM25, this->pm25_thresholds_.hysteresis);
-
   engine.evaluate(now);
+  this->publish_(now);
+}
+
+void Sense360AirIQ::publish_(uint32_t now) {
+  using namespace sense360::airiq;
+  const auto &engine = global_engine();
 
   // Honest numeric outputs: when a channel is no longer fresh its canonical
   // entity goes unknown — a stale reading is never left standing.
@@ -134,56 +194,101 @@ void Sense360AirIQ::evaluate() {
   this->publish_nan_if_stale_(POLLUTANT_PM25, this->pm4_sensor_);
   this->publish_nan_if_stale_(POLLUTANT_PM25, this->pm10_sensor_);
 
-  // Customer state outputs (publish on change only). The legacy entity
-  // carries the same canonical headline (documented semantic upgrade).
-  const std::string headline = air_quality_to_string(engine.air_quality());
-  this->publish_changed_(this->air_quality_text_sensor_, headline);
-  this->publish_changed_(this->legacy_air_quality_text_sensor_, headline);
-  this->publish_changed_(this->recommendation_text_sensor_,
-                         recommendation_to_string(engine.recommendation()));
+  // Text outputs publish on change only, keyed on the enum tuple they
+  // render: an unchanged evaluation formats nothing and allocates nothing.
+  const TextSnapshot text = capture_text(engine);
+  const int changed =
+      this->text_published_ ? text.changes_from(this->published_text_) : TEXT_ALL;
+  this->published_text_ = text;
+  this->text_published_ = true;
+
+  // Customer state outputs. The legacy entity carries the same canonical
+  // headline (documented semantic upgrade).
+  if (changed & TEXT_AIR_QUALITY) {
+    const char *headline = air_quality_to_string(text.air_quality);
+    this->publish_text_(this->air_quality_text_sensor_, headline);
+    this->publish_text_(this->legacy_air_quality_text_sensor_, headline);
+  }
+  if (changed & TEXT_RECOMMENDATION)
+    this->publish_text_(this->recommendation_text_sensor_,
+                        recommendation_to_string(text.recommendation));
 
   // Module health — real freshness evidence driving the Core-Framework
   // reserved runtime vocabulary.
-  this->publish_changed_(this->module_status_text_sensor_,
-                         health_to_string(engine.health()));
+  if (changed & TEXT_HEALTH)
+    this->publish_text_(this->module_status_text_sensor_, health_to_string(text.health));
 
-  // Diagnostics (publish on change only).
-  if (this->state_detail_text_sensor_ != nullptr) {
+  // Diagnostics.
+  if ((changed & TEXT_STATE_DETAIL) && this->state_detail_text_sensor_ != nullptr) {
     char buffer[192];
-    snprintf(buffer, sizeof(buffer), "co2=%s voc=%s nox=%s hcho=%s pm2.5=%s",
-             severity_to_string(engine.severity(POLLUTANT_CO2)),
-             severity_to_string(engine.severity(POLLUTANT_VOC)),
-             severity_to_string(engine.severity(POLLUTANT_NOX)),
-             severity_to_string(engine.severity(POLLUTANT_HCHO)),
-             severity_to_string(engine.severity(POLLUTANT_PM25)));
-    this->publish_changed_(this->state_detail_text_sensor_, std::string(buffer));
+    format_state_detail(buffer, sizeof(buffer), text);
+    this->publish_text_(this->state_detail_text_sensor_, buffer);
   }
-  if (this->recommendation_reason_text_sensor_ != nullptr) {
+  if ((changed & TEXT_RECOMMENDATION_REASON) &&
+      this->recommendation_reason_text_sensor_ != nullptr) {
     char buffer[160];
-    if (engine.worst_pollutant() < POLLUTANT_COUNT) {
-      snprintf(buffer, sizeof(buffer), "worst pollutant: %s (%s) -> %s",
-               pollutant_to_string(engine.worst_pollutant()),
-               severity_to_string(engine.severity(engine.worst_pollutant())),
-               recommendation_to_string(engine.recommendation()));
-    } else {
-      snprintf(buffer, sizeof(buffer), "no pollutant above Good -> %s",
-               recommendation_to_string(engine.recommendation()));
+    format_recommendation_reason(buffer, sizeof(buffer), text);
+    this->publish_text_(this->recommendation_reason_text_sensor_, buffer);
+  }
+  if (this->transition_journal_text_sensor_ != nullptr)
+    this->export_journal();
+
+  this->schedule_next_evaluate_(now);
+}
+
+void Sense360AirIQ::export_journal() {
+  using namespace sense360::airiq;
+  auto &engine = global_engine();
+  if (engine.journal_dropped() > 0)
+    ESP_LOGW(TAG, "Transition journal overflowed: %u entries dropped",
+             (unsigned) engine.journal_dropped());
+  Transition entries[4];
+  int count;
+  while ((count = engine.drain_journal(entries, 4)) > 0) {
+    for (int i = 0; i < count; i++) {
+      char buffer[96];
+      format_transition(buffer, sizeof(buffer), entries[i]);
+      ESP_LOGD(TAG, "Transition %s", buffer);
+      if (this->transition_journal_text_sensor_ != nullptr)
+        this->transition_journal_text_sensor_->publish_state(buffer);
     }
-    this->publish_changed_(this->recommendation_reason_text_sensor_,
-                           std::string(buffer));
   }
 }
 
+void Sense360AirIQ::reconfigure(const sense360::airiq::AirIQConfig *config) {
+  if (config == nullptr)
+    return;
+  if (!sense360::airiq::global_engine().apply_config(*config))
+    return;
+  this->config_ = config;
+  ESP_LOGI(TAG, "Configuration version %u applied", (unsigned) config->version);
+  this->evaluate();
+}
+
 void Sense360AirIQ::dump_config() {
   ESP_LOGCONFIG(TAG, "Sense360 AirIQ (glue over the canonical engine "
                      "singleton; model logic lives in "
                      "components/sense360/airiq_engine.h)");
+  using namespace sense360::airiq;
+  const auto &engine = global_engine();
   ESP_LOGCONFIG(TAG,
                 "  Expected: co2=%s voc=%s nox=%s pm=%s hcho=%s o3=%s "
                 "(composition facts, never hardware autodetection)",
-                YESNO(this->expected_co2_), YESNO(this->expected_voc_),
-                YESNO(this->expected_nox_), YESNO(this->expected_pm_),
-                YESNO(this->expected_hcho_), YESNO(this->expected_o3_));
+                YESNO(engine.expected(POLLUTANT_CO2)), YESNO(engine.expected(POLLUTANT_VOC)),
+                YESNO(engine.expected(POLLUTANT_NOX)), YESNO(engine.expected(POLLUTANT_PM25)),
+                YESNO(engine.expected(POLLUTANT_HCHO)), YESNO(engine.expected(POLLUTANT_O3)));
+  ESP_LOGCONFIG(TAG, "  Configuration version: %u", (unsigned) engine.config_version());
+  ESP_LOGCONFIG(TAG, "  Statistic outputs: %u", (unsigned) this->statistic_sensors_.size());
+  ESP_LOGCONFIG(TAG, "  Transition journal: %u entries (%s)", (unsigned) SENSE360_AIRIQ_JOURNAL,
+                this->transition_journal_text_sensor_ != nullptr ? "exported" : "on demand");
+  ESP_LOGCONFIG(TAG, "  Time-to-Poor outputs: %u", (unsigned) this->time_to_poor_sensors_.size());
+  ESP_LOGCONFIG(TAG, "  Exposure outputs: %u (daily reset: %s)",
+                (unsigned) this->exposure_sensors_.size(),
+#ifdef USE_TIME
+                this->time_ != nullptr ? "local midnight" : "none, since boot");
+#else
+                "none, since boot");
+#endif
 }
 
 }  // namespace sense360_airiq
@@ -12,15 +12,29 @@
 // Publication contract (unchanged from the YAML glue): fresh engine values
 // publish from the input callbacks; a channel that is no longer fresh
 // publishes NAN — a stale reading is never left standing as if it were
-// live. The PM channels are externally fed by the opt-in SPS30 overlay
-// through the framework's bridge script; this component owns their
-// NAN-on-stale half only. Output entity pointers are optional so partial
-// compositions stay valid.
+// live. Source callbacks are staged into one AirIQFrame and committed by a
+// single deferred flush, so the four values of one SPS30 measurement (all
+// published in the same loop pass) cost one evaluation, not four. The PM
+// sources are bound only by the opt-in SPS30 overlay. Output entity
+// pointers are optional so partial compositions stay valid. Rolling
+// statistic and exposure outputs are summaries, not live values: they
+// publish on a fixed one-minute cadence (armed only when any are composed).
+// Exposure restarts at local midnight when a time source is bound.
+// time_to_poor outputs publish the engine's trend-predicted minutes until a
+// ventilation-responsive pollutant reaches Poor on the same cadence.
+// The engine's transition journal is exported line by line to the
+// optional transition journal text sensor (and the log) as it fills.
 // ============================================================================
 
+#include <vector>
+
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/components/sense360/airiq_engine.h"
+#include "esphome/components/sense360/time_utils.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
 #include "esphome/core/component.h"
 
 namespace esphome {
@@ -32,43 +46,20 @@ class Sense360AirIQ : public Component {
   void set_voc_source(sensor::Sensor *s) { voc_source_ = s; }
   void set_nox_source(sensor::Sensor *s) { nox_source_ = s; }
   void set_hcho_source(sensor::Sensor *s) { hcho_source_ = s; }
+  void set_pm2_5_source(sensor::Sensor *s) { pm2_5_source_ = s; }
+  void set_pm1_source(sensor::Sensor *s) { pm1_source_ = s; }
+  void set_pm4_source(sensor::Sensor *s) { pm4_source_ = s; }
+  void set_pm10_source(sensor::Sensor *s) { pm10_source_ = s; }
   void set_module_status_text_sensor(text_sensor::TextSensor *t) { module_status_text_sensor_ = t; }
   void set_legacy_air_quality_text_sensor(text_sensor::TextSensor *t) {
     legacy_air_quality_text_sensor_ = t;
   }
 
-  void set_expected(bool co2, bool voc, bool nox, bool pm, bool hcho, bool o3) {
-    expected_co2_ = co2;
-    expected_voc_ = voc;
-    expected_nox_ = nox;
-    expected_pm_ = pm;
-    expected_hcho_ = hcho;
-    expected_o3_ = o3;
-  }
-  void set_windows(uint32_t co2_warmup, uint32_t co2_stale, uint32_t voc_warmup,
-                   uint32_t voc_stale, uint32_t nox_warmup, uint32_t nox_stale,
-                   uint32_t pm_warmup, uint32_t pm_stale) {
-    co2_warmup_ms_ = co2_warmup;
-    co2_stale_ms_ = co2_stale;
-    voc_warmup_ms_ = voc_warmup;
-    voc_stale_ms_ = voc_stale;
-    nox_warmup_ms_ = nox_warmup;
-    nox_stale_ms_ = nox_stale;
-    pm_warmup_ms_ = pm_warmup;
-    pm_stale_ms_ = pm_stale;
-  }
-  void set_co2_thresholds(float fair, float poor, float very_poor, float hysteresis) {
-    co2_thresholds_ = {fair, poor, very_poor, hysteresis};
-  }
-  void set_voc_thresholds(float fair, float poor, float very_poor, float hysteresis) {
-    voc_thresholds_ = {fair, poor, very_poor, hysteresis};
-  }
-  void set_nox_thresholds(float fair, float poor, float very_poor, float hysteresis) {
-    nox_thresholds_ = {fair, poor, very_poor, hysteresis};
-  }
-  void set_pm25_thresholds(float fair, float poor, float very_poor, float hysteresis) {
-    pm25_thresholds_ = {fair, poor, very_poor, hysteresis};
-  }
+  // The complete engine configuration (composition, freshness windows and
+  // provisional thresholds), emitted by the codegen as a constexpr value
+  // with static storage. Applied ONCE in setup() — never re-pushed from
+  // the evaluation path.
+  void set_config(const sense360::airiq::AirIQConfig *config) { config_ = config; }
 
   // --- output entities (platform-registered; nullptr = not composed) ---
   void set_co2_sensor(sensor::Sensor *s) { co2_sensor_ = s; }
@@ -87,30 +78,87 @@ class Sense360AirIQ : public Component {
   void set_recommendation_reason_text_sensor(text_sensor::TextSensor *t) {
     recommendation_reason_text_sensor_ = t;
   }
+  void set_transition_journal_text_sensor(text_sensor::TextSensor *t) {
+    transition_journal_text_sensor_ = t;
+  }
+  void add_statistic_sensor(sensor::Sensor *s, sense360::airiq::Pollutant pollutant,
+                            sense360::airiq::StatisticsWindow window,
+                            sense360::airiq::Statistic statistic) {
+    statistic_sensors_.push_back(StatisticOutput{s, pollutant, window, statistic});
+  }
+  void add_exposure_sensor(sensor::Sensor *s, sense360::airiq::Pollutant pollutant,
+                           sense360::airiq::ExposureMetric metric) {
+    exposure_sensors_.push_back(ExposureOutput{s, pollutant, metric});
+  }
+  void add_time_to_poor_sensor(sensor::Sensor *s, sense360::airiq::Pollutant pollutant) {
+    time_to_poor_sensors_.push_back(TimeToPoorOutput{s, pollutant});
+  }
+#ifdef USE_TIME
+  // Local clock for the daily exposure reset; without one exposure
+  // accumulates since boot.
+  void set_time(time::RealTimeClock *clock) { time_ = clock; }
+#endif
 
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override;
 
   // The single evaluation owner. Public for the framework's same-id bridge
-  // script (the SPS30 overlay's documented re-evaluation hook).
+  // script (the documented external re-evaluation hook).
   void evaluate();
 
- protected:
-  struct Thresholds {
-    float fair;
-    float poor;
-    float very_poor;
-    float hysteresis;
-  };
+  // Explicit reconfiguration — the only way the applied configuration can
+  // change after setup(). A configuration whose version is already
+  // applied is ignored; otherwise it is applied and re-evaluated at once.
+  void reconfigure(const sense360::airiq::AirIQConfig *config);
+
+  // Drains the transition journal to the log (and the journal text sensor
+  // when bound). Public for on-demand export from YAML.
+  void export_journal();
 
+ protected:
+  void bind_source_(sensor::Sensor *source, sense360::airiq::FrameField field);
+  void flush_frame_();
+  void publish_(uint32_t now);
+  void schedule_next_evaluate_(uint32_t now);
   void publish_nan_if_stale_(sense360::airiq::Pollutant pollutant, sensor::Sensor *target);
-  void publish_changed_(text_sensor::TextSensor *target, const std::string &value);
+  void publish_text_(text_sensor::TextSensor *target, const char *value);
+  void publish_summaries_();
+  void publish_summary_(sensor::Sensor *target, float value);
+  void check_exposure_reset_();
+
+  struct StatisticOutput {
+    sensor::Sensor *sensor;
+    sense360::airiq::Pollutant pollutant;
+    sense360::airiq::StatisticsWindow window;
+    sense360::airiq::Statistic statistic;
+  };
+  struct ExposureOutput {
+    sensor::Sensor *sensor;
+    sense360::airiq::Pollutant pollutant;
+    sense360::airiq::ExposureMetric metric;
+  };
+  struct TimeToPoorOutput {
+    sensor::Sensor *sensor;
+    sense360::airiq::Pollutant pollutant;
+  };
 
   sensor::Sensor *co2_source_{nullptr};
   sensor::Sensor *voc_source_{nullptr};
   sensor::Sensor *nox_source_{nullptr};
   sensor::Sensor *hcho_source_{nullptr};
+  sensor::Sensor *pm2_5_source_{nullptr};
+  sensor::Sensor *pm1_source_{nullptr};
+  sensor::Sensor *pm4_source_{nullptr};
+  sensor::Sensor *pm10_source_{nullptr};
+
+  // The enum tuple the text entities last rendered (change detection
+  // without string comparison).
+  sense360::airiq::TextSnapshot published_text_{};
+  bool text_published_{false};
+
+  // Values staged by the source callbacks since the last flush.
+  sense360::airiq::AirIQFrame pending_frame_;
 
   sensor::Sensor *co2_sensor_{nullptr};
   sensor::Sensor *voc_sensor_{nullptr};
@@ -126,25 +174,19 @@ class Sense360AirIQ : public Component {
   text_sensor::TextSensor *module_status_text_sensor_{nullptr};
   text_sensor::TextSensor *state_detail_text_sensor_{nullptr};
   text_sensor::TextSensor *recommendation_reason_text_sensor_{nullptr};
+  text_sensor::TextSensor *transition_journal_text_sensor_{nullptr};
+  std::vector<StatisticOutput> statistic_sensors_;
+  std::vector<ExposureOutput> exposure_sensors_;
+  std::vector<TimeToPoorOutput> time_to_poor_sensors_;
+
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+  // The last valid clock reading (daily reset detection).
+  sense360::time_utils::Time last_clock_{};
+  bool clock_seen_{false};
 
-  bool expected_co2_{true};
-  bool expected_voc_{true};
-  bool expected_nox_{true};
-  bool expected_pm_{false};
-  bool expected_hcho_{true};
-  bool expected_o3_{false};
-  uint32_t co2_warmup_ms_{60000};
-  uint32_t co2_stale_ms_{180000};
-  uint32_t voc_warmup_ms_{60000};
-  uint32_t voc_stale_ms_{180000};
-  uint32_t nox_warmup_ms_{60000};
-  uint32_t nox_stale_ms_{180000};
-  uint32_t pm_warmup_ms_{60000};
-  uint32_t pm_stale_ms_{180000};
-  Thresholds co2_thresholds_{800, 1200, 2000, 50};
-  Thresholds voc_thresholds_{150, 250, 400, 10};
-  Thresholds nox_thresholds_{150, 250, 400, 10};
-  Thresholds pm25_thresholds_{12, 35, 55, 2};
+  const sense360::airiq::AirIQConfig *config_{nullptr};
 };
 
 }  // namespace sense360_airiq
@@ -4,22 +4,42 @@ Declares the component-owned pollutant outputs. Schema defaults equal the
 pre-component template declarations verbatim; the framework YAML pins ids,
 names and full metadata explicitly, so the resolved entity surface is
 identical. VOC and NOx are deliberately unitless relative indices — never
-concentrations; the headline is deliberately NOT an AQI.
+concentrations; the headline is deliberately NOT an AQI. The ``statistic``
+type adds optional rolling-window views (``pollutant`` / ``window`` /
+``statistic``) over the engine's bucket aggregates; ``exposure`` adds the
+daily time-weighted exposure (``pollutant`` / ``exposure``) and
+``time_to_poor`` the trend-predicted minutes until a ventilation-responsive
+pollutant (CO2 / VOC / NOx) reaches Poor.
 """
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor
 from esphome.const import (
+    CONF_STATE_CLASS,
     CONF_TYPE,
+    CONF_UNIT_OF_MEASUREMENT,
     DEVICE_CLASS_CARBON_DIOXIDE,
     DEVICE_CLASS_PM1,
     DEVICE_CLASS_PM10,
     DEVICE_CLASS_PM25,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
 )
 
-from . import Sense360AirIQ
+from . import (
+    CONF_EXPOSURE,
+    CONF_POLLUTANT,
+    CONF_STATISTIC,
+    CONF_TIME_TO_POOR,
+    CONF_WINDOW,
+    EXPOSURE_METRICS,
+    STATISTIC_POLLUTANTS,
+    STATISTIC_WINDOWS,
+    STATISTICS,
+    TREND_POLLUTANTS,
+    Sense360AirIQ,
+)
 
 CONF_SENSE360_AIRIQ_ID = "sense360_airiq_id"
 
@@ -100,18 +120,98 @@ TYPES = {
         ),
         "setter": "set_pm10_sensor",
     },
+    # Rolling statistic of one pollutant; the unit follows the pollutant
+    # (VOC / NOx stay unitless indices).
+    CONF_STATISTIC: {
+        "schema": sensor.sensor_schema(
+            state_class=STATE_CLASS_MEASUREMENT,
+            accuracy_decimals=1,
+            icon="mdi:chart-bell-curve",
+        ).extend(
+            {
+                cv.Required(CONF_POLLUTANT): cv.one_of(
+                    *STATISTIC_POLLUTANTS, lower=True
+                ),
+                cv.Required(CONF_WINDOW): cv.one_of(*STATISTIC_WINDOWS, lower=True),
+                cv.Required(CONF_STATISTIC): cv.one_of(*STATISTICS, lower=True),
+            }
+        ),
+        "setter": "add_statistic_sensor",
+    },
+    # Time-weighted exposure of one pollutant since the daily reset; the
+    # unit follows the pollutant and the metric (dose in unit·h, hours in h)
+    # and so does the state class (see _summary_unit).
+    CONF_EXPOSURE: {
+        "schema": sensor.sensor_schema(
+            accuracy_decimals=1,
+            icon="mdi:sigma",
+        ).extend(
+            {
+                cv.Required(CONF_POLLUTANT): cv.one_of(
+                    *STATISTIC_POLLUTANTS, lower=True
+                ),
+                cv.Required(CONF_EXPOSURE): cv.one_of(*EXPOSURE_METRICS, lower=True),
+            }
+        ),
+        "setter": "add_exposure_sensor",
+    },
+    # Minutes until one pollutant's trend reaches Poor (0 = already there;
+    # unknown while no crossing is predicted).
+    CONF_TIME_TO_POOR: {
+        "schema": sensor.sensor_schema(
+            unit_of_measurement="min",
+            state_class=STATE_CLASS_MEASUREMENT,
+            accuracy_decimals=0,
+            icon="mdi:timer-sand",
+        ).extend(
+            {
+                cv.Required(CONF_POLLUTANT): cv.one_of(*TREND_POLLUTANTS, lower=True),
+            }
+        ),
+        "setter": "add_time_to_poor_sensor",
+    },
 }
 
+_POLLUTANT_UNITS = {
+    "co2": "ppm",
+    "hcho": "ppb",
+    "pm2_5": UNIT_MICROGRAMS_PER_CUBIC_METER,
+}
+
+
+def _summary_unit(config):
+    unit = _POLLUTANT_UNITS.get(config[CONF_POLLUTANT])
+    metric = config.get(CONF_EXPOSURE)
+    if metric == "hours":
+        unit = "h"
+    elif metric == "dose":
+        # An index dose (VOC / NOx) stays unitless like the index itself.
+        unit = f"{unit}·h" if unit is not None else None
+    if unit is not None and CONF_UNIT_OF_MEASUREMENT not in config:
+        config[CONF_UNIT_OF_MEASUREMENT] = unit
+    if metric is not None and CONF_STATE_CLASS not in config:
+        # Dose and hours only grow until the daily reset; the averages are
+        # measurements.
+        config[CONF_STATE_CLASS] = sensor.validate_state_class(
+            STATE_CLASS_TOTAL_INCREASING
+            if metric in ("dose", "hours")
+            else STATE_CLASS_MEASUREMENT
+        )
+    return config
+
 
 def _base_schema(type_key):
     # NOTE: cv.typed_schema POPS the `type` key before validating against
     # the selected inner schema (and re-adds it afterwards), so the inner
     # schema must NOT declare `type` itself.
-    return TYPES[type_key]["schema"].extend(
+    schema = TYPES[type_key]["schema"].extend(
         {
             cv.GenerateID(CONF_SENSE360_AIRIQ_ID): cv.use_id(Sense360AirIQ),
         }
     )
+    if type_key in (CONF_STATISTIC, CONF_EXPOSURE):
+        return cv.All(schema, _summary_unit)
+    return schema
 
 
 CONFIG_SCHEMA = cv.typed_schema(
@@ -123,4 +223,45 @@ CONFIG_SCHEMA = cv.typed_schema(
 async def to_code(config):
     hub = await cg.get_variable(config[CONF_SENSE360_AIRIQ_ID])
     var = await sensor.new_sensor(config)
+    if config[CONF_TYPE] == CONF_STATISTIC:
+        cg.add(
+            hub.add_statistic_sensor(
+                var,
+                cg.RawExpression(
+                    "sense360::airiq::"
+                    + STATISTIC_POLLUTANTS[config[CONF_POLLUTANT]][0]
+                ),
+                cg.RawExpression(
+                    "sense360::airiq::" + STATISTIC_WINDOWS[config[CONF_WINDOW]]
+                ),
+                cg.RawExpression(
+                    "sense360::airiq::" + STATISTICS[config[CONF_STATISTIC]]
+                ),
+            )
+        )
+        return
+    if config[CONF_TYPE] == CONF_EXPOSURE:
+        cg.add(
+            hub.add_exposure_sensor(
+                var,
+                cg.RawExpression(
+                    "sense360::airiq::"
+                    + STATISTIC_POLLUTANTS[config[CONF_POLLUTANT]][0]
+                ),
+                cg.RawExpression(
+                    "sense360::airiq::" + EXPOSURE_METRICS[config[CONF_EXPOSURE]]
+                ),
+            )
+        )
+        return
+    if config[CONF_TYPE] == CONF_TIME_TO_POOR:
+        cg.add(
+            hub.add_time_to_poor_sensor(
+                var,
+                cg.RawExpression(
+                    "sense360::airiq::" + TREND_POLLUTANTS[config[CONF_POLLUTANT]]
+                ),
+            )
+        )
+        return
     cg.add(getattr(hub, TYPES[config[CONF_TYPE]]["setter"])(var))
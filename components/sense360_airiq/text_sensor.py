@@ -39,6 +39,15 @@ TYPES = {
         ),
         "setter": "set_recommendation_reason_text_sensor",
     },
+    # One line per severity / headline / recommendation change, drained
+    # from the engine's transition journal (flapping evidence).
+    "transition_journal": {
+        "schema": text_sensor.text_sensor_schema(
+            icon="mdi:history",
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        "setter": "set_transition_journal_text_sensor",
+    },
 }
 
 
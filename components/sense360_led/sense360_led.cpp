@@ -108,11 +108,16 @@ void Sense360Led::evaluate() {
       environment.set_darkness_threshold(threshold);
     }
     environment.set_darkness_hysteresis(this->darkness_hysteresis_);
-    environment.evaluate(now);
+    // An automatic night behaviour in force keeps the light sensor on its
+    // fast cadence near the decision (RoomIQ adaptive sampling).
+    environment.set_darkness_armed(controller.effective_behaviour() != NIGHT_MANUAL);
+    // Darkness only: the full environmental evaluation is the RoomIQ
+    // component's own 5 s tick, not this 250 ms loop's.
+    const auto decision = environment.evaluate_darkness(now);
     Darkness darkness = DARKNESS_UNKNOWN;
-    if (environment.darkness() == sense360::roomiq::DARKNESS_DARK) {
+    if (decision == sense360::roomiq::DARKNESS_DARK) {
       darkness = DARKNESS_DARK;
-    } else if (environment.darkness() == sense360::roomiq::DARKNESS_NOT_DARK) {
+    } else if (decision == sense360::roomiq::DARKNESS_NOT_DARK) {
       darkness = DARKNESS_NOT_DARK;
     }
     controller.input_darkness(now, darkness);
@@ -148,6 +153,9 @@ void Sense360Led::evaluate() {
   }
 
   controller.evaluate(now);
+  // The ring is the board's largest variable heat source: its load drives
+  // the RoomIQ self-heating model (a no-op unless a model is configured).
+  sense360::roomiq::global_engine().input_board_heat(now, controller.heat_load());
 
   // Apply the arbitrated output when the light differs from it.
   {
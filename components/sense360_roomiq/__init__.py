@@ -41,6 +41,10 @@ Sense360RoomIQ = sense360_roomiq_ns.class_("Sense360RoomIQ", cg.Component)
 CONF_TEMPERATURE_SOURCE = "temperature_source"
 CONF_HUMIDITY_SOURCE = "humidity_source"
 CONF_ILLUMINANCE_SOURCE = "illuminance_source"
+CONF_ILLUMINANCE_POLLER = "illuminance_poller"
+CONF_ILLUMINANCE_FAST_INTERVAL = "illuminance_fast_interval"
+CONF_ILLUMINANCE_SLOW_INTERVAL = "illuminance_slow_interval"
+CONF_ILLUMINANCE_NEAR_BAND_PCT = "illuminance_near_band_pct"
 CONF_TEMPERATURE_OFFSET_NUMBER = "temperature_offset_number"
 CONF_HUMIDITY_OFFSET_NUMBER = "humidity_offset_number"
 CONF_ILLUMINANCE_SCALE_NUMBER = "illuminance_scale_number"
@@ -64,6 +68,28 @@ CONF_LUX_NORMAL = "lux_normal"
 CONF_LUX_BRIGHT = "lux_bright"
 CONF_LUX_VERY_BRIGHT = "lux_very_bright"
 CONF_BRIGHTNESS_HYSTERESIS_PCT = "brightness_hysteresis_pct"
+CONF_TEMPERATURE_PUBLISH_BAND = "temperature_publish_band"
+CONF_HUMIDITY_PUBLISH_BAND = "humidity_publish_band"
+CONF_ILLUMINANCE_PUBLISH_BAND_PCT = "illuminance_publish_band_pct"
+CONF_PUBLISH_HEARTBEAT = "publish_heartbeat"
+CONF_CLIMATE_PUBLISH_HEARTBEAT = "climate_publish_heartbeat"
+CONF_WARM_BOOT_RESTORE = "warm_boot_restore"
+CONF_WARM_BOOT_ALLOWANCE = "warm_boot_allowance"
+CONF_SELF_HEATING_CORRECTION = "self_heating_correction_per_load"
+CONF_SELF_HEATING_TIME_CONSTANT = "self_heating_time_constant"
+CONF_SELF_HEATING_REFERENCE_LOAD = "self_heating_reference_load"
+CONF_FAST_VAPOUR_PRESSURE = "fast_vapour_pressure"
+CONF_CLIMATE_PROFILE = "climate_profile"
+CONF_CLIMATE_PROFILE_RUNTIME = "climate_profile_runtime"
+
+# Board climate profile registry ids (roomiq_climate_compensation.h,
+# ClimateProfileTable) -> their ClimateProfileId enumerators. Kept in step
+# with the header by tests/test_roomiq_climate_compensation.py.
+CLIMATE_PROFILES = {
+    "NEUTRAL_CLIMATE_PROFILE": "CLIMATE_PROFILE_NEUTRAL",
+    "S360_200_R4_CLIMATE_PROFILE_V1": "CLIMATE_PROFILE_S360_200_R4_V1",
+}
+DEFAULT_CLIMATE_PROFILE = "S360_200_R4_CLIMATE_PROFILE_V1"
 
 CONFIG_SCHEMA = cv.Schema(
     {
@@ -71,6 +97,20 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Required(CONF_TEMPERATURE_SOURCE): cv.use_id(sensor.Sensor),
         cv.Required(CONF_HUMIDITY_SOURCE): cv.use_id(sensor.Sensor),
         cv.Required(CONF_ILLUMINANCE_SOURCE): cv.use_id(sensor.Sensor),
+        # The light sensor's polling component. Bound, its update interval
+        # follows the engine's adaptive sampling policy: fast near the
+        # darkness decision or while a night automation is armed, slow far
+        # from it, the sensor's own configured interval otherwise.
+        cv.Optional(CONF_ILLUMINANCE_POLLER): cv.use_id(cg.PollingComponent),
+        cv.Optional(
+            CONF_ILLUMINANCE_FAST_INTERVAL, default="2s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(
+            CONF_ILLUMINANCE_SLOW_INTERVAL, default="20s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_ILLUMINANCE_NEAR_BAND_PCT, default=50.0): cv.float_range(
+            min=0.0, max=90.0
+        ),
         # Customer calibration controls stay ordinary persisted template
         # numbers in YAML (their entity ids AND their NVS restore identity
         # are protected compatibility contracts); the component reads them.
@@ -120,6 +160,57 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_LUX_BRIGHT, default=300.0): cv.float_,
         cv.Optional(CONF_LUX_VERY_BRIGHT, default=1000.0): cv.float_,
         cv.Optional(CONF_BRIGHTNESS_HYSTERESIS_PCT, default=20.0): cv.float_,
+        # Publish change bands: a numeric output republishes only once it
+        # moves this far from the value last published (illuminance:
+        # percent of that value), or when the heartbeat falls due (0s = no
+        # heartbeat). Stale/recovered transitions always publish.
+        cv.Optional(CONF_TEMPERATURE_PUBLISH_BAND, default=0.05): cv.float_range(
+            min=0.0
+        ),
+        cv.Optional(CONF_HUMIDITY_PUBLISH_BAND, default=0.2): cv.float_range(min=0.0),
+        cv.Optional(CONF_ILLUMINANCE_PUBLISH_BAND_PCT, default=2.0): cv.float_range(
+            min=0.0, max=100.0
+        ),
+        cv.Optional(
+            CONF_PUBLISH_HEARTBEAT, default="15min"
+        ): cv.positive_time_period_milliseconds,
+        # The canonical temperature / humidity heartbeat is shorter: VentIQ
+        # consumes those entities with a 90 s freshness window, so a steady
+        # reading must still reach it inside that window.
+        cv.Optional(
+            CONF_CLIMATE_PUBLISH_HEARTBEAT, default="60s"
+        ): cv.positive_time_period_milliseconds,
+        # Warm-boot carry-over: after OTA / watchdog resets, resume from the
+        # engine snapshot kept in RTC memory (channels still inside their
+        # stale windows only). The allowance is the assumed reset duration,
+        # added to every restored data age.
+        cv.Optional(CONF_WARM_BOOT_RESTORE, default=True): cv.boolean,
+        cv.Optional(
+            CONF_WARM_BOOT_ALLOWANCE, default="5s"
+        ): cv.positive_time_period_milliseconds,
+        # Self-heating dynamics: the extra temperature correction per unit of
+        # settled LED load (0 = off, 1 = full white) above the reference load
+        # the profile was measured at, reached through a first-order lag.
+        # Off unless a time constant is given; per-board characterisation.
+        cv.Optional(CONF_SELF_HEATING_CORRECTION, default=0.0): cv.float_range(
+            min=-10.0, max=10.0
+        ),
+        cv.Optional(
+            CONF_SELF_HEATING_TIME_CONSTANT, default="0s"
+        ): cv.positive_time_period_seconds,
+        cv.Optional(CONF_SELF_HEATING_REFERENCE_LOAD, default=0.0): cv.float_range(
+            min=0.0, max=1.0
+        ),
+        # Polynomial exp() kernel for the Magnus formula (bounded error far
+        # below the SHT45 resolution; see roomiq_climate_compensation.h).
+        cv.Optional(CONF_FAST_VAPOUR_PRESSURE, default=False): cv.boolean,
+        # The board climate profile compiled in (a registry id; the board
+        # package names its board's profile). Selected at compile time.
+        cv.Optional(CONF_CLIMATE_PROFILE, default=DEFAULT_CLIMATE_PROFILE): cv.one_of(
+            *CLIMATE_PROFILES, upper=True
+        ),
+        # Bench builds only: allow switching profile by id at runtime.
+        cv.Optional(CONF_CLIMATE_PROFILE_RUNTIME, default=False): cv.boolean,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -137,6 +228,7 @@ async def to_code(config):
         cg.add(setter(source))
 
     for key, setter in (
+        (CONF_ILLUMINANCE_POLLER, var.set_illuminance_poller),
         (CONF_TEMPERATURE_OFFSET_NUMBER, var.set_temperature_offset_number),
         (CONF_HUMIDITY_OFFSET_NUMBER, var.set_humidity_offset_number),
         (CONF_ILLUMINANCE_SCALE_NUMBER, var.set_illuminance_scale_number),
@@ -153,6 +245,13 @@ async def to_code(config):
         )
     )
     cg.add(var.set_climate_pair_skew(config[CONF_CLIMATE_PAIR_SKEW]))
+    cg.add(
+        var.set_illuminance_sampling(
+            config[CONF_ILLUMINANCE_FAST_INTERVAL],
+            config[CONF_ILLUMINANCE_SLOW_INTERVAL],
+            config[CONF_ILLUMINANCE_NEAR_BAND_PCT],
+        )
+    )
     cg.add(
         var.set_temperature_bands(
             config[CONF_TEMP_COLD],
@@ -178,4 +277,36 @@ async def to_code(config):
             config[CONF_BRIGHTNESS_HYSTERESIS_PCT],
         )
     )
+    cg.add(
+        var.set_publish_bands(
+            config[CONF_TEMPERATURE_PUBLISH_BAND],
+            config[CONF_HUMIDITY_PUBLISH_BAND],
+            config[CONF_ILLUMINANCE_PUBLISH_BAND_PCT],
+            config[CONF_PUBLISH_HEARTBEAT],
+        )
+    )
+    cg.add(var.set_climate_publish_heartbeat(config[CONF_CLIMATE_PUBLISH_HEARTBEAT]))
+    cg.add(
+        var.set_warm_boot_restore(
+            config[CONF_WARM_BOOT_RESTORE], config[CONF_WARM_BOOT_ALLOWANCE]
+        )
+    )
+    if config[CONF_SELF_HEATING_TIME_CONSTANT].total_seconds > 0:
+        cg.add(
+            var.set_self_heating(
+                config[CONF_SELF_HEATING_CORRECTION],
+                config[CONF_SELF_HEATING_TIME_CONSTANT].total_seconds,
+                config[CONF_SELF_HEATING_REFERENCE_LOAD],
+            )
+        )
     cg.add(var.set_calibration_schema_version(config[CONF_CALIBRATION_SCHEMA_VERSION]))
+    # A build flag rather than a define: every translation unit that
+    # includes the compensation header must use the same kernel.
+    if config[CONF_FAST_VAPOUR_PRESSURE]:
+        cg.add_build_flag("-DSENSE360_CLIMATE_FAST_SVP=1")
+    if config[CONF_CLIMATE_PROFILE] != DEFAULT_CLIMATE_PROFILE:
+        cg.add_build_flag(
+            f"-DSENSE360_CLIMATE_PROFILE={CLIMATE_PROFILES[config[CONF_CLIMATE_PROFILE]]}"
+        )
+    if config[CONF_CLIMATE_PROFILE_RUNTIME]:
+        cg.add_build_flag("-DSENSE360_CLIMATE_PROFILE_RUNTIME=1")
@@ -6,6 +6,11 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#include <esp_system.h>
+#endif
+
 namespace esphome {
 namespace sense360_roomiq {
 
@@ -15,6 +20,26 @@ static const char *const TAG = "sense360_roomiq";
 // evaluate script carried (docs/architecture/sense360-roomiq-component-plan.md).
 static constexpr uint32_t EVALUATE_INTERVAL_MS = 5000;
 
+#ifdef USE_ESP32
+// Warm-boot carry-over: RTC memory keeps its contents across software,
+// panic and watchdog resets (OTA reboots included) but not power-on, where
+// it holds garbage — the snapshot's magic, version and checksum reject that.
+static RTC_NOINIT_ATTR sense360::roomiq::RoomIQSnapshot rtc_snapshot;
+
+static bool warm_reset() {
+  switch (esp_reset_reason()) {
+    case ESP_RST_SW:
+    case ESP_RST_PANIC:
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+      return true;
+    default:
+      return false;
+  }
+}
+#endif
+
 float Sense360RoomIQ::get_setup_priority() const {
   // After hardware sensors and number entities have set up (and restored
   // their persisted values), before late boot hooks — matching the
@@ -25,6 +50,22 @@ float Sense360RoomIQ::get_setup_priority() const {
 void Sense360RoomIQ::setup() {
   auto &engine = sense360::roomiq::global_engine();
   engine.begin(millis());
+  // The LED glue feeds the board heat input; without a time constant the
+  // static profile correction stays in force.
+  engine.set_self_heating_model(this->self_heating_);
+
+#ifdef USE_ESP32
+  // A warm reset resumes from the last snapshot (channels still inside their
+  // stale windows only), so Comfort, Brightness and darkness do not drop to
+  // Initialising for a sensor cycle after every OTA.
+  if (this->warm_boot_restore_ && warm_reset()) {
+    engine.set_climate_stale_ms(this->climate_stale_ms_);
+    engine.set_lux_stale_ms(this->lux_stale_ms_);
+    const int restored = engine.restore_snapshot(millis(), rtc_snapshot,
+                                                 this->warm_boot_allowance_ms_);
+    ESP_LOGI(TAG, "Warm boot: %d of 3 channels restored from RTC memory", restored);
+  }
+#endif
 
   // The freshness signal is the real update callback: each raw sample feeds
   // the engine and re-evaluates immediately, so either SHT45 callback order
@@ -48,16 +89,29 @@ void Sense360RoomIQ::setup() {
       this->evaluate();
     });
   }
+  // The YAML-configured light-sensor cadence is the policy's "normal"
+  // interval.
+  if (this->illuminance_poller_ != nullptr) {
+    this->lux_normal_ms_ = this->illuminance_poller_->get_update_interval();
+    this->lux_applied_ms_ = this->lux_normal_ms_;
+  }
 
   // A calibration change recalculates immediately from the latest raw pair
   // while it is still fresh (the temperature offset legitimately moves
   // humidity too: relative humidity is recomputed at the corrected
   // temperature, preserving the measured vapour pressure).
+  // The change that results always publishes, however small (the customer
+  // must see their adjustment land).
   for (number::Number *n : {this->temperature_offset_number_,
                             this->humidity_offset_number_,
                             this->illuminance_scale_number_}) {
     if (n != nullptr) {
-      n->add_on_state_callback([this](float) { this->evaluate(); });
+      n->add_on_state_callback([this](float) {
+        for (auto *band : {&this->temperature_band_, &this->humidity_band_,
+                           &this->illuminance_band_})
+          band->force();
+        this->evaluate();
+      });
     }
   }
 
@@ -69,11 +123,13 @@ void Sense360RoomIQ::setup() {
     char buffer[200];
     snprintf(buffer, sizeof(buffer),
              "%s (%s %s): temperature %+.2f C, humidity residual "
-             "%+.2f %%RH, evidence %s (one tested board; multi-unit "
-             "validation outstanding)",
+             "%+.2f %%RH, evidence %s%s",
              profile.id, profile.board_sku, profile.board_revision,
              profile.temperature_correction_c, profile.humidity_residual_pct,
-             sense360::roomiq::climate_evidence_to_string(profile.evidence));
+             sense360::roomiq::climate_evidence_to_string(profile.evidence),
+             profile.evidence == sense360::roomiq::CLIMATE_EVIDENCE_NONE
+                 ? " (no correction applied)"
+                 : " (one tested board; multi-unit validation outstanding)");
     this->climate_profile_text_sensor_->publish_state(buffer);
   }
 
@@ -82,13 +138,15 @@ void Sense360RoomIQ::setup() {
   this->evaluate();
 }
 
-void Sense360RoomIQ::publish_changed_(sensor::Sensor *target, float value) {
+// Numeric outputs publish only when their change band (or the heartbeat)
+// says so: each raw callback and the 5 s tick re-evaluate, but sub-band
+// jitter never becomes an API state frame.
+void Sense360RoomIQ::publish_changed_(sensor::Sensor *target,
+                                      sense360::roomiq::PublishDeadband &band,
+                                      uint32_t now, float value) {
   if (target == nullptr)
     return;
-  const float current = target->state;
-  const bool unchanged =
-      (std::isnan(current) && std::isnan(value)) || current == value;
-  if (!unchanged)
+  if (band.offer(now, value))
     target->publish_state(value);
 }
 
@@ -131,18 +189,29 @@ void Sense360RoomIQ::evaluate() {
     engine.set_illuminance_scale(this->illuminance_scale_number_->state);
 
   engine.evaluate(now);
+  this->apply_illuminance_interval_();
+#ifdef USE_ESP32
+  if (this->warm_boot_restore_)
+    rtc_snapshot = engine.capture_snapshot(now);
+#endif
 
-  // Canonical numeric outputs — publish on change only; a stale channel
-  // publishes NAN, never a frozen reading.
-  this->publish_changed_(this->temperature_sensor_, engine.temperature());
-  this->publish_changed_(this->humidity_sensor_, engine.humidity());
-  this->publish_changed_(this->illuminance_sensor_, engine.illuminance());
+  // Canonical numeric outputs — publish on a change beyond the entity's
+  // band (or the heartbeat); a stale channel publishes NAN at once, never a
+  // frozen reading.
+  this->publish_changed_(this->temperature_sensor_, this->temperature_band_, now,
+                         engine.temperature());
+  this->publish_changed_(this->humidity_sensor_, this->humidity_band_, now,
+                         engine.humidity());
+  this->publish_changed_(this->illuminance_sensor_, this->illuminance_band_, now,
+                         engine.illuminance());
 
   // Factory-only support diagnostics: the built-in board profile applied
   // WITHOUT customer calibration.
   this->publish_changed_(this->factory_temperature_sensor_,
+                         this->factory_temperature_band_, now,
                          engine.factory_temperature());
   this->publish_changed_(this->factory_humidity_sensor_,
+                         this->factory_humidity_band_, now,
                          engine.factory_humidity());
 
   // Customer state outputs.
@@ -185,6 +254,26 @@ void Sense360RoomIQ::evaluate() {
   }
 }
 
+// Re-arm the light sensor's poller only when the policy's interval changes
+// (each evaluate, so a lux sample entering the near band speeds up the very
+// next poll).
+void Sense360RoomIQ::apply_illuminance_interval_() {
+  if (this->illuminance_poller_ == nullptr)
+    return;
+  auto &engine = sense360::roomiq::global_engine();
+  engine.set_lux_sample_intervals(this->lux_fast_ms_, this->lux_normal_ms_,
+                                  this->lux_slow_ms_);
+  engine.set_lux_near_band_pct(this->lux_near_band_pct_);
+  const uint32_t interval = engine.lux_sample_interval_ms(millis());
+  if (interval == this->lux_applied_ms_)
+    return;
+  ESP_LOGD(TAG, "Illuminance update interval %" PRIu32 "ms -> %" PRIu32 "ms",
+           this->lux_applied_ms_, interval);
+  this->lux_applied_ms_ = interval;
+  this->illuminance_poller_->set_update_interval(interval);
+  this->illuminance_poller_->start_poller();
+}
+
 void Sense360RoomIQ::dump_config() {
   ESP_LOGCONFIG(TAG, "Sense360 RoomIQ (glue over the canonical engine "
                      "singleton; model logic lives in "
@@ -193,6 +282,24 @@ void Sense360RoomIQ::dump_config() {
                 this->climate_warmup_ms_, this->climate_stale_ms_);
   ESP_LOGCONFIG(TAG, "  Illuminance windows: warmup %" PRIu32 "ms stale %" PRIu32 "ms",
                 this->lux_warmup_ms_, this->lux_stale_ms_);
+  if (this->illuminance_poller_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Illuminance sampling: fast %" PRIu32 "ms normal %" PRIu32
+                       "ms slow %" PRIu32 "ms, near band %.0f%%",
+                  this->lux_fast_ms_, this->lux_normal_ms_, this->lux_slow_ms_,
+                  this->lux_near_band_pct_);
+  }
+  ESP_LOGCONFIG(TAG, "  Warm-boot restore: %s (reset allowance %" PRIu32 "ms)",
+                this->warm_boot_restore_ ? "yes" : "no",
+                this->warm_boot_allowance_ms_);
+  if (this->self_heating_.time_constant_s > 0.0f) {
+    ESP_LOGCONFIG(TAG, "  Self-heating: %.2f C per unit load, tau %.0fs, reference %.2f",
+                  this->self_heating_.correction_per_load_c,
+                  this->self_heating_.time_constant_s,
+                  this->self_heating_.reference_load);
+  }
+  ESP_LOGCONFIG(TAG, "  Publish heartbeat: %" PRIu32 "ms (temperature/humidity %" PRIu32
+                     "ms)",
+                this->publish_heartbeat_ms_, this->climate_publish_heartbeat_ms_);
   ESP_LOGCONFIG(TAG, "  Calibration schema version: %d",
                 this->calibration_schema_version_);
 }
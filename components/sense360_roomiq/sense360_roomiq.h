@@ -11,8 +11,10 @@
 // lives in the natively tested engine headers and is not restated here.
 //
 // Publication follows the pre-component single-owner contract exactly: one
-// evaluate path owns every engine exchange; outputs publish on change only;
-// a stale channel publishes NAN (never a frozen reading). Output entity
+// evaluate path owns every engine exchange; outputs publish on change only
+// (numeric outputs on a change beyond their band, plus a heartbeat —
+// PublishDeadband); a stale channel publishes NAN (never a frozen reading).
+// Output entity
 // pointers are optional (nullptr = not composed), so the component skeleton
 // compiles before the platform slices land and partial compositions stay
 // valid.
@@ -33,6 +35,9 @@ class Sense360RoomIQ : public Component {
   void set_temperature_source(sensor::Sensor *s) { temperature_source_ = s; }
   void set_humidity_source(sensor::Sensor *s) { humidity_source_ = s; }
   void set_illuminance_source(sensor::Sensor *s) { illuminance_source_ = s; }
+  // The light sensor's polling component (optional): when bound, its update
+  // interval follows the engine's adaptive sampling policy.
+  void set_illuminance_poller(PollingComponent *p) { illuminance_poller_ = p; }
 
   // --- customer calibration controls (persisted template numbers in YAML;
   //     entity ids and NVS restore identity are protected contracts) ---
@@ -50,6 +55,12 @@ class Sense360RoomIQ : public Component {
     lux_stale_ms_ = stale_ms;
   }
   void set_climate_pair_skew(uint32_t skew_ms) { climate_pair_skew_ms_ = skew_ms; }
+  void set_illuminance_sampling(uint32_t fast_ms, uint32_t slow_ms,
+                                float near_band_pct) {
+    lux_fast_ms_ = fast_ms;
+    lux_slow_ms_ = slow_ms;
+    lux_near_band_pct_ = near_band_pct;
+  }
   void set_temperature_bands(float cold_c, float cool_c, float warm_c, float hot_c,
                              float hysteresis_c) {
     temp_cold_c_ = cold_c;
@@ -71,6 +82,40 @@ class Sense360RoomIQ : public Component {
     lux_very_bright_lx_ = very_bright_lx;
     brightness_hysteresis_pct_ = hysteresis_pct;
   }
+  // Publish change bands (customer and factory climate outputs share the
+  // temperature / humidity bands) and the heartbeat (0 = none).
+  void set_publish_bands(float temperature_c, float humidity_pct,
+                         float illuminance_pct, uint32_t heartbeat_ms) {
+    for (auto *band : {&this->temperature_band_, &this->factory_temperature_band_})
+      band->set_band(temperature_c, 0.0f);
+    for (auto *band : {&this->humidity_band_, &this->factory_humidity_band_})
+      band->set_band(humidity_pct, 0.0f);
+    this->illuminance_band_.set_band(0.0f, illuminance_pct / 100.0f);
+    for (auto *band : {&this->temperature_band_, &this->humidity_band_,
+                       &this->illuminance_band_, &this->factory_temperature_band_,
+                       &this->factory_humidity_band_})
+      band->set_heartbeat_ms(heartbeat_ms);
+    this->publish_heartbeat_ms_ = heartbeat_ms;
+  }
+  // The canonical temperature / humidity entities feed in-firmware
+  // consumers with their own freshness windows (VentIQ), so their heartbeat
+  // is set apart (applied after set_publish_bands()).
+  void set_climate_publish_heartbeat(uint32_t heartbeat_ms) {
+    for (auto *band : {&this->temperature_band_, &this->humidity_band_})
+      band->set_heartbeat_ms(heartbeat_ms);
+    this->climate_publish_heartbeat_ms_ = heartbeat_ms;
+  }
+  // Warm-boot carry-over (ESP32 RTC memory); the allowance is the assumed
+  // duration of the reset itself, added to every restored data age.
+  void set_warm_boot_restore(bool restore, uint32_t allowance_ms) {
+    warm_boot_restore_ = restore;
+    warm_boot_allowance_ms_ = allowance_ms;
+  }
+  // Self-heating dynamics (off unless a time constant is configured).
+  void set_self_heating(float correction_per_load_c, float time_constant_s,
+                        float reference_load) {
+    self_heating_ = {reference_load, correction_per_load_c, time_constant_s};
+  }
   void set_calibration_schema_version(int version) { calibration_schema_version_ = version; }
 
   // --- output entities (registered by the platform modules; nullptr = not
@@ -104,12 +149,16 @@ class Sense360RoomIQ : public Component {
   void evaluate();
 
  protected:
-  void publish_changed_(sensor::Sensor *target, float value);
+  void publish_changed_(sensor::Sensor *target,
+                        sense360::roomiq::PublishDeadband &band, uint32_t now,
+                        float value);
   void publish_changed_(text_sensor::TextSensor *target, const std::string &value);
+  void apply_illuminance_interval_();
 
   sensor::Sensor *temperature_source_{nullptr};
   sensor::Sensor *humidity_source_{nullptr};
   sensor::Sensor *illuminance_source_{nullptr};
+  PollingComponent *illuminance_poller_{nullptr};
   number::Number *temperature_offset_number_{nullptr};
   number::Number *humidity_offset_number_{nullptr};
   number::Number *illuminance_scale_number_{nullptr};
@@ -132,6 +181,11 @@ class Sense360RoomIQ : public Component {
   uint32_t lux_warmup_ms_{30000};
   uint32_t lux_stale_ms_{60000};
   uint32_t climate_pair_skew_ms_{5000};
+  uint32_t lux_fast_ms_{2000};
+  uint32_t lux_normal_ms_{0};  // the poller's configured interval, read at setup
+  uint32_t lux_slow_ms_{20000};
+  float lux_near_band_pct_{50.0f};
+  uint32_t lux_applied_ms_{0};
   float temp_cold_c_{16.0f};
   float temp_cool_c_{18.0f};
   float temp_warm_c_{24.0f};
@@ -146,6 +200,19 @@ class Sense360RoomIQ : public Component {
   float lux_very_bright_lx_{1000.0f};
   float brightness_hysteresis_pct_{20.0f};
   int calibration_schema_version_{2};
+  bool warm_boot_restore_{true};
+  uint32_t warm_boot_allowance_ms_{5000};
+  sense360::roomiq::SelfHeatingModel self_heating_{0.0f, 0.0f, 0.0f};
+
+  // Publish gates for the numeric outputs (defaults: 0.05 °C, 0.2 %RH, 2 %
+  // of the illuminance reading; the heartbeat arrives from codegen).
+  sense360::roomiq::PublishDeadband temperature_band_{0.05f, 0.0f};
+  sense360::roomiq::PublishDeadband humidity_band_{0.2f, 0.0f};
+  sense360::roomiq::PublishDeadband illuminance_band_{0.0f, 0.02f};
+  sense360::roomiq::PublishDeadband factory_temperature_band_{0.05f, 0.0f};
+  sense360::roomiq::PublishDeadband factory_humidity_band_{0.2f, 0.0f};
+  uint32_t publish_heartbeat_ms_{0};
+  uint32_t climate_publish_heartbeat_ms_{0};
 };
 
 }  // namespace sense360_roomiq
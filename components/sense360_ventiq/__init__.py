@@ -3,14 +3,17 @@
 Wraps the canonical VentIQ ventilation engine singleton
 (``sense360::ventiq::global_engine()`` from
 ``components/sense360/ventiq_engine.h``, which embeds the canonical AirIQ
-engine for pollutant truth — one implementation, no duplicated thresholds)
+engine for pollutant truth — or, with ``shared_airiq_engine``, reads the
+composition's own AirIQ engine — one implementation, no duplicated thresholds)
 as a real ESPHome component, per
 ``docs/architecture/sense360-airiq-ventiq-component-plan.md``. It owns what
 used to be YAML glue in ``packages/features/ventiq_framework.yaml``: input
 feeding (RoomIQ canonical humidity/temperature by entity id, the board's
 SGP41 VOC/NOx), the expected-channel / freshness / heuristic configuration,
 the genuinely wired customer controls (thresholds, durations, the shower
-detection switch), the 10 s tick and the publish switchboard.
+detection switch), the 10 s tick and the publish switchboard. Bound to the
+humidity sensor's poller, it also re-times that poller for shower-onset
+burst sampling.
 
 The manual-action buttons (force ventilation / reset shower / reset mould)
 stay as YAML engine-action lambdas on their preserved legacy entities and
@@ -22,8 +25,9 @@ provisional engineering values.
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import number, sensor, switch, text_sensor
-from esphome.const import CONF_ID
+from esphome.components import number, sensor, switch, text_sensor, time
+from esphome.const import CONF_ID, CONF_TIME_ID
+from esphome.core import CORE, TimePeriod
 
 CODEOWNERS = ["@sense360store"]
 AUTO_LOAD = ["sense360", "sensor", "text_sensor", "binary_sensor", "number", "switch"]
@@ -35,6 +39,15 @@ CONF_HUMIDITY_SOURCE = "humidity_source"
 CONF_TEMPERATURE_SOURCE = "temperature_source"
 CONF_VOC_SOURCE = "voc_source"
 CONF_NOX_SOURCE = "nox_source"
+CONF_HUMIDITY_POLLER = "humidity_poller"
+CONF_HUMIDITY_BURST_INTERVAL = "humidity_burst_interval"
+CONF_HUMIDITY_BURST_PRE_RATE = "humidity_burst_pre_rate"
+CONF_HUMIDITY_BURST_PRE_MARGIN = "humidity_burst_pre_margin"
+CONF_HUMIDITY_BURST_MAX = "humidity_burst_max"
+CONF_EFFORT_SLEW_UP = "effort_slew_up"
+CONF_EFFORT_SLEW_DOWN = "effort_slew_down"
+CONF_EFFORT_MIN_ON = "effort_min_on"
+CONF_EFFORT_FLOOR = "effort_floor"
 CONF_SHOWER_THRESHOLD_NUMBER = "shower_threshold_number"
 CONF_CLEARING_NUMBER = "clearing_number"
 CONF_MOULD_THRESHOLD_NUMBER = "mould_threshold_number"
@@ -42,13 +55,21 @@ CONF_SHOWER_DETECTION_SWITCH = "shower_detection_switch"
 CONF_MODULE_STATUS_ID = "module_status_id"
 CONF_EXPECTED_VOC = "expected_voc"
 CONF_EXPECTED_NOX = "expected_nox"
+CONF_SHARED_AIRIQ_ENGINE = "shared_airiq_engine"
+CONF_MOULD_PERSISTENCE = "mould_persistence"
+CONF_MOULD_COMMIT_INTERVAL = "mould_commit_interval"
+CONF_MOULD_RESTORE_MAX_GAP = "mould_restore_max_gap"
 
 _WINDOWS = (
     "humidity_warmup", "humidity_stale",
     "temperature_warmup", "temperature_stale",
-    "voc_warmup", "voc_stale",
-    "nox_warmup", "nox_stale",
 )
+_POLLUTANT_WINDOWS = ("voc_warmup", "voc_stale", "nox_warmup", "nox_stale")
+# The embedded pollutant engine's feeds and configuration; a shared AirIQ
+# engine is configured and fed by its own component, so these are refused.
+_POLLUTANT_KEYS = (
+    CONF_VOC_SOURCE, CONF_NOX_SOURCE, CONF_EXPECTED_VOC, CONF_EXPECTED_NOX,
+) + _POLLUTANT_WINDOWS
 _HEURISTICS = (
     "shower_rate_threshold", "shower_end_delta", "shower_max_minutes",
     "mould_duration_minutes", "humidity_high_threshold", "humidity_hysteresis",
@@ -60,6 +81,34 @@ _schema = {
     cv.Optional(CONF_TEMPERATURE_SOURCE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_VOC_SOURCE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_NOX_SOURCE): cv.use_id(sensor.Sensor),
+    # The humidity sensor's polling component. Bound, its update interval
+    # follows the engine's shower-onset burst sampling: the burst interval
+    # from a pre-trigger (rate of rise, or humidity within the margin of the
+    # shower threshold) through the end of the clearing window — at most
+    # humidity_burst_max without a shower claim — and the sensor's own
+    # configured interval otherwise. The burst interval cannot go below
+    # 5 s: the engine's 2-minute rate window holds every sample down to
+    # that cadence and no further.
+    cv.Optional(CONF_HUMIDITY_POLLER): cv.use_id(cg.PollingComponent),
+    cv.Optional(CONF_HUMIDITY_BURST_INTERVAL, default="5s"): cv.All(
+        cv.positive_time_period_milliseconds, cv.Range(min=TimePeriod(seconds=5))
+    ),
+    cv.Optional(CONF_HUMIDITY_BURST_PRE_RATE, default=2.5): cv.positive_float,
+    cv.Optional(CONF_HUMIDITY_BURST_PRE_MARGIN, default=10.0): cv.float_range(
+        min=0.0, max=100.0
+    ),
+    cv.Optional(
+        CONF_HUMIDITY_BURST_MAX, default="5min"
+    ): cv.positive_time_period_milliseconds,
+    # Continuous ventilation effort shaping (the ventilation_effort sensor):
+    # rise/fall slew limits in %/min, the minimum on-time once started and
+    # the minimum running effort (a variable-speed fan's stall floor).
+    cv.Optional(CONF_EFFORT_SLEW_UP, default=120.0): cv.positive_float,
+    cv.Optional(CONF_EFFORT_SLEW_DOWN, default=20.0): cv.positive_float,
+    cv.Optional(
+        CONF_EFFORT_MIN_ON, default="3min"
+    ): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_EFFORT_FLOOR, default=20.0): cv.float_range(min=0.0, max=100.0),
     # Genuinely wired customer controls stay persisted template entities in
     # YAML (entity ids and restore identity are protected contracts).
     cv.Optional(CONF_SHOWER_THRESHOLD_NUMBER): cv.use_id(number.Number),
@@ -67,15 +116,81 @@ _schema = {
     cv.Optional(CONF_MOULD_THRESHOLD_NUMBER): cv.use_id(number.Number),
     cv.Optional(CONF_SHOWER_DETECTION_SWITCH): cv.use_id(switch.Switch),
     cv.Optional(CONF_MODULE_STATUS_ID): cv.use_id(text_sensor.TextSensor),
-    cv.Optional(CONF_EXPECTED_VOC, default=True): cv.boolean,
-    cv.Optional(CONF_EXPECTED_NOX, default=True): cv.boolean,
+    # expected_voc / expected_nox default true on the embedded engine.
+    cv.Optional(CONF_EXPECTED_VOC): cv.boolean,
+    cv.Optional(CONF_EXPECTED_NOX): cv.boolean,
+    # On a composition that also carries sense360_airiq: read VOC/NOx truth
+    # from its engine instead of an embedded copy (classified, stored and
+    # evaluated once). That engine's configuration and feeds then govern
+    # VOC/NOx — the VOC/NOx sources, expected flags and windows here are
+    # rejected — and its headline air quality and health are VentIQ's.
+    cv.Optional(CONF_SHARED_AIRIQ_ENGINE, default=False): cv.boolean,
+    # The mould-risk accumulator survives reboots and OTA in a flash
+    # preference. Committed when its risk level changes, at most every
+    # mould_commit_interval otherwise, and at a clean shutdown — never per
+    # evaluation. With time_id, a restore older than mould_restore_max_gap
+    # is discarded (the damp spell cannot be assumed unbroken).
+    cv.Optional(CONF_MOULD_PERSISTENCE, default=True): cv.boolean,
+    cv.Optional(
+        CONF_MOULD_COMMIT_INTERVAL, default="1h"
+    ): cv.positive_time_period_milliseconds,
+    cv.Optional(
+        CONF_MOULD_RESTORE_MAX_GAP, default="6h"
+    ): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
 }
 for _key in _WINDOWS:
     _schema[cv.Required(_key)] = cv.positive_time_period_milliseconds
+for _key in _POLLUTANT_WINDOWS:
+    _schema[cv.Optional(_key)] = cv.positive_time_period_milliseconds
 for _key in _HEURISTICS:
     _schema[cv.Required(_key)] = cv.float_
 
-CONFIG_SCHEMA = cv.Schema(_schema).extend(cv.COMPONENT_SCHEMA)
+
+def _validate_pollutant_mode(config):
+    if config[CONF_SHARED_AIRIQ_ENGINE]:
+        for key in _POLLUTANT_KEYS:
+            if key in config:
+                raise cv.Invalid(
+                    f"{key} does not apply with {CONF_SHARED_AIRIQ_ENGINE}: the "
+                    "sense360_airiq component configures and feeds VOC/NOx",
+                    path=[key],
+                )
+        return config
+    for key in _POLLUTANT_WINDOWS:
+        if key not in config:
+            raise cv.Invalid("required key not provided", path=[key])
+    config.setdefault(CONF_EXPECTED_VOC, True)
+    config.setdefault(CONF_EXPECTED_NOX, True)
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(_schema).extend(cv.COMPONENT_SCHEMA), _validate_pollutant_mode
+)
+
+
+def _final_validate(config):
+    if not config[CONF_SHARED_AIRIQ_ENGINE]:
+        return config
+    airiq = CORE.config.get("sense360_airiq")
+    if airiq is None:
+        raise cv.Invalid(
+            f"{CONF_SHARED_AIRIQ_ENGINE} needs a sense360_airiq component in the "
+            "same composition"
+        )
+    # The shared engine stores only the channels its composition sources or
+    # expects; VentIQ's odour signal reads both VOC and NOx.
+    for channel in ("voc", "nox"):
+        if f"{channel}_source" not in airiq and not airiq[f"expected_{channel}"]:
+            raise cv.Invalid(
+                f"{CONF_SHARED_AIRIQ_ENGINE} needs sense360_airiq to set "
+                f"{channel}_source or expected_{channel}: true"
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
 
 
 async def to_code(config):
@@ -87,23 +202,32 @@ async def to_code(config):
         (CONF_TEMPERATURE_SOURCE, var.set_temperature_source),
         (CONF_VOC_SOURCE, var.set_voc_source),
         (CONF_NOX_SOURCE, var.set_nox_source),
+        (CONF_HUMIDITY_POLLER, var.set_humidity_poller),
         (CONF_SHOWER_THRESHOLD_NUMBER, var.set_shower_threshold_number),
         (CONF_CLEARING_NUMBER, var.set_clearing_number),
         (CONF_MOULD_THRESHOLD_NUMBER, var.set_mould_threshold_number),
         (CONF_SHOWER_DETECTION_SWITCH, var.set_shower_detection_switch),
         (CONF_MODULE_STATUS_ID, var.set_module_status_text_sensor),
+        (CONF_TIME_ID, var.set_time),
     ):
         if key in config:
             bound = await cg.get_variable(config[key])
             cg.add(setter(bound))
 
-    cg.add(var.set_expected(config[CONF_EXPECTED_VOC], config[CONF_EXPECTED_NOX]))
+    # A build flag rather than a define: every translation unit that
+    # includes the engine header must agree on global_engine()'s type.
+    if config[CONF_SHARED_AIRIQ_ENGINE]:
+        cg.add_build_flag("-DSENSE360_VENTIQ_SHARED_AIRIQ")
+    else:
+        cg.add(
+            var.set_expected(config[CONF_EXPECTED_VOC], config[CONF_EXPECTED_NOX])
+        )
+    # A shared engine ignores the VOC/NOx windows (its owner configures it).
     cg.add(
         var.set_windows(
             config["humidity_warmup"], config["humidity_stale"],
             config["temperature_warmup"], config["temperature_stale"],
-            config["voc_warmup"], config["voc_stale"],
-            config["nox_warmup"], config["nox_stale"],
+            *(config.get(key, 0) for key in _POLLUTANT_WINDOWS),
         )
     )
     cg.add(
@@ -113,3 +237,26 @@ async def to_code(config):
             config["humidity_high_threshold"], config["humidity_hysteresis"],
         )
     )
+    cg.add(
+        var.set_mould_persistence(
+            config[CONF_MOULD_PERSISTENCE],
+            config[CONF_MOULD_COMMIT_INTERVAL],
+            config[CONF_MOULD_RESTORE_MAX_GAP],
+        )
+    )
+    cg.add(
+        var.set_humidity_burst(
+            config[CONF_HUMIDITY_BURST_INTERVAL],
+            config[CONF_HUMIDITY_BURST_PRE_RATE],
+            config[CONF_HUMIDITY_BURST_PRE_MARGIN],
+            config[CONF_HUMIDITY_BURST_MAX],
+        )
+    )
+    cg.add(
+        var.set_ventilation_effort(
+            config[CONF_EFFORT_SLEW_UP],
+            config[CONF_EFFORT_SLEW_DOWN],
+            config[CONF_EFFORT_MIN_ON],
+            config[CONF_EFFORT_FLOOR],
+        )
+    )
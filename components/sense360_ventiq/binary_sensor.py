@@ -1,6 +1,7 @@
 """sense360_ventiq binary_sensor platform (SENSE360-CANONICALISATION-001 PR 11).
 
-Component-owned ventilation / shower / mould-risk outputs.
+Component-owned ventilation / shower / mould-risk outputs and the humidity
+burst-sampling mode diagnostic.
 """
 
 import esphome.codegen as cg
@@ -10,6 +11,7 @@ from esphome.const import (
     CONF_TYPE,
     DEVICE_CLASS_MOISTURE,
     DEVICE_CLASS_PROBLEM,
+    ENTITY_CATEGORY_DIAGNOSTIC,
 )
 
 from . import Sense360VentIQ
@@ -38,6 +40,13 @@ TYPES = {
         ),
         "setter": "set_mould_risk_binary_sensor",
     },
+    "humidity_burst": {
+        "schema": binary_sensor.binary_sensor_schema(
+            icon="mdi:timer-play-outline",
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        "setter": "set_humidity_burst_binary_sensor",
+    },
 }
 
 
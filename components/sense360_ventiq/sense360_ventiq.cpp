@@ -1,8 +1,10 @@
 #include "sense360_ventiq.h"
 
+#include <cinttypes>
 #include <cmath>
 
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -19,6 +21,16 @@ void Sense360VentIQ::setup() {
   auto &engine = global_engine();
   engine.begin(millis());
 
+  // The persisted mould accumulator is restored once the wall clock can
+  // date it or the first humidity sample arrives, whichever is first (see
+  // restore_mould_()).
+  if (this->mould_persistence_) {
+    engine.set_mould_commit_interval_ms(this->mould_commit_interval_ms_);
+    this->mould_pref_ = global_preferences->make_preference<MouldSnapshot>(
+        fnv1_hash("sense360_ventiq_mould"), true);
+    this->mould_restore_pending_ = this->mould_pref_.load(&this->mould_saved_);
+  }
+
   // The freshness signal is the real update callback. Humidity and
   // temperature are the RoomIQ CANONICAL calibrated entities (an invalid
   // upstream sample never refreshes this engine's channel either); VOC and
@@ -55,6 +67,13 @@ void Sense360VentIQ::setup() {
     });
   }
 
+  // The YAML-configured humidity cadence is the burst policy's "normal"
+  // interval.
+  if (this->humidity_poller_ != nullptr) {
+    this->humidity_normal_ms_ = this->humidity_poller_->get_update_interval();
+    this->humidity_applied_ms_ = this->humidity_normal_ms_;
+  }
+
   // Control changes re-evaluate immediately (the controls stay persisted
   // template entities in YAML; their values are read in evaluate()).
   for (number::Number *n : {this->shower_threshold_number_, this->clearing_number_,
@@ -122,10 +141,21 @@ void Sense360VentIQ::evaluate() {
   engine.set_mould_duration_minutes(this->mould_duration_minutes_);
   engine.set_humidity_high_pct(this->humidity_high_);
   engine.set_humidity_hysteresis_pct(this->humidity_hysteresis_);
+  engine.set_burst_pre_rate(this->burst_pre_rate_);
+  engine.set_burst_pre_margin_pct(this->burst_pre_margin_);
+  engine.set_burst_max_minutes(this->burst_max_ms_ / 60000.0f);
+  engine.set_effort_slew(this->effort_slew_up_, this->effort_slew_down_);
+  engine.set_effort_min_on_minutes(this->effort_min_on_ms_ / 60000.0f);
+  engine.set_effort_floor_pct(this->effort_floor_);
   if (this->shower_detection_switch_ != nullptr)
     engine.set_shower_detection_enabled(this->shower_detection_switch_->state);
 
+  if (this->mould_restore_pending_)
+    this->restore_mould_(now);
   engine.evaluate(now);
+  this->apply_humidity_interval_();
+  if (this->mould_persistence_ && engine.mould_commit_due(now))
+    this->commit_mould_(now);
 
   // Honest numeric outputs: a stale channel goes unknown — never a frozen
   // reading.
@@ -148,6 +178,8 @@ void Sense360VentIQ::evaluate() {
                          engine.ventilation_needed());
   this->publish_changed_(this->shower_binary_sensor_, engine.shower_active());
   this->publish_changed_(this->mould_risk_binary_sensor_, engine.mould_warning());
+  this->publish_changed_(this->humidity_burst_binary_sensor_,
+                         engine.humidity_burst_active());
 
   // Module health — real SGP41 freshness evidence driving the
   // Core-Framework reserved runtime vocabulary. The RoomIQ-owned humidity
@@ -155,30 +187,146 @@ void Sense360VentIQ::evaluate() {
   this->publish_changed_(this->module_status_text_sensor_,
                          sense360::airiq::health_to_string(engine.health()));
 
-  // Diagnostics (publish on change only).
+  // Continuous ventilation effort (publish on a 1 % step; 0 and 100 always
+  // land exactly so a consuming fan stops and reaches full speed).
+  if (this->ventilation_effort_sensor_ != nullptr) {
+    const float effort = engine.ventilation_effort_pct();
+    const float last = this->ventilation_effort_sensor_->state;
+    if (!this->ventilation_effort_sensor_->has_state() || std::fabs(last - effort) >= 1.0f ||
+        (effort != last && (effort == 0.0f || effort == 100.0f)))
+      this->ventilation_effort_sensor_->publish_state(effort);
+  }
+
+  // Diagnostics (publish on change only; the burst duty on a 0.1 % step).
+  if (this->humidity_burst_duty_sensor_ != nullptr) {
+    const float duty = engine.humidity_burst_duty_pct();
+    if (!this->humidity_burst_duty_sensor_->has_state() ||
+        std::fabs(this->humidity_burst_duty_sensor_->state - duty) >= 0.1f)
+      this->humidity_burst_duty_sensor_->publish_state(duty);
+  }
   if (this->state_detail_text_sensor_ != nullptr) {
     char buffer[200];
     snprintf(buffer, sizeof(buffer),
              "demand=%s reason=%s shower=%s clearing=%.1fmin "
-             "mould=%d humidity=%s voc=%s nox=%s",
+             "mould=%d humidity=%s sampling=%s voc=%s nox=%s",
              demand_to_string(engine.demand()), reason_to_string(engine.reason()),
              engine.shower_active() ? "yes" : "no",
              engine.clearing_minutes_remaining(), engine.mould_risk(),
              engine.humidity_fresh() ? "fresh" : "not-fresh",
+             engine.humidity_burst_active() ? "burst" : "normal",
              engine.voc_fresh() ? "fresh" : "not-fresh",
              engine.nox_fresh() ? "fresh" : "not-fresh");
     this->publish_changed_(this->state_detail_text_sensor_, std::string(buffer));
   }
 }
 
+// Re-arm the humidity sensor's poller only when the burst policy's interval
+// changes (each evaluate, so a pre-trigger sample speeds up the very next
+// poll).
+void Sense360VentIQ::apply_humidity_interval_() {
+  if (this->humidity_poller_ == nullptr)
+    return;
+  auto &engine = sense360::ventiq::global_engine();
+  engine.set_humidity_sample_intervals(this->burst_interval_ms_, this->humidity_normal_ms_);
+  const uint32_t interval = engine.humidity_sample_interval_ms();
+  if (interval == this->humidity_applied_ms_)
+    return;
+  ESP_LOGD(TAG, "Humidity update interval %" PRIu32 "ms -> %" PRIu32 "ms",
+           this->humidity_applied_ms_, interval);
+  this->humidity_applied_ms_ = interval;
+  this->humidity_poller_->set_update_interval(interval);
+  this->humidity_poller_->start_poller();
+}
+
+// Wall clock in seconds since the epoch, 0 while unknown.
+uint32_t Sense360VentIQ::epoch_s_() {
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    const ESPTime clock = this->time_->now();
+    if (clock.is_valid())
+      return static_cast<uint32_t>(clock.timestamp);
+  }
+#endif
+  return 0;
+}
+
+// Restore the persisted accumulator before the first fresh humidity sample
+// is evaluated. With a clock composed, wait for it to be valid so the
+// engine can check the gap — unless humidity arrives first. The source has
+// a state from boot (RoomIQ publishes NAN on its first offer), so only a
+// real value counts as arrived.
+void Sense360VentIQ::restore_mould_(uint32_t now) {
+  const uint32_t epoch = this->epoch_s_();
+  bool clock_composed = false;
+#ifdef USE_TIME
+  clock_composed = this->time_ != nullptr;
+#endif
+  const bool humidity_arrived = this->humidity_source_ != nullptr &&
+                                this->humidity_source_->has_state() &&
+                                !std::isnan(this->humidity_source_->state);
+  if (clock_composed && epoch == 0 && !humidity_arrived)
+    return;
+  this->mould_restore_pending_ = false;
+  auto &engine = sense360::ventiq::global_engine();
+  if (engine.restore_mould(now, this->mould_saved_, epoch, this->mould_max_gap_ms_ / 1000)) {
+    ESP_LOGI(TAG, "Mould accumulator restored: %.1f min damp%s",
+             this->mould_saved_.wet_ms / 60000.0f,
+             epoch == 0 || this->mould_saved_.saved_epoch_s == 0 ? " (gap unknown)" : "");
+  } else {
+    // Supersede the discarded record, so a later boot without a clock
+    // cannot restore it.
+    ESP_LOGI(TAG, "Persisted mould accumulator discarded (gap too long)");
+    this->commit_mould_(now);
+  }
+}
+
+void Sense360VentIQ::commit_mould_(uint32_t now) {
+  const sense360::ventiq::MouldSnapshot snapshot =
+      sense360::ventiq::global_engine().commit_mould(now, this->epoch_s_());
+  this->mould_pref_.save(&snapshot);
+  this->mould_commits_++;
+  ESP_LOGD(TAG, "Mould accumulator committed (%.1f min damp, commit %" PRIu32 ")",
+           snapshot.wet_ms / 60000.0f, this->mould_commits_);
+}
+
+void Sense360VentIQ::on_safe_shutdown() {
+  if (!this->mould_persistence_ || this->mould_restore_pending_)
+    return;
+  if (sense360::ventiq::global_engine().mould_dirty()) {
+    this->commit_mould_(millis());
+    global_preferences->sync();
+  }
+}
+
 void Sense360VentIQ::dump_config() {
   ESP_LOGCONFIG(TAG, "Sense360 VentIQ (glue over the canonical ventilation "
                      "engine singleton; model logic lives in "
                      "components/sense360/ventiq_engine.h)");
-  ESP_LOGCONFIG(TAG,
-                "  Expected channels: voc=%s nox=%s (composition facts; the "
-                "RoomIQ humidity input never drives module health)",
-                YESNO(this->expected_voc_), YESNO(this->expected_nox_));
+  if (sense360::ventiq::FirmwareVentIQEngine::shares_pollutant_engine()) {
+    ESP_LOGCONFIG(TAG, "  Pollutants: shared AirIQ engine (configured, fed and "
+                       "evaluated by sense360_airiq)");
+  } else {
+    ESP_LOGCONFIG(TAG,
+                  "  Expected channels: voc=%s nox=%s (composition facts; the "
+                  "RoomIQ humidity input never drives module health)",
+                  YESNO(this->expected_voc_), YESNO(this->expected_nox_));
+  }
+  if (this->mould_persistence_) {
+    ESP_LOGCONFIG(TAG, "  Mould accumulator persisted: commit on risk change or every %" PRIu32
+                       "ms, and at clean shutdown; restore gap limit %" PRIu32 "ms",
+                  this->mould_commit_interval_ms_, this->mould_max_gap_ms_);
+  }
+  ESP_LOGCONFIG(TAG, "  Ventilation effort: +%.0f/-%.0f %%/min, floor %.0f %%, "
+                     "minimum on %" PRIu32 "ms",
+                this->effort_slew_up_, this->effort_slew_down_, this->effort_floor_,
+                this->effort_min_on_ms_);
+  if (this->humidity_poller_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Humidity burst sampling: %" PRIu32 "ms (normal %" PRIu32
+                       "ms) from %.1f %%/min or %.0f %%RH below the shower "
+                       "threshold, unclaimed for at most %" PRIu32 "ms",
+                  this->burst_interval_ms_, this->humidity_normal_ms_,
+                  this->burst_pre_rate_, this->burst_pre_margin_, this->burst_max_ms_);
+  }
 }
 
 }  // namespace sense360_ventiq
@@ -5,7 +5,8 @@
 // ============================================================================
 // Glue only: feeds and publishes the canonical VentIQ ventilation engine
 // singleton (sense360::ventiq::global_engine(), which embeds the canonical
-// AirIQ engine for pollutant truth — thresholds are never duplicated here).
+// AirIQ engine for pollutant truth, or shares sense360_airiq's — thresholds
+// are never duplicated here).
 // The ventilation model (shower detection, clearing, mould risk, demand,
 // module health) lives in the natively tested engine header. See
 // docs/architecture/sense360-airiq-ventiq-component-plan.md.
@@ -23,7 +24,11 @@
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/components/sense360/ventiq_engine.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
 #include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
 
 namespace esphome {
 namespace sense360_ventiq {
@@ -34,6 +39,9 @@ class Sense360VentIQ : public Component {
   void set_temperature_source(sensor::Sensor *s) { temperature_source_ = s; }
   void set_voc_source(sensor::Sensor *s) { voc_source_ = s; }
   void set_nox_source(sensor::Sensor *s) { nox_source_ = s; }
+  // The humidity sensor's polling component (optional): when bound, its
+  // update interval follows the engine's shower-onset burst sampling.
+  void set_humidity_poller(PollingComponent *p) { humidity_poller_ = p; }
   void set_shower_threshold_number(number::Number *n) { shower_threshold_number_ = n; }
   void set_clearing_number(number::Number *n) { clearing_number_ = n; }
   void set_mould_threshold_number(number::Number *n) { mould_threshold_number_ = n; }
@@ -67,6 +75,34 @@ class Sense360VentIQ : public Component {
     humidity_high_ = humidity_high;
     humidity_hysteresis_ = humidity_hysteresis;
   }
+  // Flash persistence of the mould-risk accumulator: commit interval (the
+  // engine's write policy) and the longest wall-clock gap a restore
+  // accepts; disabled, the accumulator starts from zero at every boot.
+  void set_mould_persistence(bool enabled, uint32_t commit_interval_ms,
+                             uint32_t max_gap_ms) {
+    mould_persistence_ = enabled;
+    mould_commit_interval_ms_ = commit_interval_ms;
+    mould_max_gap_ms_ = max_gap_ms;
+  }
+#ifdef USE_TIME
+  // Wall clock for the persisted accumulator's gap check; without one a
+  // restore cannot tell how long the device was down.
+  void set_time(time::RealTimeClock *clock) { time_ = clock; }
+#endif
+  void set_humidity_burst(uint32_t interval_ms, float pre_rate, float pre_margin,
+                          uint32_t max_ms) {
+    burst_interval_ms_ = interval_ms;
+    burst_pre_rate_ = pre_rate;
+    burst_pre_margin_ = pre_margin;
+    burst_max_ms_ = max_ms;
+  }
+  void set_ventilation_effort(float slew_up, float slew_down, uint32_t min_on_ms,
+                              float floor_pct) {
+    effort_slew_up_ = slew_up;
+    effort_slew_down_ = slew_down;
+    effort_min_on_ms_ = min_on_ms;
+    effort_floor_ = floor_pct;
+  }
 
   // --- output entities (platform-registered; nullptr = not composed) ---
   void set_voc_sensor(sensor::Sensor *s) { voc_sensor_ = s; }
@@ -84,9 +120,16 @@ class Sense360VentIQ : public Component {
   void set_mould_risk_binary_sensor(binary_sensor::BinarySensor *b) {
     mould_risk_binary_sensor_ = b;
   }
+  void set_humidity_burst_binary_sensor(binary_sensor::BinarySensor *b) {
+    humidity_burst_binary_sensor_ = b;
+  }
+  void set_humidity_burst_duty_sensor(sensor::Sensor *s) { humidity_burst_duty_sensor_ = s; }
+  void set_ventilation_effort_sensor(sensor::Sensor *s) { ventilation_effort_sensor_ = s; }
 
   void setup() override;
   void dump_config() override;
+  // Commits an outstanding mould accumulator before a clean reboot.
+  void on_safe_shutdown() override;
   float get_setup_priority() const override;
 
   // The single evaluation owner. Public for the framework's same-id bridge
@@ -96,11 +139,16 @@ class Sense360VentIQ : public Component {
  protected:
   void publish_changed_(text_sensor::TextSensor *target, const std::string &value);
   void publish_changed_(binary_sensor::BinarySensor *target, bool value);
+  void apply_humidity_interval_();
+  uint32_t epoch_s_();
+  void restore_mould_(uint32_t now);
+  void commit_mould_(uint32_t now);
 
   sensor::Sensor *humidity_source_{nullptr};
   sensor::Sensor *temperature_source_{nullptr};
   sensor::Sensor *voc_source_{nullptr};
   sensor::Sensor *nox_source_{nullptr};
+  PollingComponent *humidity_poller_{nullptr};
   number::Number *shower_threshold_number_{nullptr};
   number::Number *clearing_number_{nullptr};
   number::Number *mould_threshold_number_{nullptr};
@@ -116,6 +164,9 @@ class Sense360VentIQ : public Component {
   binary_sensor::BinarySensor *ventilation_needed_binary_sensor_{nullptr};
   binary_sensor::BinarySensor *shower_binary_sensor_{nullptr};
   binary_sensor::BinarySensor *mould_risk_binary_sensor_{nullptr};
+  binary_sensor::BinarySensor *humidity_burst_binary_sensor_{nullptr};
+  sensor::Sensor *humidity_burst_duty_sensor_{nullptr};
+  sensor::Sensor *ventilation_effort_sensor_{nullptr};
 
   bool expected_voc_{true};
   bool expected_nox_{true};
@@ -133,6 +184,26 @@ class Sense360VentIQ : public Component {
   float mould_duration_minutes_{30};
   float humidity_high_{60};
   float humidity_hysteresis_{2};
+  uint32_t burst_interval_ms_{5000};
+  float burst_pre_rate_{2.5f};
+  float burst_pre_margin_{10};
+  uint32_t burst_max_ms_{300000};
+  float effort_slew_up_{120};
+  float effort_slew_down_{20};
+  uint32_t effort_min_on_ms_{180000};
+  float effort_floor_{20};
+  uint32_t humidity_normal_ms_{0};  // the poller's configured interval, read at setup
+  uint32_t humidity_applied_ms_{0};
+  bool mould_persistence_{true};
+  uint32_t mould_commit_interval_ms_{3600000};
+  uint32_t mould_max_gap_ms_{21600000};
+  ESPPreferenceObject mould_pref_;
+  sense360::ventiq::MouldSnapshot mould_saved_{};
+  bool mould_restore_pending_{false};
+  uint32_t mould_commits_{0};  // flash commits since boot (dump/log only)
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
 };
 
 }  // namespace sense360_ventiq
@@ -1,13 +1,20 @@
 """sense360_ventiq sensor platform (SENSE360-CANONICALISATION-001 PR 11).
 
 Component-owned SGP41 relative indices — deliberately unitless, never
-presented as concentrations.
+presented as concentrations — the continuous ventilation effort for
+variable-speed fan outputs, and the humidity burst-sampling duty cycle
+diagnostic.
 """
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor
-from esphome.const import CONF_TYPE, STATE_CLASS_MEASUREMENT
+from esphome.const import (
+    CONF_TYPE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_PERCENT,
+)
 
 from . import Sense360VentIQ
 
@@ -30,6 +37,25 @@ TYPES = {
         ),
         "setter": "set_nox_sensor",
     },
+    "ventilation_effort": {
+        "schema": sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            state_class=STATE_CLASS_MEASUREMENT,
+            accuracy_decimals=0,
+            icon="mdi:fan",
+        ),
+        "setter": "set_ventilation_effort_sensor",
+    },
+    "humidity_burst_duty": {
+        "schema": sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            state_class=STATE_CLASS_MEASUREMENT,
+            accuracy_decimals=1,
+            icon="mdi:timer-sand",
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        "setter": "set_humidity_burst_duty_sensor",
+    },
 }
 
 
@@ -650,8 +650,11 @@ class FrameworkMechanicsTests(unittest.TestCase):
         cpp = (REPO_ROOT / "components" / "sense360_airiq"
                / "sense360_airiq.cpp").read_text()
         self.assertIn("add_on_state_callback", cpp)
-        for hook in ("input_co2", "input_voc", "input_nox", "input_hcho"):
+        # Callbacks stage into one engine frame (one evaluation per frame).
+        self.assertIn("input_frame", cpp)
+        for hook in ("FRAME_CO2", "FRAME_VOC", "FRAME_NOX", "FRAME_HCHO"):
             self.assertIn(hook, cpp, hook)
+        self.assertNotIn("pm2_5_source:", self.raw)
         self.assertNotIn("input_pm2_5", self.raw)
         self.assertNotIn("input_pm2_5", cpp)
 
@@ -736,7 +739,10 @@ class EngineHeaderTests(unittest.TestCase):
     def test_namespace_and_engine(self) -> None:
         self.assertIn("namespace sense360", self.raw)
         self.assertIn("namespace airiq", self.raw)
-        self.assertIn("class AirIQEngine", self.raw)
+        # One engine template specialised per composition; AirIQEngine is
+        # the all-channels engine.
+        self.assertIn("class BasicAirIQEngine", self.raw)
+        self.assertIn("BasicAirIQEngine<ALL_CHANNELS> AirIQEngine", self.raw)
 
     def test_state_strings_are_single_sourced(self) -> None:
         for value in SEVERITY_STRINGS + RECOMMENDATION_STRINGS + HEALTH_STRINGS:
@@ -1327,8 +1333,13 @@ class SPS30OverlayTests(unittest.TestCase):
         self.doc = load_yaml(SPS30_OVERLAY)
 
     def test_overlay_feeds_engine_pm_channels(self) -> None:
-        for needle in ("input_pm2_5", "input_pm1", "input_pm4", "input_pm10"):
-            self.assertIn(needle, self.raw, needle)
+        # The four fractions of one SPS30 read are bound as component
+        # sources, so the glue commits them as ONE engine frame.
+        airiq = self.doc.get("sense360_airiq") or {}
+        for key in ("pm2_5_source", "pm1_source", "pm4_source", "pm10_source"):
+            self.assertIn(key, airiq, key)
+        # No per-fraction lambda feeding (one evaluation per fraction).
+        self.assertNotIn("input_pm", self.raw)
 
     def test_overlay_reenables_pm_customer_entities(self) -> None:
         for pm in ("s360_pm2_5", "s360_pm1", "s360_pm4", "s360_pm10"):
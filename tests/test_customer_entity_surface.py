@@ -264,8 +264,8 @@ class TestNothingWasDeleted(unittest.TestCase):
     EXPECTED_TOTALS = {
         "Ceiling-POE-RoomIQ": 98,
         "Ceiling-POE-AirIQ-RoomIQ": 140,
-        "Ceiling-POE-VentIQ-RoomIQ": 136,
-        "Ceiling-POE-VentIQ-RoomIQ-LED": 148,
+        "Ceiling-POE-VentIQ-RoomIQ": 139,
+        "Ceiling-POE-VentIQ-RoomIQ-LED": 151,
     }
 
     def test_entity_totals_are_unchanged(self):
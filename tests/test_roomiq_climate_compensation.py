@@ -267,7 +267,30 @@ class ClimateProfileTests(unittest.TestCase):
 
     def test_engine_default_profile_is_the_s360_200_r4_profile(self) -> None:
         raw = ENGINE_HEADER.read_text()
-        self.assertIn(f"climate_profile_ = &{PROFILE_ID}()", raw)
+        self.assertIn("climate_profile_ = &compiled_climate_profile()", raw)
+        self.assertIn(
+            "#define SENSE360_CLIMATE_PROFILE CLIMATE_PROFILE_S360_200_R4_V1",
+            self.raw,
+        )
+
+    def test_codegen_profile_ids_match_the_registry(self) -> None:
+        # Every sense360_roomiq `climate_profile` choice names a registry
+        # entry and its ClimateProfileId, and the default is the R4 profile.
+        component = (
+            REPO_ROOT / "components" / "sense360_roomiq" / "__init__.py"
+        ).read_text()
+        table = re.search(
+            r"ENTRIES\[CLIMATE_PROFILE_COUNT\] = \{(.*?)\n  \};", self.raw, re.S
+        )
+        self.assertIsNotNone(table)
+        header_ids = re.findall(r'\{"([A-Z0-9_]+)",', table.group(1))
+        codegen = dict(
+            re.findall(r'"([A-Z0-9_]+)": "(CLIMATE_PROFILE_[A-Z0-9_]+)"', component)
+        )
+        self.assertEqual(sorted(header_ids), sorted(codegen))
+        for enumerator in codegen.values():
+            self.assertRegex(self.raw, rf"\n  {enumerator} = \d+,")
+        self.assertIn(f'DEFAULT_CLIMATE_PROFILE = "{PROFILE_ID}"', component)
 
 
 # --- The model itself (independent reference) --------------------------------
@@ -415,13 +438,17 @@ class Sht45DriverContractTests(unittest.TestCase):
         # and no engine input exists for a second temperature source.
         framework = FRAMEWORK_PACKAGE.read_text()
         self.assertNotIn("comfort_ceiling_bmp_temperature", framework)
-        # The engine exposes exactly three sensor inputs, none of which is a
-        # second temperature source, so the die temperature has nowhere to go.
+        # The engine exposes exactly three sensor inputs plus the normalised
+        # board heat load of the self-heating model — none of them a second
+        # temperature source, so the die temperature has nowhere to go.
         engine = ENGINE_HEADER.read_text()
         inputs = sorted(set(re.findall(r"void (input_\w+)\(", engine)))
         self.assertEqual(
-            inputs, ["input_humidity", "input_lux", "input_temperature"], inputs
+            inputs,
+            ["input_board_heat", "input_humidity", "input_lux", "input_temperature"],
+            inputs,
         )
+        self.assertRegex(engine, r"void input_board_heat\(uint32_t now_ms, float load\)")
         self.assertNotIn(
             "comfort_ceiling_bmp_temperature", COMPENSATION_HEADER.read_text()
         )
@@ -472,11 +499,16 @@ class CustomerContractTests(unittest.TestCase):
             self.assertEqual(entity.get("platform"), "sense360_roomiq", entity_id)
             self.assertNotIn("source_id", entity, entity_id)
         cpp = COMPONENT_CPP.read_text()
-        self.assertIn(
-            "publish_changed_(this->temperature_sensor_, engine.temperature())", cpp
+        # Each publish goes through the entity's change band.
+        self.assertRegex(
+            cpp,
+            r"publish_changed_\(this->temperature_sensor_, this->temperature_band_, "
+            r"now,\s+engine\.temperature\(\)\)",
         )
-        self.assertIn(
-            "publish_changed_(this->humidity_sensor_, engine.humidity())", cpp
+        self.assertRegex(
+            cpp,
+            r"publish_changed_\(this->humidity_sensor_, this->humidity_band_, now,"
+            r"\s+engine\.humidity\(\)\)",
         )
 
     def test_presentation_precision(self) -> None:
@@ -514,9 +546,32 @@ class CustomerContractTests(unittest.TestCase):
         # One publisher, publishing NaN (unknown) whenever the engine reports
         # the channel is no longer fresh (the switchboard moved to the
         # component glue in PR 09).
+        # The change bands (PublishDeadband, in the engine header) never
+        # hold back a transition between a real value and NaN.
         cpp = COMPONENT_CPP.read_text()
         self.assertIn("publish_changed_", cpp)
-        self.assertIn("std::isnan(current) && std::isnan(value)", cpp)
+        self.assertIn("band.offer(now, value)", cpp)
+        engine = ENGINE_HEADER.read_text()
+        self.assertIn(
+            "if (std::isnan(value) || was_nan) return std::isnan(value) != was_nan;",
+            engine,
+        )
+
+    def test_climate_heartbeat_fits_inside_ventiq_freshness(self) -> None:
+        # The canonical temperature / humidity feed VentIQ, whose humidity
+        # stale window is 90 s: a steady reading held back by its change
+        # band must still be republished inside that window.
+        init = (REPO_ROOT / "components" / "sense360_roomiq" / "__init__.py").read_text()
+        match = re.search(
+            r'CONF_CLIMATE_PUBLISH_HEARTBEAT, default="(\d+)s"', init
+        )
+        self.assertIsNotNone(match)
+        ventiq = (REPO_ROOT / "packages" / "features" / "ventiq_framework.yaml").read_text()
+        stale = re.search(r'ventiq_humidity_stale_ms: "(\d+)"', ventiq)
+        self.assertIsNotNone(stale)
+        self.assertLess(int(match.group(1)) * 1000, int(stale.group(1)))
+        header = COMPONENT_CPP.with_suffix(".h").read_text()
+        self.assertIn("void set_climate_publish_heartbeat(uint32_t heartbeat_ms)", header)
 
 
 # --- Diagnostics -------------------------------------------------------------
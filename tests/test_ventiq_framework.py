@@ -733,13 +733,16 @@ class EngineHeaderTests(unittest.TestCase):
     def test_namespace_and_engine(self) -> None:
         self.assertIn("namespace sense360", self.raw)
         self.assertIn("namespace ventiq", self.raw)
-        self.assertIn("class VentIQEngine", self.raw)
+        self.assertIn("class BasicVentIQEngine", self.raw)
+        self.assertIn(
+            "typedef BasicVentIQEngine<EmbeddedPollutants> VentIQEngine;", self.raw
+        )
 
     def test_consumes_the_canonical_airiq_engine(self) -> None:
         # Pollutant severity is CONSUMED from the AirIQ engine — never
         # reimplemented. The header includes it and embeds an instance.
         self.assertIn('#include "airiq_engine.h"', self.raw)
-        self.assertIn("airiq::AirIQEngine", self.raw)
+        self.assertIn("airiq::BasicAirIQEngine<", self.raw)
 
     def test_no_duplicated_pollutant_thresholds_in_header(self) -> None:
         # The VOC band values (150/250/400) and NOx band values
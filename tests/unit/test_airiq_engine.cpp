@@ -661,10 +661,1149 @@ TEST_CASE(declared_external_pm_missing_degrades_honestly) {
   ASSERT_EQ(e.air_quality(), AIR_QUALITY_GOOD);  // honest partial headline
 }
 
+// ---------------------------------------------------------------------------
+// Deadline-driven evaluation (the glue arms one timer for the next change)
+// ---------------------------------------------------------------------------
+
+TEST_CASE(deadline_is_the_earliest_warmup_expiry_at_startup) {
+  // Nothing seen yet: CO2 / PM / HCHO warm-ups (60 s) lapse before the
+  // VOC / NOx / O3 ones (120 s).
+  AirIQEngine e = started_engine();
+  ASSERT_EQ(e.next_deadline_ms(T0), 60000u);
+  ASSERT_EQ(e.next_deadline_ms(T0 + 10000), 50000u);
+  // One millisecond before the deadline CO2 is still initialising; at the
+  // deadline it is honestly missing.
+  e.evaluate(T0 + 59999);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_INITIALISING);
+  e.evaluate(T0 + 60000);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_UNAVAILABLE);
+  // Next the pressure warm-up (90 s), then VOC / NOx (120 s).
+  ASSERT_EQ(e.next_deadline_ms(T0 + 60000), 30000u);
+  ASSERT_EQ(e.next_deadline_ms(T0 + 90000), 30000u);
+}
+
+TEST_CASE(deadline_tracks_the_stale_expiry_of_fresh_channels) {
+  AirIQEngine e = started_engine();
+  const uint32_t t = AFTER_ALL_WARMUPS;
+  e.input_co2(t, 600.0f);
+  e.input_voc(t + 20000, 80.0f);
+  e.evaluate(t + 20000);
+  // CO2 goes stale first: fresh while age <= 90 s, so the first evaluation
+  // that observes the change is at age 90 s + 1 ms.
+  const uint32_t delay = e.next_deadline_ms(t + 20000);
+  ASSERT_EQ(delay, 70001u);
+  e.evaluate(t + 20000 + delay - 1);
+  ASSERT_TRUE(e.pollutant_fresh(POLLUTANT_CO2));
+  e.evaluate(t + 20000 + delay);
+  ASSERT_FALSE(e.pollutant_fresh(POLLUTANT_CO2));
+  // The stale VOC expiry is next.
+  ASSERT_EQ(e.next_deadline_ms(t + 20000 + delay), 20000u);
+}
+
+TEST_CASE(deadline_covers_pressure_and_mics_windows) {
+  AirIQEngine e = started_engine();
+  const uint32_t t = AFTER_ALL_WARMUPS;
+  e.evaluate(t);  // every pollutant warm-up has lapsed
+  ASSERT_EQ(e.next_deadline_ms(t), AirIQEngine::NO_DEADLINE);
+  e.input_pressure(t, 1000.0f);
+  ASSERT_EQ(e.next_deadline_ms(t), 180001u);
+  e.input_mics_reducing(t + 1000, 12.0f);
+  ASSERT_EQ(e.next_deadline_ms(t + 1000), 90001u);
+  e.evaluate(t + 1000 + 90001);
+  ASSERT_NAN(e.mics_reducing());
+  ASSERT_NEAR(e.pressure(), 1000.0f, 0.01f);
+}
+
+TEST_CASE(no_deadline_when_every_channel_is_already_missing) {
+  // An idle device with nothing pending schedules no work at all.
+  AirIQEngine e = started_engine();
+  feed_all_good(e, T0 + 5000);
+  e.evaluate(AFTER_ALL_WARMUPS + 400000);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_UNAVAILABLE);
+  ASSERT_EQ(e.next_deadline_ms(AFTER_ALL_WARMUPS + 400000),
+            AirIQEngine::NO_DEADLINE);
+}
+
+TEST_CASE(deadline_survives_millis_wrap) {
+  AirIQEngine e;
+  const uint32_t start = 0xFFFFFFFFu - 30000u;
+  e.begin(start);
+  e.input_co2(start + 20000, 600.0f);
+  const uint32_t now = start + 40000;  // wrapped past zero
+  e.evaluate(now);
+  ASSERT_TRUE(e.pollutant_fresh(POLLUTANT_CO2));
+  // Earliest: the PM / HCHO warm-ups at start + 60 s (20 s away).
+  ASSERT_EQ(e.next_deadline_ms(now), 20000u);
+}
+
+TEST_CASE(deadline_driven_schedule_matches_a_fine_grained_poll) {
+  // An engine evaluated only on input and at its reported deadlines shows
+  // the same outputs at every instant as one polled every second.
+  AirIQEngine polled = started_engine();
+  AirIQEngine scheduled = started_engine();
+  uint32_t next = T0;
+  for (uint32_t t = T0; t <= T0 + 400000; t += 1000) {
+    bool input = false;
+    if (t == T0 + 5000 || t == T0 + 35000 || t == T0 + 65000) {
+      polled.input_co2(t, 1200.0f);
+      scheduled.input_co2(t, 1200.0f);
+      input = true;
+    }
+    if (t == T0 + 70000) {
+      polled.input_voc(t, 80.0f);
+      scheduled.input_voc(t, 80.0f);
+      input = true;
+    }
+    polled.evaluate(t);
+    if (input || t >= next) {
+      scheduled.evaluate(t);
+      const uint32_t delay = scheduled.next_deadline_ms(t);
+      next = delay == AirIQEngine::NO_DEADLINE ? 0xFFFFFFFFu : t + delay;
+    }
+    ASSERT_EQ(scheduled.air_quality(), polled.air_quality());
+    ASSERT_EQ(scheduled.recommendation(), polled.recommendation());
+    ASSERT_EQ(scheduled.health(), polled.health());
+    for (int p = 0; p < POLLUTANT_COUNT; p++) {
+      ASSERT_EQ(scheduled.severity(static_cast<Pollutant>(p)),
+                polled.severity(static_cast<Pollutant>(p)));
+    }
+  }
+  ASSERT_EQ(polled.air_quality(), AIR_QUALITY_UNAVAILABLE);
+}
+
+// ---------------------------------------------------------------------------
+// Incremental evaluation (dirty tracking) — bit-identical to a full pass
+// ---------------------------------------------------------------------------
+
+// Deterministic pseudo-random source (no <random> distribution variance
+// across standard libraries).
+static uint32_t lcg_next(uint32_t &state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+static bool same_float(float a, float b) {
+  if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static void assert_identical_outputs(const AirIQEngine &a,
+                                     const AirIQEngine &b) {
+  ASSERT_EQ(a.air_quality(), b.air_quality());
+  ASSERT_EQ(a.recommendation(), b.recommendation());
+  ASSERT_EQ(a.health(), b.health());
+  ASSERT_EQ(a.worst_pollutant(), b.worst_pollutant());
+  for (int p = 0; p < POLLUTANT_COUNT; p++) {
+    const Pollutant pollutant = static_cast<Pollutant>(p);
+    ASSERT_EQ(a.severity(pollutant), b.severity(pollutant));
+    ASSERT_EQ(a.pollutant_fresh(pollutant), b.pollutant_fresh(pollutant));
+  }
+  ASSERT_TRUE(same_float(a.co2(), b.co2()));
+  ASSERT_TRUE(same_float(a.voc(), b.voc()));
+  ASSERT_TRUE(same_float(a.nox(), b.nox()));
+  ASSERT_TRUE(same_float(a.pm2_5(), b.pm2_5()));
+  ASSERT_TRUE(same_float(a.hcho(), b.hcho()));
+  ASSERT_TRUE(same_float(a.o3(), b.o3()));
+  ASSERT_TRUE(same_float(a.pm1(), b.pm1()));
+  ASSERT_TRUE(same_float(a.pressure(), b.pressure()));
+  ASSERT_TRUE(same_float(a.mics_reducing(), b.mics_reducing()));
+}
+
+TEST_CASE(incremental_evaluate_is_bit_identical_to_full_recompute) {
+  // Randomised bursts, gaps long enough to go stale, invalid samples,
+  // threshold / hysteresis / expectation / fault changes mid-stream. The
+  // reference engine is invalidated before every evaluation (the former
+  // full recompute); the incremental one only reclassifies what changed.
+  const float span[POLLUTANT_COUNT] = {2500.0f, 500.0f, 400.0f,
+                                       90.0f,   300.0f, 150.0f};
+  for (uint32_t seed = 1; seed <= 8; seed++) {
+    uint32_t rng = seed;
+    AirIQEngine incremental = started_engine();
+    AirIQEngine full = started_engine();
+    uint32_t t = T0;
+    for (int step = 0; step < 4000; step++) {
+      t += 500 + lcg_next(rng) % 20000;
+      const uint32_t action = lcg_next(rng) % 100;
+      if (action < 60) {
+        const int burst = 1 + lcg_next(rng) % 4;
+        for (int k = 0; k < burst; k++) {
+          const Pollutant p =
+              static_cast<Pollutant>(lcg_next(rng) % POLLUTANT_COUNT);
+          float v = (lcg_next(rng) % 10000) / 10000.0f * span[p];
+          if (lcg_next(rng) % 50 == 0) v = -1.0f;  // invalid
+          const uint32_t at = t + k;
+          switch (p) {
+            case POLLUTANT_CO2:
+              incremental.input_co2(at, v);
+              full.input_co2(at, v);
+              break;
+            case POLLUTANT_VOC:
+              incremental.input_voc(at, v);
+              full.input_voc(at, v);
+              break;
+            case POLLUTANT_NOX:
+              incremental.input_nox(at, v);
+              full.input_nox(at, v);
+              break;
+            case POLLUTANT_PM25:
+              incremental.input_pm2_5(at, v);
+              full.input_pm2_5(at, v);
+              incremental.input_pm1(at, v * 0.6f);
+              full.input_pm1(at, v * 0.6f);
+              break;
+            case POLLUTANT_HCHO:
+              incremental.input_hcho(at, v);
+              full.input_hcho(at, v);
+              break;
+            default:
+              incremental.input_o3(at, v);
+              full.input_o3(at, v);
+              break;
+          }
+        }
+      } else if (action < 63) {
+        const Pollutant p =
+            static_cast<Pollutant>(lcg_next(rng) % POLLUTANT_COUNT);
+        const float scale = 0.3f + (lcg_next(rng) % 120) / 100.0f;
+        const float fair = span[p] * 0.2f * scale;
+        incremental.set_thresholds(p, fair, fair * 1.5f, fair * 2.5f);
+        full.set_thresholds(p, fair, fair * 1.5f, fair * 2.5f);
+      } else if (action < 64) {
+        const Pollutant p =
+            static_cast<Pollutant>(lcg_next(rng) % POLLUTANT_COUNT);
+        const float margin = span[p] * (lcg_next(rng) % 20) / 100.0f;
+        incremental.set_hysteresis(p, margin);
+        full.set_hysteresis(p, margin);
+      } else if (action < 67) {
+        const Pollutant p =
+            static_cast<Pollutant>(lcg_next(rng) % POLLUTANT_COUNT);
+        const bool expected = lcg_next(rng) % 2 == 0;
+        incremental.set_expected(p, expected);
+        full.set_expected(p, expected);
+      } else if (action < 68) {
+        const bool fault = lcg_next(rng) % 4 == 0;
+        incremental.set_fault(fault);
+        full.set_fault(fault);
+      } else if (action < 72) {
+        incremental.input_pressure(t, 1000.0f);
+        full.input_pressure(t, 1000.0f);
+        incremental.input_mics_reducing(t, 5.0f);
+        full.input_mics_reducing(t, 5.0f);
+      }
+      // else: an idle tick (time-driven transitions only).
+      t += 4;
+      incremental.evaluate(t);
+      full.invalidate();
+      full.evaluate(t);
+      assert_identical_outputs(incremental, full);
+    }
+  }
+}
+
+TEST_CASE(time_driven_transitions_reach_a_clean_engine) {
+  // No input between evaluations: the stale transition alone must still
+  // reclassify the channel and rebuild the headline.
+  AirIQEngine e = started_engine();
+  e.input_co2(AFTER_ALL_WARMUPS, 1600.0f);  // Very poor
+  e.input_voc(AFTER_ALL_WARMUPS, 80.0f);
+  e.input_nox(AFTER_ALL_WARMUPS + 60000, 10.0f);
+  e.evaluate(AFTER_ALL_WARMUPS + 60000);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_VERY_POOR);
+  ASSERT_EQ(e.recommendation(), RECOMMENDATION_VENTILATE_NOW);
+  e.evaluate(AFTER_ALL_WARMUPS + 60000 + 40000);  // CO2 + VOC stale
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_UNAVAILABLE);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_GOOD);  // NOx alone, honestly
+  ASSERT_EQ(e.recommendation(), RECOMMENDATION_NO_ACTION);
+  ASSERT_EQ(e.health(), HEALTH_DEGRADED);
+}
+
+TEST_CASE(configuration_changes_reclassify_without_new_input) {
+  AirIQEngine e = started_engine();
+  feed_all_good(e, T0 + 5000);
+  e.evaluate(T0 + 6000);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_GOOD);
+  e.set_thresholds(POLLUTANT_CO2, 500.0f, 550.0f, 580.0f);
+  e.evaluate(T0 + 7000);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_VERY_POOR);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_VERY_POOR);
+  e.set_expected(POLLUTANT_CO2, false);
+  e.evaluate(T0 + 8000);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_GOOD);
+  e.set_fault(true);
+  e.evaluate(T0 + 9000);
+  ASSERT_EQ(e.health(), HEALTH_FAULT);
+}
+
+// ---------------------------------------------------------------------------
+// Immutable configuration (applied once, versioned)
+// ---------------------------------------------------------------------------
+
+// The shape the sense360_airiq codegen emits: substitution-driven CO2 /
+// VOC / NOx / PM2.5 channels, formaldehyde and ozone from the defaults.
+static constexpr AirIQConfig GENERATED_CONFIG = AirIQConfig{
+    1u,
+    {ChannelConfig{true, 60000u, 90000u, 800.0f, 1000.0f, 1500.0f, 50.0f},
+     ChannelConfig{true, 120000u, 90000u, 150.0f, 250.0f, 400.0f, 10.0f},
+     ChannelConfig{true, 120000u, 90000u, 100.0f, 200.0f, 300.0f, 10.0f},
+     ChannelConfig{false, 60000u, 90000u, 12.0f, 35.5f, 55.5f, 3.0f},
+     default_channel_config(POLLUTANT_HCHO).with_expected(true),
+     default_channel_config(POLLUTANT_O3).with_expected(false)},
+    0.0f};
+
+// Built entirely at compile time.
+static_assert(GENERATED_CONFIG.channels[POLLUTANT_HCHO].expected,
+              "formaldehyde expectation comes from the composition");
+static_assert(GENERATED_CONFIG.channels[POLLUTANT_HCHO].fair == 80.0f,
+              "formaldehyde bands stay the engine defaults");
+static_assert(default_config().version == 0, "defaults are version 0");
+
+TEST_CASE(default_config_is_the_constructor_baseline) {
+  AirIQEngine e;
+  ASSERT_EQ(e.config_version(), 0u);
+  ASSERT_TRUE(e.expected(POLLUTANT_CO2));
+  ASSERT_TRUE(e.expected(POLLUTANT_VOC));
+  ASSERT_TRUE(e.expected(POLLUTANT_NOX));
+  ASSERT_FALSE(e.expected(POLLUTANT_PM25));
+  ASSERT_FALSE(e.expected(POLLUTANT_HCHO));
+  ASSERT_FALSE(e.expected(POLLUTANT_O3));
+  // Re-applying the applied version changes nothing.
+  ASSERT_FALSE(e.apply_config(default_config()));
+}
+
+TEST_CASE(generated_config_applies_once_and_only_on_a_new_version) {
+  AirIQEngine e = started_engine();
+  ASSERT_TRUE(e.apply_config(GENERATED_CONFIG));
+  ASSERT_EQ(e.config_version(), 1u);
+  ASSERT_TRUE(e.expected(POLLUTANT_HCHO));
+  ASSERT_FALSE(e.apply_config(GENERATED_CONFIG));
+
+  // A same-version value with different content is NOT a reconfigure.
+  AirIQConfig stricter = GENERATED_CONFIG;
+  stricter.channels[POLLUTANT_CO2].fair = 500.0f;
+  ASSERT_FALSE(e.apply_config(stricter));
+  e.input_co2(T0 + 5000, 600.0f);
+  e.evaluate(T0 + 5000);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_GOOD);
+
+  // An explicit reconfigure (new version) reclassifies at once, with no
+  // new input required.
+  stricter.version = 2u;
+  ASSERT_TRUE(e.apply_config(stricter));
+  e.evaluate(T0 + 6000);
+  ASSERT_EQ(e.severity(POLLUTANT_CO2), SEVERITY_FAIR);
+  ASSERT_EQ(e.config_version(), 2u);
+}
+
+TEST_CASE(config_matches_the_equivalent_setter_sequence) {
+  // apply_config() is exactly the former per-evaluate setter push.
+  AirIQEngine configured = started_engine();
+  AirIQEngine pushed = started_engine();
+  configured.apply_config(GENERATED_CONFIG);
+  for (int i = 0; i < POLLUTANT_COUNT; i++) {
+    const Pollutant p = static_cast<Pollutant>(i);
+    const ChannelConfig &c = GENERATED_CONFIG.channels[i];
+    pushed.set_expected(p, c.expected);
+    pushed.set_warmup_ms(p, c.warmup_ms);
+    pushed.set_stale_ms(p, c.stale_ms);
+    pushed.set_thresholds(p, c.fair, c.poor, c.very_poor);
+    pushed.set_hysteresis(p, c.hysteresis);
+  }
+  const uint32_t t = T0 + 5000;
+  AirIQEngine *engines[] = {&configured, &pushed};
+  for (AirIQEngine *e : engines) {
+    feed_all_good(*e, t);
+    e->input_hcho(t, 130.0f);  // Poor formaldehyde (expected here)
+    e->evaluate(t + 1000);
+  }
+  assert_identical_outputs(configured, pushed);
+  ASSERT_EQ(configured.air_quality(), AIR_QUALITY_POOR);
+  ASSERT_EQ(configured.recommendation(), RECOMMENDATION_CHECK_SOURCE);
+}
+
 // ---------------------------------------------------------------------------
 // Vocabulary single-sourcing
 // ---------------------------------------------------------------------------
 
+// --- multi-channel frames ---------------------------------------------------
+
+TEST_CASE(frame_equals_separate_inputs_and_one_evaluation) {
+  // One SPS30 frame (all four fractions) plus an SCD41 CO2 sample commit
+  // at one timestamp and evaluate once — exactly the legacy per-channel
+  // calls followed by a single evaluate().
+  AirIQEngine framed = started_engine();
+  AirIQEngine separate = started_engine();
+  framed.set_expected(POLLUTANT_PM25, true);
+  separate.set_expected(POLLUTANT_PM25, true);
+  const uint32_t t = T0 + 5000;
+  feed_all_good(framed, t);
+  feed_all_good(separate, t);
+  framed.evaluate(t);
+  separate.evaluate(t);
+
+  AirIQFrame frame;
+  frame.set(FRAME_CO2, 1200.0f);
+  frame.set(FRAME_PM1, 20.0f);
+  frame.set(FRAME_PM2_5, 40.0f);
+  frame.set(FRAME_PM4, 45.0f);
+  frame.set(FRAME_PM10, 50.0f);
+  framed.input_frame(t + 1000, frame);
+
+  separate.input_co2(t + 1000, 1200.0f);
+  separate.input_pm2_5(t + 1000, 40.0f);
+  separate.input_pm1(t + 1000, 20.0f);
+  separate.input_pm4(t + 1000, 45.0f);
+  separate.input_pm10(t + 1000, 50.0f);
+  separate.evaluate(t + 1000);
+
+  assert_identical_outputs(framed, separate);
+  ASSERT_EQ(framed.severity(POLLUTANT_PM25), SEVERITY_POOR);
+  ASSERT_NEAR(framed.frame_value(FRAME_PM10), 50.0f, 1e-6f);
+  ASSERT_NEAR(framed.frame_value(FRAME_CO2), 1200.0f, 1e-6f);
+  // Absent fields were not touched: VOC still carries its earlier sample.
+  ASSERT_NEAR(framed.voc(), 80.0f, 1e-6f);
+}
+
+TEST_CASE(frame_fractions_require_a_valid_pm2_5) {
+  // Fractions without a valid PM2.5 from the same frame would describe a
+  // different measurement from the classified one: they are dropped.
+  AirIQEngine e = started_engine();
+  const uint32_t t = T0 + 5000;
+  AirIQFrame frame;
+  frame.set(FRAME_PM1, 5.0f);
+  frame.set(FRAME_PM10, 9.0f);
+  e.input_frame(t, frame);
+  ASSERT_NAN(e.pm1());
+  ASSERT_NAN(e.pm10());
+
+  frame.set(FRAME_PM2_5, NAN);
+  e.input_frame(t + 1000, frame);
+  ASSERT_NAN(e.pm2_5());
+  ASSERT_NAN(e.pm1());
+
+  frame.set(FRAME_PM2_5, 7.0f);
+  e.input_frame(t + 2000, frame);
+  ASSERT_NEAR(e.pm2_5(), 7.0f, 1e-6f);
+  ASSERT_NEAR(e.pm1(), 5.0f, 1e-6f);
+  ASSERT_NEAR(e.pm10(), 9.0f, 1e-6f);
+  ASSERT_NAN(e.pm4());  // never carried
+}
+
+TEST_CASE(frame_presence_mask_is_explicit) {
+  AirIQFrame frame;
+  ASSERT_TRUE(frame.empty());
+  frame.set(FRAME_NOX, 0.0f);  // a real zero reading, not an absent field
+  ASSERT_TRUE(frame.has(FRAME_NOX));
+  ASSERT_TRUE(frame.valid(FRAME_NOX));
+  ASSERT_FALSE(frame.has(FRAME_VOC));
+  frame.set(FRAME_VOC, -1.0f);
+  ASSERT_TRUE(frame.has(FRAME_VOC));
+  ASSERT_FALSE(frame.valid(FRAME_VOC));
+  frame.clear();
+  ASSERT_TRUE(frame.empty());
+  ASSERT_FALSE(frame.has(FRAME_NOX));
+
+  // An empty frame still evaluates (time may have moved a window).
+  AirIQEngine e = started_engine();
+  e.input_frame(AFTER_ALL_WARMUPS, frame);
+  ASSERT_EQ(e.health(), HEALTH_UNAVAILABLE);
+}
+
+// --- compile-time composition specialisation --------------------------------
+
+// The production channel sets (sense360_airiq codegen: bound sources plus
+// expected channels; VentIQ: its SGP41 pair).
+static const uint8_t AIRIQ_BOARD_CHANNELS =
+    channel_bit(POLLUTANT_CO2) | channel_bit(POLLUTANT_VOC) |
+    channel_bit(POLLUTANT_NOX) | channel_bit(POLLUTANT_HCHO);
+static const uint8_t AIRIQ_SPS30_CHANNELS =
+    AIRIQ_BOARD_CHANNELS | channel_bit(POLLUTANT_PM25);
+static const uint8_t AIRIQ_NO_SFA40_CHANNELS =
+    channel_bit(POLLUTANT_CO2) | channel_bit(POLLUTANT_VOC) |
+    channel_bit(POLLUTANT_NOX);
+static const uint8_t VENTIQ_CHANNELS =
+    channel_bit(POLLUTANT_VOC) | channel_bit(POLLUTANT_NOX);
+
+// Drive a specialised engine and the all-channels reference with the same
+// randomised stream on EVERY channel. Channels outside the set are never
+// expected in the reference, so the composition outputs must match
+// exactly; in the specialised engine those channels simply do not exist.
+template <uint8_t Channels>
+static void check_specialisation_matches_reference(uint32_t seed) {
+  typedef BasicAirIQEngine<Channels> Engine;
+  const float span[POLLUTANT_COUNT] = {2500.0f, 500.0f, 400.0f,
+                                       90.0f,   300.0f, 150.0f};
+  uint32_t rng = seed;
+  Engine specialised;
+  AirIQEngine reference;
+  specialised.begin(T0);
+  reference.begin(T0);
+  for (int p = 0; p < POLLUTANT_COUNT; p++) {
+    const Pollutant pollutant = static_cast<Pollutant>(p);
+    if (!Engine::has_channel(pollutant)) reference.set_expected(pollutant, false);
+    ASSERT_EQ(specialised.expected(pollutant), reference.expected(pollutant));
+  }
+  uint32_t t = T0;
+  for (int step = 0; step < 3000; step++) {
+    t += 500 + lcg_next(rng) % 20000;
+    const uint32_t action = lcg_next(rng) % 100;
+    if (action < 70) {
+      AirIQFrame frame;
+      const int fields = 1 + lcg_next(rng) % 4;
+      for (int k = 0; k < fields; k++) {
+        const int p = lcg_next(rng) % POLLUTANT_COUNT;
+        float v = (lcg_next(rng) % 10000) / 10000.0f * span[p];
+        if (lcg_next(rng) % 50 == 0) v = NAN;  // invalid
+        frame.set(static_cast<FrameField>(p), v);
+        if (p == POLLUTANT_PM25) frame.set(FRAME_PM10, v * 1.4f);
+      }
+      specialised.input_frame(t, frame);
+      reference.input_frame(t, frame);
+    } else if (action < 75) {
+      const Pollutant p =
+          static_cast<Pollutant>(lcg_next(rng) % POLLUTANT_COUNT);
+      const bool expected = lcg_next(rng) % 3 != 0;
+      specialised.set_expected(p, expected);
+      if (Engine::has_channel(p)) reference.set_expected(p, expected);
+      ASSERT_EQ(specialised.expected(p), reference.expected(p));
+    } else if (action < 77) {
+      specialised.input_pressure(t, 1000.0f);
+      reference.input_pressure(t, 1000.0f);
+      specialised.input_mics_oxidising(t, 3.0f);
+      reference.input_mics_oxidising(t, 3.0f);
+    }
+    t += 4;
+    specialised.evaluate(t);
+    reference.evaluate(t);
+
+    ASSERT_EQ(specialised.air_quality(), reference.air_quality());
+    ASSERT_EQ(specialised.recommendation(), reference.recommendation());
+    ASSERT_EQ(specialised.health(), reference.health());
+    ASSERT_EQ(specialised.worst_pollutant(), reference.worst_pollutant());
+    for (int p = 0; p < POLLUTANT_COUNT; p++) {
+      const Pollutant pollutant = static_cast<Pollutant>(p);
+      const FrameField field = static_cast<FrameField>(p);
+      if (Engine::has_channel(pollutant)) {
+        ASSERT_EQ(specialised.severity(pollutant), reference.severity(pollutant));
+        ASSERT_TRUE(same_float(specialised.frame_value(field),
+                               reference.frame_value(field)));
+      } else {
+        ASSERT_EQ(specialised.severity(pollutant), SEVERITY_UNAVAILABLE);
+        ASSERT_NAN(specialised.frame_value(field));
+        ASSERT_FALSE(specialised.pollutant_fresh(pollutant));
+        ASSERT_NAN(specialised.pollutant_data_age_s(pollutant, t));
+      }
+    }
+    ASSERT_TRUE(same_float(specialised.pm10(),
+                           Engine::has_channel(POLLUTANT_PM25)
+                               ? reference.pm10()
+                               : NAN));
+    // No production set carries pressure or MiCS.
+    ASSERT_NAN(specialised.pressure());
+    ASSERT_NAN(specialised.mics_oxidising());
+  }
+}
+
+TEST_CASE(specialised_compositions_match_the_reference_engine) {
+  for (uint32_t seed = 1; seed <= 3; seed++) {
+    check_specialisation_matches_reference<AIRIQ_BOARD_CHANNELS>(seed);
+    check_specialisation_matches_reference<AIRIQ_SPS30_CHANNELS>(seed);
+    check_specialisation_matches_reference<AIRIQ_NO_SFA40_CHANNELS>(seed);
+    check_specialisation_matches_reference<VENTIQ_CHANNELS>(seed);
+  }
+}
+
+TEST_CASE(absent_channels_are_inert_and_carry_no_deadline) {
+  // A VOC/NOx engine never waits on (or reports) a CO2 warm-up.
+  BasicAirIQEngine<VENTIQ_CHANNELS> e;
+  e.begin(T0);
+  e.set_expected(POLLUTANT_CO2, true);
+  ASSERT_FALSE(e.expected(POLLUTANT_CO2));
+  e.set_warmup_ms(POLLUTANT_VOC, 5000);
+  e.set_warmup_ms(POLLUTANT_NOX, 7000);
+  ASSERT_EQ(e.next_deadline_ms(T0), 5000u);
+  e.input_co2(T0 + 10, 2000.0f);
+  e.input_pressure(T0 + 10, 1013.0f);
+  e.input_pm1(T0 + 10, 3.0f);
+  e.evaluate(T0 + 10);
+  ASSERT_NAN(e.co2());
+  ASSERT_NAN(e.pm1());
+  ASSERT_NAN(e.pressure());
+  ASSERT_EQ(e.health(), HEALTH_INITIALISING);
+  e.input_voc(T0 + 20, 80.0f);
+  e.input_nox(T0 + 20, 10.0f);
+  e.evaluate(T0 + 20);
+  ASSERT_EQ(e.health(), HEALTH_AVAILABLE);
+  ASSERT_EQ(e.air_quality(), AIR_QUALITY_GOOD);
+}
+
+TEST_CASE(specialised_engines_shrink_with_the_composition) {
+  // RAM footprint per composition (host sizeof; the ESP32 layout has the
+  // same 4-byte float / uint32_t alignment).
+  const size_t all = sizeof(AirIQEngine);
+  const size_t sps30 = sizeof(BasicAirIQEngine<AIRIQ_SPS30_CHANNELS>);
+  const size_t board = sizeof(BasicAirIQEngine<AIRIQ_BOARD_CHANNELS>);
+  const size_t no_sfa40 = sizeof(BasicAirIQEngine<AIRIQ_NO_SFA40_CHANNELS>);
+  const size_t ventiq = sizeof(BasicAirIQEngine<VENTIQ_CHANNELS>);
+  printf("    sizeof: all=%u sps30=%u board=%u no-sfa40=%u ventiq=%u\n",
+         (unsigned) all, (unsigned) sps30, (unsigned) board,
+         (unsigned) no_sfa40, (unsigned) ventiq);
+  ASSERT_TRUE(sps30 < all);
+  ASSERT_TRUE(board < sps30);
+  ASSERT_TRUE(no_sfa40 < board);
+  ASSERT_TRUE(ventiq < no_sfa40);
+}
+
+// --- rolling statistics -------------------------------------------------------
+
+// Every pollutant a sense360_airiq statistic output can name.
+static const uint8_t STATISTICS_CHANNELS = AIRIQ_SPS30_CHANNELS;
+typedef BasicAirIQEngine<ALL_CHANNELS, STATISTICS_CHANNELS> StatisticsEngine;
+
+static const uint32_t MINUTE_MS = 60000;
+static const uint32_t HOUR_MS = 60 * MINUTE_MS;
+
+TEST_CASE(statistics_summarise_each_window_from_bucket_aggregates) {
+  // Twelve 5-minute buckets, each a constant level (400, 500 ... 1500 ppm)
+  // sampled every 30 s.
+  StatisticsEngine e;
+  e.begin(T0);
+  for (int k = 0; k < 12; k++) {
+    for (int j = 0; j < 10; j++)
+      e.input_co2(T0 + k * 5 * MINUTE_MS + j * 30000, 400.0f + 100.0f * k);
+  }
+  const uint32_t end = T0 + HOUR_MS - 1;
+  const WindowStatistics hour = e.statistics(POLLUTANT_CO2, WINDOW_1H, end);
+  ASSERT_EQ(hour.samples, 120u);
+  ASSERT_NEAR(hour.mean, 950.0f, 0.01f);
+  ASSERT_NEAR(hour.min, 400.0f, 0.0f);
+  ASSERT_NEAR(hour.max, 1500.0f, 0.0f);
+  // Nearest rank 114 of 120 falls in the last bucket.
+  ASSERT_NEAR(hour.p95, 1500.0f, 0.0f);
+  ASSERT_NEAR(hour.get(STATISTIC_MEAN), hour.mean, 0.0f);
+  ASSERT_NEAR(hour.get(STATISTIC_P95), hour.p95, 0.0f);
+  // The long windows see the same samples from their hourly buckets.
+  const WindowStatistics day = e.statistics(POLLUTANT_CO2, WINDOW_24H, end);
+  ASSERT_EQ(day.samples, 120u);
+  ASSERT_NEAR(day.mean, 950.0f, 0.01f);
+  ASSERT_NEAR(day.min, 400.0f, 0.0f);
+  ASSERT_NEAR(day.max, 1500.0f, 0.0f);
+  ASSERT_NEAR(day.p95, 950.0f, 0.01f);  // one hourly bucket mean
+
+  // One instant later the oldest 5-minute bucket leaves the 1 h window.
+  const WindowStatistics moved =
+      e.statistics(POLLUTANT_CO2, WINDOW_1H, end + 1);
+  ASSERT_EQ(moved.samples, 110u);
+  ASSERT_NEAR(moved.min, 500.0f, 0.0f);
+  ASSERT_NEAR(moved.mean, 1000.0f, 0.01f);
+
+  // Other pollutants hold nothing yet.
+  ASSERT_EQ(e.statistics(POLLUTANT_VOC, WINDOW_1H, end).samples, 0u);
+  ASSERT_NAN(e.statistics(POLLUTANT_VOC, WINDOW_1H, end).mean);
+}
+
+TEST_CASE(statistics_windows_expire_bucket_by_bucket) {
+  // One sample per hour, value = hour index.
+  StatisticsEngine e;
+  e.begin(T0);
+  for (int h = 0; h < 30; h++)
+    e.input_hcho(T0 + h * HOUR_MS, static_cast<float>(h));
+  const uint32_t now = T0 + 29 * HOUR_MS;
+  const WindowStatistics eight = e.statistics(POLLUTANT_HCHO, WINDOW_8H, now);
+  ASSERT_EQ(eight.samples, 8u);
+  ASSERT_NEAR(eight.min, 22.0f, 0.0f);
+  ASSERT_NEAR(eight.max, 29.0f, 0.0f);
+  ASSERT_NEAR(eight.mean, 25.5f, 0.001f);
+  const WindowStatistics day = e.statistics(POLLUTANT_HCHO, WINDOW_24H, now);
+  ASSERT_EQ(day.samples, 24u);
+  ASSERT_NEAR(day.min, 6.0f, 0.0f);
+  ASSERT_NEAR(day.p95, 28.0f, 0.0f);  // nearest rank 23 of 24
+  ASSERT_EQ(e.statistics(POLLUTANT_HCHO, WINDOW_1H, now).samples, 1u);
+
+  // Queries never mutate: a later query simply excludes aged buckets, and
+  // a window with no sample left reads NAN.
+  ASSERT_EQ(e.statistics(POLLUTANT_HCHO, WINDOW_1H, now + HOUR_MS).samples,
+            0u);
+  ASSERT_EQ(e.statistics(POLLUTANT_HCHO, WINDOW_8H, now + 4 * HOUR_MS).samples,
+            4u);
+  const WindowStatistics gone =
+      e.statistics(POLLUTANT_HCHO, WINDOW_24H, now + 24 * HOUR_MS);
+  ASSERT_EQ(gone.samples, 0u);
+  ASSERT_NAN(gone.mean);
+  ASSERT_NAN(gone.min);
+  ASSERT_NAN(gone.max);
+  ASSERT_NAN(gone.p95);
+  ASSERT_EQ(e.statistics(POLLUTANT_HCHO, WINDOW_24H, now).samples, 24u);
+
+  // A day-long silence clears the whole ring on the next sample.
+  e.input_hcho(now + 30 * HOUR_MS, 100.0f);
+  const WindowStatistics after =
+      e.statistics(POLLUTANT_HCHO, WINDOW_24H, now + 30 * HOUR_MS);
+  ASSERT_EQ(after.samples, 1u);
+  ASSERT_NEAR(after.mean, 100.0f, 0.0f);
+}
+
+// Replays the same 26 h stream from two millis() origins; the statistics
+// must not depend on where the 2^32 wrap falls.
+static void feed_statistics_day(StatisticsEngine &e, uint32_t origin) {
+  uint32_t rng = 11;
+  e.begin(origin);
+  for (uint32_t t = 0; t < 26 * HOUR_MS; t += 20000) {
+    e.input_voc(origin + t, static_cast<float>(50 + lcg_next(rng) % 300));
+  }
+}
+
+TEST_CASE(statistics_survive_millis_wrap) {
+  StatisticsEngine reference;
+  StatisticsEngine wrapped;
+  const uint32_t wrap_origin = 0xFFFFFFFFu - 10 * HOUR_MS;  // wraps mid-stream
+  feed_statistics_day(reference, T0);
+  feed_statistics_day(wrapped, wrap_origin);
+  for (uint32_t q = 25 * HOUR_MS; q < 28 * HOUR_MS; q += 7 * MINUTE_MS) {
+    for (int w = WINDOW_1H; w <= WINDOW_24H; w++) {
+      const StatisticsWindow window = static_cast<StatisticsWindow>(w);
+      const WindowStatistics a =
+          reference.statistics(POLLUTANT_VOC, window, T0 + q);
+      const WindowStatistics b =
+          wrapped.statistics(POLLUTANT_VOC, window, wrap_origin + q);
+      ASSERT_EQ(a.samples, b.samples);
+      ASSERT_TRUE(same_float(a.mean, b.mean));
+      ASSERT_TRUE(same_float(a.min, b.min));
+      ASSERT_TRUE(same_float(a.max, b.max));
+      ASSERT_TRUE(same_float(a.p95, b.p95));
+    }
+  }
+  ASSERT_TRUE(wrapped.statistics(POLLUTANT_VOC, WINDOW_24H,
+                                 wrap_origin + 25 * HOUR_MS)
+                  .samples > 0);
+}
+
+TEST_CASE(stale_gaps_are_never_averaged_in) {
+  StatisticsEngine e;
+  e.begin(T0);
+  // 20 min at 400 ppm, a 30 min SCD41 dropout (the channel goes stale and
+  // its entity reads NAN), then 10 min at 1000 ppm; samples every 30 s.
+  uint32_t t = T0;
+  for (; t < T0 + 20 * MINUTE_MS; t += 30000) e.input_co2(t, 400.0f);
+  e.evaluate(T0 + 45 * MINUTE_MS);
+  ASSERT_NAN(e.co2());
+  e.input_co2(T0 + 30 * MINUTE_MS, NAN);   // invalid samples never count
+  e.input_co2(T0 + 31 * MINUTE_MS, -5.0f);
+  for (t = T0 + 50 * MINUTE_MS; t < T0 + HOUR_MS; t += 30000)
+    e.input_co2(t, 1000.0f);
+
+  const WindowStatistics hour =
+      e.statistics(POLLUTANT_CO2, WINDOW_1H, T0 + HOUR_MS - 1);
+  // Sample-weighted over the 60 real samples: (40*400 + 20*1000) / 60.
+  // Holding 400 ppm across the gap would have read 460 ppm.
+  ASSERT_EQ(hour.samples, 60u);
+  ASSERT_NEAR(hour.mean, 600.0f, 0.01f);
+  ASSERT_NEAR(hour.min, 400.0f, 0.0f);
+  ASSERT_NEAR(hour.max, 1000.0f, 0.0f);
+
+  // Statistics are not freshness-gated: once the channel is stale the
+  // windows still summarise what they hold, until it ages out.
+  const uint32_t later = T0 + 90 * MINUTE_MS;
+  e.evaluate(later);
+  ASSERT_NAN(e.co2());
+  const WindowStatistics held = e.statistics(POLLUTANT_CO2, WINDOW_1H, later);
+  ASSERT_EQ(held.samples, 20u);
+  ASSERT_NEAR(held.mean, 1000.0f, 0.0f);
+  ASSERT_EQ(e.statistics(POLLUTANT_CO2, WINDOW_1H, T0 + 2 * HOUR_MS).samples,
+            0u);
+  ASSERT_EQ(e.statistics(POLLUTANT_CO2, WINDOW_8H, T0 + 2 * HOUR_MS).samples,
+            60u);
+}
+
+TEST_CASE(statistics_are_a_per_pollutant_compile_time_opt_in) {
+  typedef BasicAirIQEngine<AIRIQ_SPS30_CHANNELS> Core;
+  typedef BasicAirIQEngine<AIRIQ_SPS30_CHANNELS, channel_bit(POLLUTANT_CO2)>
+      Co2Statistics;
+  typedef BasicAirIQEngine<AIRIQ_SPS30_CHANNELS, STATISTICS_CHANNELS>
+      AllStatistics;
+  printf("    sizeof: core=%u +co2 stats=%u +all stats=%u\n",
+         (unsigned) sizeof(Core), (unsigned) sizeof(Co2Statistics),
+         (unsigned) sizeof(AllStatistics));
+  // No statistics -> no storage; each kept pollutant costs the same block.
+  ASSERT_EQ(sizeof(AirIQEngine), sizeof(BasicAirIQEngine<ALL_CHANNELS, 0>));
+  ASSERT_TRUE(sizeof(Co2Statistics) > sizeof(Core));
+  ASSERT_EQ(sizeof(AllStatistics) - sizeof(Core),
+            5 * (sizeof(Co2Statistics) - sizeof(Core)));
+  // A statistics bit outside the channel set stores nothing.
+  ASSERT_EQ(sizeof(BasicAirIQEngine<VENTIQ_CHANNELS, channel_bit(POLLUTANT_CO2)>),
+            sizeof(BasicAirIQEngine<VENTIQ_CHANNELS>));
+
+  ASSERT_TRUE(Co2Statistics::has_statistics(POLLUTANT_CO2));
+  ASSERT_FALSE(Co2Statistics::has_statistics(POLLUTANT_VOC));
+  ASSERT_FALSE(Core::has_statistics(POLLUTANT_CO2));
+  Co2Statistics e;
+  e.begin(T0);
+  e.input_co2(T0, 700.0f);
+  e.input_voc(T0, 90.0f);
+  e.evaluate(T0);
+  ASSERT_NEAR(e.voc(), 90.0f, 0.0f);  // the core model is unaffected
+  ASSERT_EQ(e.statistics(POLLUTANT_CO2, WINDOW_1H, T0).samples, 1u);
+  ASSERT_EQ(e.statistics(POLLUTANT_VOC, WINDOW_1H, T0).samples, 0u);
+  ASSERT_NAN(e.statistics(POLLUTANT_VOC, WINDOW_1H, T0).mean);
+}
+
+// --- exposure dose ----------------------------------------------------------
+
+typedef BasicAirIQEngine<ALL_CHANNELS, 0, STATISTICS_CHANNELS> ExposureEngine;
+
+TEST_CASE(exposure_integrates_trapezoids_exactly_across_the_limit) {
+  // CO2 ramps linearly 800 -> 1200 ppm over one hour (sampled every 60 s):
+  // 1000 ppm·h in total, of which the triangle above the 1000 ppm Poor
+  // threshold is 0.5 * 0.5 h * 200 ppm = 50 ppm·h.
+  ExposureEngine e;
+  e.begin(T0);
+  for (int m = 0; m <= 60; m++)
+    e.input_co2(T0 + m * MINUTE_MS, 800.0f + 400.0f * m / 60.0f);
+  const ExposureSummary x = e.exposure(POLLUTANT_CO2, T0 + 60 * MINUTE_MS);
+  ASSERT_NEAR(x.integral, 1000.0f, 0.05f);
+  ASSERT_NEAR(x.get(EXPOSURE_DOSE), 50.0f, 0.01f);
+  ASSERT_NEAR(x.get(EXPOSURE_HOURS), 1.0f, 1e-5f);
+  ASSERT_NEAR(x.get(EXPOSURE_TWA), 1000.0f, 0.05f);
+  ASSERT_NEAR(x.get(EXPOSURE_TWA_8H), 125.0f, 0.01f);
+
+  // A segment crossing the limit mid-way counts only its part above it.
+  ExposureEngine crossing;
+  crossing.begin(T0);
+  crossing.input_pm2_5(T0, 25.5f);
+  crossing.input_pm2_5(T0 + MINUTE_MS, 45.5f);  // Poor lower bound 35.5
+  ASSERT_NEAR(crossing.exposure(POLLUTANT_PM25, T0 + MINUTE_MS).dose, 2.5f / 60.0f, 1e-5f);
+}
+
+TEST_CASE(stale_time_contributes_no_exposure) {
+  ExposureEngine e;
+  e.begin(T0);
+  e.set_stale_ms(POLLUTANT_CO2, 90000);
+  // 30 samples at 1500 ppm, a 10-minute SCD41 dropout, 30 more samples.
+  for (int m = 0; m < 30; m++) e.input_co2(T0 + m * MINUTE_MS, 1500.0f);
+  e.input_co2(T0 + 35 * MINUTE_MS, NAN);  // invalid: neither value nor time
+  for (int m = 40; m < 70; m++) e.input_co2(T0 + m * MINUTE_MS, 1500.0f);
+  const ExposureSummary x = e.exposure(POLLUTANT_CO2, T0 + 69 * MINUTE_MS);
+  ASSERT_NEAR(x.hours, 58.0f / 60.0f, 1e-5f);
+  ASSERT_NEAR(x.dose, 500.0f * 58.0f / 60.0f, 0.01f);
+  ASSERT_NEAR(x.get(EXPOSURE_TWA), 1500.0f, 0.01f);
+  // A gap exactly at the stale window still counts (the severity rule).
+  ExposureEngine edge;
+  edge.begin(T0);
+  edge.set_stale_ms(POLLUTANT_VOC, 90000);
+  edge.input_voc(T0, 100.0f);
+  edge.input_voc(T0 + 90000, 100.0f);
+  edge.input_voc(T0 + 180001, 100.0f);
+  ASSERT_NEAR(edge.exposure(POLLUTANT_VOC, T0 + 180001).hours, 90000.0f / HOUR_MS, 1e-7f);
+}
+
+TEST_CASE(exposure_matches_a_fine_grained_reference_integration) {
+  // A random stream with jittered intervals, some beyond the stale
+  // window, integrated against 1 s steps of the same linear segments.
+  ExposureEngine e;
+  e.begin(T0);
+  e.set_stale_ms(POLLUTANT_NOX, 90000);
+  uint32_t rng = 5;
+  uint32_t t = T0;
+  float last = NAN;
+  double integral = 0.0;
+  double dose = 0.0;
+  double covered_s = 0.0;
+  for (int i = 0; i < 2000; i++) {
+    const uint32_t gap = (lcg_next(rng) % 10 == 0) ? 95000 + lcg_next(rng) % 60000
+                                                   : 5000 + lcg_next(rng) % 80000;
+    t += gap - gap % 1000;
+    const float v = static_cast<float>(lcg_next(rng) % 400);
+    if (!std::isnan(last) && gap - gap % 1000 <= 90000) {
+      const int steps = static_cast<int>((gap - gap % 1000) / 1000);
+      for (int k = 0; k < steps; k++) {
+        const double mid = last + (v - last) * (k + 0.5) / steps;
+        integral += mid / 3600.0;
+        if (mid > 200.0) dose += (mid - 200.0) / 3600.0;
+      }
+      covered_s += steps;
+    }
+    e.input_nox(t, v);
+    last = v;
+  }
+  const ExposureSummary x = e.exposure(POLLUTANT_NOX, t);
+  printf("    exposure: integral=%.2f (ref %.2f) dose=%.2f (ref %.2f) h=%.3f\n",
+         x.integral, integral, x.dose, dose, x.hours);
+  ASSERT_NEAR(x.hours, covered_s / 3600.0, 1e-3);
+  ASSERT_NEAR(x.integral, integral, integral * 1e-3);
+  ASSERT_NEAR(x.dose, dose, dose * 1e-3 + 0.01);
+}
+
+TEST_CASE(exposure_resets_daily_and_is_a_compile_time_opt_in) {
+  ExposureEngine e;
+  e.begin(T0);
+  e.input_co2(T0, 1200.0f);
+  e.input_co2(T0 + MINUTE_MS, 1200.0f);
+  ASSERT_NEAR(e.exposure(POLLUTANT_CO2, T0 + MINUTE_MS).dose, 200.0f / 60.0f, 1e-4f);
+  e.reset_exposure();
+  const ExposureSummary fresh_day = e.exposure(POLLUTANT_CO2, T0 + MINUTE_MS);
+  ASSERT_NEAR(fresh_day.dose, 0.0f, 0.0f);
+  ASSERT_NEAR(fresh_day.hours, 0.0f, 0.0f);
+  ASSERT_NAN(fresh_day.get(EXPOSURE_TWA));  // no covered time yet
+  // The rolling 8 hours run on across the day boundary.
+  ASSERT_NEAR(fresh_day.get(EXPOSURE_TWA_8H), 1200.0f / 60.0f / 8.0f, 1e-3f);
+  // The segment from the last sample counts towards the new day.
+  e.input_co2(T0 + 2 * MINUTE_MS, 1200.0f);
+  ASSERT_NEAR(e.exposure(POLLUTANT_CO2, T0 + 2 * MINUTE_MS).dose, 200.0f / 60.0f,
+              1e-4f);
+
+  typedef BasicAirIQEngine<AIRIQ_SPS30_CHANNELS> Core;
+  typedef BasicAirIQEngine<AIRIQ_SPS30_CHANNELS, 0, channel_bit(POLLUTANT_CO2)>
+      Co2Exposure;
+  printf("    sizeof: core=%u +co2 exposure=%u\n", (unsigned) sizeof(Core),
+         (unsigned) sizeof(Co2Exposure));
+  ASSERT_EQ(sizeof(Co2Exposure) - sizeof(Core), 56u);
+  ASSERT_TRUE(Co2Exposure::has_exposure(POLLUTANT_CO2));
+  ASSERT_FALSE(Co2Exposure::has_exposure(POLLUTANT_VOC));
+  Co2Exposure c;
+  c.begin(T0);
+  c.input_voc(T0, 500.0f);
+  c.input_voc(T0 + MINUTE_MS, 500.0f);
+  ASSERT_NAN(c.exposure(POLLUTANT_VOC, T0 + MINUTE_MS).dose);
+  ASSERT_NAN(c.exposure(POLLUTANT_VOC, T0 + MINUTE_MS).get(EXPOSURE_TWA_8H));
+}
+
+TEST_CASE(eight_hour_twa_is_a_rolling_window) {
+  // A constant 10 ug/m3 for 20 hours, sampled every 60 s: the 8-hour TWA
+  // reads the level back at every hour and between them, however long
+  // the day's accumulators have run.
+  ExposureEngine e;
+  e.begin(T0);
+  for (int m = 0; m <= 20 * 60; m++) {
+    const uint32_t now = T0 + m * MINUTE_MS;
+    e.input_pm2_5(now, 10.0f);
+    if (m >= 8 * 60 && m % 20 == 0)
+      ASSERT_NEAR(e.exposure(POLLUTANT_PM25, now).get(EXPOSURE_TWA_8H), 10.0f,
+                  0.01f);
+  }
+  const uint32_t end = T0 + 20 * HOUR_MS;
+  const ExposureSummary x = e.exposure(POLLUTANT_PM25, end);
+  printf("    20 h at 10 ug/m3: twa_8h=%.3f twa=%.3f integral=%.1f\n",
+         x.get(EXPOSURE_TWA_8H), x.get(EXPOSURE_TWA), x.integral);
+  ASSERT_NEAR(x.integral, 200.0f, 0.05f);
+  ASSERT_NEAR(x.get(EXPOSURE_TWA), 10.0f, 0.01f);
+
+  // Stale time counts as zero: four hours without a sample halve it, and
+  // eight hours empty it.
+  ASSERT_NEAR(e.exposure(POLLUTANT_PM25, end + 4 * HOUR_MS).get(EXPOSURE_TWA_8H),
+              5.0f, 0.01f);
+  ASSERT_NEAR(e.exposure(POLLUTANT_PM25, end + 8 * HOUR_MS).get(EXPOSURE_TWA_8H),
+              0.0f, 0.01f);
+}
+
+// CO2 ramp from 600 ppm at `slope` ppm/min, sampled every 30 s for
+// `minutes`, with VOC/NOx steady and Good so the headline is CO2's.
+static void feed_co2_ramp(AirIQEngine &e, uint32_t start, int minutes,
+                          float slope) {
+  for (int i = 0; i <= minutes * 2; i++) {
+    const uint32_t t = start + i * 30000u;
+    e.input_co2(t, 600.0f + slope * i * 0.5f);
+    e.input_voc(t, 80.0f);
+    e.input_nox(t, 10.0f);
+    e.evaluate(t);
+  }
+}
+
+TEST_CASE(trend_tracks_a_ramp_and_predicts_the_poor_crossing) {
+  AirIQEngine e = started_engine();
+  feed_co2_ramp(e, T0, 10, 10.0f);  // ends at 700 ppm
+  ASSERT_NEAR(e.trend_per_min(POLLUTANT_CO2), 10.0f, 0.01f);
+  ASSERT_NEAR(e.minutes_until_poor(POLLUTANT_CO2), 30.0f, 0.05f);
+  ASSERT_NEAR(e.trend_per_min(POLLUTANT_VOC), 0.0f, 1e-3f);
+  // Flat: no crossing (or one beyond any horizon, from float rounding).
+  ASSERT_FALSE(e.minutes_until_poor(POLLUTANT_VOC) < 1e4f);
+  // Only the ventilation-responsive pollutants carry a trend.
+  e.input_pm2_5(T0, 5.0f);
+  e.input_pm2_5(T0 + 5 * MINUTE_MS, 8.0f);
+  ASSERT_NAN(e.trend_per_min(POLLUTANT_PM25));
+  ASSERT_NAN(e.minutes_until_poor(POLLUTANT_PM25));
+
+  AirIQEngine falling = started_engine();
+  feed_co2_ramp(falling, T0, 10, -10.0f);
+  ASSERT_NEAR(falling.trend_per_min(POLLUTANT_CO2), -10.0f, 0.01f);
+  ASSERT_NAN(falling.minutes_until_poor(POLLUTANT_CO2));
+
+  AirIQEngine above = started_engine();
+  feed_co2_ramp(above, T0, 10, 50.0f);  // ends at 1100 ppm
+  ASSERT_NEAR(above.minutes_until_poor(POLLUTANT_CO2), 0.0f, 0.0f);
+}
+
+TEST_CASE(trend_needs_spread_and_restarts_after_a_stale_gap) {
+  AirIQEngine e = started_engine();
+  e.input_co2(T0, 600.0f);
+  e.input_co2(T0 + 1000, 650.0f);  // a burst never extrapolates noise
+  ASSERT_NAN(e.trend_per_min(POLLUTANT_CO2));
+  feed_co2_ramp(e, T0 + 30000, 10, 10.0f);
+  ASSERT_TRUE(e.trend_per_min(POLLUTANT_CO2) > 0.0f);
+  // A dropout beyond the 90 s stale window: the trend is unknown while
+  // stale and the first sample after it starts a fresh fit.
+  const uint32_t back = T0 + 30000 + 10 * MINUTE_MS + 120000;
+  e.evaluate(back);
+  ASSERT_NAN(e.trend_per_min(POLLUTANT_CO2));
+  e.input_co2(back, 900.0f);
+  ASSERT_NAN(e.trend_per_min(POLLUTANT_CO2));
+  for (int i = 1; i <= 8; i++) e.input_co2(back + i * 30000u, 900.0f);
+  e.evaluate(back + 8 * 30000u);
+  ASSERT_NEAR(e.trend_per_min(POLLUTANT_CO2), 0.0f, 1e-3f);
+}
+
+TEST_CASE(incremental_trend_matches_a_full_weighted_fit) {
+  AirIQEngine e = started_engine();
+  uint32_t rng = 9;
+  uint32_t t = T0;
+  float times[400];
+  float values[400];
+  for (int i = 0; i < 400; i++) {
+    t += 5000 + lcg_next(rng) % 80000;
+    values[i] = 500.0f + 0.2f * i + static_cast<float>(lcg_next(rng) % 40);
+    times[i] = static_cast<float>(t - T0) / 60000.0f;
+    e.input_co2(t, values[i]);
+  }
+  e.evaluate(t);
+  // Direct weighted least squares over every retained sample.
+  double w = 0.0, st = 0.0, sv = 0.0, stt = 0.0, stv = 0.0;
+  for (int i = 0; i < 400; i++) {
+    const double age = times[399] - times[i];
+    const double k = std::exp(-age / detail::TrendEstimator::TAU_MIN);
+    w += k;
+    st += k * -age;
+    sv += k * values[i];
+    stt += k * age * age;
+    stv += k * -age * values[i];
+  }
+  const double slope = (w * stv - st * sv) / (w * stt - st * st);
+  printf("    trend: incremental=%.4f reference=%.4f ppm/min\n",
+         e.trend_per_min(POLLUTANT_CO2), slope);
+  ASSERT_NEAR(e.trend_per_min(POLLUTANT_CO2), slope,
+              1e-3 * std::fabs(slope) + 1e-3);
+}
+
+TEST_CASE(early_ventilate_is_opt_in_and_names_the_rising_pollutant) {
+  // Default: purely reactive — a Fair ramp still recommends nothing.
+  AirIQEngine reactive = started_engine();
+  feed_co2_ramp(reactive, T0, 30, 10.0f);  // 900 ppm, Poor in 10 min
+  ASSERT_EQ(reactive.air_quality(), AIR_QUALITY_FAIR);
+  ASSERT_EQ(reactive.recommendation(), RECOMMENDATION_NO_ACTION);
+  ASSERT_EQ(reactive.rising_pollutant(), POLLUTANT_COUNT);
+
+  AirIQConfig config = default_config();
+  config.version = 1;
+  config.early_ventilate_min = 10.0f;
+  AirIQEngine early = started_engine();
+  early.apply_config(config);
+  feed_co2_ramp(early, T0, 29, 10.0f);  // 890 ppm: 11 min out
+  ASSERT_EQ(early.recommendation(), RECOMMENDATION_NO_ACTION);
+  early.input_co2(T0 + 30 * MINUTE_MS, 900.0f);
+  early.evaluate(T0 + 30 * MINUTE_MS);
+  ASSERT_EQ(early.air_quality(), AIR_QUALITY_FAIR);
+  ASSERT_EQ(early.recommendation(), RECOMMENDATION_VENTILATE_SOON);
+  ASSERT_EQ(early.rising_pollutant(), POLLUTANT_CO2);
+  char reason[160];
+  format_recommendation_reason(reason, sizeof(reason), capture_text(early));
+  ASSERT_STREQ(reason, "CO2 rising towards Poor -> Ventilate soon");
+
+  // The trend levelling off withdraws the prediction.
+  for (int i = 1; i <= 40; i++) {
+    const uint32_t t = T0 + 30 * MINUTE_MS + i * 30000u;
+    early.input_co2(t, 900.0f);
+    early.input_voc(t, 80.0f);
+    early.input_nox(t, 10.0f);
+    early.evaluate(t);
+  }
+  ASSERT_EQ(early.recommendation(), RECOMMENDATION_NO_ACTION);
+  ASSERT_EQ(early.rising_pollutant(), POLLUTANT_COUNT);
+}
+
+// --- transition journal -------------------------------------------------------
+
+typedef BasicAirIQEngine<ALL_CHANNELS, 0, 0, 8> JournalEngine;
+
+static void feed_co2_voc_nox(JournalEngine &e, uint32_t t, float co2) {
+  e.input_co2(t, co2);
+  e.input_voc(t, 80.0f);
+  e.input_nox(t, 10.0f);
+  e.evaluate(t);
+}
+
+TEST_CASE(journal_records_severity_headline_and_recommendation_changes) {
+  JournalEngine e;
+  e.begin(T0);
+  feed_co2_voc_nox(e, AFTER_ALL_WARMUPS, 600.0f);
+  Transition entries[8];
+  ASSERT_TRUE(e.drain_journal(entries, 8) > 0);  // start-up transitions
+  ASSERT_EQ(e.journal_pending(), 0);
+
+  feed_co2_voc_nox(e, AFTER_ALL_WARMUPS + 30000, 1200.4f);
+  ASSERT_EQ(e.drain_journal(entries, 8), 3);
+  ASSERT_EQ(entries[0].subject, POLLUTANT_CO2);
+  ASSERT_EQ(entries[0].from(), SEVERITY_GOOD);
+  ASSERT_EQ(entries[0].to(), SEVERITY_POOR);
+  ASSERT_EQ(entries[0].value, 1200);
+  ASSERT_EQ(entries[0].at_ms, AFTER_ALL_WARMUPS + 30000);
+  ASSERT_EQ(entries[1].subject, JOURNAL_AIR_QUALITY);
+  ASSERT_EQ(entries[2].subject, JOURNAL_RECOMMENDATION);
+  char line[96];
+  format_transition(line, sizeof(line), entries[0]);
+  ASSERT_STREQ(line, "231.000s CO2: Good -> Poor (1200)");
+  format_transition(line, sizeof(line), entries[1]);
+  ASSERT_STREQ(line, "231.000s Air quality: Good -> Poor (1200)");
+  format_transition(line, sizeof(line), entries[2]);
+  ASSERT_STREQ(line,
+               "231.000s Recommendation: No action needed -> Ventilate soon "
+               "(1200)");
+
+  // An unchanged evaluation records nothing; a channel going stale is a
+  // transition with no value.
+  feed_co2_voc_nox(e, AFTER_ALL_WARMUPS + 60000, 1200.0f);
+  ASSERT_EQ(e.journal_pending(), 0);
+  e.input_co2(AFTER_ALL_WARMUPS + 200000, NAN);
+  e.input_voc(AFTER_ALL_WARMUPS + 200000, 80.0f);
+  e.input_nox(AFTER_ALL_WARMUPS + 200000, 10.0f);
+  e.evaluate(AFTER_ALL_WARMUPS + 200000);
+  ASSERT_TRUE(e.drain_journal(entries, 1) == 1);
+  ASSERT_EQ(entries[0].subject, POLLUTANT_CO2);
+  ASSERT_EQ(entries[0].to(), SEVERITY_UNAVAILABLE);
+}
+
+TEST_CASE(journal_is_a_fixed_ring_that_counts_what_it_drops) {
+  JournalEngine e;
+  e.begin(T0);
+  feed_co2_voc_nox(e, AFTER_ALL_WARMUPS, 600.0f);
+  Transition entries[8];
+  while (e.drain_journal(entries, 8) > 0) {
+  }
+  // Ten Good <-> Poor flaps: 3 entries each (CO2, headline,
+  // recommendation) — 30 into an 8-entry ring.
+  for (int i = 1; i <= 10; i++)
+    feed_co2_voc_nox(e, AFTER_ALL_WARMUPS + i * 30000u,
+                     (i % 2) ? 1200.0f : 600.0f);
+  ASSERT_EQ(e.journal_pending(), 8);
+  ASSERT_EQ(e.journal_dropped(), 22u);
+  // The newest eight survive, oldest first.
+  ASSERT_EQ(e.drain_journal(entries, 3), 3);
+  ASSERT_EQ(entries[0].at_ms, AFTER_ALL_WARMUPS + 8 * 30000u);
+  ASSERT_EQ(entries[0].subject, JOURNAL_AIR_QUALITY);
+  ASSERT_EQ(e.journal_dropped(), 22u);  // still pending entries
+  ASSERT_EQ(e.drain_journal(entries, 8), 5);
+  ASSERT_EQ(entries[4].at_ms, AFTER_ALL_WARMUPS + 10 * 30000u);
+  ASSERT_EQ(entries[4].subject, JOURNAL_RECOMMENDATION);
+  ASSERT_EQ(e.journal_dropped(), 0u);
+
+  // Constant memory: 8 bytes per entry plus the ring indices; an engine
+  // without a journal pays nothing and drains nothing.
+  printf("    sizeof: core=%u +8-entry journal=%u\n",
+         (unsigned) sizeof(AirIQEngine), (unsigned) sizeof(JournalEngine));
+  ASSERT_EQ(sizeof(JournalEngine) - sizeof(AirIQEngine), 8u * 8u + 4u);
+  ASSERT_FALSE(AirIQEngine::has_journal());
+  AirIQEngine plain = started_engine();
+  feed_all_good(plain, AFTER_ALL_WARMUPS);
+  plain.evaluate(AFTER_ALL_WARMUPS);
+  ASSERT_EQ(plain.drain_journal(entries, 8), 0);
+}
+
 TEST_CASE(state_strings_match_the_customer_contract) {
   ASSERT_STREQ(severity_to_string(SEVERITY_GOOD), "Good");
   ASSERT_STREQ(severity_to_string(SEVERITY_FAIR), "Fair");
@@ -762,6 +1901,73 @@ int main() {
            "unexpected_pm_data_never_drives_the_headline");
   run_test(test_declared_external_pm_missing_degrades_honestly,
            "declared_external_pm_missing_degrades_honestly");
+  run_test(test_deadline_is_the_earliest_warmup_expiry_at_startup,
+           "deadline_is_the_earliest_warmup_expiry_at_startup");
+  run_test(test_deadline_tracks_the_stale_expiry_of_fresh_channels,
+           "deadline_tracks_the_stale_expiry_of_fresh_channels");
+  run_test(test_deadline_covers_pressure_and_mics_windows,
+           "deadline_covers_pressure_and_mics_windows");
+  run_test(test_no_deadline_when_every_channel_is_already_missing,
+           "no_deadline_when_every_channel_is_already_missing");
+  run_test(test_deadline_survives_millis_wrap, "deadline_survives_millis_wrap");
+  run_test(test_deadline_driven_schedule_matches_a_fine_grained_poll,
+           "deadline_driven_schedule_matches_a_fine_grained_poll");
+  run_test(test_incremental_evaluate_is_bit_identical_to_full_recompute,
+           "incremental_evaluate_is_bit_identical_to_full_recompute");
+  run_test(test_time_driven_transitions_reach_a_clean_engine,
+           "time_driven_transitions_reach_a_clean_engine");
+  run_test(test_configuration_changes_reclassify_without_new_input,
+           "configuration_changes_reclassify_without_new_input");
+  run_test(test_default_config_is_the_constructor_baseline,
+           "default_config_is_the_constructor_baseline");
+  run_test(test_generated_config_applies_once_and_only_on_a_new_version,
+           "generated_config_applies_once_and_only_on_a_new_version");
+  run_test(test_config_matches_the_equivalent_setter_sequence,
+           "config_matches_the_equivalent_setter_sequence");
+  run_test(test_frame_equals_separate_inputs_and_one_evaluation,
+           "frame_equals_separate_inputs_and_one_evaluation");
+  run_test(test_frame_fractions_require_a_valid_pm2_5,
+           "frame_fractions_require_a_valid_pm2_5");
+  run_test(test_frame_presence_mask_is_explicit,
+           "frame_presence_mask_is_explicit");
+  run_test(test_specialised_compositions_match_the_reference_engine,
+           "specialised_compositions_match_the_reference_engine");
+  run_test(test_absent_channels_are_inert_and_carry_no_deadline,
+           "absent_channels_are_inert_and_carry_no_deadline");
+  run_test(test_specialised_engines_shrink_with_the_composition,
+           "specialised_engines_shrink_with_the_composition");
+  run_test(test_statistics_summarise_each_window_from_bucket_aggregates,
+           "statistics_summarise_each_window_from_bucket_aggregates");
+  run_test(test_statistics_windows_expire_bucket_by_bucket,
+           "statistics_windows_expire_bucket_by_bucket");
+  run_test(test_statistics_survive_millis_wrap,
+           "statistics_survive_millis_wrap");
+  run_test(test_stale_gaps_are_never_averaged_in,
+           "stale_gaps_are_never_averaged_in");
+  run_test(test_statistics_are_a_per_pollutant_compile_time_opt_in,
+           "statistics_are_a_per_pollutant_compile_time_opt_in");
+  run_test(test_exposure_integrates_trapezoids_exactly_across_the_limit,
+           "exposure_integrates_trapezoids_exactly_across_the_limit");
+  run_test(test_stale_time_contributes_no_exposure,
+           "stale_time_contributes_no_exposure");
+  run_test(test_exposure_matches_a_fine_grained_reference_integration,
+           "exposure_matches_a_fine_grained_reference_integration");
+  run_test(test_exposure_resets_daily_and_is_a_compile_time_opt_in,
+           "exposure_resets_daily_and_is_a_compile_time_opt_in");
+  run_test(test_eight_hour_twa_is_a_rolling_window,
+           "eight_hour_twa_is_a_rolling_window");
+  run_test(test_trend_tracks_a_ramp_and_predicts_the_poor_crossing,
+           "trend_tracks_a_ramp_and_predicts_the_poor_crossing");
+  run_test(test_trend_needs_spread_and_restarts_after_a_stale_gap,
+           "trend_needs_spread_and_restarts_after_a_stale_gap");
+  run_test(test_incremental_trend_matches_a_full_weighted_fit,
+           "incremental_trend_matches_a_full_weighted_fit");
+  run_test(test_early_ventilate_is_opt_in_and_names_the_rising_pollutant,
+           "early_ventilate_is_opt_in_and_names_the_rising_pollutant");
+  run_test(test_journal_records_severity_headline_and_recommendation_changes,
+           "journal_records_severity_headline_and_recommendation_changes");
+  run_test(test_journal_is_a_fixed_ring_that_counts_what_it_drops,
+           "journal_is_a_fixed_ring_that_counts_what_it_drops");
   run_test(test_state_strings_match_the_customer_contract,
            "state_strings_match_the_customer_contract");
 
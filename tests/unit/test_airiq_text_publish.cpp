@@ -0,0 +1,230 @@
+// AIRIQ-FRAMEWORK-001 — host allocation benchmark for the AirIQ text
+// publishing path (components/sense360_airiq/sense360_airiq.cpp).
+//
+// The glue renders five text entities (headline + legacy headline,
+// recommendation, module health, state detail, recommendation reason) after
+// every evaluation. This test replays a day of evaluations through two
+// publishers over the SAME engine:
+//
+//   * legacy   — the former path: std::string headline, std::string-built
+//                snprintf diagnostics and std::string state comparison on
+//                every evaluation;
+//   * snapshot — the current path: the enum tuple (TextSnapshot) is
+//                compared and text is formatted / published only for the
+//                parts that changed.
+//
+// It counts heap allocations per evaluation (global operator new is
+// replaced in this binary), asserts both publishers leave every entity in
+// the identical state, and asserts an unchanged evaluation allocates
+// nothing on the snapshot path.
+//
+// A green run here is LOGIC/HOST-BENCHMARK proof only — never hardware
+// validation; ESP32 heap behaviour is not measured here.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../../components/sense360/airiq_engine.h"
+
+using namespace sense360::airiq;
+
+static long allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations++;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+#if __cplusplus >= 201402L
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#endif
+
+// Stand-in for esphome::text_sensor::TextSensor (state + publish).
+struct FakeTextSensor {
+  std::string state;
+  int publishes = 0;
+  void publish_state(const std::string &value) {
+    state = value;
+    publishes++;
+  }
+};
+
+struct TextEntities {
+  FakeTextSensor air_quality;
+  FakeTextSensor legacy_air_quality;
+  FakeTextSensor recommendation;
+  FakeTextSensor module_status;
+  FakeTextSensor state_detail;
+  FakeTextSensor recommendation_reason;
+
+  int publishes() const {
+    return air_quality.publishes + legacy_air_quality.publishes +
+           recommendation.publishes + module_status.publishes +
+           state_detail.publishes + recommendation_reason.publishes;
+  }
+};
+
+// The former publish path, verbatim in structure.
+static void publish_changed(FakeTextSensor &target, const std::string &value) {
+  if (target.state != value) target.publish_state(value);
+}
+
+static void publish_legacy(const AirIQEngine &engine, TextEntities &out) {
+  const std::string headline = air_quality_to_string(engine.air_quality());
+  publish_changed(out.air_quality, headline);
+  publish_changed(out.legacy_air_quality, headline);
+  publish_changed(out.recommendation,
+                  recommendation_to_string(engine.recommendation()));
+  publish_changed(out.module_status, health_to_string(engine.health()));
+  {
+    char buffer[192];
+    snprintf(buffer, sizeof(buffer), "co2=%s voc=%s nox=%s hcho=%s pm2.5=%s",
+             severity_to_string(engine.severity(POLLUTANT_CO2)),
+             severity_to_string(engine.severity(POLLUTANT_VOC)),
+             severity_to_string(engine.severity(POLLUTANT_NOX)),
+             severity_to_string(engine.severity(POLLUTANT_HCHO)),
+             severity_to_string(engine.severity(POLLUTANT_PM25)));
+    publish_changed(out.state_detail, std::string(buffer));
+  }
+  {
+    char buffer[160];
+    if (engine.worst_pollutant() < POLLUTANT_COUNT) {
+      snprintf(buffer, sizeof(buffer), "worst pollutant: %s (%s) -> %s",
+               pollutant_to_string(engine.worst_pollutant()),
+               severity_to_string(engine.severity(engine.worst_pollutant())),
+               recommendation_to_string(engine.recommendation()));
+    } else {
+      snprintf(buffer, sizeof(buffer), "no pollutant above Good -> %s",
+               recommendation_to_string(engine.recommendation()));
+    }
+    publish_changed(out.recommendation_reason, std::string(buffer));
+  }
+}
+
+// The current publish path (mirrors Sense360AirIQ::publish_()).
+struct SnapshotPublisher {
+  TextSnapshot published;
+  bool has_published = false;
+
+  int publish(const AirIQEngine &engine, TextEntities &out) {
+    const TextSnapshot text = capture_text(engine);
+    const int changed =
+        has_published ? text.changes_from(published) : TEXT_ALL;
+    published = text;
+    has_published = true;
+    if (changed & TEXT_AIR_QUALITY) {
+      const char *headline = air_quality_to_string(text.air_quality);
+      out.air_quality.publish_state(headline);
+      out.legacy_air_quality.publish_state(headline);
+    }
+    if (changed & TEXT_RECOMMENDATION)
+      out.recommendation.publish_state(
+          recommendation_to_string(text.recommendation));
+    if (changed & TEXT_HEALTH)
+      out.module_status.publish_state(health_to_string(text.health));
+    if (changed & TEXT_STATE_DETAIL) {
+      char buffer[192];
+      format_state_detail(buffer, sizeof(buffer), text);
+      out.state_detail.publish_state(buffer);
+    }
+    if (changed & TEXT_RECOMMENDATION_REASON) {
+      char buffer[160];
+      format_recommendation_reason(buffer, sizeof(buffer), text);
+      out.recommendation_reason.publish_state(buffer);
+    }
+    return changed;
+  }
+};
+
+static void assert_same_text(const TextEntities &a, const TextEntities &b) {
+  assert(a.air_quality.state == b.air_quality.state);
+  assert(a.legacy_air_quality.state == b.legacy_air_quality.state);
+  assert(a.recommendation.state == b.recommendation.state);
+  assert(a.module_status.state == b.module_status.state);
+  assert(a.state_detail.state == b.state_detail.state);
+  assert(a.recommendation_reason.state == b.recommendation_reason.state);
+}
+
+static uint32_t lcg_next(uint32_t &state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+int main() {
+  printf("\n=== AIRIQ-FRAMEWORK-001 text publish allocation benchmark ===\n");
+
+  AirIQEngine engine;
+  engine.set_expected(POLLUTANT_HCHO, true);
+  engine.begin(0);
+
+  TextEntities legacy_out;
+  TextEntities snapshot_out;
+  SnapshotPublisher snapshot;
+
+  long legacy_allocs = 0;
+  long snapshot_allocs = 0;
+  long unchanged_evaluations = 0;
+  long evaluations = 0;
+  uint32_t rng = 7;
+  float co2 = 600.0f;
+  float voc = 100.0f;
+
+  // 24 h: sensor callbacks every 30 s (CO2 drifting through the bands,
+  // VOC wandering, NOx/HCHO steady; one 20-minute SGP41 dropout) plus the
+  // former 10 s poll between them.
+  for (uint32_t t = 1000; t < 24u * 3600u * 1000u; t += 10000) {
+    if ((t / 10000) % 3 == 0) {
+      co2 += static_cast<float>(lcg_next(rng) % 61) - 30.0f;
+      if (co2 < 420.0f) co2 = 420.0f;
+      if (co2 > 1800.0f) co2 = 1800.0f;
+      voc += static_cast<float>(lcg_next(rng) % 21) - 10.0f;
+      if (voc < 20.0f) voc = 20.0f;
+      engine.input_co2(t, co2);
+      const bool sgp41_dropout = t > 36000000u && t < 37200000u;
+      if (!sgp41_dropout) {
+        engine.input_voc(t, voc);
+        engine.input_nox(t, 10.0f);
+      }
+      engine.input_hcho(t, 30.0f);
+    }
+    engine.evaluate(t);
+    evaluations++;
+
+    long before = allocations;
+    publish_legacy(engine, legacy_out);
+    legacy_allocs += allocations - before;
+
+    before = allocations;
+    const int changed = snapshot.publish(engine, snapshot_out);
+    const long spent = allocations - before;
+    snapshot_allocs += spent;
+    if (changed == 0) {
+      unchanged_evaluations++;
+      assert(spent == 0);  // an unchanged tuple formats and allocates nothing
+    }
+
+    assert_same_text(legacy_out, snapshot_out);
+  }
+
+  printf("    evaluations: %ld (%ld with an unchanged text tuple)\n",
+         evaluations, unchanged_evaluations);
+  printf("    allocations per evaluate: legacy=%.3f snapshot=%.3f\n",
+         static_cast<double>(legacy_allocs) / evaluations,
+         static_cast<double>(snapshot_allocs) / evaluations);
+  printf("    publishes: legacy=%d snapshot=%d\n", legacy_out.publishes(),
+         snapshot_out.publishes());
+
+  assert(unchanged_evaluations > evaluations / 2);
+  assert(snapshot_allocs * 10 < legacy_allocs);
+  assert(snapshot_out.publishes() <= legacy_out.publishes());
+
+  printf("1/1 tests passed\n");
+  return 0;
+}
@@ -35,6 +35,49 @@ static Demand airiq_demand_bridge(sense360::airiq::AirIQEngine &airiq) {
   return demand_from_airiq_recommendation((int) airiq.recommendation());
 }
 
+// A recorded occupied-room CO2 rise (ppm, one SCD41 sample every 30 s):
+// ~15 ppm/min early on, crossing the 1000 ppm Poor threshold at ~29.5 min.
+static const uint16_t CO2_RAMP_PPM[] = {
+    557, 565, 578, 584, 592, 605, 621, 628, 637, 639, 652, 657,
+    665, 672, 682, 699, 706, 714, 722, 723, 733, 745, 754, 763,
+    771, 769, 783, 792, 797, 801, 812, 815, 832, 838, 842, 846,
+    860, 863, 874, 880, 883, 889, 898, 902, 906, 914, 927, 924,
+    930, 944, 946, 955, 961, 965, 979, 975, 984, 987, 999, 1000,
+    1007, 1017, 1018, 1026, 1036, 1032, 1037, 1044, 1056, 1060, 1061, 1067,
+    1070, 1079, 1079, 1092, 1100, 1105, 1108, 1115, 1109, 1117, 1130, 1132,
+    1133, 1144, 1145, 1152, 1150, 1153, 1161, 1162, 1169, 1180, 1177, 1178,
+};
+static const int CO2_RAMP_SAMPLES =
+    sizeof(CO2_RAMP_PPM) / sizeof(CO2_RAMP_PPM[0]);
+
+// Replays a CO2 trace (VOC/NOx steady and Good) through an AirIQ engine and
+// a "Ventilate soon"-triggered blower; returns the ms from the first sample
+// to the first boost, or -1 if the fan never boosts.
+static long first_boost_ms(const uint16_t *co2, int samples,
+                           float early_ventilate_min) {
+  const uint32_t start = 1000;
+  const uint32_t t0 = start + 200000;  // beyond every warm-up window
+  sense360::airiq::AirIQEngine airiq;
+  airiq.set_early_ventilate_min(early_ventilate_min);
+  airiq.begin(start);
+  BlowerController fan;
+  fan.set_has_airiq(true);
+  fan.set_mode(MODE_AUTO);
+  fan.set_trigger(TRIGGER_SOON);
+  fan.begin(start);
+  for (int i = 0; i < samples; i++) {
+    const uint32_t t = t0 + i * 30000u;
+    airiq.input_co2(t, co2[i]);
+    airiq.input_voc(t, 80.0f);
+    airiq.input_nox(t, 10.0f);
+    airiq.evaluate(t);
+    fan.input_demand(t, airiq_demand_bridge(airiq));
+    fan.evaluate(t);
+    if (fan.boosting()) return static_cast<long>(t - t0);
+  }
+  return -1;
+}
+
 int main() {
   printf("\n=== BLOWER-FRAMEWORK-001 header-coexistence test ===\n");
 
@@ -104,6 +147,25 @@ int main() {
     assert(fan.state() == STATE_AUTO_BOOST);
   }
 
+  // 4) Predictive "Ventilate soon": on the recorded CO2 ramp the opt-in
+  //    early recommendation boosts the fan well before the reactive path
+  //    (which waits for the Poor band), and a flat noisy trace — no trend —
+  //    never triggers it.
+  {
+    const long reactive = first_boost_ms(CO2_RAMP_PPM, CO2_RAMP_SAMPLES, 0.0f);
+    const long early = first_boost_ms(CO2_RAMP_PPM, CO2_RAMP_SAMPLES, 10.0f);
+    printf("    CO2 ramp first boost: reactive=%.1f min early=%.1f min\n",
+           reactive / 60000.0, early / 60000.0);
+    assert(reactive > 0);
+    assert(early > 0);
+    assert(early + 5 * 60000 <= reactive);
+
+    uint16_t flat[CO2_RAMP_SAMPLES];
+    for (int i = 0; i < CO2_RAMP_SAMPLES; i++)
+      flat[i] = static_cast<uint16_t>(900 + (CO2_RAMP_PPM[i] * 7) % 13 - 6);
+    assert(first_boost_ms(flat, CO2_RAMP_SAMPLES, 10.0f) == -1);
+  }
+
   printf("[PASS] blower_controller.h + airiq_engine.h coexist and cooperate\n");
   printf("\n1/1 tests passed\n");
   return 0;
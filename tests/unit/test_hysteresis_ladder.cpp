@@ -0,0 +1,545 @@
+// Shared band classifier (HysteresisLadder<N> in
+// components/sense360/hysteresis_ladder.h) — equivalence with the hand-written
+// ladders it replaced in RoomIQEngine (temperature, humidity, brightness) and
+// AirIQEngine (pollutant severity).
+//
+// The legacy ladders are reproduced below exactly as they stood in the
+// engines. For each of the four policies, on the shipped defaults and on
+// deliberately awkward configurations (zero margins, equal and unsorted
+// boundaries, negative boundaries), the test proves:
+//
+//   * raw_band() agrees on every probe value — each boundary, the boundary
+//     +/- margin, their float neighbours, a dense sweep, +/-infinity, NaN;
+//   * update() agrees from EVERY held state (no band yet, and each band) on
+//     every probe value — the whole transition table, not just sampled walks;
+//   * a long pseudo-random walk agrees step for step;
+//   * the engines classify through the ladder (public outputs unchanged on
+//     the default bands).
+//
+// The timing lines are informational (host CPU), never asserted.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/airiq_engine.h"
+#include "../../components/sense360/roomiq_engine.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <vector>
+
+using sense360::HysteresisLadder;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_EQ(a, b) assert((a) == (b))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+// Compile-time: the engines' default ladders are constant expressions.
+static_assert(HysteresisLadder<4>::symmetric(0.3f, 16.0f, 18.0f, 24.0f, 27.0f)
+                      .boundary(2) == 24.0f,
+              "constexpr boundaries");
+
+// ---------------------------------------------------------------------------
+// The legacy ladders, verbatim apart from the surrounding struct.
+// ---------------------------------------------------------------------------
+struct LegacyTemperature {  // RoomIQEngine raw_temp_band / temp_band_lower
+  float temp_cold_, temp_cool_, temp_warm_, temp_hot_, temp_hysteresis_;
+  int temp_band_ = 2;
+  bool temp_band_valid_ = false;
+
+  int raw_temp_band(float t) const {
+    if (t < temp_cold_) return 0;
+    if (t < temp_cool_) return 1;
+    if (t < temp_warm_) return 2;
+    if (t < temp_hot_) return 3;
+    return 4;
+  }
+  float temp_band_lower(int band) const {
+    switch (band) {
+      case 1:
+        return temp_cold_;
+      case 2:
+        return temp_cool_;
+      case 3:
+        return temp_warm_;
+      case 4:
+        return temp_hot_;
+    }
+    return temp_cold_;
+  }
+  int update(float t) {
+    const int raw_t = raw_temp_band(t);
+    if (!temp_band_valid_) {
+      temp_band_ = raw_t;
+      temp_band_valid_ = true;
+    } else {
+      while (raw_t > temp_band_ &&
+             t >= temp_band_lower(temp_band_ + 1) + temp_hysteresis_) {
+        temp_band_++;
+      }
+      while (raw_t < temp_band_ &&
+             t < temp_band_lower(temp_band_) - temp_hysteresis_) {
+        temp_band_--;
+      }
+    }
+    return temp_band_;
+  }
+};
+
+struct LegacyHumidity {  // RoomIQEngine raw_humidity_band / humidity_band_lower
+  float humidity_dry_, humidity_humid_, humidity_hysteresis_;
+  int humidity_band_ = 1;
+  bool humidity_band_valid_ = false;
+
+  int raw_humidity_band(float h) const {
+    if (h < humidity_dry_) return 0;
+    if (h < humidity_humid_) return 1;
+    return 2;
+  }
+  float humidity_band_lower(int band) const {
+    return band == 2 ? humidity_humid_ : humidity_dry_;
+  }
+  int update(float h) {
+    const int raw_h = raw_humidity_band(h);
+    if (!humidity_band_valid_) {
+      humidity_band_ = raw_h;
+      humidity_band_valid_ = true;
+    } else {
+      while (raw_h > humidity_band_ &&
+             h >= humidity_band_lower(humidity_band_ + 1) +
+                      humidity_hysteresis_) {
+        humidity_band_++;
+      }
+      while (raw_h < humidity_band_ &&
+             h < humidity_band_lower(humidity_band_) - humidity_hysteresis_) {
+        humidity_band_--;
+      }
+    }
+    return humidity_band_;
+  }
+};
+
+struct LegacyBrightness {  // RoomIQEngine raw_brightness_band / brightness_band_lower
+  float lux_dim_, lux_normal_, lux_bright_, lux_very_bright_;
+  float brightness_hysteresis_pct_;
+  int brightness_band_ = 2;
+  bool brightness_band_valid_ = false;
+
+  int raw_brightness_band(float lux) const {
+    if (lux < lux_dim_) return 0;
+    if (lux < lux_normal_) return 1;
+    if (lux < lux_bright_) return 2;
+    if (lux < lux_very_bright_) return 3;
+    return 4;
+  }
+  float brightness_band_lower(int band) const {
+    switch (band) {
+      case 1:
+        return lux_dim_;
+      case 2:
+        return lux_normal_;
+      case 3:
+        return lux_bright_;
+      case 4:
+        return lux_very_bright_;
+    }
+    return lux_dim_;
+  }
+  int update(float lux) {
+    const int raw = raw_brightness_band(lux);
+    if (!brightness_band_valid_) {
+      brightness_band_ = raw;
+      brightness_band_valid_ = true;
+    } else if (raw > brightness_band_) {
+      brightness_band_ = raw;
+    } else {
+      const float margin = 1.0f - brightness_hysteresis_pct_ / 100.0f;
+      while (raw < brightness_band_ &&
+             lux < brightness_band_lower(brightness_band_) * margin) {
+        brightness_band_--;
+      }
+    }
+    return brightness_band_;
+  }
+};
+
+struct LegacySeverity {  // AirIQEngine raw_band / band_lower, one slot
+  float fair_, poor_, very_poor_, hysteresis_;
+  int band_ = 0;
+  bool band_valid_ = false;
+
+  int raw_band(float v) const {
+    if (v < fair_) return 0;
+    if (v < poor_) return 1;
+    if (v < very_poor_) return 2;
+    return 3;
+  }
+  float band_lower(int band) const {
+    switch (band) {
+      case 1:
+        return fair_;
+      case 2:
+        return poor_;
+      case 3:
+        return very_poor_;
+    }
+    return fair_;
+  }
+  int update(float v) {
+    const int raw = raw_band(v);
+    if (!band_valid_) {
+      band_ = raw;
+      band_valid_ = true;
+    } else if (raw > band_) {
+      band_ = raw;
+    } else {
+      while (raw < band_ && v < band_lower(band_) - hysteresis_) {
+        band_--;
+      }
+    }
+    return band_;
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Probe values: every boundary, boundary +/- margin (and * scale), each of
+// those with its float neighbours, a dense sweep across the range, and the
+// non-finite values.
+// ---------------------------------------------------------------------------
+static void add_with_neighbours(std::vector<float> &probes, float x) {
+  probes.push_back(x);
+  probes.push_back(std::nextafter(x, INFINITY));
+  probes.push_back(std::nextafter(x, -INFINITY));
+}
+
+static std::vector<float> probes_for(const std::vector<float> &boundaries, float margin,
+                                     float scale) {
+  std::vector<float> probes;
+  float lo = 0.0f;
+  float hi = 0.0f;
+  for (float b : boundaries) {
+    add_with_neighbours(probes, b);
+    add_with_neighbours(probes, b + margin);
+    add_with_neighbours(probes, b - margin);
+    add_with_neighbours(probes, b * scale);
+    lo = std::fmin(lo, std::fmin(b - margin, b * scale));
+    hi = std::fmax(hi, b + margin);
+  }
+  const float span = hi - lo + 1.0f;
+  for (int i = 0; i <= 4000; i++)
+    probes.push_back(lo - 0.1f * span + 1.2f * span * static_cast<float>(i) / 4000.0f);
+  probes.push_back(INFINITY);
+  probes.push_back(-INFINITY);
+  probes.push_back(NAN);
+  return probes;
+}
+
+static uint32_t lcg_next(uint32_t &state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+// Held-state access into the legacy structs.
+static void force_band(LegacyTemperature &l, int band) {
+  l.temp_band_ = band;
+  l.temp_band_valid_ = true;
+}
+static void force_band(LegacyHumidity &l, int band) {
+  l.humidity_band_ = band;
+  l.humidity_band_valid_ = true;
+}
+static void force_band(LegacyBrightness &l, int band) {
+  l.brightness_band_ = band;
+  l.brightness_band_valid_ = true;
+}
+static void force_band(LegacySeverity &l, int band) {
+  l.band_ = band;
+  l.band_valid_ = true;
+}
+static int legacy_raw(const LegacyTemperature &l, float v) { return l.raw_temp_band(v); }
+static int legacy_raw(const LegacyHumidity &l, float v) { return l.raw_humidity_band(v); }
+static int legacy_raw(const LegacyBrightness &l, float v) { return l.raw_brightness_band(v); }
+static int legacy_raw(const LegacySeverity &l, float v) { return l.raw_band(v); }
+
+// From every held state, every probe: the whole transition table. Then a
+// pseudo-random walk over the probes.
+template <int N, typename Legacy, typename Configure>
+static long check_equivalence(const std::vector<float> &probes, Configure configure) {
+  long compared = 0;
+  Legacy legacy_base = configure(static_cast<Legacy *>(nullptr));
+  HysteresisLadder<N> ladder_base = configure(static_cast<HysteresisLadder<N> *>(nullptr));
+  for (int held = -1; held <= N; held++) {
+    for (float value : probes) {
+      Legacy legacy = legacy_base;
+      HysteresisLadder<N> ladder = ladder_base;
+      if (held >= 0) {  // -1: no band held yet
+        ladder.restore(held);
+        force_band(legacy, held);
+      }
+      ASSERT_EQ(ladder.raw_band(value), legacy_raw(legacy, value));
+      ASSERT_EQ(ladder.update(value), legacy.update(value));
+      compared++;
+    }
+  }
+  uint32_t rng = 7;
+  Legacy legacy = legacy_base;
+  HysteresisLadder<N> ladder = ladder_base;
+  for (int i = 0; i < 200000; i++) {
+    const float value = probes[lcg_next(rng) % probes.size()];
+    ASSERT_EQ(ladder.update(value), legacy.update(value));
+    compared++;
+  }
+  return compared;
+}
+
+// One configuration of each policy, built for both implementations.
+struct TemperatureConfig {
+  float b[4];
+  float h;
+  LegacyTemperature operator()(LegacyTemperature *) const {
+    LegacyTemperature l;
+    l.temp_cold_ = b[0];
+    l.temp_cool_ = b[1];
+    l.temp_warm_ = b[2];
+    l.temp_hot_ = b[3];
+    l.temp_hysteresis_ = h;
+    return l;
+  }
+  HysteresisLadder<4> operator()(HysteresisLadder<4> *) const {
+    HysteresisLadder<4> ladder;
+    ladder.set_boundaries(b);
+    ladder.set_symmetric(h);
+    return ladder;
+  }
+};
+struct HumidityConfig {
+  float b[2];
+  float h;
+  LegacyHumidity operator()(LegacyHumidity *) const {
+    LegacyHumidity l;
+    l.humidity_dry_ = b[0];
+    l.humidity_humid_ = b[1];
+    l.humidity_hysteresis_ = h;
+    return l;
+  }
+  HysteresisLadder<2> operator()(HysteresisLadder<2> *) const {
+    HysteresisLadder<2> ladder;
+    ladder.set_boundaries(b);
+    ladder.set_symmetric(h);
+    return ladder;
+  }
+};
+struct BrightnessConfig {
+  float b[4];
+  float pct;
+  LegacyBrightness operator()(LegacyBrightness *) const {
+    LegacyBrightness l;
+    l.lux_dim_ = b[0];
+    l.lux_normal_ = b[1];
+    l.lux_bright_ = b[2];
+    l.lux_very_bright_ = b[3];
+    l.brightness_hysteresis_pct_ = pct;
+    return l;
+  }
+  HysteresisLadder<4> operator()(HysteresisLadder<4> *) const {
+    HysteresisLadder<4> ladder;
+    ladder.set_boundaries(b);
+    ladder.set_immediate_rise_scaled(1.0f - pct / 100.0f);
+    return ladder;
+  }
+};
+struct SeverityConfig {
+  float b[3];
+  float h;
+  LegacySeverity operator()(LegacySeverity *) const {
+    LegacySeverity l;
+    l.fair_ = b[0];
+    l.poor_ = b[1];
+    l.very_poor_ = b[2];
+    l.hysteresis_ = h;
+    return l;
+  }
+  HysteresisLadder<3> operator()(HysteresisLadder<3> *) const {
+    HysteresisLadder<3> ladder;
+    ladder.set_boundaries(b);
+    ladder.set_immediate_rise(h);
+    return ladder;
+  }
+};
+
+TEST_CASE(temperature_ladder_matches_legacy) {
+  const TemperatureConfig configs[] = {
+      {{16.0f, 18.0f, 24.0f, 27.0f}, 0.3f},  // shipped defaults
+      {{16.0f, 18.0f, 24.0f, 27.0f}, 0.0f},
+      {{16.0f, 16.0f, 24.0f, 24.0f}, 1.0f},  // equal boundaries
+      {{24.0f, 18.0f, 27.0f, 16.0f}, 0.5f},  // unsorted
+      {{-30.0f, -10.0f, 0.0f, 5.0f}, 5.0f},  // wide margin, negative
+  };
+  long compared = 0;
+  for (const TemperatureConfig &c : configs)
+    compared += check_equivalence<4, LegacyTemperature>(
+        probes_for({c.b[0], c.b[1], c.b[2], c.b[3]}, c.h, 1.0f), c);
+  printf("    temperature: %ld transitions compared\n", compared);
+}
+
+TEST_CASE(humidity_ladder_matches_legacy) {
+  const HumidityConfig configs[] = {
+      {{30.0f, 60.0f}, 2.0f},
+      {{30.0f, 60.0f}, 0.0f},
+      {{45.0f, 45.0f}, 2.0f},
+      {{70.0f, 20.0f}, 3.0f},
+  };
+  long compared = 0;
+  for (const HumidityConfig &c : configs)
+    compared += check_equivalence<2, LegacyHumidity>(probes_for({c.b[0], c.b[1]}, c.h, 1.0f),
+                                                     c);
+  printf("    humidity: %ld transitions compared\n", compared);
+}
+
+TEST_CASE(brightness_ladder_matches_legacy) {
+  const BrightnessConfig configs[] = {
+      {{10.0f, 50.0f, 300.0f, 1000.0f}, 20.0f},
+      {{10.0f, 50.0f, 300.0f, 1000.0f}, 0.0f},
+      {{10.0f, 50.0f, 300.0f, 1000.0f}, 90.0f},
+      {{5.0f, 5.0f, 400.0f, 100.0f}, 33.3f},
+  };
+  long compared = 0;
+  for (const BrightnessConfig &c : configs)
+    compared += check_equivalence<4, LegacyBrightness>(
+        probes_for({c.b[0], c.b[1], c.b[2], c.b[3]}, 0.0f, 1.0f - c.pct / 100.0f), c);
+  printf("    brightness: %ld transitions compared\n", compared);
+}
+
+TEST_CASE(severity_ladder_matches_legacy) {
+  const SeverityConfig configs[] = {
+      {{800.0f, 1200.0f, 1500.0f}, 50.0f},  // CO2-like
+      {{12.0f, 35.4f, 55.4f}, 1.0f},        // PM2.5-like
+      {{150.0f, 250.0f, 400.0f}, 0.0f},
+      {{0.0f, 0.0f, 0.0f}, 0.0f},  // unconfigured slot
+      {{300.0f, 100.0f, 200.0f}, 10.0f},
+  };
+  long compared = 0;
+  for (const SeverityConfig &c : configs)
+    compared += check_equivalence<3, LegacySeverity>(
+        probes_for({c.b[0], c.b[1], c.b[2]}, c.h, 1.0f), c);
+  printf("    severity: %ld transitions compared\n", compared);
+}
+
+TEST_CASE(engines_classify_through_the_ladder) {
+  // RoomIQ defaults: 24.1 C inside the warm hysteresis stays Comfortable
+  // when coming from below, Warm when starting there.
+  sense360::roomiq::RoomIQEngine room;
+  room.begin(0);
+  room.input_temperature(0, 29.7f);  // R4 profile: 23.9 C
+  room.input_humidity(0, 30.0f);
+  room.evaluate(0);
+  ASSERT_EQ(room.comfort(), sense360::roomiq::COMFORT_COMFORTABLE);
+  room.input_temperature(30000, 29.9f);  // 24.1 C
+  room.input_humidity(30000, 30.0f);
+  room.evaluate(30000);
+  ASSERT_EQ(room.comfort(), sense360::roomiq::COMFORT_COMFORTABLE);
+  room.input_temperature(60000, 30.2f);  // 24.4 C: beyond the margin
+  room.input_humidity(60000, 30.0f);
+  room.evaluate(60000);
+  ASSERT_EQ(room.comfort(), sense360::roomiq::COMFORT_WARM);
+
+  // AirIQ defaults: worsening at once, improving past the margin.
+  sense360::airiq::AirIQEngine air;
+  air.begin(0);
+  air.set_expected(sense360::airiq::POLLUTANT_CO2, true);
+  air.input_co2(0, 500.0f);
+  air.evaluate(0);
+  const sense360::airiq::Severity good = air.severity(sense360::airiq::POLLUTANT_CO2);
+  air.input_co2(1000, 5000.0f);
+  air.evaluate(1000);
+  ASSERT_EQ(air.severity(sense360::airiq::POLLUTANT_CO2), sense360::airiq::SEVERITY_VERY_POOR);
+  air.input_co2(2000, 500.0f);
+  air.evaluate(2000);
+  ASSERT_EQ(air.severity(sense360::airiq::POLLUTANT_CO2), good);
+}
+
+// Informational: per-update cost of each implementation on this host.
+template <int N, typename Legacy, typename Configure>
+static void bench(const char *name, const std::vector<float> &values, Configure configure) {
+  Legacy legacy = configure(static_cast<Legacy *>(nullptr));
+  HysteresisLadder<N> ladder = configure(static_cast<HysteresisLadder<N> *>(nullptr));
+  long sink = 0;
+  const auto a = std::chrono::steady_clock::now();
+  for (float v : values) sink += legacy.update(v);
+  const auto b = std::chrono::steady_clock::now();
+  for (float v : values) sink -= ladder.update(v);
+  const auto c = std::chrono::steady_clock::now();
+  printf("    host ns/update %-12s legacy %.2f ladder %.2f (%ld)\n", name,
+         std::chrono::duration<double, std::nano>(b - a).count() / values.size(),
+         std::chrono::duration<double, std::nano>(c - b).count() / values.size(), sink);
+}
+
+TEST_CASE(benchmark) {
+  const int n = 1 << 20;
+  std::vector<float> temperatures(n);
+  std::vector<float> lux(n);
+  std::vector<float> co2(n);
+  std::vector<float> jitter(n);
+  uint32_t rng = 11;
+  float t = 21.0f;
+  float l = 100.0f;
+  float c = 900.0f;
+  for (int i = 0; i < n; i++) {
+    // Random walks that wander across the boundaries.
+    t = std::fmin(30.0f, std::fmax(12.0f, t + (static_cast<float>(lcg_next(rng) % 201) - 100.0f) / 400.0f));
+    l = std::fmin(2000.0f, std::fmax(0.0f, l * (0.9f + static_cast<float>(lcg_next(rng) % 201) / 1000.0f)));
+    c = std::fmin(2500.0f, std::fmax(400.0f, c + (static_cast<float>(lcg_next(rng) % 201) - 100.0f)));
+    temperatures[i] = t;
+    lux[i] = l;
+    co2[i] = c;
+    // Sensor noise sitting on the warm boundary.
+    jitter[i] = 24.0f + (static_cast<float>(lcg_next(rng) % 201) - 100.0f) / 200.0f;
+  }
+  bench<4, LegacyTemperature>("temperature", temperatures,
+                              TemperatureConfig{{16.0f, 18.0f, 24.0f, 27.0f}, 0.3f});
+  bench<4, LegacyTemperature>("at boundary", jitter,
+                              TemperatureConfig{{16.0f, 18.0f, 24.0f, 27.0f}, 0.3f});
+  bench<4, LegacyBrightness>("brightness", lux,
+                             BrightnessConfig{{10.0f, 50.0f, 300.0f, 1000.0f}, 20.0f});
+  bench<3, LegacySeverity>("severity", co2,
+                           SeverityConfig{{800.0f, 1200.0f, 1500.0f}, 50.0f});
+}
+
+int main() {
+  printf("\nShared hysteresis ladder equivalence tests\n");
+  printf("==========================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_temperature_ladder_matches_legacy, "temperature_ladder_matches_legacy");
+  run_test(test_humidity_ladder_matches_legacy, "humidity_ladder_matches_legacy");
+  run_test(test_brightness_ladder_matches_legacy, "brightness_ladder_matches_legacy");
+  run_test(test_severity_ladder_matches_legacy, "severity_ladder_matches_legacy");
+  run_test(test_engines_classify_through_the_ladder, "engines_classify_through_the_ladder");
+  run_test(test_benchmark, "benchmark");
+  printf("\n==========================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All hysteresis ladder tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
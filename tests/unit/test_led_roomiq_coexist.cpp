@@ -26,10 +26,9 @@ using namespace sense360::ledfw;
 // engine and inject its decision as the LED controller's darkness input.
 static Darkness roomiq_darkness_bridge(sense360::roomiq::RoomIQEngine &env,
                                        uint32_t now) {
-  env.evaluate(now);
-  if (env.darkness() == sense360::roomiq::DARKNESS_DARK) return DARKNESS_DARK;
-  if (env.darkness() == sense360::roomiq::DARKNESS_NOT_DARK)
-    return DARKNESS_NOT_DARK;
+  const sense360::roomiq::Darkness decision = env.evaluate_darkness(now);
+  if (decision == sense360::roomiq::DARKNESS_DARK) return DARKNESS_DARK;
+  if (decision == sense360::roomiq::DARKNESS_NOT_DARK) return DARKNESS_NOT_DARK;
   return DARKNESS_UNKNOWN;
 }
 
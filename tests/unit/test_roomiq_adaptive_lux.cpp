@@ -0,0 +1,281 @@
+// ROOMIQ-FRAMEWORK-001 — adaptive illuminance sampling
+// (RoomIQEngine::lux_sample_interval_ms() in components/sense360/roomiq_engine.h).
+//
+// The policy the sense360_roomiq glue applies to the LTR-303 poller:
+//
+//   * the three tiers (fast near the darkness decision or while a night
+//     automation is armed, slow far from it, normal otherwise) and the
+//     relative near band;
+//   * lux that is not fresh never relaxes the cadence, and slow is capped
+//     at a third of the stale window;
+//   * a lights-off simulation through the real darkness hysteresis: the
+//     board's median-of-3 copy sensor, the 5 s RoomIQ tick and the 250 ms
+//     LED tick, swept over every lights-off phase. The adaptive cadence
+//     bounds the lag to a few fast intervals where the fixed 10 s cadence
+//     lags by more than 10 s; a bright unarmed day polls less than fixed.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/roomiq_engine.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <exception>
+
+using namespace sense360::roomiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t FAST_MS = 2000;
+static const uint32_t NORMAL_MS = 10000;
+static const uint32_t SLOW_MS = 20000;
+
+// Production defaults: threshold 20 lx, hysteresis 1.5, band 50 % ->
+// near [10, 45] lx, far below 2.5 lx or above 180 lx.
+static void configure(RoomIQEngine &engine) {
+  engine.set_darkness_threshold(20.0f);
+  engine.set_darkness_hysteresis(1.5f);
+  engine.set_lux_sample_intervals(FAST_MS, NORMAL_MS, SLOW_MS);
+  engine.set_lux_near_band_pct(50.0f);
+}
+
+static uint32_t interval_at(float lux, bool armed) {
+  RoomIQEngine engine;
+  configure(engine);
+  engine.begin(0);
+  engine.set_darkness_armed(armed);
+  engine.input_lux(1000, lux);
+  return engine.lux_sample_interval_ms(1000);
+}
+
+TEST_CASE(tiers_follow_the_distance_from_the_darkness_decision) {
+  // Near band edges are inclusive.
+  ASSERT_EQ(interval_at(10.0f, false), FAST_MS);
+  ASSERT_EQ(interval_at(20.0f, false), FAST_MS);
+  ASSERT_EQ(interval_at(45.0f, false), FAST_MS);
+  // Between near and far.
+  ASSERT_EQ(interval_at(5.0f, false), NORMAL_MS);
+  ASSERT_EQ(interval_at(100.0f, false), NORMAL_MS);
+  ASSERT_EQ(interval_at(180.0f, false), NORMAL_MS);
+  // Far.
+  ASSERT_EQ(interval_at(1.0f, false), SLOW_MS);
+  ASSERT_EQ(interval_at(400.0f, false), SLOW_MS);
+  // The customer illuminance multiplier moves the comparison too.
+  RoomIQEngine scaled;
+  configure(scaled);
+  scaled.begin(0);
+  scaled.set_illuminance_scale(0.2f);
+  scaled.input_lux(1000, 150.0f);  // calibrated 30 lx
+  ASSERT_EQ(scaled.lux_sample_interval_ms(1000), FAST_MS);
+}
+
+TEST_CASE(armed_automation_stays_fast_unless_far) {
+  ASSERT_EQ(interval_at(100.0f, true), FAST_MS);
+  ASSERT_EQ(interval_at(5.0f, true), FAST_MS);
+  // Far from the decision an armed automation still never relaxes to slow.
+  ASSERT_EQ(interval_at(400.0f, true), NORMAL_MS);
+  ASSERT_EQ(interval_at(1.0f, true), NORMAL_MS);
+}
+
+TEST_CASE(near_band_is_configurable_and_clamped) {
+  RoomIQEngine engine;
+  configure(engine);
+  engine.begin(0);
+  engine.input_lux(1000, 50.0f);
+  ASSERT_EQ(engine.lux_sample_interval_ms(1000), NORMAL_MS);  // > 45 lx
+  engine.set_lux_near_band_pct(80.0f);                         // up to 54 lx
+  ASSERT_EQ(engine.lux_sample_interval_ms(1000), FAST_MS);
+  engine.set_lux_near_band_pct(0.0f);  // exactly the hysteresis gap [20, 30]
+  ASSERT_EQ(engine.lux_sample_interval_ms(1000), NORMAL_MS);
+  engine.set_lux_near_band_pct(NAN);  // recovers to 0
+  ASSERT_EQ(engine.lux_sample_interval_ms(1000), NORMAL_MS);
+}
+
+TEST_CASE(unfresh_lux_never_relaxes_and_slow_respects_staleness) {
+  RoomIQEngine engine;
+  configure(engine);
+  engine.begin(0);
+  engine.set_darkness_armed(true);
+  ASSERT_EQ(engine.lux_sample_interval_ms(1000), NORMAL_MS);    // warm-up
+  ASSERT_EQ(engine.lux_sample_interval_ms(40000), NORMAL_MS);   // missing
+  engine.set_darkness_armed(false);
+  engine.input_lux(40000, 900.0f);
+  ASSERT_EQ(engine.lux_sample_interval_ms(40000), SLOW_MS);
+  ASSERT_EQ(engine.lux_sample_interval_ms(101000), NORMAL_MS);  // stale
+
+  // A long slow interval is capped at a third of the stale window ...
+  engine.set_lux_sample_intervals(FAST_MS, NORMAL_MS, 120000);
+  engine.input_lux(102000, 900.0f);
+  ASSERT_EQ(engine.lux_sample_interval_ms(102000), 20000u);
+  // ... but never below normal, and fast never exceeds normal.
+  engine.set_lux_stale_ms(15000);
+  ASSERT_EQ(engine.lux_sample_interval_ms(102000), NORMAL_MS);
+  engine.set_lux_sample_intervals(30000, NORMAL_MS, SLOW_MS);
+  engine.input_lux(102000, 20.0f);
+  ASSERT_EQ(engine.lux_sample_interval_ms(102000), NORMAL_MS);
+  // Zero intervals are ignored.
+  engine.set_lux_sample_intervals(0, 0, 0);
+  ASSERT_EQ(engine.lux_sample_interval_ms(102000), NORMAL_MS);
+}
+
+// --- lights-off simulation ----------------------------------------------------
+// Mirrors the production path: the LTR-303 poller samples the scene, the
+// median-of-3 copy sensor (window 3, send_every 1, send_first_at 1) feeds
+// the engine, the glue re-times the poller after every evaluate (sample
+// callbacks and the 5 s tick), and the LED loop reads evaluate_darkness()
+// every 250 ms.
+struct Rig {
+  RoomIQEngine engine;
+  bool adaptive;
+  uint32_t next_poll_ms = 0;
+  uint32_t applied_ms = NORMAL_MS;
+  uint32_t polls = 0;
+  float window[3] = {0.0f, 0.0f, 0.0f};
+  int filled = 0;
+
+  Rig(bool adaptive_sampling, bool armed) : adaptive(adaptive_sampling) {
+    configure(engine);
+    engine.begin(0);
+    engine.set_darkness_armed(armed);
+    next_poll_ms = NORMAL_MS;
+  }
+
+  void retime(uint32_t now) {
+    if (!adaptive) return;
+    const uint32_t interval = engine.lux_sample_interval_ms(now);
+    if (interval == applied_ms) return;
+    applied_ms = interval;
+    next_poll_ms = now + interval;  // start_poller(): a fresh period
+  }
+
+  float median(float lux) {
+    window[0] = window[1];
+    window[1] = window[2];
+    window[2] = lux;
+    if (filled < 3) filled++;
+    // ESPHome's median: the middle sample (the mean of the two while only
+    // two are held).
+    if (filled == 1) return window[2];
+    if (filled == 2) return (window[1] + window[2]) / 2.0f;
+    return std::max(std::min(window[0], window[1]),
+                    std::min(std::max(window[0], window[1]), window[2]));
+  }
+
+  // One 250 ms step; returns the LED loop's darkness decision.
+  Darkness step(uint32_t now, float scene_lux) {
+    if (now >= next_poll_ms) {
+      polls++;
+      next_poll_ms = now + applied_ms;
+      engine.input_lux(now, median(scene_lux));
+      engine.evaluate(now);
+      retime(now);
+    }
+    if (now % 5000 == 0) {
+      engine.evaluate(now);
+      retime(now);
+    }
+    return engine.evaluate_darkness(now);
+  }
+};
+
+// Worst lights-off -> DARK lag over every lights-off phase within one
+// normal period (250 ms steps).
+static uint32_t worst_lights_off_lag(bool adaptive, bool armed, float lights_on_lux) {
+  uint32_t worst = 0;
+  for (uint32_t phase = 0; phase < NORMAL_MS; phase += 250) {
+    Rig rig(adaptive, armed);
+    const uint32_t off_ms = 120000 + phase;
+    uint32_t dark_ms = 0;
+    for (uint32_t now = 0; now < off_ms + 60000; now += 250) {
+      const float scene = now < off_ms ? lights_on_lux : 1.0f;
+      const Darkness d = rig.step(now, scene);
+      if (now < off_ms) {
+        if (now >= 60000) ASSERT_EQ(d, DARKNESS_NOT_DARK);
+      } else if (d == DARKNESS_DARK) {
+        dark_ms = now;
+        break;
+      }
+    }
+    ASSERT_TRUE(dark_ms != 0);
+    worst = std::max(worst, dark_ms - off_ms);
+  }
+  return worst;
+}
+
+TEST_CASE(lights_off_reaches_the_led_loop_within_fast_intervals) {
+  // Armed night automation, room lit at 150 lx (normal tier unarmed).
+  const uint32_t fixed = worst_lights_off_lag(false, true, 150.0f);
+  const uint32_t adaptive = worst_lights_off_lag(true, true, 150.0f);
+  // Unarmed, a dim room inside the near band.
+  const uint32_t fixed_dim = worst_lights_off_lag(false, false, 40.0f);
+  const uint32_t adaptive_dim = worst_lights_off_lag(true, false, 40.0f);
+  printf("    worst lights-off lag: armed 150 lx fixed %.2f s adaptive %.2f s; "
+         "unarmed 40 lx fixed %.2f s adaptive %.2f s\n",
+         fixed / 1000.0, adaptive / 1000.0, fixed_dim / 1000.0,
+         adaptive_dim / 1000.0);
+  // The median needs two dark samples: at most two fast periods (plus the
+  // 250 ms LED tick), against more than one full 10 s period when fixed.
+  ASSERT_TRUE(adaptive <= 2 * FAST_MS + 250);
+  ASSERT_TRUE(adaptive_dim <= 2 * FAST_MS + 250);
+  ASSERT_TRUE(fixed > NORMAL_MS);
+  ASSERT_TRUE(fixed_dim > NORMAL_MS);
+}
+
+TEST_CASE(bright_unarmed_day_polls_less_than_fixed) {
+  Rig fixed(false, false);
+  Rig adaptive(true, false);
+  for (uint32_t now = 0; now < 3600000; now += 250) {
+    fixed.step(now, 800.0f);
+    ASSERT_EQ(adaptive.step(now, 800.0f), fixed.engine.darkness());
+  }
+  printf("    bright hour: fixed %u polls, adaptive %u polls\n",
+         static_cast<unsigned>(fixed.polls), static_cast<unsigned>(adaptive.polls));
+  ASSERT_TRUE(adaptive.polls * 10 < fixed.polls * 6);
+}
+
+int main() {
+  printf("\nROOMIQ-FRAMEWORK-001 adaptive illuminance sampling tests\n");
+  printf("========================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_tiers_follow_the_distance_from_the_darkness_decision,
+           "tiers_follow_the_distance_from_the_darkness_decision");
+  run_test(test_armed_automation_stays_fast_unless_far,
+           "armed_automation_stays_fast_unless_far");
+  run_test(test_near_band_is_configurable_and_clamped,
+           "near_band_is_configurable_and_clamped");
+  run_test(test_unfresh_lux_never_relaxes_and_slow_respects_staleness,
+           "unfresh_lux_never_relaxes_and_slow_respects_staleness");
+  run_test(test_lights_off_reaches_the_led_loop_within_fast_intervals,
+           "lights_off_reaches_the_led_loop_within_fast_intervals");
+  run_test(test_bright_unarmed_day_polls_less_than_fixed,
+           "bright_unarmed_day_polls_less_than_fixed");
+  printf("\n========================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All RoomIQ adaptive illuminance sampling tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
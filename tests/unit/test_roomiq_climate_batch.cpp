@@ -0,0 +1,163 @@
+// S360-200-R4-CLIMATE-COMPENSATION-001 — batch climate compensation
+// (compensate_climate_batch() in components/sense360/roomiq_climate_compensation.h).
+//
+// The batch path feeds the host-side profile fitter
+// (tests/tools/fit_climate_profile.cpp). This test holds it to the scalar
+// model:
+//
+//   1) a -40...85 °C x 0-100 %RH sweep and a jittered day-long log, on the
+//      shipped profile and with customer offsets: temperature bit-identical
+//      to compensate_climate(), humidity within 1e-4 %RH;
+//   2) every invalid input (NaN / inf sample, the Magnus pole, a NaN
+//      customer offset) resolves as the scalar model does, and pairs below
+//      BATCH_MIN_TEMPERATURE_C are invalid;
+//   3) the 0 / 100 %RH clamp and an empty span.
+//
+// The timing line is informational (host CPU, this binary's flags), never
+// asserted.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/roomiq_climate_compensation.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace sense360::roomiq;
+
+static bool same_float(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static uint32_t lcg_next(uint32_t &state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+// Worst humidity deviation of the batch from the scalar model over the
+// given pairs; asserts validity and temperature agree exactly.
+static double compare_with_scalar(const ClimateProfile &profile,
+                                  const std::vector<float> &raw_t,
+                                  const std::vector<float> &raw_rh,
+                                  float t_offset, float h_offset) {
+  const uint32_t n = static_cast<uint32_t>(raw_t.size());
+  std::vector<float> out_t(n);
+  std::vector<float> out_rh(n);
+  compensate_climate_batch(profile, raw_t.data(), raw_rh.data(), n, t_offset,
+                           h_offset, out_t.data(), out_rh.data());
+  double worst = 0.0;
+  for (uint32_t i = 0; i < n; i++) {
+    const ClimateResult scalar =
+        compensate_climate(profile, raw_t[i], raw_rh[i], t_offset, h_offset);
+    if (!scalar.valid) {
+      assert(std::isnan(out_t[i]) && std::isnan(out_rh[i]));
+      continue;
+    }
+    assert(same_float(out_t[i], scalar.temperature_c));
+    const double error = std::fabs(out_rh[i] - scalar.humidity_pct);
+    if (error > worst) worst = error;
+  }
+  return worst;
+}
+
+int main() {
+  printf("\n=== S360-200-R4-CLIMATE-COMPENSATION-001 batch compensation ===\n");
+  const ClimateProfile &profile = S360_200_R4_CLIMATE_PROFILE_V1();
+
+  // 1) Sweep and a jittered day, with and without customer offsets.
+  {
+    std::vector<float> raw_t;
+    std::vector<float> raw_rh;
+    for (int i = 0; i <= 12500; i++) {
+      for (int rh = 0; rh <= 100; rh += 10) {
+        raw_t.push_back(-40.0f + 0.01f * static_cast<float>(i));
+        raw_rh.push_back(static_cast<float>(rh));
+      }
+    }
+    uint32_t rng = 3;
+    for (int i = 0; i < 2880; i++) {
+      raw_t.push_back(26.0f + static_cast<float>(lcg_next(rng) % 900) / 100.0f);
+      raw_rh.push_back(38.0f + static_cast<float>(lcg_next(rng) % 2500) / 100.0f);
+    }
+    const double plain = compare_with_scalar(profile, raw_t, raw_rh, 0.0f, 0.0f);
+    const double offsets = compare_with_scalar(profile, raw_t, raw_rh, 0.7f, -1.3f);
+    printf("    %u pairs: humidity worst |batch - scalar| %.3g %%RH "
+           "(offsets: %.3g %%RH), temperature bit-identical\n",
+           static_cast<unsigned>(raw_t.size()), plain, offsets);
+    assert(plain < 1e-4);
+    assert(offsets < 1e-4);
+  }
+
+  // 2) Invalid inputs mirror invalid_climate_result().
+  {
+    const std::vector<float> raw_t = {NAN, 25.0f, INFINITY, -INFINITY, -243.12f,
+                                      -250.0f, 25.0f, 25.0f};
+    const std::vector<float> raw_rh = {50.0f, NAN, 50.0f, 50.0f, 50.0f,
+                                       50.0f, INFINITY, 50.0f};
+    compare_with_scalar(profile, raw_t, raw_rh, 0.0f, 0.0f);
+    // Below the batch domain bound — raw, or only after the correction —
+    // every lane is NAN (the scalar model is still valid there).
+    const float cold_t[] = {-100.0f, -95.0f, -150.0f, -230.0f};
+    const float cold_rh[] = {50.0f, 50.0f, 50.0f, 50.0f};
+    float out_t[4];
+    float out_rh[4];
+    compensate_climate_batch(profile, cold_t, cold_rh, 4, 0.0f, 0.0f, out_t, out_rh);
+    for (int i = 0; i < 4; i++) assert(std::isnan(out_t[i]) && std::isnan(out_rh[i]));
+    // A NaN customer offset is neutral, exactly as in the scalar path.
+    const std::vector<float> one_t = {24.0f};
+    const std::vector<float> one_rh = {47.0f};
+    assert(compare_with_scalar(profile, one_t, one_rh, NAN, NAN) < 1e-4);
+  }
+
+  // 3) Clamping and an empty span.
+  {
+    const float raw_t[] = {25.0f, 25.0f};
+    const float raw_rh[] = {0.0f, 100.0f};
+    float out_t[] = {1.0f, 1.0f};
+    float out_rh[] = {1.0f, 1.0f};
+    compensate_climate_batch(profile, raw_t, raw_rh, 2, 0.0f, -30.0f, out_t, out_rh);
+    assert(out_rh[0] == 0.0f);
+    compensate_climate_batch(profile, raw_t, raw_rh, 2, -10.0f, 0.0f, out_t, out_rh);
+    assert(out_rh[1] == 100.0f);
+    float untouched_t = 7.0f;
+    float untouched_rh = 7.0f;
+    compensate_climate_batch(profile, raw_t, raw_rh, 0, 0.0f, 0.0f, &untouched_t,
+                             &untouched_rh);
+    assert(untouched_t == 7.0f && untouched_rh == 7.0f);
+  }
+
+  // Informational: one pass over a fitting-sized log on this host.
+  {
+    const uint32_t n = 1u << 20;
+    std::vector<float> raw_t(n);
+    std::vector<float> raw_rh(n);
+    uint32_t rng = 5;
+    for (uint32_t i = 0; i < n; i++) {
+      raw_t[i] = 20.0f + static_cast<float>(lcg_next(rng) % 1500) / 100.0f;
+      raw_rh[i] = 30.0f + static_cast<float>(lcg_next(rng) % 4000) / 100.0f;
+    }
+    std::vector<float> out_t(n);
+    std::vector<float> out_rh(n);
+    const auto a = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) {
+      const ClimateResult r = compensate_climate(profile, raw_t[i], raw_rh[i], 0.0f, 0.0f);
+      out_t[i] = r.temperature_c;
+      out_rh[i] = r.humidity_pct;
+    }
+    const auto b = std::chrono::steady_clock::now();
+    compensate_climate_batch(profile, raw_t.data(), raw_rh.data(), n, 0.0f, 0.0f,
+                             out_t.data(), out_rh.data());
+    const auto c = std::chrono::steady_clock::now();
+    printf("    host ns/pair: compensate_climate %.2f batch %.2f (%.4g)\n",
+           std::chrono::duration<double, std::nano>(b - a).count() / n,
+           std::chrono::duration<double, std::nano>(c - b).count() / n,
+           static_cast<double>(out_rh[n / 2]));
+  }
+
+  printf("1/1 tests passed\n");
+  return 0;
+}
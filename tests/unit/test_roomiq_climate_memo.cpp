@@ -0,0 +1,161 @@
+// S360-200-R4-CLIMATE-COMPENSATION-001 — memoised climate result in the
+// RoomIQ engine (components/sense360/roomiq_engine.h).
+//
+// The engine computes the ClimateResult once per new coherent SHT45 pair or
+// profile / offset change and serves every getter from it. This test:
+//
+//   1) replays a day of samples (jittered callback order, dropped humidity
+//      halves, offset and profile changes) and asserts every compensated
+//      output is bit-identical to a direct compensate_climate() call on the
+//      same coherent pair;
+//   2) counts exp() calls (the Magnus formula's exponential, routed through
+//      SENSE360_CLIMATE_EXP) per evaluate + publish cycle, reading every
+//      getter the glue and the roomiq_framework.yaml lambdas read.
+//
+// A green run here is LOGIC/HOST-BENCHMARK proof only — never hardware
+// validation.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+static long exp_calls = 0;
+
+static float counted_exp(float x) {
+  exp_calls++;
+  return std::exp(x);
+}
+
+#define SENSE360_CLIMATE_EXP counted_exp
+#include "../../components/sense360/roomiq_engine.h"
+
+using namespace sense360::roomiq;
+
+static bool same_float(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static uint32_t lcg_next(uint32_t &state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+// Every climate-derived read of one evaluate + publish cycle: the
+// Sense360RoomIQ publish path plus the legacy template lambdas.
+static float publish_cycle(RoomIQEngine &engine, uint32_t now) {
+  engine.evaluate(now);
+  float sink = 0.0f;
+  const float reads[] = {engine.temperature(),         engine.humidity(),
+                         engine.factory_temperature(), engine.factory_humidity(),
+                         engine.heat_index(),          engine.legacy_comfort_score()};
+  for (float r : reads)
+    if (!std::isnan(r)) sink += r;
+  sink += static_cast<float>(std::strlen(engine.legacy_comfort_status()));
+  sink += static_cast<float>(std::strlen(engine.legacy_temperature_advice()));
+  sink += static_cast<float>(std::strlen(engine.legacy_humidity_advice()));
+  return sink;
+}
+
+// Humidity-derived reads per cycle that each ran compensate_climate()
+// (three exp() calls) before memoisation: humidity(), factory_humidity(),
+// update_comfort(), heat_index(), legacy_comfort_score() twice (directly and
+// through legacy_comfort_status()) and legacy_humidity_advice().
+static const int LEGACY_CLIMATE_READS = 7;
+
+static const ClimateProfile TEST_PROFILE = {
+    "TEST_PROFILE", "S360-200", "R9", -3.0f, 1.5f, CLIMATE_EVIDENCE_NONE,
+};
+
+int main() {
+  printf("\n=== S360-200-R4-CLIMATE-COMPENSATION-001 memoised climate ===\n");
+
+  // 1) Bit-identical to a direct compensation of the same coherent pair.
+  {
+    RoomIQEngine engine;
+    engine.begin(0);
+    uint32_t rng = 11;
+    float pair_t = NAN;
+    float pair_h = NAN;
+    float t_offset = 0.0f;
+    float h_offset = 0.0f;
+    const ClimateProfile *profile = &S360_200_R4_CLIMATE_PROFILE_V1();
+    long compared = 0;
+    for (uint32_t now = 1000; now < 24u * 3600u * 1000u; now += 30000) {
+      const float t = 22.0f + static_cast<float>(lcg_next(rng) % 800) / 100.0f;
+      const float h = 35.0f + static_cast<float>(lcg_next(rng) % 3000) / 100.0f;
+      const bool drop_humidity = lcg_next(rng) % 17 == 0;
+      if (lcg_next(rng) % 2) {
+        engine.input_temperature(now, t);
+        if (!drop_humidity) engine.input_humidity(now + 2, h);
+      } else {
+        if (!drop_humidity) engine.input_humidity(now, h);
+        engine.input_temperature(now + 2, t);
+      }
+      if (!drop_humidity) {
+        pair_t = t;
+        pair_h = h;
+      }
+      if (lcg_next(rng) % 97 == 0) {
+        t_offset = static_cast<float>(lcg_next(rng) % 21) / 10.0f - 1.0f;
+        engine.set_temperature_offset(t_offset);
+      }
+      if (lcg_next(rng) % 89 == 0) {
+        h_offset = static_cast<float>(lcg_next(rng) % 41) / 10.0f - 2.0f;
+        engine.set_humidity_offset(h_offset);
+      }
+      if (lcg_next(rng) % 389 == 0) {
+        profile = profile == &TEST_PROFILE ? &S360_200_R4_CLIMATE_PROFILE_V1()
+                                           : &TEST_PROFILE;
+        engine.set_climate_profile(*profile);
+      }
+      engine.evaluate(now + 2);
+      if (!engine.humidity_fresh()) continue;
+      const ClimateResult direct =
+          compensate_climate(*profile, pair_t, pair_h, t_offset, h_offset);
+      assert(same_float(engine.humidity(), direct.humidity_pct));
+      assert(same_float(engine.factory_humidity(), direct.factory_humidity_pct));
+      compared++;
+    }
+    printf("    %ld fresh cycles bit-identical to compensate_climate()\n",
+           compared);
+    assert(compared > 2500);
+  }
+
+  // 2) exp() calls per evaluate + publish cycle.
+  {
+    RoomIQEngine engine;
+    engine.begin(0);
+    engine.input_temperature(1000, 27.5f);
+    engine.input_humidity(1000, 55.0f);
+    engine.evaluate(61000);  // past the warm-up: climate fresh
+
+    exp_calls = 0;
+    publish_cycle(engine, 62000);
+    const long unchanged = exp_calls;
+
+    exp_calls = 0;
+    engine.input_temperature(91000, 27.6f);
+    engine.input_humidity(91000, 55.5f);
+    publish_cycle(engine, 91000);
+    const long new_pair = exp_calls;
+
+    exp_calls = 0;
+    engine.set_temperature_offset(0.5f);
+    engine.set_humidity_offset(0.0f);  // unchanged: not a recompute
+    publish_cycle(engine, 92000);
+    const long offset_change = exp_calls;
+
+    printf("    exp() per cycle: unchanged=%ld new pair=%ld offset change=%ld "
+           "(before memoisation: %d per cycle)\n",
+           unchanged, new_pair, offset_change, 3 * LEGACY_CLIMATE_READS);
+    assert(unchanged == 0);
+    assert(new_pair == 3);
+    assert(offset_change == 3);
+  }
+
+  printf("1/1 tests passed\n");
+  return 0;
+}
@@ -0,0 +1,185 @@
+// S360-200-R4-CLIMATE-COMPENSATION-001 — board climate profile registry
+// (ClimateProfileTable in components/sense360/roomiq_climate_compensation.h).
+//
+// Built the way a bench build is: a non-default compiled profile
+// (-DSENSE360_CLIMATE_PROFILE=CLIMATE_PROFILE_NEUTRAL) and the runtime
+// id-string switch (-DSENSE360_CLIMATE_PROFILE_RUNTIME=1). Covers EVERY
+// registry entry:
+//
+//   * the table is a compile-time constant (static_asserts below) and every
+//     entry is named, attributed to a board, unique and finite;
+//   * each entry, selected by ClimateProfileId and by id string, drives the
+//     engine to exactly the compensate_climate() result for that entry;
+//   * the compiled-in profile is the engine default;
+//   * an unknown id string is rejected without changing the profile.
+//
+// The default (production) build — S360-200 R4 compiled in, no runtime
+// lookup — is covered by test_roomiq_engine.cpp.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#define SENSE360_CLIMATE_PROFILE CLIMATE_PROFILE_NEUTRAL
+#define SENSE360_CLIMATE_PROFILE_RUNTIME 1
+#include "../../components/sense360/roomiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+using namespace sense360::roomiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_STREQ(a, b) assert(std::strcmp((a), (b)) == 0)
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+// Compile-time: constant lookups, no runtime initialisation.
+static_assert(climate_profile_entry(CLIMATE_PROFILE_S360_200_R4_V1)
+                      .temperature_correction_c == -5.80f,
+              "S360-200 R4 correction");
+static_assert(climate_profile_entry(CLIMATE_PROFILE_S360_200_R4_V1)
+                      .humidity_residual_pct == 4.52f,
+              "S360-200 R4 residual");
+static_assert(climate_profile_entry(CLIMATE_PROFILE_NEUTRAL)
+                      .temperature_correction_c == 0.0f,
+              "neutral is neutral");
+static_assert(&compiled_climate_profile() ==
+                  &climate_profile_entry(CLIMATE_PROFILE_NEUTRAL),
+              "the compiled profile follows SENSE360_CLIMATE_PROFILE");
+static_assert(&S360_200_R4_CLIMATE_PROFILE_V1() ==
+                  &climate_profile_entry(CLIMATE_PROFILE_S360_200_R4_V1),
+              "historical identifier is the table entry");
+
+static bool same_float(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// One coherent pair, then the engine must match the pure model bit for bit.
+static void assert_engine_uses(RoomIQEngine &engine, const ClimateProfile &profile,
+                               uint32_t now) {
+  engine.input_temperature(now, 28.4f);
+  engine.input_humidity(now, 51.0f);
+  engine.evaluate(now + 60000);
+  const ClimateResult direct = compensate_climate(profile, 28.4f, 51.0f,
+                                                  engine.temperature_offset(),
+                                                  engine.humidity_offset());
+  ASSERT_TRUE(direct.valid);
+  ASSERT_TRUE(same_float(engine.temperature(), direct.temperature_c));
+  ASSERT_TRUE(same_float(engine.humidity(), direct.humidity_pct));
+  ASSERT_TRUE(same_float(engine.factory_humidity(), direct.factory_humidity_pct));
+}
+
+TEST_CASE(every_entry_is_named_attributed_unique_and_finite) {
+  for (int i = 0; i < CLIMATE_PROFILE_COUNT; i++) {
+    const ClimateProfile &entry =
+        climate_profile_entry(static_cast<ClimateProfileId>(i));
+    ASSERT_TRUE(entry.id != nullptr && entry.id[0] != '\0');
+    ASSERT_TRUE(entry.board_sku != nullptr && entry.board_sku[0] != '\0');
+    ASSERT_TRUE(entry.board_revision != nullptr && entry.board_revision[0] != '\0');
+    ASSERT_TRUE(std::isfinite(entry.temperature_correction_c));
+    ASSERT_TRUE(std::isfinite(entry.humidity_residual_pct));
+    // A correction without evidence would be an unattributed number.
+    if (entry.evidence == CLIMATE_EVIDENCE_NONE) {
+      ASSERT_EQ(entry.temperature_correction_c, 0.0f);
+      ASSERT_EQ(entry.humidity_residual_pct, 0.0f);
+    }
+    for (int j = 0; j < i; j++) {
+      ASSERT_TRUE(std::strcmp(
+                      entry.id,
+                      climate_profile_entry(static_cast<ClimateProfileId>(j)).id) != 0);
+    }
+  }
+}
+
+TEST_CASE(compiled_profile_is_the_engine_default) {
+  RoomIQEngine engine;
+  engine.begin(0);
+  ASSERT_TRUE(&engine.climate_profile() == &compiled_climate_profile());
+  ASSERT_STREQ(engine.climate_profile().id, "NEUTRAL_CLIMATE_PROFILE");
+  assert_engine_uses(engine, compiled_climate_profile(), 1000);
+  // Neutral: the canonical values are the raw pair.
+  ASSERT_EQ(engine.temperature(), 28.4f);
+}
+
+TEST_CASE(every_entry_selected_by_id_drives_the_engine) {
+  for (int i = 0; i < CLIMATE_PROFILE_COUNT; i++) {
+    const ClimateProfileId id = static_cast<ClimateProfileId>(i);
+    RoomIQEngine engine;
+    engine.begin(0);
+    engine.set_temperature_offset(0.4f);
+    engine.set_humidity_offset(-0.6f);
+    engine.set_climate_profile(id);
+    ASSERT_TRUE(&engine.climate_profile() == &climate_profile_entry(id));
+    assert_engine_uses(engine, climate_profile_entry(id), 1000);
+  }
+}
+
+TEST_CASE(every_entry_selected_by_id_string_at_runtime) {
+  RoomIQEngine engine;
+  engine.begin(0);
+  uint32_t now = 1000;
+  for (int i = CLIMATE_PROFILE_COUNT - 1; i >= 0; i--) {
+    const ClimateProfile &entry =
+        climate_profile_entry(static_cast<ClimateProfileId>(i));
+    ASSERT_TRUE(find_climate_profile(entry.id) == &entry);
+    ASSERT_TRUE(engine.set_climate_profile(entry.id));
+    ASSERT_TRUE(&engine.climate_profile() == &entry);
+    assert_engine_uses(engine, entry, now);
+    now += 120000;
+  }
+}
+
+TEST_CASE(unknown_id_string_changes_nothing) {
+  RoomIQEngine engine;
+  engine.begin(0);
+  engine.set_climate_profile(CLIMATE_PROFILE_S360_200_R4_V1);
+  ASSERT_FALSE(engine.set_climate_profile("S360_200_R5_CLIMATE_PROFILE_V1"));
+  ASSERT_FALSE(engine.set_climate_profile(""));
+  ASSERT_FALSE(engine.set_climate_profile(static_cast<const char *>(nullptr)));
+  ASSERT_TRUE(find_climate_profile("s360_200_r4_climate_profile_v1") == nullptr);
+  ASSERT_TRUE(&engine.climate_profile() == &S360_200_R4_CLIMATE_PROFILE_V1());
+}
+
+int main() {
+  printf("\nS360-200-R4-CLIMATE-COMPENSATION-001 profile registry tests\n");
+  printf("============================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_every_entry_is_named_attributed_unique_and_finite,
+           "every_entry_is_named_attributed_unique_and_finite");
+  run_test(test_compiled_profile_is_the_engine_default,
+           "compiled_profile_is_the_engine_default");
+  run_test(test_every_entry_selected_by_id_drives_the_engine,
+           "every_entry_selected_by_id_drives_the_engine");
+  run_test(test_every_entry_selected_by_id_string_at_runtime,
+           "every_entry_selected_by_id_string_at_runtime");
+  run_test(test_unknown_id_string_changes_nothing,
+           "unknown_id_string_changes_nothing");
+  printf("\n============================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All RoomIQ climate profile registry tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
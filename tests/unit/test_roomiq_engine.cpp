@@ -749,6 +749,71 @@ TEST_CASE(darkness_unknown_before_first_sample) {
   ASSERT_EQ(engine.darkness(), DARKNESS_UNKNOWN);
 }
 
+// The LED loop's darkness-only query reaches the full evaluation's decision
+// at every instant: a lux trace crossing the hysteresis band, threshold
+// changes, a sensor dropout into staleness and recovery. One engine runs the
+// full evaluate() at 250 ms; the other mirrors production — darkness-only at
+// 250 ms, the full evaluation on the RoomIQ component's 5 s tick.
+TEST_CASE(darkness_only_query_matches_full_evaluation) {
+  RoomIQEngine full = make_engine();
+  RoomIQEngine fast = make_engine();
+  uint32_t rng = 9;
+  float lux = 15.0f;
+  int transitions = 0;
+  Darkness previous = DARKNESS_UNKNOWN;
+  for (uint32_t t = T0; t < T0 + 3600000; t += 250) {
+    const bool dropout = t > T0 + 1200000 && t < T0 + 1500000;
+    if ((t - T0) % 10000 == 0 && !dropout) {
+      rng = rng * 1664525u + 1013904223u;
+      lux += static_cast<float>((rng >> 8) % 9) - 4.0f;
+      if (lux < 0.0f) lux = 0.0f;
+      full.input_lux(t, lux);
+      fast.input_lux(t, lux);
+    }
+    if ((t - T0) % 600000 == 0) {
+      const float threshold = (t - T0) % 1200000 == 0 ? 20.0f : 14.0f;
+      full.set_darkness_threshold(threshold);
+      fast.set_darkness_threshold(threshold);
+    }
+    full.evaluate(t);
+    if ((t - T0) % 5000 == 0) fast.evaluate(t);
+    ASSERT_EQ(fast.evaluate_darkness(t), full.darkness());
+    ASSERT_EQ(fast.darkness(), full.darkness());
+    if (full.darkness() != previous) transitions++;
+    previous = full.darkness();
+  }
+  ASSERT_TRUE(transitions >= 6);
+}
+
+// Darkness-only never touches another output, even when the lux channel
+// goes stale between two full evaluations.
+TEST_CASE(darkness_only_query_leaves_other_outputs_alone) {
+  RoomIQEngine engine = make_engine();
+  feed_all(engine, T0 + 1000, 21.0f, 45.0f, 400.0f);
+  engine.evaluate(T0 + LUX_WARMUP + 2000);
+  const Comfort comfort = engine.comfort();
+  const Brightness brightness = engine.brightness();
+  const Environment environment = engine.environment();
+  const Health health = engine.health();
+  ASSERT_TRUE(engine.illuminance_fresh());
+  ASSERT_EQ(brightness, BRIGHTNESS_BRIGHT);
+
+  // Lux stale: the darkness decision goes Unknown at once ...
+  const uint32_t stale = T0 + 1000 + LUX_STALE + 1;
+  ASSERT_EQ(engine.evaluate_darkness(stale), DARKNESS_UNKNOWN);
+  // ... but everything else waits for the next full evaluation.
+  ASSERT_EQ(engine.comfort(), comfort);
+  ASSERT_EQ(engine.brightness(), brightness);
+  ASSERT_EQ(engine.environment(), environment);
+  ASSERT_EQ(engine.health(), health);
+  ASSERT_TRUE(engine.illuminance_fresh());
+  ASSERT_NEAR(engine.illuminance(), 400.0f, 0.001f);
+
+  engine.evaluate(stale);
+  ASSERT_FALSE(engine.illuminance_fresh());
+  ASSERT_EQ(engine.darkness(), DARKNESS_UNKNOWN);
+}
+
 // ---------------------------------------------------------------------------
 // Environment State (deterministic precedence)
 // ---------------------------------------------------------------------------
@@ -974,6 +1039,113 @@ TEST_CASE(legacy_advice_strings_preserved) {
   ASSERT_STREQ(offline.legacy_temperature_advice(), "Sensor unavailable");
 }
 
+// ---------------------------------------------------------------------------
+// Publish gate (PublishDeadband — the sense360_roomiq change bands)
+// ---------------------------------------------------------------------------
+
+TEST_CASE(publish_gate_holds_sub_band_changes_against_the_last_publish) {
+  PublishDeadband gate(0.05f, 0.0f);
+  ASSERT_TRUE(gate.offer(0, 21.30f));    // first value always publishes
+  ASSERT_FALSE(gate.offer(1000, 21.30f));
+  ASSERT_FALSE(gate.offer(2000, 21.33f));
+  ASSERT_FALSE(gate.offer(3000, 21.27f));
+  // Drift is measured from what the consumer holds, so it adds up.
+  ASSERT_FALSE(gate.offer(4000, 21.34f));
+  ASSERT_TRUE(gate.offer(5000, 21.36f));
+  ASSERT_TRUE(gate.last_published() == 21.36f);
+  ASSERT_FALSE(gate.offer(6000, 21.32f));
+  ASSERT_TRUE(gate.offer(7000, 21.30f));
+}
+
+TEST_CASE(publish_gate_relative_band_scales_with_the_reading) {
+  PublishDeadband gate(0.0f, 0.02f);
+  ASSERT_TRUE(gate.offer(0, 500.0f));
+  ASSERT_FALSE(gate.offer(1000, 509.0f));  // < 10 lx
+  ASSERT_TRUE(gate.offer(2000, 490.0f));
+  ASSERT_TRUE(gate.offer(3000, 2.0f));
+  ASSERT_FALSE(gate.offer(4000, 2.03f));   // < 0.04 lx
+  ASSERT_TRUE(gate.offer(5000, 2.05f));
+  // Zero band: exactly the old publish-on-change contract.
+  PublishDeadband exact(0.0f, 0.0f);
+  ASSERT_TRUE(exact.offer(0, 0.0f));
+  ASSERT_FALSE(exact.offer(1000, 0.0f));
+  ASSERT_TRUE(exact.offer(2000, 0.001f));
+}
+
+TEST_CASE(publish_gate_never_holds_back_staleness_or_recovery) {
+  PublishDeadband gate(0.05f, 0.0f);
+  gate.set_heartbeat_ms(60000);
+  ASSERT_TRUE(gate.offer(0, NAN));         // unknown at boot
+  ASSERT_FALSE(gate.offer(1000, NAN));
+  ASSERT_FALSE(gate.offer(120000, NAN));   // no heartbeat for a held NAN
+  ASSERT_TRUE(gate.offer(121000, 22.0f));  // recovery
+  ASSERT_TRUE(gate.offer(122000, NAN));    // stale
+  ASSERT_TRUE(gate.offer(123000, 22.01f)); // recovery within the band
+}
+
+TEST_CASE(publish_gate_heartbeat_force_and_wraparound) {
+  PublishDeadband gate(0.2f, 0.0f);
+  gate.set_heartbeat_ms(900000);
+  ASSERT_TRUE(gate.offer(4294000000u, 45.0f));
+  ASSERT_FALSE(gate.offer(4294500000u, 45.1f));
+  // Heartbeat across the millis() wrap.
+  ASSERT_FALSE(gate.offer(4294000000u + 899999u, 45.1f));
+  ASSERT_TRUE(gate.offer(4294000000u + 900000u, 45.1f));
+  ASSERT_FALSE(gate.offer(4294000000u + 900001u, 45.1f));
+  gate.force();
+  ASSERT_TRUE(gate.offer(4294000000u + 900002u, 45.1f));
+  // Invalid band inputs recover to zero (exact change).
+  gate.set_band(NAN, -1.0f);
+  ASSERT_TRUE(gate.offer(4294000000u + 900003u, 45.11f));
+}
+
+// A day of SHT45 / LTR-303 sample jitter driven through the component's
+// publish path (every raw callback and the 5 s tick evaluate): the bands
+// cut the state frames the API connection carries to a small fraction of
+// publish-on-exact-change while every published value stays within its
+// band of the engine's current output.
+TEST_CASE(publish_gate_cuts_frames_on_a_jittery_day) {
+  RoomIQEngine engine;
+  engine.set_climate_profile(CLIMATE_PROFILE_NEUTRAL);
+  engine.begin(0);
+  PublishDeadband t_exact(0.0f, 0.0f), h_exact(0.0f, 0.0f), l_exact(0.0f, 0.0f);
+  PublishDeadband t_band(0.05f, 0.0f), h_band(0.2f, 0.0f), l_band(0.0f, 0.02f);
+  t_band.set_heartbeat_ms(900000);
+  h_band.set_heartbeat_ms(900000);
+  l_band.set_heartbeat_ms(900000);
+  uint32_t rng = 11;
+  int exact_frames = 0;
+  int banded_frames = 0;
+  for (uint32_t now = 0; now < 86400000u; now += 5000) {
+    rng = rng * 1664525u + 1013904223u;
+    const float jitter = static_cast<float>((rng >> 8) % 1000) / 1000.0f - 0.5f;
+    // Slow diurnal trend plus sensor-resolution jitter.
+    const float trend = std::sin(static_cast<float>(now) / 86400000.0f * 6.2832f);
+    if (now % 30000 == 0) {
+      engine.input_temperature(now, 21.0f + 2.0f * trend + 0.04f * jitter);
+      engine.input_humidity(now, 50.0f - 8.0f * trend + 0.3f * jitter);
+    }
+    if (now % 10000 == 0) engine.input_lux(now, 300.0f + 200.0f * trend + 6.0f * jitter);
+    engine.evaluate(now);
+    const float values[3] = {engine.temperature(), engine.humidity(), engine.illuminance()};
+    PublishDeadband *exact[3] = {&t_exact, &h_exact, &l_exact};
+    PublishDeadband *banded[3] = {&t_band, &h_band, &l_band};
+    for (int i = 0; i < 3; i++) {
+      if (exact[i]->offer(now, values[i])) exact_frames++;
+      if (banded[i]->offer(now, values[i])) banded_frames++;
+    }
+    if (!std::isnan(values[0])) {
+      ASSERT_TRUE(std::fabs(t_band.last_published() - values[0]) < 0.05f);
+      ASSERT_TRUE(std::fabs(h_band.last_published() - values[1]) < 0.2f);
+      ASSERT_TRUE(std::fabs(l_band.last_published() - values[2]) <=
+                  0.02f * std::fabs(l_band.last_published()));
+    }
+  }
+  printf("    jittery day: %d frames on exact change, %d banded\n", exact_frames,
+         banded_frames);
+  ASSERT_TRUE(banded_frames * 5 < exact_frames);
+}
+
 // ---------------------------------------------------------------------------
 // String vocabularies
 // ---------------------------------------------------------------------------
@@ -1099,6 +1271,10 @@ int main() {
            "darkness_threshold_is_runtime_configurable");
   run_test(test_darkness_unknown_before_first_sample,
            "darkness_unknown_before_first_sample");
+  run_test(test_darkness_only_query_matches_full_evaluation,
+           "darkness_only_query_matches_full_evaluation");
+  run_test(test_darkness_only_query_leaves_other_outputs_alone,
+           "darkness_only_query_leaves_other_outputs_alone");
   run_test(test_environment_comfortable_normal_light,
            "environment_comfortable_normal_light");
   run_test(test_environment_reports_climate_discomfort_first,
@@ -1135,6 +1311,16 @@ int main() {
            "legacy_light_status_maps_canonical_brightness");
   run_test(test_legacy_advice_strings_preserved,
            "legacy_advice_strings_preserved");
+  run_test(test_publish_gate_holds_sub_band_changes_against_the_last_publish,
+           "publish_gate_holds_sub_band_changes_against_the_last_publish");
+  run_test(test_publish_gate_relative_band_scales_with_the_reading,
+           "publish_gate_relative_band_scales_with_the_reading");
+  run_test(test_publish_gate_never_holds_back_staleness_or_recovery,
+           "publish_gate_never_holds_back_staleness_or_recovery");
+  run_test(test_publish_gate_heartbeat_force_and_wraparound,
+           "publish_gate_heartbeat_force_and_wraparound");
+  run_test(test_publish_gate_cuts_frames_on_a_jittery_day,
+           "publish_gate_cuts_frames_on_a_jittery_day");
   run_test(test_state_strings_are_customer_wording,
            "state_strings_are_customer_wording");
 
@@ -0,0 +1,239 @@
+// S360-200-R4-CLIMATE-COMPENSATION-001 — self-heating dynamics
+// (SelfHeatingModel / SelfHeatingFilter in
+// components/sense360/roomiq_climate_compensation.h; RoomIQEngine::
+// set_self_heating_model() / input_board_heat(), fed the LED ring load by the
+// sense360_led glue).
+//
+// Simulates step changes in LED load and proves:
+//
+//   * the dynamic correction follows the exact first-order response — one
+//     time constant after a step it has covered 1 - 1/e of the way, and it
+//     settles on correction_per_load_c * (load - reference_load), for steps
+//     up and down alike, independent of the evaluate cadence;
+//   * the compensated temperature AND humidity follow it (the humidity model
+//     sees the same corrected temperature);
+//   * with no model, or with the load held at the reference load, the
+//     engine is the static profile bit for bit;
+//   * NaN loads are ignored and out-of-range loads clamp.
+//
+// Built with the neutral profile compiled in so the corrections are the
+// model's alone.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#define SENSE360_CLIMATE_PROFILE CLIMATE_PROFILE_NEUTRAL
+#include "../../components/sense360/roomiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+using namespace sense360::roomiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NEAR(a, b, tol) assert(std::fabs((a) - (b)) <= (tol))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static bool same_float(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Ring measured at 20 % load; each unit of settled load above that needs
+// 2.5 C more (negative) correction; 20 min thermal time constant.
+static const SelfHeatingModel MODEL = {0.20f, -2.5f, 1200.0f};
+static const uint32_t TAU_MS = 1200000;
+
+// A device on the 250 ms LED loop and the 5 s RoomIQ tick, SHT45 every 30 s
+// at a constant raw reading, the ring load switching at the given instants.
+struct Rig {
+  RoomIQEngine engine;
+  uint32_t now = 0;
+  float load = 0.20f;
+
+  explicit Rig(bool with_model) {
+    engine.begin(0);
+    if (with_model) engine.set_self_heating_model(MODEL);
+  }
+
+  void run_until(uint32_t end_ms) {
+    for (; now <= end_ms; now += 250) {
+      engine.input_board_heat(now, load);
+      if (now % 30000 == 0) {
+        engine.input_temperature(now, 27.0f);
+        engine.input_humidity(now, 45.0f);
+      }
+      if (now % 5000 == 0) engine.evaluate(now);
+    }
+  }
+};
+
+static float expected_after_step(float from, float to, uint32_t elapsed_ms) {
+  const float settled =
+      to + (from - to) * std::exp(-static_cast<float>(elapsed_ms) / TAU_MS);
+  return MODEL.correction_per_load_c * (settled - MODEL.reference_load);
+}
+
+TEST_CASE(step_up_follows_the_first_order_response) {
+  Rig rig(true);
+  rig.run_until(600000);  // settled at the reference load
+  ASSERT_EQ(rig.engine.self_heating_correction(), 0.0f);
+  ASSERT_TRUE(same_float(rig.engine.temperature(), 27.0f));
+
+  rig.load = 1.0f;  // full white from 600 250 ms on
+  rig.run_until(600000 + TAU_MS);
+  // One time constant: 63.2 % of the way to -2.5 * 0.8 = -2.0 C.
+  const float at_tau = rig.engine.self_heating_correction();
+  ASSERT_NEAR(at_tau, expected_after_step(0.20f, 1.0f, TAU_MS - 250), 1e-4f);
+  ASSERT_NEAR(at_tau, -2.0f * (1.0f - std::exp(-1.0f)), 2e-3f);
+  ASSERT_NEAR(rig.engine.temperature(), 27.0f + at_tau, 1e-4f);
+
+  // Settled after twenty time constants.
+  rig.run_until(600000 + 20 * TAU_MS);
+  ASSERT_NEAR(rig.engine.self_heating_correction(), -2.0f, 1e-4f);
+  ASSERT_NEAR(rig.engine.temperature(), 25.0f, 1e-3f);
+}
+
+TEST_CASE(step_down_decays_back_to_the_static_correction) {
+  Rig rig(true);
+  rig.load = 1.0f;
+  rig.run_until(600000);  // first load seen is taken as settled
+  ASSERT_NEAR(rig.engine.self_heating_correction(), -2.0f, 1e-6f);
+
+  rig.load = 0.0f;  // ring off from 600 250 ms on
+  const uint32_t step = rig.now;
+  rig.run_until(600000 + TAU_MS / 2);  // last evaluate at 1 200 000 ms
+  ASSERT_NEAR(rig.engine.self_heating_correction(),
+              expected_after_step(1.0f, 0.0f, 1200000 - step), 1e-4f);
+  // Below the reference load the correction changes sign (less heating
+  // than the profile was measured with).
+  rig.run_until(step + 20 * TAU_MS);
+  ASSERT_NEAR(rig.engine.self_heating_correction(), 0.5f, 1e-4f);
+  ASSERT_NEAR(rig.engine.temperature(), 27.5f, 1e-3f);
+}
+
+TEST_CASE(response_does_not_depend_on_the_update_cadence) {
+  // The same step evaluated every 5 s and once after an hour.
+  SelfHeatingFilter fine;
+  SelfHeatingFilter coarse;
+  fine.set_model(MODEL);
+  coarse.set_model(MODEL);
+  fine.input_load(0, 0.2f);
+  coarse.input_load(0, 0.2f);
+  fine.input_load(1000, 0.9f);
+  coarse.input_load(1000, 0.9f);
+  for (uint32_t t = 1000; t <= 3601000; t += 5000) fine.excess_correction_c(t);
+  ASSERT_NEAR(fine.excess_correction_c(3601000), coarse.excess_correction_c(3601000),
+              1e-4f);
+  ASSERT_NEAR(coarse.excess_correction_c(3601000), expected_after_step(0.2f, 0.9f, 3600000),
+              1e-5f);
+}
+
+TEST_CASE(humidity_follows_the_corrected_temperature) {
+  Rig rig(true);
+  rig.load = 1.0f;
+  rig.run_until(60000);
+  const float correction = rig.engine.self_heating_correction();
+  const ClimateResult direct =
+      compensate_climate(ClimateProfile{"x", "x", "x", correction, 0.0f,
+                                        CLIMATE_EVIDENCE_NONE},
+                         27.0f, 45.0f, 0.0f, 0.0f);
+  ASSERT_TRUE(same_float(rig.engine.temperature(), direct.temperature_c));
+  ASSERT_TRUE(same_float(rig.engine.humidity(), direct.humidity_pct));
+  // Cooler corrected air holds less water: relative humidity rises.
+  ASSERT_TRUE(rig.engine.humidity() > 45.0f);
+}
+
+TEST_CASE(no_model_or_reference_load_is_the_static_profile) {
+  // No model: load steps change nothing.
+  Rig none(false);
+  none.run_until(300000);
+  none.load = 1.0f;
+  none.run_until(900000);
+  ASSERT_EQ(none.engine.self_heating_correction(), 0.0f);
+  ASSERT_TRUE(same_float(none.engine.temperature(), 27.0f));
+  ASSERT_TRUE(same_float(none.engine.humidity(), 45.0f));
+
+  // A model, load held at the reference: bit for bit the static engine.
+  Rig held(true);
+  held.run_until(900000);
+  ASSERT_TRUE(same_float(held.engine.temperature(), none.engine.temperature()));
+  ASSERT_TRUE(same_float(held.engine.humidity(), none.engine.humidity()));
+
+  // A model but no heat input (no LED component): static.
+  RoomIQEngine engine;
+  engine.begin(0);
+  engine.set_self_heating_model(MODEL);
+  engine.input_temperature(0, 27.0f);
+  engine.input_humidity(0, 45.0f);
+  engine.evaluate(60000);
+  ASSERT_EQ(engine.self_heating_correction(), 0.0f);
+  ASSERT_TRUE(same_float(engine.temperature(), 27.0f));
+}
+
+TEST_CASE(invalid_loads_are_ignored_or_clamped) {
+  SelfHeatingFilter filter;
+  filter.set_model(MODEL);
+  ASSERT_TRUE(std::isnan(filter.settled_load()));
+  filter.input_load(0, NAN);
+  ASSERT_TRUE(std::isnan(filter.settled_load()));
+  filter.input_load(0, 7.0f);  // clamps to full load
+  ASSERT_EQ(filter.settled_load(), 1.0f);
+  filter.input_load(1000, NAN);  // holds full load
+  ASSERT_NEAR(filter.excess_correction_c(TAU_MS), -2.0f, 1e-6f);
+  filter.input_load(TAU_MS, -3.0f);  // clamps to off
+  ASSERT_NEAR(filter.excess_correction_c(TAU_MS + 20 * TAU_MS), 0.5f, 1e-5f);
+
+  // A nonsense model is off, not undefined.
+  SelfHeatingFilter bad;
+  bad.set_model({NAN, NAN, -5.0f});
+  ASSERT_FALSE(bad.enabled());
+  bad.input_load(0, 1.0f);
+  ASSERT_EQ(bad.excess_correction_c(1000), 0.0f);
+}
+
+int main() {
+  printf("\nS360-200-R4-CLIMATE-COMPENSATION-001 self-heating dynamics tests\n");
+  printf("================================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_step_up_follows_the_first_order_response,
+           "step_up_follows_the_first_order_response");
+  run_test(test_step_down_decays_back_to_the_static_correction,
+           "step_down_decays_back_to_the_static_correction");
+  run_test(test_response_does_not_depend_on_the_update_cadence,
+           "response_does_not_depend_on_the_update_cadence");
+  run_test(test_humidity_follows_the_corrected_temperature,
+           "humidity_follows_the_corrected_temperature");
+  run_test(test_no_model_or_reference_load_is_the_static_profile,
+           "no_model_or_reference_load_is_the_static_profile");
+  run_test(test_invalid_loads_are_ignored_or_clamped,
+           "invalid_loads_are_ignored_or_clamped");
+  printf("\n================================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All RoomIQ self-heating dynamics tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
@@ -0,0 +1,147 @@
+// S360-200-R4-CLIMATE-COMPENSATION-001 — fast saturation vapour pressure
+// kernel (components/sense360/roomiq_climate_compensation.h).
+//
+// Compiles the compensation model with the opt-in polynomial exp() kernel
+// (-DSENSE360_CLIMATE_FAST_SVP=1, the sense360_roomiq
+// `fast_vapour_pressure` option) and sweeps it against the std::exp kernel:
+//
+//   1) fast_exp() over the full Magnus argument range of -40...85 °C;
+//   2) saturation_vapour_pressure_hpa() in 0.001 °C steps, against the
+//      std::exp float kernel and a double-precision Magnus reference;
+//   3) compensated humidity on the shipped board profile over the same
+//      temperature range and 0-100 %RH, against the std::exp model —
+//      asserting the documented bound, far below the SHT45's 0.01 %RH
+//      resolution.
+//
+// The timing line is informational (host CPU), never asserted.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#define SENSE360_CLIMATE_FAST_SVP 1
+#include "../../components/sense360/roomiq_climate_compensation.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace sense360::roomiq;
+
+static const float T_MIN = -40.0f;
+static const float T_MAX = 85.0f;
+static const int SWEEP_STEPS = 125000;  // 0.001 °C
+
+static float sweep_temperature(int i) {
+  return T_MIN + (T_MAX - T_MIN) * static_cast<float>(i) / SWEEP_STEPS;
+}
+
+// The std::exp float kernel (the default build's implementation).
+static float reference_svp(float temperature_c) {
+  return 6.112f * std::exp((17.62f * temperature_c) / (243.12f + temperature_c));
+}
+
+static double exact_svp(double temperature_c) {
+  return 6.112 * std::exp((17.62 * temperature_c) / (243.12 + temperature_c));
+}
+
+// The humidity model with the std::exp kernel, for the same pair.
+static float reference_humidity(const ClimateProfile &profile, float raw_t,
+                                float raw_rh) {
+  const float final_t = raw_t + profile.temperature_correction_c;
+  const float vapour = (raw_rh / 100.0f) * reference_svp(raw_t);
+  return clamp_relative_humidity(100.0f * vapour / reference_svp(final_t) +
+                                 profile.humidity_residual_pct);
+}
+
+int main() {
+  printf("\n=== S360-200-R4-CLIMATE-COMPENSATION-001 fast SVP kernel ===\n");
+
+  // 1) fast_exp() against std::exp over the Magnus argument range.
+  {
+    double worst = 0.0;
+    for (int i = 0; i <= SWEEP_STEPS; i++) {
+      const float t = sweep_temperature(i);
+      const float x = (17.62f * t) / (243.12f + t);
+      const double error =
+          std::fabs(fast_exp(x) / std::exp(static_cast<double>(x)) - 1.0);
+      if (error > worst) worst = error;
+    }
+    printf("    fast_exp worst relative error: %.3g\n", worst);
+    assert(worst < 3e-7);
+    assert(std::fabs(fast_exp(0.0f) - 1.0f) < 2e-7f);
+  }
+
+  // 2) Saturation vapour pressure, -40...85 °C in 0.001 °C steps.
+  {
+    double worst_vs_float = 0.0;
+    double worst_vs_exact = 0.0;
+    double reference_worst_vs_exact = 0.0;
+    for (int i = 0; i <= SWEEP_STEPS; i++) {
+      const float t = sweep_temperature(i);
+      const float fast = saturation_vapour_pressure_hpa(t);
+      const double exact = exact_svp(t);
+      const double vs_float = std::fabs(fast / reference_svp(t) - 1.0);
+      const double vs_exact = std::fabs(fast / exact - 1.0);
+      const double ref_vs_exact = std::fabs(reference_svp(t) / exact - 1.0);
+      if (vs_float > worst_vs_float) worst_vs_float = vs_float;
+      if (vs_exact > worst_vs_exact) worst_vs_exact = vs_exact;
+      if (ref_vs_exact > reference_worst_vs_exact)
+        reference_worst_vs_exact = ref_vs_exact;
+    }
+    printf("    svp worst relative error: vs std::exp kernel %.3g, vs double "
+           "%.3g (std::exp kernel vs double %.3g)\n",
+           worst_vs_float, worst_vs_exact, reference_worst_vs_exact);
+    assert(worst_vs_float < 5e-7);
+    // Against exact arithmetic both kernels are bounded by the float
+    // evaluation of the Magnus argument; the fast kernel adds < 5e-7.
+    assert(worst_vs_exact < reference_worst_vs_exact + 5e-7);
+    // The pole and non-finite inputs are still rejected.
+    assert(std::isnan(saturation_vapour_pressure_hpa(-243.12f)));
+    assert(std::isnan(saturation_vapour_pressure_hpa(NAN)));
+  }
+
+  // 3) Compensated humidity on the shipped profile: below 1e-4 %RH.
+  {
+    const ClimateProfile &profile = S360_200_R4_CLIMATE_PROFILE_V1();
+    double worst = 0.0;
+    for (int i = 0; i <= SWEEP_STEPS; i += 10) {
+      const float raw_t = sweep_temperature(i);
+      for (int rh = 0; rh <= 100; rh += 5) {
+        const ClimateResult fast =
+            compensate_climate(profile, raw_t, static_cast<float>(rh), 0.0f, 0.0f);
+        if (!fast.valid) continue;
+        const double error = std::fabs(
+            fast.humidity_pct - reference_humidity(profile, raw_t, rh));
+        if (error > worst) worst = error;
+      }
+    }
+    printf("    compensated humidity worst error: %.3g %%RH "
+           "(SHT45 resolution 0.01 %%RH)\n",
+           worst);
+    assert(worst < 1e-4);
+  }
+
+  // Informational: exp() cost on this host (the win is on targets without
+  // a hardware exp, where libm's expf is a long software routine).
+  {
+    static float arguments[SWEEP_STEPS + 1];
+    for (int i = 0; i <= SWEEP_STEPS; i++) {
+      const float t = sweep_temperature(i);
+      arguments[i] = (17.62f * t) / (243.12f + t);
+    }
+    float sum_std = 0.0f;
+    float sum_fast = 0.0f;
+    const auto a = std::chrono::steady_clock::now();
+    for (int i = 0; i <= SWEEP_STEPS; i++) sum_std += std::exp(arguments[i]);
+    const auto b = std::chrono::steady_clock::now();
+    for (int i = 0; i <= SWEEP_STEPS; i++) sum_fast += fast_exp(arguments[i]);
+    const auto c = std::chrono::steady_clock::now();
+    printf("    host ns/call: std::exp %.2f fast_exp %.2f (sums %.6g / %.6g)\n",
+           std::chrono::duration<double, std::nano>(b - a).count() / SWEEP_STEPS,
+           std::chrono::duration<double, std::nano>(c - b).count() / SWEEP_STEPS,
+           sum_std, sum_fast);
+  }
+
+  printf("1/1 tests passed\n");
+  return 0;
+}
@@ -0,0 +1,245 @@
+// ROOMIQ-FRAMEWORK-001 — warm-boot carry-over
+// (RoomIQSnapshot / RoomIQEngine::capture_snapshot() / restore_snapshot() in
+// components/sense360/roomiq_engine.h; kept in RTC memory by the
+// sense360_roomiq glue across OTA and watchdog resets).
+//
+// Proves, on the pure engine:
+//
+//   * a snapshot round trip resumes the exact outputs — compensated values
+//     bit for bit, Comfort, Brightness and darkness — with no Initialising
+//     gap, where a cold engine sits in Initialising for a full SHT45 cycle;
+//   * hysteresis memory survives (a reading inside a band's hysteresis keeps
+//     the pre-reset category instead of re-deciding from scratch);
+//   * restored data ages on from its snapshot age plus the reset allowance
+//     and expires exactly when live data would; data already too old for
+//     its stale window is not restored;
+//   * corrupted, foreign-version and empty snapshots restore nothing, and a
+//     post-reset sample never pairs with a pre-reset half.
+//
+// Built with the neutral profile compiled in so the scenario temperatures
+// are the comfort-model temperatures.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#define SENSE360_CLIMATE_PROFILE CLIMATE_PROFILE_NEUTRAL
+#include "../../components/sense360/roomiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+
+using namespace sense360::roomiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t ALLOWANCE_MS = 5000;
+
+static bool same_float(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// A device that has been running: SHT45 every 30 s, lux every 10 s, the
+// 5 s evaluate tick; last samples at 599 000 / 595 000 ms (lux / climate).
+static void run_device(RoomIQEngine &engine, float celsius, float percent, float lux) {
+  engine.begin(0);
+  for (uint32_t now = 0; now < 600000; now += 1000) {
+    if (now % 30000 == 25000) {
+      engine.input_temperature(now, celsius);
+      engine.input_humidity(now, percent);
+    }
+    if (now % 10000 == 9000) engine.input_lux(now, lux);
+    if (now % 5000 == 0) engine.evaluate(now);
+  }
+  engine.evaluate(600000);
+}
+
+TEST_CASE(round_trip_resumes_every_output_without_initialising) {
+  RoomIQEngine before;
+  run_device(before, 22.0f, 48.0f, 3.0f);
+  ASSERT_EQ(before.comfort(), COMFORT_COMFORTABLE);
+  ASSERT_EQ(before.darkness(), DARKNESS_DARK);
+  const RoomIQSnapshot snapshot = before.capture_snapshot(600000);
+  ASSERT_TRUE(roomiq_snapshot_valid(snapshot));
+
+  // Cold boot for comparison: Initialising until the first SHT45 cycle.
+  RoomIQEngine cold;
+  cold.begin(0);
+  cold.evaluate(0);
+  ASSERT_EQ(cold.comfort(), COMFORT_INITIALISING);
+  ASSERT_EQ(cold.brightness(), BRIGHTNESS_INITIALISING);
+  ASSERT_EQ(cold.evaluate_darkness(0), DARKNESS_UNKNOWN);
+
+  RoomIQEngine after;
+  after.begin(0);
+  ASSERT_EQ(after.restore_snapshot(0, snapshot, ALLOWANCE_MS), 3);
+  ASSERT_EQ(after.evaluate_darkness(0), DARKNESS_DARK);  // the LED loop's view
+  after.evaluate(0);
+  ASSERT_EQ(after.comfort(), before.comfort());
+  ASSERT_EQ(after.brightness(), before.brightness());
+  ASSERT_EQ(after.environment(), before.environment());
+  ASSERT_EQ(after.health(), HEALTH_AVAILABLE);
+  ASSERT_TRUE(same_float(after.temperature(), before.temperature()));
+  ASSERT_TRUE(same_float(after.humidity(), before.humidity()));
+  ASSERT_TRUE(same_float(after.illuminance(), before.illuminance()));
+}
+
+TEST_CASE(hysteresis_memory_survives_the_reset) {
+  // Comfortable at 23.9 C; 24.1 C is inside the 0.3 C hysteresis above the
+  // 24 C warm boundary, so a running engine stays Comfortable.
+  RoomIQEngine before;
+  run_device(before, 23.9f, 48.0f, 300.0f);
+  before.input_temperature(600000, 24.1f);
+  before.input_humidity(600000, 48.0f);
+  before.evaluate(600000);
+  ASSERT_EQ(before.comfort(), COMFORT_COMFORTABLE);
+
+  RoomIQEngine after;
+  after.begin(0);
+  after.restore_snapshot(0, before.capture_snapshot(600000), ALLOWANCE_MS);
+  after.evaluate(0);
+  ASSERT_EQ(after.comfort(), COMFORT_COMFORTABLE);
+
+  // Without the band memory the same reading re-decides as Warm.
+  RoomIQEngine fresh;
+  fresh.begin(0);
+  fresh.input_temperature(0, 24.1f);
+  fresh.input_humidity(0, 48.0f);
+  fresh.evaluate(0);
+  ASSERT_EQ(fresh.comfort(), COMFORT_WARM);
+}
+
+TEST_CASE(restored_data_ages_on_and_expires_like_live_data) {
+  RoomIQEngine before;
+  run_device(before, 22.0f, 48.0f, 300.0f);
+  // Climate last sampled at 595 000, lux at 599 000.
+  const RoomIQSnapshot at_650s = before.capture_snapshot(650000);  // 55 s / 51 s
+  RoomIQEngine after;
+  after.begin(0);
+  ASSERT_EQ(after.restore_snapshot(0, at_650s, ALLOWANCE_MS), 3);
+  // Lux: 51 s + 5 s allowance = 56 s; stale after 60 s.
+  after.evaluate(4000);
+  ASSERT_TRUE(after.illuminance_fresh());
+  after.evaluate(4001);
+  ASSERT_FALSE(after.illuminance_fresh());
+  // Climate: 55 s + 5 s = 60 s; stale after 90 s.
+  after.evaluate(30000);
+  ASSERT_TRUE(after.temperature_fresh() && after.humidity_fresh());
+  after.evaluate(30001);
+  ASSERT_FALSE(after.temperature_fresh() || after.humidity_fresh());
+
+  // Lux 56 s old at capture: with the allowance it is past 60 s — only the
+  // climate channels come back.
+  RoomIQEngine late;
+  late.begin(0);
+  ASSERT_EQ(late.restore_snapshot(0, before.capture_snapshot(655000), ALLOWANCE_MS), 2);
+  late.evaluate(0);
+  ASSERT_FALSE(late.illuminance_fresh());
+  ASSERT_EQ(late.darkness(), DARKNESS_UNKNOWN);
+  ASSERT_EQ(late.comfort(), COMFORT_COMFORTABLE);
+  // And nothing at all once climate is past its window too.
+  RoomIQEngine stale;
+  stale.begin(0);
+  ASSERT_EQ(stale.restore_snapshot(0, before.capture_snapshot(681000), ALLOWANCE_MS), 0);
+}
+
+TEST_CASE(invalid_snapshots_restore_nothing) {
+  RoomIQEngine before;
+  run_device(before, 22.0f, 48.0f, 300.0f);
+  const RoomIQSnapshot good = before.capture_snapshot(600000);
+
+  RoomIQSnapshot garbage;
+  std::memset(&garbage, 0xA5, sizeof(garbage));  // power-on RTC contents
+  RoomIQSnapshot corrupt = good;
+  corrupt.pair_temperature_c += 1.0f;
+  RoomIQSnapshot foreign = good;
+  foreign.version = ROOMIQ_SNAPSHOT_VERSION + 1;
+  foreign.checksum = roomiq_snapshot_checksum(foreign);
+  for (const RoomIQSnapshot *bad : {&garbage, &corrupt, &foreign}) {
+    RoomIQEngine after;
+    after.begin(0);
+    ASSERT_FALSE(roomiq_snapshot_valid(*bad));
+    ASSERT_EQ(after.restore_snapshot(0, *bad, ALLOWANCE_MS), 0);
+    after.evaluate(0);
+    ASSERT_EQ(after.comfort(), COMFORT_INITIALISING);
+  }
+
+  // A snapshot taken before any sample marks every channel as never seen.
+  RoomIQEngine empty;
+  empty.begin(0);
+  const RoomIQSnapshot none = empty.capture_snapshot(1000);
+  ASSERT_TRUE(roomiq_snapshot_valid(none));
+  ASSERT_EQ(none.temperature_age_ms, ROOMIQ_SNAPSHOT_NEVER);
+  RoomIQEngine after;
+  after.begin(0);
+  ASSERT_EQ(after.restore_snapshot(0, none, ALLOWANCE_MS), 0);
+}
+
+TEST_CASE(post_reset_sample_never_pairs_with_a_pre_reset_half) {
+  RoomIQEngine before;
+  run_device(before, 22.0f, 48.0f, 300.0f);
+  before.input_temperature(600000, 22.0f);
+  before.input_humidity(600000, 48.0f);
+  // Capture 1 s after that pair, allowance 0: the restored temperature sits
+  // 1 s in the past, well inside the 5 s pair skew of the sample below.
+  RoomIQEngine after;
+  after.begin(0);
+  ASSERT_EQ(after.restore_snapshot(0, before.capture_snapshot(601000), 0), 3);
+  after.evaluate(0);
+  ASSERT_TRUE(same_float(after.raw_temperature(), 22.0f));
+  const float restored = after.humidity();
+  // A lone humidity sample: retained, never paired with the restored
+  // temperature, so the humidity value holds.
+  after.input_humidity(500, 80.0f);
+  after.evaluate(500);
+  ASSERT_TRUE(same_float(after.humidity(), restored));
+  // Its real partner pairs normally.
+  after.input_temperature(600, 22.0f);
+  after.evaluate(600);
+  ASSERT_FALSE(same_float(after.humidity(), restored));
+}
+
+int main() {
+  printf("\nROOMIQ-FRAMEWORK-001 warm-boot carry-over tests\n");
+  printf("================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_round_trip_resumes_every_output_without_initialising,
+           "round_trip_resumes_every_output_without_initialising");
+  run_test(test_hysteresis_memory_survives_the_reset,
+           "hysteresis_memory_survives_the_reset");
+  run_test(test_restored_data_ages_on_and_expires_like_live_data,
+           "restored_data_ages_on_and_expires_like_live_data");
+  run_test(test_invalid_snapshots_restore_nothing, "invalid_snapshots_restore_nothing");
+  run_test(test_post_reset_sample_never_pairs_with_a_pre_reset_half,
+           "post_reset_sample_never_pairs_with_a_pre_reset_half");
+  printf("\n================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All RoomIQ warm-boot carry-over tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
@@ -187,6 +187,22 @@ TEST_CASE(minutes_until_target_is_now) {
   ASSERT_EQ(minutes_until(current, target), 0);
 }
 
+TEST_CASE(passed_daily_reset_across_midnight) {
+  Time midnight(0, 0);
+  ASSERT_TRUE(passed_daily_reset(Time(23, 59), Time(0, 0), midnight));
+  ASSERT_TRUE(passed_daily_reset(Time(23, 58), Time(0, 1), midnight));
+  ASSERT_FALSE(passed_daily_reset(Time(0, 0), Time(0, 1), midnight));  // already taken
+  ASSERT_FALSE(passed_daily_reset(Time(10, 0), Time(10, 0), midnight));
+}
+
+TEST_CASE(passed_daily_reset_same_day_point) {
+  Time reset(6, 30);
+  ASSERT_TRUE(passed_daily_reset(Time(6, 29), Time(6, 30), reset));
+  ASSERT_FALSE(passed_daily_reset(Time(6, 30), Time(6, 31), reset));
+  ASSERT_FALSE(passed_daily_reset(Time(5, 0), Time(6, 0), reset));
+  ASSERT_TRUE(passed_daily_reset(Time(22, 0), Time(7, 0), reset));  // overnight gap
+}
+
 TEST_CASE(is_valid_time_valid) {
   ASSERT_TRUE(is_valid_time(0, 0));
   ASSERT_TRUE(is_valid_time(12, 30));
@@ -358,6 +374,10 @@ int main() {
   run_test(test_minutes_until_next_day, "minutes_until_next_day");
   run_test(test_minutes_until_target_is_now, "minutes_until_target_is_now");
 
+  // Daily reset tests
+  run_test(test_passed_daily_reset_across_midnight, "passed_daily_reset_across_midnight");
+  run_test(test_passed_daily_reset_same_day_point, "passed_daily_reset_same_day_point");
+
   // Validation tests
   run_test(test_is_valid_time_valid, "is_valid_time_valid");
   run_test(test_is_valid_time_invalid_hour, "is_valid_time_invalid_hour");
@@ -0,0 +1,393 @@
+// VENTIQ-FRAMEWORK-001 — shower-onset burst sampling
+// (VentIQEngine::humidity_sample_interval_ms() in
+// components/sense360/ventiq_engine.h).
+//
+// The policy the sense360_ventiq glue applies to the SHT45 poller:
+//
+//   * a pre-trigger (rate of rise >= 2.5 %/min, or humidity within 10 %RH
+//     of the shower threshold) starts a 5 s burst; without a shower claim
+//     it ends after its bound and re-arms only once the pre-trigger has
+//     cleared, so a humid bathroom never polls fast indefinitely;
+//   * a claimed burst runs through the shower and its clearing window and
+//     drops back to the normal cadence when clearing ends;
+//   * humidity that is not fresh, paused detection and a manual shower
+//     reset all fall back to normal;
+//   * the duty-cycle diagnostic is the share of time spent in burst;
+//   * at the burst cadence the rate fit still covers its whole 2-minute
+//     window (25 samples), and no burst interval is shorter than the 5 s
+//     cadence the window is sized for;
+//   * a shower simulation — the poller re-timed as the glue does it, the
+//     10 s VentIQ tick, swept over every onset phase of the 30 s cadence —
+//     claims the shower sooner with bursts than at the fixed cadence.
+//
+// The simulation feeds every SHT45 sample straight to the engine (the
+// RoomIQ publish band passes a rising shower's samples; its heartbeat
+// covers a steady reading).
+//
+// LOGIC/SIMULATION PROOF ONLY — never hardware validation.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/ventiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+
+using namespace sense360::ventiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NEAR(a, b, eps) assert(std::fabs((a) - (b)) <= (eps))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t BURST_MS = 5000;
+static const uint32_t NORMAL_MS = 30000;
+static const uint32_t T0 = 1000;
+static const uint32_t MIN = 60000;
+
+// Truth: 50 %RH, a shower from onset (first-order approach to 95 %RH,
+// 3 min time constant) for shower_min, then decay back to 50 %RH
+// (8 min time constant).
+struct Bathroom {
+  uint32_t onset_ms;
+  float shower_min;
+
+  float at(uint32_t t_ms) const {
+    if (t_ms < onset_ms) return 50.0f;
+    const float minutes = (t_ms - onset_ms) / 60000.0f;
+    if (minutes <= shower_min) return 95.0f - 45.0f * std::exp(-minutes / 3.0f);
+    const float peak = 95.0f - 45.0f * std::exp(-shower_min / 3.0f);
+    return 50.0f + (peak - 50.0f) * std::exp(-(minutes - shower_min) / 8.0f);
+  }
+};
+
+// The device: the SHT45 poller at the interval the engine asks for (the
+// glue re-times it after an evaluate, restarting the interval then), the
+// 10 s VentIQ tick, and an evaluate after every sample.
+struct Rig {
+  VentIQEngine engine;
+  bool adaptive;
+  uint32_t now = T0;
+  uint32_t next_poll;
+  uint32_t next_tick;
+  uint32_t applied_ms = NORMAL_MS;
+  long polls = 0;
+
+  Rig(bool adaptive_sampling, uint32_t first_poll)
+      : adaptive(adaptive_sampling), next_poll(first_poll), next_tick(T0 + 10000) {
+    engine.set_humidity_sample_intervals(BURST_MS, NORMAL_MS);
+    engine.begin(T0);
+  }
+
+  void evaluate() {
+    engine.evaluate(now);
+    if (!adaptive) return;
+    const uint32_t interval = engine.humidity_sample_interval_ms();
+    if (interval == applied_ms) return;
+    applied_ms = interval;
+    next_poll = now + interval;
+  }
+
+  // Runs to end_ms; returns the first time the shower is claimed (0: not).
+  uint32_t run_until(uint32_t end_ms, const Bathroom &room) {
+    uint32_t claimed = 0;
+    for (; now <= end_ms; now += 1000) {
+      if (now >= next_poll) {
+        polls++;
+        engine.input_humidity(now, std::round(room.at(now) * 100.0f) / 100.0f);
+        next_poll = now + applied_ms;
+        evaluate();
+      }
+      if (now >= next_tick) {
+        next_tick += 10000;
+        evaluate();
+      }
+      if (claimed == 0 && engine.shower_active()) claimed = now;
+    }
+    return claimed;
+  }
+};
+
+static VentIQEngine fresh_engine(float pct) {
+  VentIQEngine e;
+  e.set_humidity_sample_intervals(BURST_MS, NORMAL_MS);
+  e.begin(T0);
+  e.input_humidity(T0 + 30000, pct);
+  e.input_humidity(T0 + 60000, pct);
+  e.evaluate(T0 + 60000);
+  return e;
+}
+
+TEST_CASE(idle_bathroom_samples_at_the_normal_cadence) {
+  VentIQEngine e = fresh_engine(50.0f);
+  ASSERT_FALSE(e.humidity_burst_active());
+  ASSERT_EQ(e.humidity_sample_interval_ms(), NORMAL_MS);
+  // Zero intervals are ignored.
+  e.set_humidity_sample_intervals(0, 0);
+  ASSERT_EQ(e.humidity_sample_interval_ms(), NORMAL_MS);
+  // Defaults before any configuration: 5 s burst, 30 s normal.
+  VentIQEngine defaults;
+  ASSERT_EQ(defaults.humidity_sample_interval_ms(), NORMAL_MS);
+}
+
+TEST_CASE(pre_trigger_by_rate_or_by_level) {
+  // A 2.8 %/min rise — below the 5 %/min shower rate — starts a burst.
+  VentIQEngine rising = fresh_engine(50.0f);
+  rising.input_humidity(T0 + 90000, 52.0f);
+  rising.input_humidity(T0 + 120000, 54.0f);
+  rising.evaluate(T0 + 120000);
+  ASSERT_TRUE(rising.humidity_rate() >= 2.5f);
+  ASSERT_FALSE(rising.shower_active());
+  ASSERT_TRUE(rising.humidity_burst_active());
+  ASSERT_EQ(rising.humidity_sample_interval_ms(), BURST_MS);
+
+  // Within 10 %RH of the 75 %RH threshold, with no rise, starts one too.
+  VentIQEngine level = fresh_engine(65.0f);
+  ASSERT_TRUE(level.humidity_burst_active());
+  VentIQEngine below = fresh_engine(64.9f);
+  ASSERT_FALSE(below.humidity_burst_active());
+  // The margin and the rate are configurable.
+  below.set_burst_pre_margin_pct(15.0f);
+  below.evaluate(T0 + 61000);
+  ASSERT_TRUE(below.humidity_burst_active());
+  rising = fresh_engine(50.0f);
+  rising.set_burst_pre_rate(4.0f);
+  rising.input_humidity(T0 + 90000, 52.0f);
+  rising.input_humidity(T0 + 120000, 54.0f);
+  rising.evaluate(T0 + 120000);
+  ASSERT_FALSE(rising.humidity_burst_active());
+}
+
+TEST_CASE(unclaimed_burst_is_bounded_and_rearms_after_clearing) {
+  // A bathroom resting at 70 %RH: never a shower, never a fast poller for
+  // more than the 5 min bound.
+  VentIQEngine e = fresh_engine(70.0f);
+  const uint32_t start = T0 + 60000;
+  ASSERT_TRUE(e.humidity_burst_active());
+  uint32_t t = start;
+  for (; t < start + 5 * MIN; t += 5000) {
+    e.input_humidity(t, 70.0f);
+    e.evaluate(t);
+    ASSERT_TRUE(e.humidity_burst_active());
+  }
+  for (; t < start + 60 * MIN; t += 30000) {
+    e.input_humidity(t, 70.0f);
+    e.evaluate(t);
+    ASSERT_FALSE(e.humidity_burst_active());
+    ASSERT_FALSE(e.shower_active());
+  }
+  // Dry out below the pre-trigger (re-arms), then back up: a new burst.
+  for (int i = 0; i < 10; i++, t += 30000) {
+    e.input_humidity(t, 60.0f);
+    e.evaluate(t);
+  }
+  ASSERT_FALSE(e.humidity_burst_active());
+  for (int i = 0; i < 10; i++, t += 30000) {
+    e.input_humidity(t, 66.0f);
+    e.evaluate(t);
+  }
+  ASSERT_TRUE(e.humidity_burst_active());
+}
+
+TEST_CASE(burst_spans_the_shower_and_clearing_then_drops_back) {
+  const Bathroom room = {T0 + 10 * MIN + 7000, 10.0f};
+  Rig rig(true, T0 + 30000);
+  ASSERT_TRUE(rig.run_until(room.onset_ms + 8 * MIN, room) != 0);
+  ASSERT_TRUE(rig.engine.shower_active());
+  ASSERT_EQ(rig.engine.humidity_sample_interval_ms(), BURST_MS);
+
+  // Through the end of the shower and the 15 min clearing window the
+  // sampling stays fast; the first evaluate after clearing ends drops back.
+  bool saw_clearing = false;
+  uint32_t clearing_end = 0;
+  while (rig.now < room.onset_ms + 120 * MIN) {
+    rig.run_until(rig.now + 1000 - 1, room);
+    const bool busy = rig.engine.shower_active() ||
+                      rig.engine.clearing_minutes_remaining() > 0.0f;
+    if (rig.engine.clearing_minutes_remaining() > 0.0f) saw_clearing = true;
+    if (busy) {
+      ASSERT_EQ(rig.engine.humidity_sample_interval_ms(), BURST_MS);
+    } else if (saw_clearing) {
+      clearing_end = rig.now;
+      break;
+    }
+  }
+  ASSERT_TRUE(clearing_end != 0);
+  ASSERT_FALSE(rig.engine.humidity_burst_active());
+  ASSERT_EQ(rig.applied_ms, NORMAL_MS);
+  // And it stays at the normal cadence as the bathroom dries.
+  rig.run_until(rig.now + 60 * MIN, room);
+  ASSERT_FALSE(rig.engine.humidity_burst_active());
+  ASSERT_FALSE(rig.engine.shower_active());
+}
+
+TEST_CASE(stale_paused_or_reset_falls_back_to_normal) {
+  // Humidity going stale ends a burst.
+  VentIQEngine stale = fresh_engine(70.0f);
+  ASSERT_TRUE(stale.humidity_burst_active());
+  stale.evaluate(T0 + 60000 + 91000);
+  ASSERT_FALSE(stale.humidity_burst_active());
+  ASSERT_EQ(stale.humidity_sample_interval_ms(), NORMAL_MS);
+
+  // Paused shower detection never bursts.
+  VentIQEngine paused = fresh_engine(50.0f);
+  paused.set_shower_detection_enabled(false);
+  paused.input_humidity(T0 + 90000, 80.0f);
+  paused.evaluate(T0 + 90000);
+  ASSERT_FALSE(paused.humidity_burst_active());
+
+  // A manual shower reset ends the burst and disarms it until humidity
+  // falls back below the pre-trigger.
+  VentIQEngine reset = fresh_engine(50.0f);
+  reset.input_humidity(T0 + 90000, 80.0f);
+  reset.evaluate(T0 + 90000);
+  ASSERT_TRUE(reset.shower_active());
+  ASSERT_TRUE(reset.humidity_burst_active());
+  reset.reset_shower(T0 + 95000);
+  ASSERT_FALSE(reset.humidity_burst_active());
+  reset.input_humidity(T0 + 120000, 80.0f);
+  reset.evaluate(T0 + 120000);
+  ASSERT_FALSE(reset.humidity_burst_active());
+}
+
+TEST_CASE(duty_cycle_is_the_share_of_time_in_burst) {
+  // An hour at 70 %RH: one bounded 5 min burst from the first evaluate,
+  // then the normal cadence.
+  VentIQEngine e = fresh_engine(70.0f);
+  ASSERT_TRUE(e.humidity_burst_active());
+  ASSERT_NEAR(e.humidity_burst_duty_pct(), 0.0f, 1e-6f);
+  uint32_t t = T0 + 65000;
+  for (; t <= T0 + 60 * MIN; t += 5000) {
+    e.input_humidity(t, 70.0f);
+    e.evaluate(t);
+  }
+  // Five minutes (1-6 min) of the hour since start-up, weighted by the
+  // one-day memory.
+  const double tau = 1440.0;
+  const double weighted_burst = std::exp(-54.0 / tau) - std::exp(-59.0 / tau);
+  const double weighted_all = 1.0 - std::exp(-60.0 / tau);
+  ASSERT_NEAR(e.humidity_burst_duty_pct(), 100.0 * weighted_burst / weighted_all, 0.05);
+  ASSERT_NEAR(e.humidity_burst_duty_pct(), 100.0f * 5.0f / 60.0f, 0.2f);
+  // A quiet week forgets it.
+  for (int day = 0; day < 7 * 144; day++, t += 600000) {
+    e.input_humidity(t, 50.0f);
+    e.evaluate(t);
+  }
+  ASSERT_TRUE(e.humidity_burst_duty_pct() < 0.01f);
+}
+
+TEST_CASE(burst_cadence_keeps_the_whole_rate_window) {
+  // A burst (humidity within the margin of the shower threshold) read
+  // every 5 s: the slope must be the least-squares fit of every sample of
+  // the last 2 min — a count-bounded ring would drop the oldest of them
+  // and change it.
+  static const int N = 40;
+  uint32_t t[N];
+  float v[N];
+  VentIQEngine e = fresh_engine(66.0f);
+  const uint32_t start = T0 + 60000;
+  for (int i = 0; i < N; i++) {
+    t[i] = start + (i + 1) * BURST_MS;
+    v[i] = 66.0f + 0.0005f * i * i;  // curved: every sample moves the fit
+    e.input_humidity(t[i], v[i]);
+    e.evaluate(t[i]);
+    ASSERT_TRUE(e.humidity_burst_active());
+  }
+  double st = 0, sv = 0, stt = 0, stv = 0;
+  int k = 0;
+  for (int i = N - 1; i >= 0 && t[N - 1] - t[i] <= 120000; i--, k++) {
+    const double x = (t[i] - t[0]) / 60000.0;
+    const double y = std::lround(v[i] * 1000.0f) / 1000.0;
+    st += x;
+    sv += y;
+    stt += x * x;
+    stv += x * y;
+  }
+  const double slope = (k * stv - st * sv) / (k * stt - st * st);
+  printf("    burst rate window: %d samples over %u s\n", k,
+         static_cast<unsigned>((t[N - 1] - t[N - k]) / 1000));
+  ASSERT_EQ(k, 25);
+  ASSERT_NEAR(e.humidity_rate(), slope, 1e-4 + 1e-5 * std::fabs(slope));
+
+  // A faster burst interval is raised to the window's 5 s sizing cadence.
+  e.set_humidity_sample_intervals(1000, NORMAL_MS);
+  ASSERT_EQ(e.humidity_sample_interval_ms(), BURST_MS);
+}
+
+TEST_CASE(bursts_claim_showers_sooner_than_the_fixed_cadence) {
+  // Every onset phase of the 30 s cadence, 1 s apart.
+  uint32_t worst_fixed = 0, worst_burst = 0;
+  double sum_fixed = 0, sum_burst = 0;
+  long polls_fixed = 0, polls_burst = 0;
+  for (uint32_t phase = 0; phase < NORMAL_MS; phase += 1000) {
+    const Bathroom room = {T0 + 10 * MIN + phase, 10.0f};
+    Rig fixed(false, T0 + 30000);
+    Rig burst(true, T0 + 30000);
+    const uint32_t lag_fixed = fixed.run_until(room.onset_ms + 10 * MIN, room) - room.onset_ms;
+    const uint32_t lag_burst = burst.run_until(room.onset_ms + 10 * MIN, room) - room.onset_ms;
+    ASSERT_TRUE(lag_burst <= lag_fixed);
+    worst_fixed = lag_fixed > worst_fixed ? lag_fixed : worst_fixed;
+    worst_burst = lag_burst > worst_burst ? lag_burst : worst_burst;
+    sum_fixed += lag_fixed;
+    sum_burst += lag_burst;
+    polls_fixed += fixed.polls;
+    polls_burst += burst.polls;
+  }
+  printf("    shower claimed after onset: fixed 30 s worst %.0f s mean %.1f s; "
+         "burst worst %.0f s mean %.1f s\n",
+         worst_fixed / 1000.0, sum_fixed / 30000.0, worst_burst / 1000.0,
+         sum_burst / 30000.0);
+  printf("    SHT45 reads over the 20 min runs: fixed %ld, burst %ld\n", polls_fixed / 30,
+         polls_burst / 30);
+  ASSERT_TRUE(worst_burst < worst_fixed);
+  ASSERT_TRUE(sum_burst < sum_fixed);
+}
+
+int main() {
+  printf("\nVENTIQ-FRAMEWORK-001 shower-onset burst sampling tests\n");
+  printf("======================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_idle_bathroom_samples_at_the_normal_cadence,
+           "idle_bathroom_samples_at_the_normal_cadence");
+  run_test(test_pre_trigger_by_rate_or_by_level, "pre_trigger_by_rate_or_by_level");
+  run_test(test_unclaimed_burst_is_bounded_and_rearms_after_clearing,
+           "unclaimed_burst_is_bounded_and_rearms_after_clearing");
+  run_test(test_burst_spans_the_shower_and_clearing_then_drops_back,
+           "burst_spans_the_shower_and_clearing_then_drops_back");
+  run_test(test_stale_paused_or_reset_falls_back_to_normal,
+           "stale_paused_or_reset_falls_back_to_normal");
+  run_test(test_duty_cycle_is_the_share_of_time_in_burst,
+           "duty_cycle_is_the_share_of_time_in_burst");
+  run_test(test_burst_cadence_keeps_the_whole_rate_window,
+           "burst_cadence_keeps_the_whole_rate_window");
+  run_test(test_bursts_claim_showers_sooner_than_the_fixed_cadence,
+           "bursts_claim_showers_sooner_than_the_fixed_cadence");
+  printf("\n======================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All VentIQ burst sampling tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
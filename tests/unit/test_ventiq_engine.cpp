@@ -626,12 +626,24 @@ TEST_CASE(dew_point_from_canonical_inputs) {
 TEST_CASE(humidity_rate_is_computed_from_timestamps) {
   uint32_t t = T0 + 300000;
   VentIQEngine e = calm_engine(t);
-  // Samples: 45 @ t-30 s, 45 @ t, 51 @ t+60 s. The rate uses the oldest
-  // retained sample inside the 3-minute window: +6 %RH over 90 s
-  // = 4 %/min (deliberately smoothed against cadence jitter).
+  // Samples: 45 @ t-30 s, 45 @ t, 51 @ t+60 s. The rate is the
+  // least-squares slope of every sample inside the 2-minute window, on
+  // their real timestamps: 300 / 4200 %RH per s = 30/7 %/min.
   e.input_humidity(t + 60000, 51.0f);
   e.evaluate(t + 60000);
-  ASSERT_NEAR(e.humidity_rate(), 4.0f, 0.2f);
+  ASSERT_NEAR(e.humidity_rate(), 30.0f / 7.0f, 0.001f);
+  // Below 20 s of span there is no rate; samples older than 2 min drop.
+  VentIQEngine fresh = started_engine();
+  fresh.input_humidity(T0 + 1000, 45.0f);
+  fresh.input_humidity(T0 + 11000, 47.0f);
+  fresh.evaluate(T0 + 11000);
+  ASSERT_NAN(fresh.humidity_rate());
+  fresh.input_humidity(T0 + 21000, 49.0f);
+  fresh.evaluate(T0 + 21000);
+  ASSERT_NEAR(fresh.humidity_rate(), 12.0f, 0.001f);
+  fresh.input_humidity(T0 + 132000, 49.0f);  // the 45 and 47 fall out
+  fresh.evaluate(T0 + 132000);
+  ASSERT_NEAR(fresh.humidity_rate(), 0.0f, 0.001f);
 }
 
 TEST_CASE(fan_percent_mapping_preserves_legacy_semantics) {
@@ -0,0 +1,345 @@
+// VENTIQ-FRAMEWORK-001 — humidity rate-of-rise as a windowed least-squares
+// slope (VentIQEngine::humidity_rate(), components/sense360/ventiq_engine.h).
+//
+// Replays shower ramps through the engine and through the two-point rate it
+// replaced (newest sample against the oldest in-window sample at least 20 s
+// old — reproduced verbatim below as the reference) and proves:
+//
+//   * the slope is the exact least-squares fit of the windowed samples,
+//     checked against a brute-force recomputation after every push, and
+//     the running sums do not drift over a week of samples;
+//   * the fit covers the whole 2-minute window at every cadence down to
+//     the 5 s burst interval — never a count-bounded part of it;
+//   * over the replayed ramps, time-to-detect (rate >= 5 %/min) is no later
+//     than the two-point method's, and never more than one sample later on
+//     any single ramp — the per-ramp times are printed;
+//   * calm air with sensor noise never reaches the rate trigger, and the
+//     rate it reports scatters less than the two-point rate did.
+//
+// No recorded bathroom traces are held in the repo, so the ramps are
+// synthetic: a first-order approach from 50 %RH towards 95 %RH (time
+// constants of 2, 3 and 5 min — a shower's typical range), sampled every
+// 10 s and every 30 s, with deterministic sensor noise and the SHT45's
+// 0.01 %RH output step.
+//
+// LOGIC/SIMULATION PROOF ONLY — never hardware validation.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+#include "../../components/sense360/ventiq_engine.h"
+
+using namespace sense360::ventiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NEAR(a, b, eps) assert(std::fabs((a) - (b)) <= (eps))
+#define ASSERT_NAN(a) assert(std::isnan(a))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t T0 = 1000;
+static const uint32_t WINDOW_MS = 120000;
+static const uint32_t LEGACY_WINDOW_MS = 180000;  // the two-point method's
+static const uint32_t MIN_SPAN_MS = 20000;
+static const int LEGACY_SLOTS = 12;  // the two-point method's ring
+static const int SLOTS = 25;         // the engine's: 2 min at 5 s, inclusive
+static const float TRIGGER = 5.0f;  // default shower rate threshold, %/min
+
+// ---------------------------------------------------------------------------
+// The two-point rate the engine used before (reference only).
+// ---------------------------------------------------------------------------
+
+struct TwoPointRate {
+  uint32_t t[LEGACY_SLOTS] = {};
+  float v[LEGACY_SLOTS] = {};
+  int head = 0;
+  int count = 0;
+
+  void push(uint32_t now_ms, float pct) {
+    t[head] = now_ms;
+    v[head] = pct;
+    head = (head + 1) % LEGACY_SLOTS;
+    if (count < LEGACY_SLOTS) count++;
+  }
+
+  float rate() const {
+    if (count < 2) return NAN;
+    const int newest = (head + LEGACY_SLOTS - 1) % LEGACY_SLOTS;
+    const uint32_t t_new = t[newest];
+    const float v_new = v[newest];
+    bool found = false;
+    uint32_t t_ref = 0;
+    float v_ref = 0.0f;
+    for (int i = 1; i < count; i++) {
+      const int idx = (newest + LEGACY_SLOTS - i) % LEGACY_SLOTS;
+      const uint32_t age = t_new - t[idx];
+      if (age > LEGACY_WINDOW_MS) break;
+      if (age >= MIN_SPAN_MS) {
+        t_ref = t[idx];
+        v_ref = v[idx];
+        found = true;
+      }
+    }
+    if (!found) return NAN;
+    const float span_min = (t_new - t_ref) / 60000.0f;
+    return (v_new - v_ref) / span_min;
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Synthetic sensor: deterministic noise, 0.01 %RH output step.
+// ---------------------------------------------------------------------------
+
+struct Sensor {
+  uint32_t lcg = 12345u;
+  float noise_pct;
+
+  explicit Sensor(float noise) : noise_pct(noise) {}
+
+  float read(float truth) {
+    lcg = lcg * 1664525u + 1013904223u;
+    const float u = static_cast<float>(lcg >> 8) / 16777216.0f;  // [0, 1)
+    return std::round((truth + (2.0f * u - 1.0f) * noise_pct) * 100.0f) / 100.0f;
+  }
+};
+
+// Truth: 50 %RH until onset, then a first-order approach to 95 %RH.
+static float shower_truth(uint32_t t_ms, uint32_t onset_ms, float tau_min) {
+  if (t_ms < onset_ms) return 50.0f;
+  const float minutes = (t_ms - onset_ms) / 60000.0f;
+  return 95.0f - 45.0f * std::exp(-minutes / tau_min);
+}
+
+// Brute-force least-squares slope (%/min) of the samples within the window
+// of the newest one, mirroring the engine's 20 s minimum span.
+static double brute_force_slope(const uint32_t *t, const float *v, int n) {
+  const uint32_t t_new = t[n - 1];
+  double st = 0, sv = 0, stt = 0, stv = 0;
+  int k = 0;
+  uint32_t t_old = t_new;
+  for (int i = n - 1; i >= 0 && i >= n - SLOTS && t_new - t[i] <= WINDOW_MS; i--) {
+    const double x = (t[i] - t[0]) / 60000.0;
+    const double y = std::lround(v[i] * 1000.0f) / 1000.0;
+    st += x;
+    sv += y;
+    stt += x * x;
+    stv += x * y;
+    t_old = t[i];
+    k++;
+  }
+  if (k < 2 || t_new - t_old < MIN_SPAN_MS) return NAN;
+  return (k * stv - st * sv) / (k * stt - st * st);
+}
+
+struct Detection {
+  int64_t least_squares_ms;  // -1: never
+  int64_t two_point_ms;
+};
+
+static Detection replay_ramp(float tau_min, uint32_t cadence_ms) {
+  VentIQEngine e;
+  e.begin(T0);
+  TwoPointRate legacy;
+  Sensor sensor(0.05f);
+  const uint32_t onset = T0 + 10 * 60000;
+  Detection d = {-1, -1};
+  for (uint32_t t = T0; t <= onset + 15 * 60000; t += cadence_ms) {
+    const float pct = sensor.read(shower_truth(t, onset, tau_min));
+    e.input_humidity(t, pct);
+    e.evaluate(t);
+    legacy.push(t, pct);
+    const float ls = e.humidity_rate();
+    const float tp = legacy.rate();
+    if (t < onset) {
+      // Calm lead-in: neither method may trigger.
+      ASSERT_FALSE(ls >= TRIGGER);
+      ASSERT_FALSE(tp >= TRIGGER);
+      continue;
+    }
+    if (d.least_squares_ms < 0 && ls >= TRIGGER) d.least_squares_ms = t - onset;
+    if (d.two_point_ms < 0 && tp >= TRIGGER) d.two_point_ms = t - onset;
+  }
+  return d;
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+TEST_CASE(slope_matches_brute_force_least_squares) {
+  static const int N = 400;
+  uint32_t t[N];
+  float v[N];
+  VentIQEngine e;
+  e.begin(T0);
+  Sensor sensor(0.2f);
+  uint32_t now = T0;
+  for (int i = 0; i < N; i++) {
+    // Irregular cadence — stretches of 1-5 s and of 7-41 s — so both
+    // expiry paths run: by age and by ring slot reuse.
+    now += (i / 60) % 2 ? 1000 + (sensor.lcg >> 20) % 4000
+                        : 7000 + (sensor.lcg >> 20) % 35000;
+    t[i] = now;
+    v[i] = sensor.read(shower_truth(now, T0 + 1800000, 4.0f));
+    e.input_humidity(now, v[i]);
+    e.evaluate(now);
+    const double expected = brute_force_slope(t, v, i + 1);
+    if (std::isnan(expected)) {
+      ASSERT_NAN(e.humidity_rate());
+    } else {
+      ASSERT_NEAR(e.humidity_rate(), expected, 1e-4 + 1e-5 * std::fabs(expected));
+    }
+  }
+}
+
+TEST_CASE(running_sums_do_not_drift) {
+  // A week at a 10 s cadence over a slow sine, then a clean linear ramp:
+  // the slope must be the exact ramp slope, however many samples came
+  // and went before it.
+  VentIQEngine e;
+  e.begin(T0);
+  uint32_t now = T0;
+  for (int i = 0; i < 7 * 24 * 360; i++, now += 10000) {
+    const float pct = 55.0f + 10.0f * std::sin(i * 0.001f);
+    e.input_humidity(now, std::round(pct * 100.0f) / 100.0f);
+  }
+  for (int i = 0; i < SLOTS; i++, now += 10000) {
+    e.input_humidity(now, 40.0f + 1.0f * i);  // +1 %RH per 10 s = 6 %/min
+  }
+  e.evaluate(now - 10000);
+  ASSERT_NEAR(e.humidity_rate(), 6.0f, 1e-5f);
+}
+
+TEST_CASE(window_holds_every_sample_at_the_burst_cadence) {
+  // A curved rise sampled every 5 s: any sample missing from the fit would
+  // change the slope, so it must match the uncapped brute force over the
+  // full window (25 samples).
+  static const int N = 200;
+  uint32_t t[N];
+  float v[N];
+  VentIQEngine e;
+  e.begin(T0);
+  for (int i = 0; i < N; i++) {
+    t[i] = T0 + i * 5000u;
+    v[i] = 50.0f + 0.0004f * i * i;
+    e.input_humidity(t[i], v[i]);
+  }
+  e.evaluate(t[N - 1]);
+  double st = 0, sv = 0, stt = 0, stv = 0;
+  int k = 0;
+  for (int i = N - 1; i >= 0 && t[N - 1] - t[i] <= WINDOW_MS; i--, k++) {
+    const double x = (t[i] - t[0]) / 60000.0;
+    const double y = std::lround(v[i] * 1000.0f) / 1000.0;
+    st += x;
+    sv += y;
+    stt += x * x;
+    stv += x * y;
+  }
+  ASSERT_EQ(k, SLOTS);
+  const double expected = (k * stv - st * sv) / (k * stt - st * st);
+  printf("    5 s cadence: %d samples in the fit, slope %.4f %%/min\n", k, expected);
+  ASSERT_NEAR(e.humidity_rate(), expected, 1e-4 + 1e-5 * std::fabs(expected));
+}
+
+TEST_CASE(detects_shower_ramps_no_later_than_two_point) {
+  // Per ramp the least-squares slope may trail by at most one sample (the
+  // two-point rate can cross early on a lucky noise pair); summed over
+  // all ramps it must be no later.
+  static const float TAUS[] = {2.0f, 3.0f, 5.0f};
+  static const uint32_t CADENCES[] = {10000, 30000};
+  int64_t total_ls = 0;
+  int64_t total_tp = 0;
+  printf("    ramp tau  cadence  least-squares  two-point\n");
+  for (float tau : TAUS) {
+    for (uint32_t cadence : CADENCES) {
+      const Detection d = replay_ramp(tau, cadence);
+      printf("    %5.0f min  %4u s   %7.0f s     %7.0f s\n", tau,
+             static_cast<unsigned>(cadence / 1000), d.least_squares_ms / 1000.0,
+             d.two_point_ms / 1000.0);
+      ASSERT_TRUE(d.least_squares_ms >= 0);
+      ASSERT_TRUE(d.two_point_ms >= 0);
+      ASSERT_TRUE(d.least_squares_ms <= d.two_point_ms + cadence);
+      total_ls += d.least_squares_ms;
+      total_tp += d.two_point_ms;
+    }
+  }
+  ASSERT_TRUE(total_ls <= total_tp);
+}
+
+TEST_CASE(calm_noisy_air_never_triggers) {
+  // Six hours of 50 %RH with +-0.3 %RH noise at the fastest cadence. The
+  // spread of the reported rate (RMS once the window is full) is printed
+  // for both methods; the least-squares one must be the tighter.
+  VentIQEngine e;
+  e.begin(T0);
+  TwoPointRate legacy;
+  Sensor sensor(0.3f);
+  float ls_max = 0.0f;
+  double ls_sq = 0.0;
+  double tp_sq = 0.0;
+  int n = 0;
+  for (uint32_t t = T0; t <= T0 + 6 * 3600000u; t += 10000) {
+    const float pct = sensor.read(50.0f);
+    e.input_humidity(t, pct);
+    e.evaluate(t);
+    legacy.push(t, pct);
+    ASSERT_FALSE(e.shower_active());
+    if (!std::isnan(e.humidity_rate())) ls_max = std::fmax(ls_max, e.humidity_rate());
+    if (t - T0 < WINDOW_MS) continue;
+    ls_sq += e.humidity_rate() * e.humidity_rate();
+    tp_sq += legacy.rate() * legacy.rate();
+    n++;
+  }
+  const double ls_rms = std::sqrt(ls_sq / n);
+  const double tp_rms = std::sqrt(tp_sq / n);
+  printf("    calm rate RMS: least-squares %.3f %%/min, two-point %.3f %%/min\n", ls_rms,
+         tp_rms);
+  ASSERT_TRUE(ls_max < TRIGGER);
+  ASSERT_TRUE(ls_rms < tp_rms);
+}
+
+int main() {
+  printf("\nVENTIQ-FRAMEWORK-001 humidity least-squares slope tests\n");
+  printf("=======================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_slope_matches_brute_force_least_squares,
+           "slope_matches_brute_force_least_squares");
+  run_test(test_running_sums_do_not_drift, "running_sums_do_not_drift");
+  run_test(test_window_holds_every_sample_at_the_burst_cadence,
+           "window_holds_every_sample_at_the_burst_cadence");
+  run_test(test_detects_shower_ramps_no_later_than_two_point,
+           "detects_shower_ramps_no_later_than_two_point");
+  run_test(test_calm_noisy_air_never_triggers, "calm_noisy_air_never_triggers");
+  printf("\n=======================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All VentIQ humidity slope tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
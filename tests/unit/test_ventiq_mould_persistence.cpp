@@ -0,0 +1,444 @@
+// VENTIQ-FRAMEWORK-001 — persistent mould-risk accumulator
+// (MouldSnapshot, mould_commit_due() / commit_mould() / restore_mould() in
+// components/sense360/ventiq_engine.h).
+//
+// The sense360_ventiq glue keeps the damp accumulator in a flash
+// preference. This harness replays the glue's policy against a simulated
+// preference that counts real flash writes (ESPHome only writes a record
+// whose bytes changed):
+//
+//   * a blank, foreign or corrupted record is never restored;
+//   * commits follow the write policy — risk-level change, the commit
+//     interval, a clean shutdown — never per evaluation, and a dry idle
+//     room never writes;
+//   * a restore is elapsed-time honest: downtime is never counted as damp
+//     time, the next fresh sample confirms or resets it, a dated record
+//     past the gap limit (or from the future) is discarded, and the live
+//     accumulator is never overwritten;
+//   * a restore waits for the clock through the NAN RoomIQ's humidity
+//     publishes on its first offer — only a real sample ends the wait;
+//   * a reboot mid-spell loses at most one commit interval of damp time,
+//     a clean one nothing;
+//   * flash writes per simulated month of a real bathroom (two showers a
+//     day, damp spells, weekly OTA, a power cut), against committing on
+//     every change.
+//
+// LOGIC/SIMULATION PROOF ONLY — never hardware validation.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/ventiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+using namespace sense360::ventiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t T0 = 1000;
+static const uint32_t SEC = 1000;
+static const uint32_t MIN = 60000;
+static const uint32_t HOUR = 60 * MIN;
+static const uint32_t EPOCH0 = 1790000000u;  // a valid wall clock (2026)
+static const uint32_t MAX_GAP_S = 6 * 3600;
+
+// The flash preference: one record; a save whose bytes are unchanged is
+// not a write (as ESPHome's preference backends behave).
+struct Flash {
+  MouldSnapshot record;
+  bool present = false;
+  long writes = 0;
+
+  void save(const MouldSnapshot &snapshot) {
+    if (present && std::memcmp(&record, &snapshot, sizeof(record)) == 0) return;
+    record = snapshot;
+    present = true;
+    writes++;
+  }
+};
+
+// The glue's persistence path around one engine lifetime: restore pending
+// until the clock is valid or a real humidity value arrives, a commit
+// whenever due after evaluate, and a commit at clean shutdown. The
+// humidity source's state starts as the NAN RoomIQ publishes on its first
+// offer (so it has a state from boot), and the clock may only become valid
+// some time after boot (SNTP).
+struct Device {
+  Flash *flash;
+  VentIQEngine engine;
+  bool restore_pending;
+  uint32_t boot_epoch_s;  // wall clock at boot, 0 = no clock
+  uint32_t boot_ms;
+  uint32_t clock_delay_ms;  // the clock reads 0 until this long after boot
+  float humidity_state = NAN;
+  bool restored = false;
+
+  Device(Flash *f, uint32_t now_ms, uint32_t epoch_s, uint32_t clock_delay = 0)
+      : flash(f), restore_pending(f->present), boot_epoch_s(epoch_s), boot_ms(now_ms),
+        clock_delay_ms(clock_delay) {
+    engine.begin(now_ms);
+  }
+
+  uint32_t epoch(uint32_t now_ms) const {
+    if (boot_epoch_s == 0 || now_ms - boot_ms < clock_delay_ms) return 0;
+    return boot_epoch_s + (now_ms - boot_ms) / 1000;
+  }
+
+  void tick(uint32_t now_ms, bool humidity_sample, float rh) {
+    if (humidity_sample) {
+      engine.input_humidity(now_ms, rh);
+      humidity_state = rh;
+    }
+    const bool clock_composed = boot_epoch_s != 0;
+    if (restore_pending &&
+        (!clock_composed || epoch(now_ms) != 0 || !std::isnan(humidity_state))) {
+      restore_pending = false;
+      restored = engine.restore_mould(now_ms, flash->record, epoch(now_ms), MAX_GAP_S);
+      if (!restored) flash->save(engine.commit_mould(now_ms, epoch(now_ms)));
+    }
+    engine.evaluate(now_ms);
+    if (engine.mould_commit_due(now_ms))
+      flash->save(engine.commit_mould(now_ms, epoch(now_ms)));
+  }
+
+  void safe_shutdown(uint32_t now_ms) {
+    if (!restore_pending && engine.mould_dirty())
+      flash->save(engine.commit_mould(now_ms, epoch(now_ms)));
+  }
+};
+
+// Runs a device for `duration` at the 10 s tick with a 30 s humidity
+// sample held at `rh`.
+static uint32_t run(Device &device, uint32_t from, uint32_t duration, float rh) {
+  uint32_t t = from;
+  for (; t < from + duration; t += 10 * SEC)
+    device.tick(t, (t - from) % (30 * SEC) == 0, rh);
+  return t;
+}
+
+TEST_CASE(blank_foreign_and_corrupt_records_are_never_restored) {
+  VentIQEngine source;
+  source.begin(T0);
+  for (uint32_t t = T0; t <= T0 + 40 * MIN; t += 30 * SEC) {
+    source.input_humidity(t, 80.0f);
+    source.evaluate(t);
+  }
+  const MouldSnapshot good = source.commit_mould(T0 + 40 * MIN, 0);
+  ASSERT_TRUE(mould_snapshot_valid(good));
+
+  MouldSnapshot blank;
+  std::memset(&blank, 0xFF, sizeof(blank));  // erased flash
+  MouldSnapshot other_version = good;
+  other_version.version = MOULD_SNAPSHOT_VERSION + 1;
+  other_version.checksum = mould_snapshot_checksum(other_version);
+  MouldSnapshot corrupt = good;
+  corrupt.wet_ms ^= 0x10;
+  const MouldSnapshot bad_records[] = {blank, other_version, corrupt};
+  for (const MouldSnapshot &bad : bad_records) {
+    VentIQEngine e;
+    e.begin(T0);
+    ASSERT_FALSE(e.restore_mould(T0, bad, 0, MAX_GAP_S));
+    e.evaluate(T0);
+    ASSERT_EQ(e.mould_risk(), 0);
+  }
+  VentIQEngine e;
+  e.begin(T0);
+  ASSERT_TRUE(e.restore_mould(T0, good, 0, MAX_GAP_S));
+  e.evaluate(T0);
+  ASSERT_EQ(e.mould_risk(), 2);  // 40 min of damp, 30 min duration
+}
+
+TEST_CASE(commits_follow_the_write_policy_never_each_evaluate) {
+  Flash flash;
+  Device device(&flash, T0, EPOCH0);
+  // A dry room for a day never writes.
+  uint32_t t = run(device, T0, 24 * HOUR, 50.0f);
+  ASSERT_EQ(flash.writes, 0);
+
+  // 3 h of damp: a commit per risk level (15 / 30 / 60 min), then hourly
+  // while it keeps accumulating; drying out commits the reset.
+  t = run(device, t, 3 * HOUR, 72.0f);
+  ASSERT_EQ(device.engine.mould_risk(), 3);
+  const long damp_writes = flash.writes;
+  printf("    3 h damp spell: %ld writes over %d evaluations\n", damp_writes,
+         (int)(3 * HOUR / (10 * SEC)));
+  ASSERT_EQ(damp_writes, 3 + 2);  // risk 1 / 2 / 3, then at 2 h and 3 h
+  t = run(device, t, 20 * MIN, 50.0f);
+  ASSERT_EQ(flash.writes, damp_writes + 1);
+  ASSERT_EQ(flash.record.wet_ms, 0u);
+
+  // Damp that dries before the first risk level writes nothing, however
+  // long after the last commit.
+  t = run(device, t, 2 * HOUR, 50.0f);
+  const long before = flash.writes;
+  t = run(device, t, 10 * MIN, 72.0f);
+  t = run(device, t, 20 * MIN, 50.0f);
+  ASSERT_EQ(flash.writes, before);
+  ASSERT_FALSE(device.engine.mould_dirty());
+
+  // A clean shutdown commits what is outstanding, once.
+  t = run(device, t, 20 * MIN, 72.0f);
+  ASSERT_TRUE(device.engine.mould_dirty());
+  const long pre_shutdown = flash.writes;
+  device.safe_shutdown(t);
+  device.safe_shutdown(t);
+  ASSERT_EQ(flash.writes, pre_shutdown + 1);
+  ASSERT_FALSE(device.engine.mould_dirty());
+}
+
+TEST_CASE(restore_is_elapsed_time_honest) {
+  // 40 min of damp committed (risk 2), then down for `gap`.
+  Flash damp;
+  {
+    Device device(&damp, T0, EPOCH0);
+    const uint32_t t = run(device, T0, 40 * MIN, 80.0f);
+    device.safe_shutdown(t);
+  }
+  const uint32_t saved_epoch = damp.record.saved_epoch_s;
+  const uint32_t saved_wet = damp.record.wet_ms;
+
+  // Back after 5 min: restored, the downtime NOT counted, frozen until
+  // humidity — then continued by damp...
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch + 300);
+    device.tick(T0, false, NAN);
+    ASSERT_TRUE(device.restored);
+    ASSERT_EQ(device.engine.mould_risk(), 2);
+    run(device, T0 + 10 * SEC, 2 * MIN, NAN);  // no humidity yet: frozen
+    ASSERT_EQ(flash.record.wet_ms, saved_wet);
+    ASSERT_FALSE(device.engine.mould_dirty());
+    run(device, T0 + 3 * MIN, 25 * MIN, 80.0f);
+    ASSERT_EQ(device.engine.mould_risk(), 3);
+  }
+  // ...or reset by a dry first sample.
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch + 300);
+    device.tick(T0, true, 50.0f);
+    ASSERT_EQ(device.engine.mould_risk(), 0);
+    ASSERT_EQ(flash.record.wet_ms, 0u);  // the reset is a risk change: committed
+  }
+  // A dated record past the gap limit, or from the future, is discarded
+  // and superseded; an undated one (no clock at either end) is kept.
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch + MAX_GAP_S + 1);
+    device.tick(T0, false, NAN);
+    ASSERT_FALSE(device.restored);
+    ASSERT_EQ(device.engine.mould_risk(), 0);
+    ASSERT_EQ(flash.record.wet_ms, 0u);
+  }
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch - 60);
+    device.tick(T0, false, NAN);
+    ASSERT_FALSE(device.restored);
+  }
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, 0);
+    device.tick(T0, false, NAN);
+    ASSERT_TRUE(device.restored);
+    ASSERT_EQ(device.engine.mould_risk(), 2);
+  }
+  // The live accumulator is never overwritten once fresh humidity moved it.
+  VentIQEngine e;
+  e.begin(T0);
+  e.input_humidity(T0, 50.0f);
+  e.evaluate(T0);
+  ASSERT_FALSE(e.restore_mould(T0 + 10 * SEC, damp.record, 0, MAX_GAP_S));
+}
+
+TEST_CASE(restore_waits_for_the_clock_through_a_nan_first_offer) {
+  Flash damp;
+  {
+    Device device(&damp, T0, EPOCH0);
+    const uint32_t t = run(device, T0, 40 * MIN, 80.0f);
+    device.safe_shutdown(t);
+  }
+  const uint32_t saved_epoch = damp.record.saved_epoch_s;
+
+  // Back after a day, SNTP valid 20 s after boot: RoomIQ's NAN first offer
+  // at boot does not end the wait, so the dated gap discards the record.
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch + 24 * 3600, 20 * SEC);
+    device.tick(T0, true, NAN);
+    device.tick(T0 + 10 * SEC, false, NAN);
+    ASSERT_TRUE(device.restore_pending);
+    device.tick(T0 + 20 * SEC, false, NAN);
+    ASSERT_FALSE(device.restore_pending);
+    ASSERT_FALSE(device.restored);
+    ASSERT_EQ(device.engine.mould_risk(), 0);
+    ASSERT_EQ(flash.record.wet_ms, 0u);
+  }
+  // A real sample before the clock ends the wait (the gap then unknown).
+  {
+    Flash flash = damp;
+    Device device(&flash, T0, saved_epoch + 24 * 3600, 60 * SEC);
+    device.tick(T0, true, NAN);
+    ASSERT_TRUE(device.restore_pending);
+    device.tick(T0 + 10 * SEC, true, 80.0f);
+    ASSERT_TRUE(device.restored);
+    ASSERT_EQ(device.engine.mould_risk(), 2);
+  }
+}
+
+TEST_CASE(a_reboot_mid_spell_loses_at_most_one_interval) {
+  // Reboot at every minute of a 3 h damp spell: an unclean reset loses at
+  // most one commit interval of damp time, a clean one none.
+  uint32_t worst_loss = 0;
+  for (uint32_t at = 1 * MIN; at < 3 * HOUR; at += MIN) {
+    for (int clean = 0; clean <= 1; clean++) {
+      Flash flash;
+      uint32_t wet_before;
+      {
+        Device device(&flash, T0, EPOCH0);
+        const uint32_t t = run(device, T0, at, 72.0f);
+        wet_before = device.engine.mould_wet_ms();
+        if (clean) device.safe_shutdown(t);
+      }
+      if (!flash.present) {
+        ASSERT_FALSE(clean);
+        ASSERT_TRUE(wet_before < 15 * MIN);  // below the first risk level
+        if (wet_before > worst_loss) worst_loss = wet_before;
+        continue;
+      }
+      Device device(&flash, T0, EPOCH0 + at / 1000 + 30);
+      device.tick(T0, false, NAN);
+      ASSERT_TRUE(device.restored);
+      const uint32_t loss = wet_before - flash.record.wet_ms;
+      if (clean) ASSERT_EQ(loss, 0u);
+      ASSERT_TRUE(loss <= HOUR);
+      if (!clean && loss > worst_loss) worst_loss = loss;
+    }
+  }
+  printf("    worst damp time lost to an unclean reboot: %.1f min (clean: 0)\n",
+         worst_loss / 60000.0);
+  ASSERT_TRUE(worst_loss <= HOUR);
+}
+
+// A month of bathroom: 55 %RH base; showers at 07:00 (10 min) and 19:30
+// (15 min) peaking near 90 %RH and decaying over ~12 min; three damp days
+// (68 %RH from 06:00 to midnight); a weekly OTA (clean reboot) and a 3 h
+// power cut on day 17 (unclean). The baselines replay the same month
+// without reboots: a write on every evaluation that changed the
+// accumulator, and a save per evaluation synced every 60 s (ESPHome's
+// default flash_write_interval).
+static float month_rh(uint32_t day, uint32_t minute_of_day) {
+  float rh = 55.0f;
+  if ((day == 4 || day == 12 || day == 23) && minute_of_day >= 360) rh = 68.0f;
+  const uint32_t showers[2][2] = {{7 * 60, 10}, {19 * 60 + 30, 15}};
+  for (const auto &shower : showers) {
+    if (minute_of_day < shower[0]) continue;
+    const float since = minute_of_day - shower[0];
+    const float after = since < shower[1] ? 0.0f : since - shower[1];
+    const float shower_rh = rh + (90.0f - rh) * std::exp(-after / 12.0f);
+    if (shower_rh > rh) rh = shower_rh;
+  }
+  return rh;
+}
+
+TEST_CASE(flash_writes_per_simulated_month) {
+  Flash flash;
+  Device *device = new Device(&flash, T0, EPOCH0);
+  long changed_evaluations = 0, changed_minutes = 0;
+  uint32_t last_wet = 0;
+  bool minute_changed = false;
+  uint32_t uptime_base = T0;
+  const uint32_t TICKS_PER_DAY = 24 * HOUR / (10 * SEC);
+  for (uint32_t day = 0; day < 30; day++) {
+    for (uint32_t tick = 0; tick < TICKS_PER_DAY; tick++) {
+      const uint32_t minute_of_day = tick / 6;
+      const uint32_t t = uptime_base + (day * TICKS_PER_DAY + tick) * 10 * SEC;
+      if (day == 17 && minute_of_day >= 600 && minute_of_day < 780) continue;  // power cut
+      if (day == 17 && minute_of_day == 780 && tick % 6 == 0) {
+        delete device;  // unclean: nothing committed at the cut
+        device = new Device(&flash, t, EPOCH0 + (t - T0) / 1000);
+      }
+      if (day % 7 == 6 && tick == 3 * 360) {  // weekly OTA at 03:00, clean
+        device->safe_shutdown(t);
+        delete device;
+        device = new Device(&flash, t, EPOCH0 + (t - T0) / 1000);
+      }
+      device->tick(t, tick % 3 == 0, month_rh(day, minute_of_day));
+    }
+  }
+  delete device;
+
+  // The per-evaluate baseline, replayed on a fresh engine without reboots.
+  VentIQEngine e;
+  e.begin(T0);
+  for (uint32_t day = 0; day < 30; day++) {
+    for (uint32_t tick = 0; tick < TICKS_PER_DAY; tick++) {
+      const uint32_t t = T0 + (day * TICKS_PER_DAY + tick) * 10 * SEC;
+      if (tick % 3 == 0) e.input_humidity(t, month_rh(day, tick / 6));
+      e.evaluate(t);
+      const uint32_t wet = e.mould_wet_ms();
+      if (wet != last_wet) {
+        changed_evaluations++;
+        minute_changed = true;
+      }
+      last_wet = wet;
+      if (tick % 6 == 5) {
+        if (minute_changed) changed_minutes++;
+        minute_changed = false;
+      }
+    }
+  }
+  printf("    flash writes per month: policy %ld (%.1f/day); per-evaluate %ld; "
+         "per-evaluate with 60 s sync %ld\n",
+         flash.writes, flash.writes / 30.0, changed_evaluations, changed_minutes);
+  ASSERT_TRUE(flash.writes > 0);
+  ASSERT_TRUE(flash.writes * 20 < changed_minutes);  // vs the 60 s sync
+  ASSERT_TRUE(flash.writes <= 12 * 30);  // bounded by the day's risk changes
+}
+
+int main() {
+  printf("\nVENTIQ-FRAMEWORK-001 mould accumulator persistence tests\n");
+  printf("=========================================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_blank_foreign_and_corrupt_records_are_never_restored,
+           "blank_foreign_and_corrupt_records_are_never_restored");
+  run_test(test_commits_follow_the_write_policy_never_each_evaluate,
+           "commits_follow_the_write_policy_never_each_evaluate");
+  run_test(test_restore_is_elapsed_time_honest, "restore_is_elapsed_time_honest");
+  run_test(test_restore_waits_for_the_clock_through_a_nan_first_offer,
+           "restore_waits_for_the_clock_through_a_nan_first_offer");
+  run_test(test_a_reboot_mid_spell_loses_at_most_one_interval,
+           "a_reboot_mid_spell_loses_at_most_one_interval");
+  run_test(test_flash_writes_per_simulated_month, "flash_writes_per_simulated_month");
+  printf("\n=========================================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All VentIQ mould persistence tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
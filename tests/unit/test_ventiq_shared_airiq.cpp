@@ -0,0 +1,269 @@
+// VENTIQ-FRAMEWORK-001 — VentIQ over a shared AirIQ engine
+// (BasicVentIQEngine<SharedPollutants<...>> in
+// components/sense360/ventiq_engine.h).
+//
+// On a composition that carries both the VentIQ and the AirIQ boards, the
+// sense360_ventiq shared_airiq_engine option binds VentIQ to
+// airiq::global_engine() instead of its embedded copy:
+//
+//   * bound to an AirIQ engine holding the same VOC/NOx configuration and
+//     fed the same samples, every VentIQ output — demand, reason, fan
+//     percent, odour, air quality, health, legacy strings — equals the
+//     embedded engine's, tick for tick, through showers, pollution
+//     episodes, sensor dropouts and manual actions;
+//   * the shared engine stays its owner's: VentIQ's pollutant setters and
+//     inputs never configure or feed it, and VentIQ never evaluates it;
+//   * its headline is the composition's — a channel only the owner expects
+//     (CO2) drives VentIQ's air-quality demand — and is documented so;
+//   * the RAM saved is the embedded engine less one pointer (printed).
+//
+// LOGIC/SIMULATION PROOF ONLY — never hardware validation.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include "../../components/sense360/ventiq_engine.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+using namespace sense360;
+using namespace sense360::ventiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+typedef BasicVentIQEngine<SharedPollutants<airiq::AirIQEngine> > SharedVentIQEngine;
+typedef BasicVentIQEngine<SharedPollutants<airiq::FirmwareAirIQEngine> >
+    FirmwareSharedVentIQEngine;
+
+static const uint32_t T0 = 1000;
+static const uint32_t SEC = 1000;
+static const uint32_t MIN = 60000;
+
+static bool same_value(float a, float b) {
+  return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+// Every output the glue publishes, compared between the two modes.
+template <class Shared>
+static void assert_same_outputs(const VentIQEngine &embedded, const Shared &shared,
+                                uint32_t now) {
+  ASSERT_EQ((int)embedded.demand(), (int)shared.demand());
+  ASSERT_EQ((int)embedded.reason(), (int)shared.reason());
+  ASSERT_EQ(embedded.fan_percent(), shared.fan_percent());
+  ASSERT_EQ(embedded.ventilation_effort_pct(), shared.ventilation_effort_pct());
+  ASSERT_EQ(embedded.ventilation_needed(), shared.ventilation_needed());
+  ASSERT_EQ(embedded.odour(), shared.odour());
+  ASSERT_EQ(embedded.air_quality(), shared.air_quality());
+  ASSERT_EQ(embedded.health(), shared.health());
+  ASSERT_EQ(embedded.voc_fresh(), shared.voc_fresh());
+  ASSERT_EQ(embedded.nox_fresh(), shared.nox_fresh());
+  ASSERT_TRUE(same_value(embedded.voc(), shared.voc()));
+  ASSERT_TRUE(same_value(embedded.nox(), shared.nox()));
+  ASSERT_TRUE(same_value(embedded.voc_data_age_s(now), shared.voc_data_age_s(now)));
+  ASSERT_EQ(embedded.shower_active(), shared.shower_active());
+  ASSERT_EQ(embedded.mould_risk(), shared.mould_risk());
+  ASSERT_EQ(std::strcmp(embedded.legacy_status(), shared.legacy_status()), 0);
+  ASSERT_EQ(std::strcmp(embedded.legacy_air_quality_status(),
+                        shared.legacy_air_quality_status()),
+            0);
+}
+
+// Six hours of bathroom at the production cadences (humidity every 30 s,
+// SGP41 every 10 s, the 10 s VentIQ tick): two showers, a long damp
+// spell, VOC climbing through every band, an NOx spike, a humidity and an
+// SGP41 dropout, a forced ventilation and a manual shower reset. The
+// shared engine is evaluated by its owner before VentIQ reads it, as the
+// AirIQ component's tick does. Returns the distinct reasons seen.
+template <class AirIQ>
+static int replay_day(AirIQ &air) {
+  VentIQEngine embedded;
+  BasicVentIQEngine<SharedPollutants<AirIQ> > shared(air);
+  air.apply_config(default_pollutant_config());
+  air.begin(T0);
+  embedded.begin(T0);
+  shared.begin(T0);
+
+  bool reasons_seen[16] = {};
+  for (uint32_t t = T0; t <= T0 + 360 * MIN; t += 10 * SEC) {
+    const uint32_t m = (t - T0) / MIN;
+    // Humidity: showers at 20 and 200 min, damp 80-140 min, a 10 min gap.
+    float rh = 50.0f;
+    if ((m >= 20 && m < 32) || (m >= 200 && m < 215)) rh = 92.0f;
+    else if (m >= 80 && m < 140) rh = 72.0f;
+    const bool humidity_gap = m >= 160 && m < 170;
+    if ((t - T0) % (30 * SEC) == 0 && !humidity_gap) {
+      embedded.input_humidity(t, rh);
+      shared.input_humidity(t, rh);
+    }
+    // SGP41: VOC climbing through Good -> Very Poor and back, an NOx
+    // spike, and a 5 min dropout of both.
+    float voc = 90.0f;
+    if (m >= 40 && m < 70) voc = 100.0f + 12.0f * (m - 40);
+    float nox = m >= 240 && m < 260 ? 320.0f : 1.0f;
+    const bool sgp_gap = m >= 290 && m < 295;
+    if (!sgp_gap) {
+      embedded.input_voc(t, voc);
+      embedded.input_nox(t, nox);
+      air.input_voc(t, voc);
+      air.input_nox(t, nox);
+    }
+    if (t == T0 + 300 * MIN) {
+      embedded.force_ventilation(t, 10.0f);
+      shared.force_ventilation(t, 10.0f);
+    }
+    if (t == T0 + 205 * MIN) {
+      embedded.reset_shower(t);
+      shared.reset_shower(t);
+    }
+    embedded.evaluate(t);
+    air.evaluate(t);
+    shared.evaluate(t);
+    assert_same_outputs(embedded, shared, t);
+    reasons_seen[embedded.reason()] = true;
+  }
+  int distinct = 0;
+  for (bool seen : reasons_seen) distinct += seen ? 1 : 0;
+  return distinct;
+}
+
+TEST_CASE(shared_engine_matches_the_embedded_one_tick_for_tick) {
+  airiq::AirIQEngine air;
+  const int reasons = replay_day(air);
+  printf("    6 h replay, 2161 ticks identical; %d distinct reasons exercised\n",
+         reasons);
+  ASSERT_TRUE(reasons >= 7);
+}
+
+TEST_CASE(firmware_global_engine_binds_the_same_way) {
+  // airiq::global_engine() is the firmware engine type: what
+  // SENSE360_VENTIQ_SHARED_AIRIQ binds in production.
+  ASSERT_TRUE(replay_day(airiq::global_engine()) >= 7);
+  ASSERT_TRUE(FirmwareSharedVentIQEngine::shares_pollutant_engine());
+  ASSERT_FALSE(VentIQEngine::shares_pollutant_engine());
+  ASSERT_FALSE(FirmwareVentIQEngine::shares_pollutant_engine());
+}
+
+TEST_CASE(shared_engine_is_left_to_its_owner) {
+  airiq::AirIQEngine air;
+  air.apply_config(default_pollutant_config());
+  air.begin(T0);
+  const uint32_t version = air.config_version();
+  SharedVentIQEngine shared(air);
+  shared.begin(T0);
+
+  // Configuration is the owner's: refused or ignored, never applied.
+  airiq::AirIQConfig other = default_pollutant_config();
+  other.version = version + 1;
+  ASSERT_FALSE(shared.apply_pollutant_config(other));
+  shared.set_voc_stale_ms(1000);
+  shared.set_pollutant_expected(airiq::POLLUTANT_CO2, true);
+  shared.set_fault(true);
+  ASSERT_EQ(air.config_version(), version);
+  ASSERT_FALSE(air.expected(airiq::POLLUTANT_CO2));
+
+  // So are the feeds and the evaluation.
+  shared.input_voc(T0 + 10 * SEC, 420.0f);
+  shared.evaluate(T0 + 10 * SEC);
+  air.evaluate(T0 + 10 * SEC);
+  ASSERT_FALSE(air.pollutant_fresh(airiq::POLLUTANT_VOC));
+  ASSERT_EQ(air.health(), airiq::HEALTH_INITIALISING);
+
+  // What the owner feeds is what VentIQ reads (after the owner's tick).
+  air.input_voc(T0 + 20 * SEC, 420.0f);
+  shared.evaluate(T0 + 20 * SEC);
+  ASSERT_FALSE(shared.voc_fresh());
+  air.evaluate(T0 + 20 * SEC);
+  shared.evaluate(T0 + 20 * SEC);
+  ASSERT_TRUE(shared.voc_fresh());
+  ASSERT_EQ(shared.voc(), 420.0f);
+  ASSERT_EQ(shared.air_quality(), airiq::AIR_QUALITY_VERY_POOR);
+  ASSERT_EQ(shared.reason(), REASON_AIR_QUALITY);
+}
+
+TEST_CASE(shared_headline_spans_the_owners_channels) {
+  // The AirIQ board's composition also expects CO2: a stuffy room with
+  // clean VOC/NOx is poor air for VentIQ too once the engine is shared —
+  // the platform's one air-quality answer.
+  airiq::AirIQEngine air;
+  air.begin(T0);
+  VentIQEngine embedded;
+  SharedVentIQEngine shared(air);
+  embedded.begin(T0);
+  shared.begin(T0);
+  for (uint32_t t = T0; t <= T0 + 5 * MIN; t += 10 * SEC) {
+    embedded.input_humidity(t, 50.0f);
+    shared.input_humidity(t, 50.0f);
+    embedded.input_voc(t, 90.0f);
+    embedded.input_nox(t, 1.0f);
+    air.input_voc(t, 90.0f);
+    air.input_nox(t, 1.0f);
+    air.input_co2(t, 1800.0f);
+    embedded.evaluate(t);
+    air.evaluate(t);
+    shared.evaluate(t);
+  }
+  ASSERT_EQ(embedded.reason(), REASON_NONE);
+  ASSERT_EQ(shared.air_quality(), air.air_quality());
+  ASSERT_TRUE(shared.air_quality() == airiq::AIR_QUALITY_POOR ||
+              shared.air_quality() == airiq::AIR_QUALITY_VERY_POOR);
+  ASSERT_EQ(shared.reason(), REASON_AIR_QUALITY);
+  ASSERT_FALSE(shared.odour());
+}
+
+TEST_CASE(sharing_saves_the_embedded_engine) {
+  const size_t embedded = sizeof(VentIQEngine);
+  const size_t shared = sizeof(FirmwareSharedVentIQEngine);
+  const size_t copy = sizeof(EmbeddedPollutants::Engine);
+  printf("    VentIQ engine: embedded %u B, shared %u B — %u B saved "
+         "(VOC/NOx AirIQ copy %u B, binding %u B)\n",
+         (unsigned)embedded, (unsigned)shared, (unsigned)(embedded - shared),
+         (unsigned)copy, (unsigned)sizeof(void *));
+  ASSERT_TRUE(shared < embedded);
+  // The copy, less the pointer that replaces it (alignment padding aside).
+  ASSERT_TRUE(embedded - shared + sizeof(void *) + alignof(VentIQEngine) > copy);
+}
+
+int main() {
+  printf("\nVENTIQ-FRAMEWORK-001 shared AirIQ engine tests\n");
+  printf("==============================================\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+  run_test(test_shared_engine_matches_the_embedded_one_tick_for_tick,
+           "shared_engine_matches_the_embedded_one_tick_for_tick");
+  run_test(test_firmware_global_engine_binds_the_same_way,
+           "firmware_global_engine_binds_the_same_way");
+  run_test(test_shared_engine_is_left_to_its_owner, "shared_engine_is_left_to_its_owner");
+  run_test(test_shared_headline_spans_the_owners_channels,
+           "shared_headline_spans_the_owners_channels");
+  run_test(test_sharing_saves_the_embedded_engine, "sharing_saves_the_embedded_engine");
+  printf("\n==============================================\n");
+  printf("Results: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All VentIQ shared AirIQ engine tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}
@@ -0,0 +1,320 @@
+// VENTIQ-FRAMEWORK-001 — continuous ventilation effort
+// (VentIQEngine::ventilation_effort_pct in components/sense360/ventiq_engine.h).
+//
+// The demand ladder's stepped fan percent (0/30/50/70/100) stays the legacy
+// compatibility view; variable-speed outputs follow the effort instead:
+//
+//   * the target scales with the driver behind the demand — humidity
+//     excess, clearing remaining, damp time, the AirIQ severity progress
+//     (no VOC/NOx threshold is re-declared here) — the humidity rate acts
+//     through the shower claim only;
+//   * the output follows the target within the slew limits, never sits
+//     between 0 and the running floor, holds the floor for the minimum
+//     on-time and jumps to 100 for a manual request;
+//   * in a closed-loop bathroom model the effort clears a shower faster,
+//     spends less fan energy (affinity law, speed^3) at partial demand and
+//     moves the fan in far smaller steps than the legacy mapping (printed).
+//
+// LOGIC/SIMULATION PROOF ONLY — never hardware validation. The room model
+// is a first-order moisture balance, not a measured bathroom.
+//
+// Compile via tests/Makefile (auto-discovered):  cd tests && make test
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+#include "../../components/sense360/ventiq_engine.h"
+
+using namespace sense360::ventiq;
+
+// Simple test framework (repo convention — see test_led_logic.cpp)
+#define TEST_CASE(name) void test_##name()
+#define ASSERT_TRUE(cond) assert(cond)
+#define ASSERT_FALSE(cond) assert(!(cond))
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_NEAR(a, b, eps) assert(std::fabs((a) - (b)) <= (eps))
+
+static int test_count = 0;
+static int passed_count = 0;
+
+void run_test(void (*test_func)(), const char *test_name) {
+  test_count++;
+  try {
+    test_func();
+    passed_count++;
+    printf("[PASS] %s\n", test_name);
+  } catch (const std::exception &e) {
+    printf("[FAIL] %s: %s\n", test_name, e.what());
+  } catch (...) {
+    printf("[FAIL] %s: unknown error\n", test_name);
+  }
+}
+
+static const uint32_t T0 = 1000;
+static const uint32_t SEC = 1000;
+static const uint32_t MIN = 60000;
+
+// One 10 s VentIQ tick with every channel fed.
+static void tick(VentIQEngine &e, uint32_t t, float rh, float voc) {
+  e.input_humidity(t, rh);
+  e.input_temperature(t, 22.0f);
+  e.input_voc(t, voc);
+  e.input_nox(t, 10.0f);
+  e.evaluate(t);
+}
+
+// Calm and fully fresh (humidity 45 %RH, VOC/NOx Good) at T0 + 5 min.
+static VentIQEngine calm_engine() {
+  VentIQEngine e;
+  e.begin(T0);
+  for (uint32_t t = T0; t <= T0 + 5 * MIN; t += 10 * SEC) tick(e, t, 45.0f, 80.0f);
+  return e;
+}
+
+static const uint32_t CALM = T0 + 5 * MIN;
+
+// ---------------------------------------------------------------------------
+// Driver-scaled target
+// ---------------------------------------------------------------------------
+
+TEST_CASE(calm_room_needs_no_effort) {
+  VentIQEngine e = calm_engine();
+  ASSERT_EQ(e.ventilation_effort_target_pct(), 0.0f);
+  ASSERT_EQ(e.ventilation_effort_pct(), 0.0f);
+}
+
+TEST_CASE(target_scales_with_each_driver) {
+  // High humidity: 20 at the threshold (60 %RH), 80 at the shower
+  // threshold (75 %RH) — 63 %RH is a fifth of the way.
+  VentIQEngine humid = calm_engine();
+  for (uint32_t t = CALM; t <= CALM + 25 * MIN; t += 10 * SEC) {
+    const float rh = std::fmin(63.0f, 45.0f + 1.0f * (t - CALM) / MIN);
+    tick(humid, t, rh, 80.0f);
+  }
+  ASSERT_EQ(humid.reason(), REASON_HUMIDITY);
+  ASSERT_NEAR(humid.ventilation_effort_target_pct(), 32.0f, 0.01f);
+
+  // Odour: 30 at Fair (150) to 100 at Very poor (400), from the AirIQ
+  // severity progress; a Poor headline holds at least 50.
+  VentIQEngine odour = calm_engine();
+  tick(odour, CALM + 10 * SEC, 45.0f, 200.0f);
+  ASSERT_TRUE(odour.odour());
+  ASSERT_NEAR(odour.ventilation_effort_target_pct(), 44.0f, 0.01f);
+  VentIQEngine poor = calm_engine();
+  tick(poor, CALM + 10 * SEC, 45.0f, 300.0f);
+  ASSERT_NEAR(poor.ventilation_effort_target_pct(), 72.0f, 0.01f);
+  VentIQEngine very_poor = calm_engine();
+  tick(very_poor, CALM + 10 * SEC, 45.0f, 420.0f);
+  ASSERT_EQ(very_poor.ventilation_effort_target_pct(), 100.0f);
+
+  // A rise that is not yet a shower waits for the claim: extracting ahead
+  // of it would flatten the rise the shower detector keys on.
+  VentIQEngine rising = calm_engine();
+  float rh = 45.0f;
+  for (uint32_t t = CALM; t <= CALM + 2 * MIN; t += 10 * SEC) {
+    tick(rising, t, rh, 80.0f);
+    rh += 0.5f;  // 3.0 %/min
+  }
+  ASSERT_FALSE(rising.shower_active());
+  ASSERT_NEAR(rising.humidity_rate(), 3.0f, 0.01f);
+  ASSERT_EQ(rising.ventilation_effort_target_pct(), 0.0f);
+  ASSERT_EQ(rising.fan_percent(), 0);
+
+  // Shower: 100; clearing: 100 falling to 30 as the window runs out.
+  VentIQEngine shower = calm_engine();
+  uint32_t t = CALM + 10 * SEC;
+  tick(shower, t, 85.0f, 80.0f);
+  ASSERT_TRUE(shower.shower_active());
+  ASSERT_EQ(shower.ventilation_effort_target_pct(), 100.0f);
+  for (t += 10 * SEC; shower.shower_active(); t += 10 * SEC) tick(shower, t, 50.0f, 80.0f);
+  ASSERT_EQ(shower.reason(), REASON_CLEARING);
+  const float clearing_start = shower.ventilation_effort_target_pct();
+  for (uint32_t end = t + 12 * MIN; t < end; t += 10 * SEC) tick(shower, t, 50.0f, 80.0f);
+  ASSERT_EQ(shower.reason(), REASON_CLEARING);
+  const float clearing_late = shower.ventilation_effort_target_pct();
+  printf("    clearing target %.1f%% at the start, %.1f%% after 12 min\n", clearing_start,
+         clearing_late);
+  ASSERT_TRUE(clearing_start > 95.0f);
+  ASSERT_TRUE(clearing_late < 50.0f && clearing_late >= 30.0f);
+}
+
+TEST_CASE(damp_target_rises_with_damp_time) {
+  VentIQEngine e = calm_engine();
+  uint32_t t = CALM;
+  // 67 %RH reached slowly (no shower): over the 65 %RH mould threshold,
+  // medium after 30 min there, high after 60. The high-humidity driver
+  // alone would ask 48.
+  for (; t <= CALM + 40 * MIN; t += 10 * SEC) {
+    tick(e, t, std::fmin(67.0f, 45.0f + 1.0f * (t - CALM) / MIN), 80.0f);
+  }
+  ASSERT_TRUE(e.mould_risk() < 2);
+  for (; e.mould_risk() < 2; t += 10 * SEC) tick(e, t, 67.0f, 80.0f);
+  const float medium = e.ventilation_effort_target_pct();
+  for (uint32_t end = t + 20 * MIN; t < end; t += 10 * SEC) tick(e, t, 67.0f, 80.0f);
+  const float later = e.ventilation_effort_target_pct();
+  ASSERT_NEAR(medium, 50.0f, 2.0f);
+  ASSERT_TRUE(later > medium + 25.0f);
+}
+
+// ---------------------------------------------------------------------------
+// Output shaping
+// ---------------------------------------------------------------------------
+
+TEST_CASE(slew_floor_and_minimum_on_time) {
+  VentIQEngine e = calm_engine();
+  uint32_t t = CALM + 10 * SEC;
+  // Odour (target 44): up at 120 %/min — 20 per tick, the floor first.
+  tick(e, t, 45.0f, 200.0f);
+  ASSERT_NEAR(e.ventilation_effort_pct(), 20.0f, 0.01f);
+  tick(e, t += 10 * SEC, 45.0f, 200.0f);
+  ASSERT_NEAR(e.ventilation_effort_pct(), 40.0f, 0.01f);
+  tick(e, t += 10 * SEC, 45.0f, 200.0f);
+  ASSERT_NEAR(e.ventilation_effort_pct(), 44.0f, 0.01f);
+  const uint32_t started = CALM + 10 * SEC;
+
+  // Cleared: down at 20 %/min to the floor, which holds until the
+  // minimum on-time (3 min) has run, then off — never between 0 and 20.
+  tick(e, t += 10 * SEC, 45.0f, 80.0f);
+  ASSERT_FALSE(e.odour());
+  ASSERT_EQ(e.ventilation_effort_target_pct(), 0.0f);
+  ASSERT_NEAR(e.ventilation_effort_pct(), 44.0f - 20.0f / 6.0f, 0.01f);
+  float previous = e.ventilation_effort_pct();
+  while (e.ventilation_effort_pct() > 0.0f) {
+    tick(e, t += 10 * SEC, 45.0f, 80.0f);
+    const float effort = e.ventilation_effort_pct();
+    ASSERT_TRUE(effort == 0.0f || effort >= 20.0f);
+    ASSERT_TRUE(effort <= previous);
+    if (effort > 0.0f) ASSERT_TRUE(previous - effort <= 20.0f / 6.0f + 0.01f);
+    previous = effort;
+  }
+  ASSERT_TRUE(t - started >= 3 * MIN);
+  ASSERT_TRUE(t - started <= 3 * MIN + 10 * SEC);
+
+  // Tuned shaping applies.
+  VentIQEngine quick = calm_engine();
+  quick.set_effort_slew(600.0f, 600.0f);
+  quick.set_effort_floor_pct(10.0f);
+  tick(quick, CALM + 10 * SEC, 45.0f, 200.0f);
+  ASSERT_NEAR(quick.ventilation_effort_pct(), 44.0f, 0.01f);
+}
+
+TEST_CASE(manual_request_runs_full_at_once) {
+  VentIQEngine e = calm_engine();
+  e.force_ventilation(CALM + 10 * SEC, 5.0f);
+  tick(e, CALM + 10 * SEC, 45.0f, 80.0f);
+  ASSERT_EQ(e.ventilation_effort_pct(), 100.0f);
+  ASSERT_EQ(e.fan_percent(), 100);
+}
+
+TEST_CASE(legacy_fan_percent_is_unchanged) {
+  // The stepped view keeps its values whatever the effort does.
+  VentIQEngine odour = calm_engine();
+  tick(odour, CALM + 10 * SEC, 45.0f, 200.0f);
+  ASSERT_EQ(odour.fan_percent(), 50);
+  ASSERT_NEAR(odour.ventilation_effort_target_pct(), 44.0f, 0.01f);
+  VentIQEngine shower = calm_engine();
+  tick(shower, CALM + 10 * SEC, 85.0f, 80.0f);
+  ASSERT_EQ(shower.fan_percent(), 100);
+  ASSERT_NEAR(shower.ventilation_effort_pct(), 20.0f, 0.01f);  // slewing
+}
+
+// ---------------------------------------------------------------------------
+// Closed-loop bathroom
+// ---------------------------------------------------------------------------
+
+// First-order moisture balance (per minute): a shower or a damp source
+// adds moisture; leakage and the fan pull towards 50 %RH; the fan's
+// extraction is proportional to its speed. Humidity sampled every 30 s,
+// SGP41 every 10 s, the 10 s VentIQ tick.
+struct RoomRun {
+  float clear_min;     // shower end -> humidity back under 60 %RH
+  float energy;        // full-speed-equivalent minutes (speed^3)
+  float travel;        // total |speed change|, %
+  float max_step;      // largest single-tick speed change, %
+};
+
+static RoomRun run_room(bool use_effort, bool shower, float damp_source, float voc_level) {
+  VentIQEngine e;
+  e.begin(T0);
+  RoomRun run = {NAN, 0.0f, 0.0f, 0.0f};
+  float rh = 50.0f;
+  float speed = 0.0f;
+  const float dt_min = 10.0f / 60.0f;
+  for (uint32_t t = T0; t <= T0 + 120 * MIN; t += 10 * SEC) {
+    const float m = (t - T0) / (float)MIN;
+    float source = damp_source;
+    if (shower && m >= 20.0f && m < 32.0f) source += 6.0f;
+    rh += dt_min * (source - (0.03f + 0.25f * speed / 100.0f) * (rh - 50.0f));
+    if ((t - T0) % (30 * SEC) == 0) e.input_humidity(t, rh);
+    e.input_temperature(t, 22.0f);
+    e.input_voc(t, m >= 20.0f && m < 80.0f ? voc_level : 80.0f);
+    e.input_nox(t, 10.0f);
+    e.evaluate(t);
+    const float next = use_effort ? e.ventilation_effort_pct() : (float)e.fan_percent();
+    run.travel += std::fabs(next - speed);
+    run.max_step = std::fmax(run.max_step, std::fabs(next - speed));
+    speed = next;
+    run.energy += dt_min * std::pow(speed / 100.0f, 3.0f);
+    if (shower && m >= 32.0f && std::isnan(run.clear_min) && rh < 60.0f) run.clear_min = m - 32.0f;
+  }
+  return run;
+}
+
+static void print_run(const char *label, const RoomRun &run) {
+  if (std::isnan(run.clear_min)) {
+    printf("    %-28s energy %5.2f  travel %6.1f%%  max step %5.1f%%\n", label, run.energy,
+           run.travel, run.max_step);
+  } else {
+    printf("    %-28s clear %4.1f min  energy %5.2f  travel %6.1f%%  max step %5.1f%%\n",
+           label, run.clear_min, run.energy, run.travel, run.max_step);
+  }
+}
+
+TEST_CASE(closed_loop_full_demand_clears_faster) {
+  const RoomRun legacy = run_room(false, true, 0.0f, 80.0f);
+  const RoomRun effort = run_room(true, true, 0.0f, 80.0f);
+  print_run("shower, legacy steps:", legacy);
+  print_run("shower, continuous effort:", effort);
+  ASSERT_FALSE(std::isnan(effort.clear_min));
+  ASSERT_TRUE(effort.clear_min < legacy.clear_min);
+  ASSERT_TRUE(effort.max_step < legacy.max_step);
+}
+
+TEST_CASE(closed_loop_partial_demand_spends_less_and_moves_less) {
+  // A damp source holding the room just over the high-humidity threshold,
+  // plus an hour of Fair-band odour.
+  const RoomRun legacy = run_room(false, false, 0.4f, 180.0f);
+  const RoomRun effort = run_room(true, false, 0.4f, 180.0f);
+  print_run("damp + odour, legacy steps:", legacy);
+  print_run("damp + odour, continuous:", effort);
+  ASSERT_TRUE(effort.energy < legacy.energy);
+  ASSERT_TRUE(effort.travel < legacy.travel);
+  ASSERT_TRUE(effort.max_step < legacy.max_step);
+}
+
+int main() {
+  printf("\n=== VentIQ ventilation effort tests ===\n");
+  printf("LOGIC/SIMULATION PROOF ONLY — never hardware validation.\n\n");
+
+  run_test(test_calm_room_needs_no_effort, "calm_room_needs_no_effort");
+  run_test(test_target_scales_with_each_driver, "target_scales_with_each_driver");
+  run_test(test_damp_target_rises_with_damp_time, "damp_target_rises_with_damp_time");
+  run_test(test_slew_floor_and_minimum_on_time, "slew_floor_and_minimum_on_time");
+  run_test(test_manual_request_runs_full_at_once, "manual_request_runs_full_at_once");
+  run_test(test_legacy_fan_percent_is_unchanged, "legacy_fan_percent_is_unchanged");
+  run_test(test_closed_loop_full_demand_clears_faster,
+           "closed_loop_full_demand_clears_faster");
+  run_test(test_closed_loop_partial_demand_spends_less_and_moves_less,
+           "closed_loop_partial_demand_spends_less_and_moves_less");
+
+  printf("\nResults: %d/%d tests passed\n", passed_count, test_count);
+  if (passed_count == test_count) {
+    printf("All VentIQ ventilation effort tests passed.\n");
+    return 0;
+  }
+  printf("SOME TESTS FAILED\n");
+  return 1;
+}